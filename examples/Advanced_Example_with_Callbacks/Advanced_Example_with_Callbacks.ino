@@ -53,6 +53,14 @@ void setup() {
     }
   });
   
+  // Typed events from every update path, progress at most every 5%
+  ota.setProgressRate(0, 5);
+  ota.onEvent([](const AViShaOTAEvent& event) {
+    if (event.type == AViShaOTAEvent::UPDATE_PROGRESS && event.total > 0) {
+      Serial.printf("Update source %u: %u of %u bytes\n", event.source, event.progress, event.total);
+    }
+  }, AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::UPDATE_PROGRESS));
+  
   // Start OTA
   if (ota.begin("YourWiFi", "YourPassword")) {
     Serial.println("OTA Service Started Successfully!");
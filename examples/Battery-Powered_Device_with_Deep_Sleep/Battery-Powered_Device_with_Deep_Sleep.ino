@@ -6,6 +6,20 @@
 AViShaOTA ota("battery-sensor");
 RTC_DATA_ATTR int bootCount = 0;
 
+// Let AViShaOTA confirm a new image instead of the core (arduino-esp32 2.x)
+bool verifyRollbackLater() {
+  return true;
+}
+
+void goToSleep() {
+  // Waking boots the image again, confirm a new one first or the
+  // bootloader puts the old one back
+  if (!ota.confirmIfHealthy()) {
+    Serial.println("New firmware not confirmed, it will be rolled back");
+  }
+  esp_deep_sleep_start();
+}
+
 void checkBattery() {
   int batteryLevel = analogRead(BATTERY_PIN);
   float voltage = (batteryLevel * 3.3) / 4095.0 * 2; // Voltage divider
@@ -14,7 +28,7 @@ void checkBattery() {
   
   if (voltage < 3.2) {
     Serial.println("Low battery - entering deep sleep");
-    esp_deep_sleep_start();
+    goToSleep();
   }
 }
 
@@ -28,34 +42,43 @@ void setup() {
   pinMode(WAKE_PIN, INPUT_PULLUP);
   bool otaMode = (digitalRead(WAKE_PIN) == LOW);
   
-  if (otaMode || bootCount == 1) {
-    Serial.println("Entering OTA mode...");
-    
-    ota.setOTAPassword("battery123");
-    ota.enableSerialDebug(true);
-    
-    ota.onWiFiConnected([]() {
-      Serial.println("OTA Mode Active!");
-      Serial.println("URL: " + ota.getUploadURL());
-      Serial.println("Hold WAKE pin LOW to exit OTA mode");
-    });
+  ota.setOTAPassword("battery123");
+  ota.enableSerialDebug(true);
+  
+  // Reuse channel, BSSID and IP from the last wake instead of scanning
+  // and asking DHCP; the first boot after power-up does a full connect
+  ota.enableFastConnect(true);
+  
+  // Other wakes listen 300 ms and only stay up when an update server
+  // announces new firmware for this device, e.g.
+  //   python3 extras/beacon.py send "battery-*" --version 1.1.0
+  // The WAKE pin and the first boot open the OTA window without a beacon.
+  ota.enableBeaconWake(!otaMode && bootCount > 1, 300);
+  
+  // A new image counts as healthy once WiFi is up and begin() has either
+  // started the servers or found no beacon
+  ota.enableRollback(true);
+  
+  if (ota.begin("Battery_Network", "battery_pass")) {
+    Serial.println("OTA Mode Active!");
+    Serial.println("URL: " + ota.getUploadURL());
+    Serial.printf("Wake to IP: %lu ms (%s connect)\n", ota.getConnectTime(),
+                  ota.isFastConnected() ? "fast" : "full");
     
-    if (ota.begin("Battery_Network", "battery_pass")) {
-      Serial.println("OTA service started");
+    // Stay in OTA mode for 5 minutes or until wake pin released
+    unsigned long otaStart = millis();
+    while (millis() - otaStart < 300000) { // 5 minutes
+      ota.handle();
       
-      // Stay in OTA mode for 5 minutes or until wake pin released
-      unsigned long otaStart = millis();
-      while (millis() - otaStart < 300000) { // 5 minutes
-        ota.handle();
-        
-        if (digitalRead(WAKE_PIN) == HIGH) {
-          Serial.println("Exiting OTA mode...");
-          break;
-        }
-        
-        delay(100);
+      if (otaMode && digitalRead(WAKE_PIN) == HIGH) {
+        Serial.println("Exiting OTA mode...");
+        break;
       }
+      
+      delay(100);
     }
+  } else if (ota.getStartState() == AViShaOTA::START_NO_BEACON) {
+    Serial.printf("No update announced, awake for %lu ms\n", millis());
   }
   
   // Normal operation
@@ -69,7 +92,7 @@ void setup() {
   Serial.println("Going to sleep for 1 hour...");
   esp_sleep_enable_timer_wakeup(3600 * 1000000ULL); // 1 hour in microseconds
   esp_sleep_enable_ext0_wakeup(GPIO_NUM_33, 0); // Wake on WAKE_PIN LOW
-  esp_deep_sleep_start();
+  goToSleep();
 }
 
 void loop() {
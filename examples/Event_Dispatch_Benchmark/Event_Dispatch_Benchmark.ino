@@ -0,0 +1,75 @@
+#include <AViShaOTA.h>
+
+// Measures the per-chunk cost of progress reporting for a 1.4 MB image
+// received in 1436-byte TCP segments, without touching WiFi or flash:
+//   1. raw callback pointer plus a Serial percent line (the old path)
+//   2. raw callback pointer alone
+//   3. event dispatcher delivering every chunk
+//   4. event dispatcher coalescing to 1% steps, with the Serial line
+
+#define IMAGE_SIZE 1433600
+#define CHUNK_SIZE 1436
+
+volatile uint32_t sink = 0;
+void (*rawCallback)(unsigned int progress, unsigned int total) = nullptr;
+
+void countProgress(unsigned int progress, unsigned int total) {
+  sink += progress;
+}
+
+template <typename Body>
+void measure(const char* label, Body body) {
+  Serial.flush();
+  unsigned long start = micros();
+  uint32_t chunks = 0;
+  for (uint32_t progress = 0; progress < IMAGE_SIZE; chunks++) {
+    progress = min((uint32_t)IMAGE_SIZE, progress + CHUNK_SIZE);
+    body(progress);
+  }
+  Serial.flush();
+  unsigned long elapsed = micros() - start;
+  Serial.printf("\n%-32s %8lu us total, %6.2f us/chunk\n", label, elapsed, (float)elapsed / chunks);
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+  rawCallback = countProgress;
+
+  measure("raw callback + Serial.printf", [](uint32_t progress) {
+    Serial.printf("OTA Progress: %u%%\r", (progress * 100) / IMAGE_SIZE);
+    rawCallback(progress, IMAGE_SIZE);
+  });
+
+  measure("raw callback", [](uint32_t progress) {
+    rawCallback(progress, IMAGE_SIZE);
+  });
+
+  static AViShaOTAEvents events;
+  AViShaOTAEvent start = {};
+  start.type = AViShaOTAEvent::UPDATE_START;
+
+  int id = events.subscribe([](const AViShaOTAEvent& event) {
+    sink += event.progress;
+  }, AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::UPDATE_PROGRESS));
+  events.setProgressRate(0, 0);
+  events.emit(start);
+  measure("dispatcher, every chunk", [](uint32_t progress) {
+    events.progress(AViShaOTAEvent::SOURCE_WEB, progress, IMAGE_SIZE);
+  });
+  events.unsubscribe(id);
+
+  events.subscribe([](const AViShaOTAEvent& event) {
+    Serial.printf("OTA Progress: %u%%\r", (event.progress * 100) / event.total);
+    sink += event.progress;
+  }, AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::UPDATE_PROGRESS));
+  events.setProgressRate(0, 1);
+  events.emit(start);
+  measure("dispatcher, 1% steps + Serial", [](uint32_t progress) {
+    events.progress(AViShaOTAEvent::SOURCE_WEB, progress, IMAGE_SIZE);
+  });
+}
+
+void loop() {
+  delay(1000);
+}
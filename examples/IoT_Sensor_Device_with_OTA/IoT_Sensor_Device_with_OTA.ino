@@ -18,6 +18,7 @@ void setup() {
   // OTA Configuration
   ota.setOTAPassword("sensor123");
   ota.enableSerialDebug(true);
+  ota.enableAsyncStart(true); // Don't hold up the first sensor reading
   
   // OTA Callbacks
   ota.onStart([]() {
@@ -37,11 +38,15 @@ void setup() {
     digitalWrite(LED_PIN, (millis() % 500) < 250);
   });
   
-  // Start OTA
-  if (ota.begin("IoT_Network", "network_password")) {
-    Serial.println("Sensor Node Online!");
-    Serial.println("OTA URL: " + ota.getUploadURL());
-  }
+  ota.onStateChange([](AViShaOTA::StartState state) {
+    if (state == AViShaOTA::START_READY) {
+      Serial.println("Sensor Node Online!");
+      Serial.println("OTA URL: " + ota.getUploadURL());
+    }
+  });
+  
+  // Start OTA - returns immediately, handle() finishes the startup
+  ota.begin("IoT_Network", "network_password");
 }
 
 void loop() {
@@ -1,45 +1,34 @@
 #include <AViShaOTA.h>
-#include <EEPROM.h>
-
-// Device ID stored in EEPROM
-struct DeviceConfig {
-  char deviceId[32];
-  char otaPassword[32];
-  bool isConfigured;
-};
 
 AViShaOTA ota;
-DeviceConfig config;
 
-void loadConfig() {
-  EEPROM.begin(sizeof(DeviceConfig));
-  EEPROM.get(0, config);
+void setup() {
+  Serial.begin(115200);
   
-  if (!config.isConfigured) {
+  // Device ID and password live in NVS, saveConfig() only writes when
+  // something changed
+  if (!ota.loadConfig()) {
     // First time setup
-    sprintf(config.deviceId, "device-%06X", ESP.getEfuseMac() & 0xFFFFFF);
-    strcpy(config.otaPassword, "default123");
-    config.isConfigured = true;
+    char deviceId[32];
+    snprintf(deviceId, sizeof(deviceId), "device-%06X", (unsigned)(ESP.getEfuseMac() & 0xFFFFFF));
     
-    EEPROM.put(0, config);
-    EEPROM.commit();
+    AViShaOTA::Config config = ota.getConfig();
+    config.hostname = deviceId;
+    config.otaPassword = "default123";
+    ota.setConfig(config);
+    ota.saveConfig();
   }
-}
-
-void setup() {
-  Serial.begin(115200);
-  loadConfig();
   
-  Serial.printf("Device ID: %s\n", config.deviceId);
+  Serial.printf("Device ID: %s\n", ota.getHostname().c_str());
   
-  // Initialize OTA with unique device ID
-  ota = AViShaOTA(config.deviceId, 80);
-  ota.setOTAPassword(config.otaPassword);
+  // Updated devices pass the image on to the rest of the fleet
+  ota.setFirmwareVersion("1.0.0");
+  ota.enablePeerShare(true);
   
   ota.onWiFiConnected([]() {
     Serial.println("Device online - OTA available at:");
     Serial.println("http://" + ota.getLocalIP() + "/");
-    Serial.printf("Device: %s\n", config.deviceId);
+    Serial.printf("Device: %s\n", ota.getHostname().c_str());
   });
   
   // Start with your WiFi credentials
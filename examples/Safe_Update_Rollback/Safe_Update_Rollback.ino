@@ -0,0 +1,48 @@
+#include <AViShaOTA.h>
+
+// Automatic rollback of a bad update. A new image boots pending and has
+// 60 s to connect to WiFi, finish begin() and pass sensorHealthy(). If it
+// does not, or it crashes first, the previous image comes back and reports
+// why and how long the outage lasted.
+//
+// Try it by uploading a build with FAIL_HEALTH_CHECK 1: it runs for a
+// minute, then the device returns to the firmware it had before.
+
+#define FAIL_HEALTH_CHECK 0
+
+const char* ssid = "YOUR_WIFI_SSID";
+const char* password = "YOUR_WIFI_PASSWORD";
+
+AViShaOTA ota("rollback-demo");
+
+// arduino-esp32 2.x confirms every image before setup() unless told not to
+bool verifyRollbackLater() {
+  return true;
+}
+
+bool sensorHealthy() {
+  // Replace with a real check, e.g. the sensor answers on I2C
+  return !FAIL_HEALTH_CHECK;
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  ota.setHealthCheck(sensorHealthy);
+  ota.enableRollback(true, 60000);
+
+  if (ota.getLastRollbackReason() != AViShaOTA::ROLLBACK_NONE) {
+    Serial.printf("Last update was rolled back (%s), recovered in %lu ms\n",
+                  AViShaOTA::getRollbackReasonName(ota.getLastRollbackReason()),
+                  ota.getLastRecoveryMs());
+  }
+  if (ota.isUpdatePending()) {
+    Serial.println("Running a new image, waiting for health checks");
+  }
+
+  ota.begin(ssid, password);
+}
+
+void loop() {
+  ota.handle(); // Runs the health checks while the image is pending
+}
@@ -0,0 +1,56 @@
+#include <AViShaOTA.h>
+
+// Upload throughput with a busy loop(), with and without the service task.
+// loop() stands in for a sketch that reads sensors and sleeps for 100 ms.
+// Flash once with USE_SERVICE_TASK 0 and once with 1, then time the same
+// upload from a PC:
+//
+//   time curl -F "firmware=@firmware.bin" http://<ip>/update
+//
+// The device prints the measured rate before it restarts. Without the
+// task, requests are only accepted every 100 ms and the ArduinoOTA and
+// /auth round trips each wait for loop(); with it, uploads run at the
+// rate of the network and flash.
+
+#define USE_SERVICE_TASK 1
+
+const char* ssid = "YOUR_WIFI_SSID";
+const char* password = "YOUR_WIFI_PASSWORD";
+
+AViShaOTA ota("throughput-test");
+
+void setup() {
+  Serial.begin(115200);
+
+  // Runs on the service task when it is enabled, in loop() otherwise
+  ota.onEvent([](const AViShaOTAEvent& event) {
+    AViShaOTA::UpdateStats stats = ota.getLastUpdateStats();
+    Serial.printf("%s: %u bytes in %lu ms, %lu KB/s (flash busy %lu ms, stalled %lu ms)\n",
+                  USE_SERVICE_TASK ? "service task" : "loop()",
+                  (unsigned)stats.writtenBytes, stats.durationMs,
+                  stats.durationMs ? (unsigned long)(stats.writtenBytes / stats.durationMs) : 0UL,
+                  stats.flashBusyMs, stats.stallMs);
+    Serial.printf("%u chunks, latency p50 <= %u us, p99 <= %u us, max %u us, min free heap %u\n",
+                  stats.chunks, stats.chunkP50Us, stats.chunkP99Us, stats.chunkMaxUs, stats.minFreeHeap);
+    Serial.printf("buffer waits p50 <= %u us, p99 <= %u us, max %u us%s\n",
+                  stats.stallP50Us, stats.stallP99Us, stats.stallMaxUs,
+                  stats.preErased ? ", erased ahead of the data" :
+                  stats.presized ? ", size known up front" : "");
+  }, AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::UPDATE_END));
+
+#if USE_SERVICE_TASK
+  // Core 0 keeps it beside the WiFi stack, loop() stays on core 1
+  ota.enableServiceTask(true, 0);
+#endif
+
+  ota.begin(ssid, password);
+}
+
+void loop() {
+  ota.handle(); // Does nothing while the service task runs
+
+  if (ota.isWebUpdateInProgress() || ota.isOTAInProgress()) {
+    Serial.println("Update running");
+  }
+  delay(100);
+}
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Announce new firmware to sleeping AViShaOTA devices.
+
+Devices with enableBeaconWake() listen on a UDP multicast group for a few
+hundred milliseconds after every wake and only start their web server
+(or pull the named manifest) when a beacon targets them. Sleep cycles are
+not synchronised, so keep sending until every device has woken once.
+
+    python3 extras/beacon.py send "sensor-*" --version 1.2.0
+    python3 extras/beacon.py send sensor-0a1b2c --firmware firmware.bin --manifest http://host/manifest.json --password secret
+    python3 extras/beacon.py listen sensor-0a1b2c --version 1.1.0
+
+"listen" applies the device's rules to what it receives and prints the
+action taken, so the sender can be checked without hardware, e.g. over
+loopback:
+
+    python3 extras/beacon.py listen sensor-1 --group 127.0.0.1 &
+    python3 extras/beacon.py send "sensor-*" --group 127.0.0.1 --count 3
+
+Beacons are not authenticated, so devices only follow a manifest URL when
+they require signed images or the beacon carries a mac made with the OTA
+password (--password); otherwise they pull their own setPullURL() or just
+start the web server.
+"""
+
+import argparse
+import hashlib
+import hmac
+import ipaddress
+import json
+import socket
+import struct
+import time
+
+# AVISHA_OTA_BEACON_GROUP, _PORT and _SIZE in AViShaOTA.h
+GROUP = "239.255.65.86"
+PORT = 4586
+MAX_SIZE = 384
+
+
+def is_multicast(address):
+    return ipaddress.ip_address(address).is_multicast
+
+
+# AViShaOTA::pollBeacon() checks this before acting on the beacon
+def beacon_mac(password, beacon):
+    message = "beacon:" + "\n".join(beacon.get(k, "") for k in ("target", "version", "md5", "manifest"))
+    return hmac.new(password.encode(), message.encode(), hashlib.sha256).hexdigest()
+
+
+def make_beacon(args):
+    beacon = {"avisha": "beacon", "target": args.target}
+    if args.version:
+        beacon["version"] = args.version
+    if args.firmware:
+        with open(args.firmware, "rb") as f:
+            beacon["md5"] = hashlib.md5(f.read()).hexdigest()
+    if args.manifest:
+        beacon["manifest"] = args.manifest
+    if args.password:
+        beacon["mac"] = beacon_mac(args.password, beacon)
+    packet = json.dumps(beacon, separators=(",", ":")).encode()
+    if len(packet) > MAX_SIZE:
+        raise SystemExit("beacon is %d bytes, devices ignore more than %d" % (len(packet), MAX_SIZE))
+    return packet
+
+
+def send(args):
+    packet = make_beacon(args)
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    if is_multicast(args.group):
+        sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, args.ttl)
+        sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_LOOP, 1)
+
+    print("sending %d bytes to %s:%d every %.0f ms: %s" % (
+        len(packet), args.group, args.port, args.interval * 1000, packet.decode()))
+    sent = 0
+    try:
+        while args.count == 0 or sent < args.count:
+            sock.sendto(packet, (args.group, args.port))
+            sent += 1
+            time.sleep(args.interval)
+    except KeyboardInterrupt:
+        pass
+    print("%d beacons sent" % sent)
+
+
+def matches(target, hostname):
+    if target == "*" or target == hostname:
+        return True
+    return target.endswith("*") and hostname.startswith(target[:-1])
+
+
+# Mirrors AViShaOTA::pollBeacon()
+def action(packet, args):
+    if len(packet) > MAX_SIZE:
+        return None
+    try:
+        beacon = json.loads(packet)
+    except ValueError:
+        return None
+    if not isinstance(beacon, dict) or beacon.get("avisha") != "beacon":
+        return None
+    if not matches(beacon.get("target", ""), args.hostname):
+        return None
+    if (args.version and beacon.get("version") == args.version) or \
+            (args.md5 and beacon.get("md5") == args.md5):
+        return "ignore, already running %s" % beacon.get("version", "this image")
+    authenticated = False
+    if beacon.get("mac") and args.password:
+        if not hmac.compare_digest(beacon["mac"], beacon_mac(args.password, beacon)):
+            return "ignore, wrong mac"
+        authenticated = True
+    manifest = beacon.get("manifest", "")
+    if manifest and not (authenticated or args.signed or manifest == args.pull_url):
+        manifest = args.pull_url
+    if manifest:
+        return "pull %s" % manifest
+    return "serve, start ArduinoOTA and the web server"
+
+
+def listen(args):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    if is_multicast(args.group):
+        sock.bind(("", args.port))
+        membership = struct.pack("4s4s", socket.inet_aton(args.group), socket.inet_aton("0.0.0.0"))
+        sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, membership)
+    else:
+        sock.bind((args.group, args.port))
+    if args.window:
+        sock.settimeout(args.window / 1000.0)
+
+    print("listening as %s on %s:%d" % (args.hostname, args.group, args.port))
+    begin = time.monotonic()
+    try:
+        while True:
+            packet, sender = sock.recvfrom(2048)
+            result = action(packet, args)
+            if result:
+                print("%7.1f ms  %s: %s" % ((time.monotonic() - begin) * 1000, sender[0], result))
+                if args.window and not result.startswith("ignore"):
+                    return
+    except socket.timeout:
+        print("no beacon for %s within %d ms" % (args.hostname, args.window))
+    except KeyboardInterrupt:
+        pass
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    common = argparse.ArgumentParser(add_help=False)
+    common.add_argument("--group", default=GROUP, help="multicast group, or a unicast address such as 127.0.0.1")
+    common.add_argument("--port", type=int, default=PORT)
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    sender = commands.add_parser("send", parents=[common], help="broadcast beacons")
+    sender.add_argument("target", help='hostname, prefix ending in "*", or "*" for every device')
+    sender.add_argument("--version", help="firmware version being announced")
+    sender.add_argument("--firmware", help="image file, its MD5 lets devices already running it stay asleep")
+    sender.add_argument("--manifest", help="manifest URL, devices pull it instead of opening the web server")
+    sender.add_argument("--password", help="OTA password, signs the beacon so devices follow --manifest")
+    sender.add_argument("--interval", type=float, default=0.1, help="seconds between beacons")
+    sender.add_argument("--count", type=int, default=0, help="beacons to send, 0 = until interrupted")
+    sender.add_argument("--ttl", type=int, default=1, help="multicast TTL")
+    sender.set_defaults(func=send)
+
+    listener = commands.add_parser("listen", parents=[common], help="act as a device and print what it would do")
+    listener.add_argument("hostname")
+    listener.add_argument("--version", help="firmware version the device runs")
+    listener.add_argument("--md5", help="MD5 of the image the device runs")
+    listener.add_argument("--password", help="OTA password of the device")
+    listener.add_argument("--signed", action="store_true", help="device requires signed images")
+    listener.add_argument("--pull-url", default="", help="the device's setPullURL()")
+    listener.add_argument("--window", type=int, default=0, help="stop after this many ms like a device, 0 = forever")
+    listener.set_defaults(func=listen)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Generate src/AViShaOTAUI.h from extras/ui/upload.html.
+
+The page is minified and gzip-compressed so the device can serve it with
+Content-Encoding: gzip. The minified text is embedded as well for clients
+that do not accept gzip. Run this after editing the HTML:
+
+    python3 extras/build_ui.py
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "extras", "ui", "upload.html")
+TARGET = os.path.join(ROOT, "src", "AViShaOTAUI.h")
+
+
+def minify(html):
+    lines = []
+    for line in html.splitlines():
+        line = line.strip()
+        # Whole-line and trailing JS comments; newlines are kept for ASI
+        if not line or line.startswith("//"):
+            continue
+        line = re.sub(r";\s*//.*$", ";", line)
+        line = re.sub(r"\s+", " ", line)
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def c_array(name, data):
+    out = ["static const uint8_t %s[] PROGMEM = {" % name]
+    for i in range(0, len(data), 16):
+        out.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    out.append("};")
+    return "\n".join(out)
+
+
+def main():
+    with open(SOURCE, encoding="utf-8") as f:
+        text = minify(f.read()).encode("utf-8")
+    packed = gzip.compress(text, compresslevel=9, mtime=0)
+    digest = hashlib.sha256(text).hexdigest()[:8]
+
+    # CRLF like the rest of src/
+    with open(TARGET, "w", encoding="utf-8", newline="\r\n") as f:
+        f.write("// Generated by extras/build_ui.py from extras/ui/upload.html - do not edit\n")
+        f.write("#ifndef AVISHA_OTA_UI_H\n#define AVISHA_OTA_UI_H\n\n")
+        f.write("#include <Arduino.h>\n\n")
+        f.write('#define AVISHA_OTA_UI_HASH "%s"\n' % digest)
+        f.write("#define AVISHA_OTA_UI_SIZE %d\n" % len(text))
+        f.write("#define AVISHA_OTA_UI_GZ_SIZE %d\n\n" % len(packed))
+        f.write(c_array("AVISHA_OTA_UI_GZ", packed) + "\n\n")
+        f.write(c_array("AVISHA_OTA_UI", text + b"\0") + "\n\n")
+        f.write("#endif // AVISHA_OTA_UI_H\n")
+
+    print("%s: %d bytes minified, %d bytes gzip" % (os.path.relpath(TARGET, ROOT), len(text), len(packed)))
+
+
+if __name__ == "__main__":
+    main()
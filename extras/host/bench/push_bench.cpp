@@ -0,0 +1,300 @@
+// push_bench.cpp - Push upload throughput of the library on the host HAL
+//
+// Each run starts a fresh AViShaOTA with the push server, sends a random
+// image to it over loopback with the protocol of extras/push_upload.py and
+// checks that the update partition holds the image and boots next. The
+// image is random with repeats, about as compressible as a real app, and
+// goes through each mode in turn:
+//   writer   setWriteBuffers() default: a writer task, the partition
+//            erased ahead of the data
+//   inline   setWriteBuffers(0): Update.write() on the receiving task
+//   gzip     as writer, but the image is sent gzip-compressed and inflated
+//            on the device (needs zlib on the host)
+//
+//   push_bench [--size KB] [--runs N] [--chunk BYTES] [--mode writer|inline|gzip|all]
+//              [--erase-us US] [--block-us US] [--page-us US] [--port PORT]
+//
+// Reported per run: MB/s of image from connect to the final status, the
+// same as ms, the bytes sent, the client's send() latency percentiles (TCP
+// backpressure from the device), the library's UpdateStats (chunk and
+// stall percentiles, flash busy time) and the heap peak above what was in
+// use before the run. Exits non-zero when an update fails or the partition
+// does not match.
+#include <AViShaOTA.h>
+#include <esp_ota_ops.h>
+#include <sys/mman.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#if AVISHA_HOST_ZLIB
+#include <zlib.h>
+#endif
+#include "push_client.h"
+#include "sim.h"
+
+struct Options {
+    size_t sizeKB = 1024;
+    int runs = 3;
+    size_t chunk = 1460;
+    std::string mode = "all";
+    uint16_t port = 18266;
+    sim::FlashTiming timing = sim::getFlashTiming();
+};
+
+struct RunResult {
+    PushResult client;
+    AViShaOTA::UpdateStats stats;
+    sim::FlashCounters flash;
+    size_t heapPeak = 0;
+    bool matches = false;
+};
+
+static uint32_t percentile(std::vector<uint32_t> values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t index = (size_t)(p * (values.size() - 1) + 0.5);
+    return values[index];
+}
+
+static bool partitionMatches(const uint8_t* image, size_t size) {
+    const esp_partition_t* boot = esp_ota_get_boot_partition();
+    if (!boot || strcmp(boot->label, "app1") != 0) {
+        return false;
+    }
+    std::vector<uint8_t> chunk(4096);
+    for (size_t offset = 0; offset < size; offset += chunk.size()) {
+        size_t n = std::min(chunk.size(), size - offset);
+        if (esp_partition_read(boot, offset, chunk.data(), n) != ESP_OK || memcmp(chunk.data(), image + offset, n) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static RunResult runOnce(const Options& options, bool inlineWrites, const PushPayload& payload, const uint8_t* image,
+                         size_t size, int index) {
+    RunResult result;
+    sim::resetFlash();
+    std::atomic<bool> restarted(false);
+    sim::onRestart([&restarted]() { restarted = true; });
+
+    // Alternate ports, a closed listener can linger in TIME_WAIT
+    uint16_t webPort = options.port + 2 * (index % 16);
+    uint16_t pushPort = webPort + 1;
+    sim::resetHeapPeak();
+    size_t baseline = sim::heapInUse();
+
+    AViShaOTA* ota = new AViShaOTA("avisha-bench", webPort);
+    ota->setLogLevel(AViShaOTALog::LEVEL_WARN);
+    ota->enableMDNS(false);
+    ota->enablePushServer(true, pushPort);
+    if (inlineWrites) {
+        ota->setWriteBuffers(0);
+    }
+    if (!ota->begin("sim", "")) {
+        result.client.error = "begin() failed";
+        delete ota;
+        return result;
+    }
+
+    std::atomic<bool> clientDone(false);
+    std::thread client([&]() {
+        pushImage(pushPort, payload, options.chunk, result.client);
+        clientDone = true;
+    });
+    // The loop task: handle() receives the whole image once the handshake is in
+    while (!clientDone || (result.client.ok && !restarted)) {
+        ota->handle();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    client.join();
+
+    result.stats = ota->getLastUpdateStats();
+    result.flash = sim::getFlashCounters();
+    delete ota;
+    result.heapPeak = sim::heapPeak() - baseline;
+    result.matches = result.client.ok && partitionMatches(image, size);
+    sim::onRestart(nullptr);
+    return result;
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: push_bench [--size KB] [--runs N] [--chunk BYTES] [--mode writer|inline|gzip|all]\n"
+            "                  [--erase-us US] [--block-us US] [--page-us US] [--port PORT]\n");
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--size") {
+            options.sizeKB = strtoul(value, nullptr, 10);
+        } else if (arg == "--runs") {
+            options.runs = atoi(value);
+        } else if (arg == "--chunk") {
+            options.chunk = strtoul(value, nullptr, 10);
+        } else if (arg == "--mode") {
+            options.mode = value;
+        } else if (arg == "--erase-us") {
+            options.timing.eraseSectorUs = strtoul(value, nullptr, 10);
+        } else if (arg == "--block-us") {
+            options.timing.eraseBlockUs = strtoul(value, nullptr, 10);
+        } else if (arg == "--page-us") {
+            options.timing.programPageUs = strtoul(value, nullptr, 10);
+        } else if (arg == "--port") {
+            options.port = (uint16_t)atoi(value);
+        } else {
+            return false;
+        }
+    }
+    return options.sizeKB > 0 && options.runs > 0 && options.chunk > 0 &&
+           (options.mode == "all" || options.mode == "writer" || options.mode == "inline" ||
+            options.mode == "gzip");
+}
+
+// Like an app image: runs of fresh bytes, biased like machine code, and
+// copies of earlier stretches like repeated code and string tables
+static void fillImage(uint8_t* image, size_t size) {
+    uint32_t seed = 0xA5A5F00D;
+    auto next = [&seed]() {
+        seed = seed * 1664525 + 1013904223;
+        return seed >> 8;
+    };
+    size_t pos = 0;
+    while (pos < size) {
+        size_t run = std::min<size_t>(16 + next() % 112, size - pos);
+        if (pos >= 4096 && next() % 3 == 0) {
+            size_t from = pos - 1 - next() % std::min<size_t>(pos, 32768);
+            for (size_t i = 0; i < run; i++) {
+                image[pos + i] = image[from + i];
+            }
+        } else {
+            for (size_t i = 0; i < run; i++) {
+                uint32_t r = next();
+                image[pos + i] = (uint8_t)(r & 0x03 ? r >> 16 & 0x7F : r >> 16);
+            }
+        }
+        pos += run;
+    }
+    image[0] = 0xE9;  // ESP_IMAGE_HEADER_MAGIC
+}
+
+// gzip of the image in memory outside the simulated heap, 0 without zlib
+static size_t gzipImage(const uint8_t* image, size_t size, uint8_t** out) {
+#if AVISHA_HOST_ZLIB
+    z_stream stream = {};
+    if (deflateInit2(&stream, 9, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return 0;
+    }
+    size_t bound = deflateBound(&stream, size);
+    void* buffer = mmap(nullptr, bound, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffer == MAP_FAILED) {
+        deflateEnd(&stream);
+        return 0;
+    }
+    stream.next_in = (Bytef*)image;
+    stream.avail_in = (uInt)size;
+    stream.next_out = (Bytef*)buffer;
+    stream.avail_out = (uInt)bound;
+    int result = deflate(&stream, Z_FINISH);
+    size_t len = stream.total_out;
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        munmap(buffer, bound);
+        return 0;
+    }
+    *out = (uint8_t*)buffer;
+    return len;
+#else
+    return 0;
+#endif
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+    sim::setFlashTiming(options.timing);
+    if (!sim::heapTracked()) {
+        printf("note: heap use is not tracked on this host\n");
+    }
+
+    // Outside the simulated heap, the image is the sender's
+    size_t size = options.sizeKB * 1024;
+    uint8_t* image = (uint8_t*)mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (image == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    fillImage(image, size);
+    uint8_t sha256[32];
+    mbedtls_sha256(image, size, sha256, 0);
+    uint8_t* gzipped = nullptr;
+    size_t gzipSize = gzipImage(image, size, &gzipped);
+
+    printf("image %u KB, chunk %u B, flash: sector erase %u us, block erase %u us, page program %u us\n",
+           (unsigned)options.sizeKB, (unsigned)options.chunk, options.timing.eraseSectorUs,
+           options.timing.eraseBlockUs, options.timing.programPageUs);
+    if (gzipSize > 0) {
+        printf("gzip %u KB, %.1f %% of the image\n", (unsigned)(gzipSize / 1024), 100.0 * gzipSize / size);
+    }
+    printf("%-7s %3s %7s %7s %7s %8s %8s %8s %8s %8s %8s %8s %8s %6s %6s %7s\n", "mode", "run", "MB/s", "ms",
+           "sentKB", "send50", "send99", "sendmax", "chunk50", "chunk99", "stall50", "stall99", "flashms", "erase",
+           "blocks", "heapKB");
+
+    // PUSH_FLAG_RAW for the plain image, the device detects gzip itself
+    const PushPayload raw = {image, size, PUSH_CLIENT_RAW, nullptr, sha256};
+    const PushPayload compressed = {gzipped, gzipSize, 0, nullptr, sha256};
+    const char* modes[] = {"writer", "inline", "gzip"};
+    bool failed = false;
+    int index = 0;
+    for (const char* name : modes) {
+        if (options.mode != "all" && options.mode != name) {
+            continue;
+        }
+        bool inlineWrites = strcmp(name, "inline") == 0;
+        bool gzip = strcmp(name, "gzip") == 0;
+        if (gzip && gzipSize == 0) {
+            printf("%-7s skipped, built without zlib\n", name);
+            continue;
+        }
+        std::vector<double> rates;
+        for (int run = 0; run < options.runs; run++) {
+            RunResult result = runOnce(options, inlineWrites, gzip ? compressed : raw, image, size, index++);
+            if (!result.matches) {
+                failed = true;
+                printf("%-7s %3d  FAILED: %s\n", name, run + 1,
+                       result.client.ok ? "partition does not match the image" : result.client.error.c_str());
+                continue;
+            }
+            double rate = size / result.client.seconds / (1024.0 * 1024.0);
+            rates.push_back(rate);
+            printf("%-7s %3d %7.3f %7.0f %7u %8u %8u %8u %8u %8u %8u %8u %8lu %6s %6u %7.1f\n", name, run + 1, rate,
+                   result.client.seconds * 1000, (unsigned)((gzip ? gzipSize : size) / 1024), percentile(result.client.sendUs, 0.50), percentile(result.client.sendUs, 0.99),
+                   percentile(result.client.sendUs, 1.0), result.stats.chunkP50Us, result.stats.chunkP99Us,
+                   result.stats.stallP50Us, result.stats.stallP99Us, result.stats.flashBusyMs,
+                   result.stats.preErased ? "ahead" : "inline", result.flash.blocksErased,
+                   result.heapPeak / 1024.0);
+        }
+        if (!rates.empty()) {
+            std::sort(rates.begin(), rates.end());
+            printf("%-7s median %.3f MB/s over %u runs\n", name, rates[rates.size() / 2], (unsigned)rates.size());
+        }
+    }
+    munmap(image, size);
+    if (gzipped) {
+        munmap(gzipped, gzipSize);
+    }
+    return failed ? 1 : 0;
+}
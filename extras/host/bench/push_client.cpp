@@ -0,0 +1,127 @@
+// push_client.cpp - Host side of the push protocol
+#include "push_client.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+struct ClientPushHeader {
+    char magic[4];
+    uint8_t version;
+    uint8_t flags;
+    uint16_t reserved;
+    uint32_t size;
+    uint8_t md5[16];
+    uint8_t sha256[32];
+};
+
+struct ClientPushStatus {
+    uint8_t code;
+    uint8_t reserved[3];
+    uint32_t value;
+};
+
+uint64_t pushNowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool sendAll(int fd, const void* data, size_t len) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    while (len > 0) {
+        ssize_t n = send(fd, bytes, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        bytes += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool recvAll(int fd, void* data, size_t len) {
+    uint8_t* bytes = (uint8_t*)data;
+    while (len > 0) {
+        ssize_t n = recv(fd, bytes, len, 0);
+        if (n <= 0) {
+            return false;
+        }
+        bytes += n;
+        len -= n;
+    }
+    return true;
+}
+
+void pushImage(uint16_t port, const PushPayload& payload, size_t chunk, PushResult& result) {
+    int fd = -1;
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    for (int attempt = 0; attempt < 100; attempt++) {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0) {
+            break;
+        }
+        close(fd);
+        fd = -1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    if (fd < 0) {
+        result.error = "cannot connect";
+        return;
+    }
+    int flag = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    timeval timeout = {30, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    uint64_t start = pushNowUs();
+
+    ClientPushHeader header = {};
+    memcpy(header.magic, "AVPU", 4);
+    header.version = 2;
+    header.flags = payload.flags;
+    header.size = (uint32_t)payload.size;
+    if (payload.md5) {
+        memcpy(header.md5, payload.md5, sizeof(header.md5));
+    }
+    if (payload.sha256) {
+        memcpy(header.sha256, payload.sha256, sizeof(header.sha256));
+    }
+    char hello[36];
+    uint8_t mac[32] = {0};
+    ClientPushStatus status;
+    if (!sendAll(fd, &header, sizeof(header)) || !recvAll(fd, hello, sizeof(hello)) ||
+        memcmp(hello, "AVP2", 4) != 0 || !sendAll(fd, mac, sizeof(mac)) || !recvAll(fd, &status, sizeof(status)) ||
+        status.code != 0) {
+        result.error = "handshake refused";
+        close(fd);
+        return;
+    }
+
+    result.sendUs.reserve(payload.size / chunk + 1);
+    for (size_t sent = 0; sent < payload.size; sent += chunk) {
+        size_t n = std::min(chunk, payload.size - sent);
+        uint64_t before = pushNowUs();
+        if (!sendAll(fd, payload.data + sent, n)) {
+            result.error = "connection lost while sending";
+            close(fd);
+            return;
+        }
+        result.sendUs.push_back((uint32_t)(pushNowUs() - before));
+    }
+    if (!recvAll(fd, &status, sizeof(status))) {
+        result.error = "no final status";
+    } else if (status.code != 1 || status.value != payload.size) {
+        result.error = "update failed, status " + std::to_string(status.code);
+    } else {
+        result.ok = true;
+    }
+    result.seconds = (pushNowUs() - start) / 1e6;
+    close(fd);
+}
@@ -0,0 +1,35 @@
+// push_client.h - Host side of the push protocol (extras/push_upload.py),
+// shared by the bench and the tests
+#ifndef AVISHA_HOST_PUSH_CLIENT_H
+#define AVISHA_HOST_PUSH_CLIENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define PUSH_CLIENT_DELTA 0x01  // PUSH_FLAG_DELTA
+#define PUSH_CLIENT_RAW 0x02    // PUSH_FLAG_RAW
+
+// What goes over the wire
+struct PushPayload {
+    const uint8_t* data;
+    size_t size;
+    uint8_t flags;
+    const uint8_t* md5;         // Resulting image, nullptr = not sent
+    const uint8_t* sha256;      // Resulting image, nullptr = not checked
+};
+
+struct PushResult {
+    bool ok = false;
+    std::string error;
+    double seconds = 0;             // Connect to the final status
+    std::vector<uint32_t> sendUs;   // Per send() call
+};
+
+uint64_t pushNowUs();
+
+// Sends payload in chunk byte send() calls, without a password
+void pushImage(uint16_t port, const PushPayload& payload, size_t chunk, PushResult& result);
+
+#endif // AVISHA_HOST_PUSH_CLIENT_H
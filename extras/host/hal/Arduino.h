@@ -0,0 +1,306 @@
+// Arduino.h - Host stand-in for the arduino-esp32 core, see extras/host
+#ifndef AVISHA_HOST_ARDUINO_H
+#define AVISHA_HOST_ARDUINO_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+
+#include "freertos/FreeRTOS.h"
+
+// The 2.x core, which keeps WebServer's raw body support and the multipart
+// streaming path in the build
+#define ESP_ARDUINO_VERSION_MAJOR 2
+#define ESP_ARDUINO_VERSION_MINOR 0
+#define ESP_ARDUINO_VERSION_PATCH 17
+
+typedef uint8_t byte;
+typedef bool boolean;
+class __FlashStringHelper;
+#define F(x) (x)
+#define PSTR(x) (x)
+#define PROGMEM
+#define PGM_P const char*
+#define IRAM_ATTR
+#define RTC_NOINIT_ATTR
+#define RTC_DATA_ATTR
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define strlen_P strlen
+#define memcpy_P memcpy
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define HIGH 1
+#define LOW 0
+
+class Print;
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+class String {
+public:
+    String() {}
+    String(const char* value) : text(value ? value : "") {}
+    String(const std::string& value) : text(value) {}
+    String(const __FlashStringHelper* value) : text(reinterpret_cast<const char*>(value)) {}
+    explicit String(char c) : text(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10) { fromNumber(value, base); }
+    explicit String(int value, unsigned char base = 10) { fromSigned(value, base); }
+    explicit String(unsigned int value, unsigned char base = 10) { fromNumber(value, base); }
+    explicit String(long value, unsigned char base = 10) { fromSigned(value, base); }
+    explicit String(unsigned long value, unsigned char base = 10) { fromNumber(value, base); }
+    explicit String(long long value, unsigned char base = 10) { fromSigned(value, base); }
+    explicit String(unsigned long long value, unsigned char base = 10) { fromNumber(value, base); }
+    explicit String(float value, unsigned int decimals = 2) { fromFloat(value, decimals); }
+    explicit String(double value, unsigned int decimals = 2) { fromFloat(value, decimals); }
+
+    unsigned int length() const { return text.size(); }
+    const char* c_str() const { return text.c_str(); }
+    bool reserve(unsigned int size) { text.reserve(size); return true; }
+    bool isEmpty() const { return text.empty(); }
+
+    String& operator+=(const String& rhs) { text += rhs.text; return *this; }
+    String& operator+=(const char* rhs) { text += rhs ? rhs : ""; return *this; }
+    String& operator+=(char rhs) { text += rhs; return *this; }
+    String& operator+=(int rhs) { text += String(rhs).text; return *this; }
+    String& operator+=(unsigned int rhs) { text += String(rhs).text; return *this; }
+    String& operator+=(long rhs) { text += String(rhs).text; return *this; }
+    String& operator+=(unsigned long rhs) { text += String(rhs).text; return *this; }
+    bool concat(const String& rhs) { text += rhs.text; return true; }
+    bool concat(const char* rhs) { text += rhs ? rhs : ""; return true; }
+    bool concat(const char* rhs, unsigned int len) { text.append(rhs, len); return true; }
+    bool concat(char rhs) { text += rhs; return true; }
+
+    friend String operator+(const String& a, const String& b) { return String(a.text + b.text); }
+    friend String operator+(const String& a, const char* b) { return String(a.text + (b ? b : "")); }
+    friend String operator+(const char* a, const String& b) { return String((a ? a : "") + b.text); }
+    friend String operator+(const String& a, char b) { return String(a.text + b); }
+
+    bool operator==(const String& rhs) const { return text == rhs.text; }
+    bool operator==(const char* rhs) const { return text == (rhs ? rhs : ""); }
+    bool operator!=(const String& rhs) const { return text != rhs.text; }
+    bool operator!=(const char* rhs) const { return !(*this == rhs); }
+    bool operator<(const String& rhs) const { return text < rhs.text; }
+    char operator[](unsigned int index) const { return index < text.size() ? text[index] : 0; }
+    char& operator[](unsigned int index) { return text[index]; }
+    char charAt(unsigned int index) const { return (*this)[index]; }
+    void setCharAt(unsigned int index, char c) { if (index < text.size()) text[index] = c; }
+
+    bool equals(const String& rhs) const { return text == rhs.text; }
+    bool equalsIgnoreCase(const String& rhs) const {
+        if (text.size() != rhs.text.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < text.size(); i++) {
+            if (tolower((unsigned char)text[i]) != tolower((unsigned char)rhs.text[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    int compareTo(const String& rhs) const { return text.compare(rhs.text); }
+    bool startsWith(const String& prefix) const { return text.compare(0, prefix.text.size(), prefix.text) == 0; }
+    bool endsWith(const String& suffix) const {
+        return text.size() >= suffix.text.size() &&
+               text.compare(text.size() - suffix.text.size(), suffix.text.size(), suffix.text) == 0;
+    }
+
+    int indexOf(char c, unsigned int from = 0) const { return position(text.find(c, from)); }
+    int indexOf(const String& s, unsigned int from = 0) const { return position(text.find(s.text, from)); }
+    int lastIndexOf(char c) const { return position(text.rfind(c)); }
+    int lastIndexOf(const String& s) const { return position(text.rfind(s.text)); }
+    String substring(unsigned int from) const { return from < text.size() ? String(text.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) {
+            unsigned int swap = from;
+            from = to;
+            to = swap;
+        }
+        return from < text.size() ? String(text.substr(from, to - from)) : String();
+    }
+
+    void remove(unsigned int index) { if (index < text.size()) text.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < text.size()) text.erase(index, count); }
+    void replace(const String& find, const String& with) {
+        if (find.text.empty()) {
+            return;
+        }
+        for (size_t at = text.find(find.text); at != std::string::npos; at = text.find(find.text, at + with.text.size())) {
+            text.replace(at, find.text.size(), with.text);
+        }
+    }
+    void trim() {
+        size_t start = text.find_first_not_of(" \t\r\n");
+        size_t end = text.find_last_not_of(" \t\r\n");
+        text = start == std::string::npos ? std::string() : text.substr(start, end - start + 1);
+    }
+    void toLowerCase() { for (char& c : text) c = tolower((unsigned char)c); }
+    void toUpperCase() { for (char& c : text) c = toupper((unsigned char)c); }
+    long toInt() const { return strtol(text.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(text.c_str(), nullptr); }
+    void getBytes(unsigned char* buf, unsigned int size, unsigned int index = 0) const {
+        toCharArray(reinterpret_cast<char*>(buf), size, index);
+    }
+    void toCharArray(char* buf, unsigned int size, unsigned int index = 0) const {
+        if (size == 0) {
+            return;
+        }
+        size_t n = index < text.size() ? text.copy(buf, size - 1, index) : 0;
+        buf[n] = 0;
+    }
+
+private:
+    std::string text;
+
+    static int position(size_t at) { return at == std::string::npos ? -1 : (int)at; }
+    void fromNumber(unsigned long long value, unsigned char base) {
+        char buf[66];
+        char* p = buf + sizeof(buf) - 1;
+        *p = 0;
+        do {
+            unsigned digit = value % base;
+            *--p = digit < 10 ? '0' + digit : 'a' + digit - 10;
+            value /= base;
+        } while (value);
+        text = p;
+    }
+    void fromSigned(long long value, unsigned char base) {
+        if (value < 0 && base == 10) {
+            fromNumber(-(unsigned long long)value, base);
+            text.insert(0, 1, '-');
+        } else {
+            fromNumber((unsigned long long)value, base);
+        }
+    }
+    void fromFloat(double value, unsigned int decimals) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", (int)decimals, value);
+        text = buf;
+    }
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size-- && write(*buffer++)) {
+            n++;
+        }
+        return n;
+    }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    size_t print(const String& s) { return write(s.c_str(), s.length()); }
+    size_t print(const char* s) { return write(s); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(int n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned int n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(long n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned long n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(long long n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(unsigned long long n, int base = 10) { return print(String(n, (unsigned char)base)); }
+    size_t print(double n, int decimals = 2) { return print(String(n, (unsigned int)decimals)); }
+    size_t print(const Printable& x) { return x.printTo(*this); }
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T& value) { return print(value) + println(); }
+    template <typename T>
+    size_t println(const T& value, int format) { return print(value, format) + println(); }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    void setTimeout(unsigned long timeout) { this->timeout = timeout; }
+    unsigned long getTimeout() const { return timeout; }
+    size_t readBytes(uint8_t* buffer, size_t length);
+    size_t readBytes(char* buffer, size_t length) { return readBytes((uint8_t*)buffer, length); }
+    String readString();
+    String readStringUntil(char terminator);
+
+protected:
+    unsigned long timeout = 1000;
+    int timedRead();
+};
+
+// Writes to stdout
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud) {}
+    void end() {}
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    int availableForWrite() override { return 4096; }
+    size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+    size_t write(const uint8_t* buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+    void flush() override { fflush(stdout); }
+    operator bool() const { return true; }
+    using Print::write;
+};
+extern HardwareSerial Serial;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+// As in the core, both arguments must have the same type
+using std::max;
+using std::min;
+#define constrain(x, low, high) ((x) < (low) ? (low) : ((x) > (high) ? (high) : (x)))
+
+// Heap figures come from the allocation tracking in sim.h
+class EspClass {
+public:
+    void restart();
+    uint32_t getHeapSize();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getPsramSize() { return 0; }
+    uint32_t getFreePsram() { return 0; }
+    uint32_t getChipRevision() { return 3; }
+    const char* getChipModel() { return "ESP32-HOST"; }
+    uint8_t getChipCores() { return 2; }
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getCycleCount() { return (uint32_t)(micros() * 240); }
+    const char* getSdkVersion() { return "host"; }
+    uint32_t getFlashChipSize() { return 4 * 1024 * 1024; }
+    uint32_t getFlashChipSpeed() { return 80000000; }
+    uint32_t getSketchSize();
+    uint32_t getFreeSketchSpace();
+    String getSketchMD5();
+    uint64_t getEfuseMac() { return 0x0000A1B2C3D4E5F6ULL; }
+};
+extern EspClass ESP;
+
+#endif // AVISHA_HOST_ARDUINO_H
@@ -0,0 +1,45 @@
+// ArduinoOTA.h - Host stand-in. Keeps the callbacks; no espota client
+// reaches it, so handle() never starts an update.
+#ifndef AVISHA_HOST_ARDUINOOTA_H
+#define AVISHA_HOST_ARDUINOOTA_H
+
+#include "Update.h"
+#include "WiFi.h"
+
+typedef enum { OTA_AUTH_ERROR, OTA_BEGIN_ERROR, OTA_CONNECT_ERROR, OTA_RECEIVE_ERROR, OTA_END_ERROR } ota_error_t;
+
+class ArduinoOTAClass {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+    typedef std::function<void(ota_error_t)> THandlerFunction_Error;
+    typedef std::function<void(unsigned int, unsigned int)> THandlerFunction_Progress;
+
+    ArduinoOTAClass& setPort(uint16_t port) { this->port = port; return *this; }
+    ArduinoOTAClass& setHostname(const char* hostname) { this->hostname = hostname; return *this; }
+    String getHostname() { return hostname; }
+    ArduinoOTAClass& setPassword(const char* password) { this->password = password; return *this; }
+    ArduinoOTAClass& setPasswordHash(const char* hash) { return *this; }
+    ArduinoOTAClass& setMdnsEnabled(bool enabled) { return *this; }
+    ArduinoOTAClass& setRebootOnSuccess(bool reboot) { return *this; }
+    ArduinoOTAClass& onStart(THandlerFunction fn) { startCallback = fn; return *this; }
+    ArduinoOTAClass& onEnd(THandlerFunction fn) { endCallback = fn; return *this; }
+    ArduinoOTAClass& onError(THandlerFunction_Error fn) { errorCallback = fn; return *this; }
+    ArduinoOTAClass& onProgress(THandlerFunction_Progress fn) { progressCallback = fn; return *this; }
+    void begin() { running = true; }
+    void end() { running = false; }
+    void handle() {}
+    int getCommand() { return 0; }
+
+private:
+    uint16_t port = 3232;
+    String hostname;
+    String password;
+    bool running = false;
+    THandlerFunction startCallback;
+    THandlerFunction endCallback;
+    THandlerFunction_Error errorCallback;
+    THandlerFunction_Progress progressCallback;
+};
+extern ArduinoOTAClass ArduinoOTA;
+
+#endif // AVISHA_HOST_ARDUINOOTA_H
@@ -0,0 +1,31 @@
+// ESPmDNS.h - Host stand-in. Registers services locally; queries find no
+// peers, so peer checks end without a download.
+#ifndef AVISHA_HOST_ESPMDNS_H
+#define AVISHA_HOST_ESPMDNS_H
+
+#include "WiFi.h"
+
+class MDNSResponder {
+public:
+    bool begin(const char* hostname) { instanceName = hostname; return true; }
+    void end() { services = 0; }
+    bool addService(const char* service, const char* proto, uint16_t port) { services++; return true; }
+    bool addService(const String& service, const String& proto, uint16_t port) { services++; return true; }
+    bool addServiceTxt(const char* service, const char* proto, const char* key, const char* value) { return true; }
+    void enableArduino(uint16_t port = 3232, bool auth = false) {}
+    int queryService(const char* service, const char* proto) { return 0; }
+    int queryService(const String& service, const String& proto) { return 0; }
+    String hostname(int index) { return String(); }
+    IPAddress IP(int index) { return IPAddress(); }
+    uint16_t port(int index) { return 0; }
+    int numTxt(int index) { return 0; }
+    bool hasTxt(int index, const char* key) { return false; }
+    String txt(int index, const char* key) { return String(); }
+
+private:
+    String instanceName;
+    int services = 0;
+};
+extern MDNSResponder MDNS;
+
+#endif // AVISHA_HOST_ESPMDNS_H
@@ -0,0 +1,41 @@
+// HTTPClient.h - Host stand-in. Every request fails to connect, so pull
+// checks and peer downloads end at the first step.
+#ifndef AVISHA_HOST_HTTPCLIENT_H
+#define AVISHA_HOST_HTTPCLIENT_H
+
+#include "WiFi.h"
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTP_CODE_OK 200
+#define HTTP_CODE_NOT_MODIFIED 304
+
+class HTTPClient {
+public:
+    bool begin(const String& url) { this->url = url; return true; }
+    bool begin(WiFiClient& client, const String& url) { this->url = url; return true; }
+    void end() {}
+    void useHTTP10(bool useHTTP10 = true) {}
+    void setReuse(bool reuse) {}
+    void setTimeout(uint16_t timeout) {}
+    void setConnectTimeout(int32_t timeout) {}
+    void addHeader(const String& name, const String& value) {}
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {}
+    String header(const char* name) { return String(); }
+    bool hasHeader(const char* name) { return false; }
+    int GET() { return HTTPC_ERROR_CONNECTION_REFUSED; }
+    int sendRequest(const char* type, uint8_t* payload = nullptr, size_t size = 0) {
+        return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+    int getSize() { return -1; }
+    String getString() { return String(); }
+    WiFiClient& getStream() { return client; }
+    WiFiClient* getStreamPtr() { return &client; }
+    bool connected() { return false; }
+    static String errorToString(int error) { return String("connection refused"); }
+
+private:
+    String url;
+    WiFiClient client;
+};
+
+#endif // AVISHA_HOST_HTTPCLIENT_H
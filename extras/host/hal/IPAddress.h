@@ -0,0 +1,41 @@
+// IPAddress.h - Host stand-in, IPv4 only
+#ifndef AVISHA_HOST_IPADDRESS_H
+#define AVISHA_HOST_IPADDRESS_H
+
+#include "Arduino.h"
+
+class IPAddress : public Printable {
+public:
+    IPAddress() : address(0) {}
+    IPAddress(uint32_t address) : address(address) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+        : address(a | (b << 8) | (c << 16) | ((uint32_t)d << 24)) {}
+
+    operator uint32_t() const { return address; }
+    uint8_t operator[](int index) const { return (address >> (8 * index)) & 0xFF; }
+    bool operator==(const IPAddress& other) const { return address == other.address; }
+    bool operator!=(const IPAddress& other) const { return address != other.address; }
+
+    String toString() const {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+        return String(buf);
+    }
+    bool fromString(const char* text) {
+        unsigned a, b, c, d;
+        char tail;
+        if (!text || sscanf(text, "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4 ||
+            a > 255 || b > 255 || c > 255 || d > 255) {
+            return false;
+        }
+        address = a | (b << 8) | (c << 16) | ((uint32_t)d << 24);
+        return true;
+    }
+    bool fromString(const String& text) { return fromString(text.c_str()); }
+    size_t printTo(Print& p) const override { return p.print(toString()); }
+
+private:
+    uint32_t address;  // Network byte order, as lwIP keeps it
+};
+
+#endif // AVISHA_HOST_IPADDRESS_H
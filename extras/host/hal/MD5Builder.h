@@ -0,0 +1,27 @@
+// MD5Builder.h - Host stand-in
+#ifndef AVISHA_HOST_MD5BUILDER_H
+#define AVISHA_HOST_MD5BUILDER_H
+
+#include "Arduino.h"
+
+class MD5Builder {
+public:
+    void begin();
+    void add(const uint8_t* data, uint16_t len);
+    void add(const char* data) { add((const uint8_t*)data, strlen(data)); }
+    void add(const String& data) { add(data.c_str()); }
+    void calculate();
+    void getBytes(uint8_t* output) { memcpy(output, digest, 16); }
+    void getChars(char* output);
+    String toString();
+
+private:
+    uint32_t state[4];
+    uint64_t count;
+    uint8_t block[64];
+    uint8_t digest[16];
+
+    void transform(const uint8_t* chunk);
+};
+
+#endif // AVISHA_HOST_MD5BUILDER_H
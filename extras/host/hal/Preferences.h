@@ -0,0 +1,32 @@
+// Preferences.h - Host stand-in, an in-memory NVS shared by every instance
+#ifndef AVISHA_HOST_PREFERENCES_H
+#define AVISHA_HOST_PREFERENCES_H
+
+#include "Arduino.h"
+
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false, const char* partitionLabel = nullptr);
+    void end();
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+    size_t putBytes(const char* key, const void* value, size_t len);
+    size_t getBytes(const char* key, void* buf, size_t maxLen);
+    size_t getBytesLength(const char* key);
+    size_t putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+    size_t putULong(const char* key, uint32_t value) { return putUInt(key, value); }
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0) { return getUInt(key, defaultValue); }
+    size_t putBool(const char* key, bool value) { return putBytes(key, &value, sizeof(value)); }
+    bool getBool(const char* key, bool defaultValue = false);
+    size_t putString(const char* key, const String& value) { return putBytes(key, value.c_str(), value.length()); }
+    String getString(const char* key, const String& defaultValue = String());
+
+private:
+    String space;
+    bool open = false;
+    bool readOnly = false;
+};
+
+#endif // AVISHA_HOST_PREFERENCES_H
@@ -0,0 +1,23 @@
+// StreamString.h - Host stand-in
+#ifndef AVISHA_HOST_STREAMSTRING_H
+#define AVISHA_HOST_STREAMSTRING_H
+
+#include "Arduino.h"
+
+class StreamString : public Stream, public String {
+public:
+    size_t write(const uint8_t* data, size_t size) override {
+        concat((const char*)data, size);
+        return size;
+    }
+    size_t write(uint8_t data) override { return concat((char)data) ? 1 : 0; }
+    int available() override { return length() - position; }
+    int read() override { return position < length() ? (uint8_t)charAt(position++) : -1; }
+    int peek() override { return position < length() ? (uint8_t)charAt(position) : -1; }
+    using Print::write;
+
+private:
+    unsigned int position = 0;
+};
+
+#endif // AVISHA_HOST_STREAMSTRING_H
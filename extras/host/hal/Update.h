@@ -0,0 +1,78 @@
+// Update.h - Host stand-in for the 2.x UpdateClass, writing the simulated
+// OTA partition the way the core does: a sector buffer, erase then program
+// per sector, the first 16 bytes held back until end().
+#ifndef AVISHA_HOST_UPDATE_H
+#define AVISHA_HOST_UPDATE_H
+
+#include "Arduino.h"
+#include "MD5Builder.h"
+#include "esp_partition.h"
+
+#define UPDATE_ERROR_OK 0
+#define UPDATE_ERROR_WRITE 1
+#define UPDATE_ERROR_ERASE 2
+#define UPDATE_ERROR_READ 3
+#define UPDATE_ERROR_SPACE 4
+#define UPDATE_ERROR_SIZE 5
+#define UPDATE_ERROR_STREAM 6
+#define UPDATE_ERROR_MD5 7
+#define UPDATE_ERROR_MAGIC_BYTE 8
+#define UPDATE_ERROR_ACTIVATE 9
+#define UPDATE_ERROR_NO_PARTITION 10
+#define UPDATE_ERROR_BAD_ARGUMENT 11
+#define UPDATE_ERROR_ABORT 12
+
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+#define U_FLASH 0
+#define U_SPIFFS 100
+
+class UpdateClass {
+public:
+    typedef std::function<void(size_t, size_t)> THandlerFunction_Progress;
+
+    UpdateClass();
+    ~UpdateClass();
+
+    UpdateClass& onProgress(THandlerFunction_Progress fn) { progressCallback = fn; return *this; }
+    bool begin(size_t size = UPDATE_SIZE_UNKNOWN, int command = U_FLASH, int ledPin = -1, uint8_t ledOn = LOW,
+               const char* label = nullptr);
+    size_t write(uint8_t* data, size_t len);
+    size_t writeStream(Stream& data);
+    bool end(bool evenIfRemaining = false);
+    void abort();
+    void printError(Print& out) { out.println(errorString()); }
+    const char* errorString();
+    bool setMD5(const char* expectedMD5);
+    String md5String() { return md5.toString(); }
+
+    bool hasError() { return error != UPDATE_ERROR_OK; }
+    uint8_t getError() { return error; }
+    void clearError() { error = UPDATE_ERROR_OK; }
+    bool isRunning() { return totalSize > 0; }
+    bool isFinished() { return progressSize == totalSize; }
+    size_t size() { return totalSize; }
+    size_t progress() { return progressSize; }
+    size_t remaining() { return totalSize - progressSize; }
+    bool canRollBack();
+    bool rollBack();
+
+private:
+    uint8_t* buffer;
+    size_t bufferLen;
+    size_t totalSize;
+    size_t progressSize;
+    size_t erasedTo;
+    uint8_t error;
+    const esp_partition_t* partition;
+    uint8_t skipBuffer[16];
+    String target;
+    MD5Builder md5;
+    THandlerFunction_Progress progressCallback;
+
+    void reset();
+    bool writeBuffer();
+    void fail(uint8_t code);
+};
+extern UpdateClass Update;
+
+#endif // AVISHA_HOST_UPDATE_H
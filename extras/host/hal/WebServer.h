@@ -0,0 +1,125 @@
+// WebServer.h - Host stand-in for the synchronous WebServer of the 2.x core.
+// One request per connection, served from handleClient(). Enough HTTP/1.x
+// for the library's routes: query arguments, collected headers, raw
+// (application/octet-stream) bodies in HTTP_RAW_BUFLEN pieces and
+// multipart file parts in HTTP_UPLOAD_BUFLEN pieces.
+#ifndef AVISHA_HOST_WEBSERVER_H
+#define AVISHA_HOST_WEBSERVER_H
+
+#include <vector>
+#include "WiFi.h"
+
+typedef enum { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS } HTTPMethod;
+enum HTTPUploadStatus { UPLOAD_FILE_START, UPLOAD_FILE_WRITE, UPLOAD_FILE_END, UPLOAD_FILE_ABORTED };
+enum HTTPRawStatus { RAW_START, RAW_WRITE, RAW_END, RAW_ABORTED };
+
+#define HTTP_UPLOAD_BUFLEN 1436
+#define HTTP_RAW_BUFLEN 1436
+#define HTTP_MAX_DATA_WAIT 5000
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define CONTENT_LENGTH_NOT_SET ((size_t)-2)
+
+typedef struct {
+    HTTPUploadStatus status;
+    String filename;
+    String name;
+    String type;
+    size_t totalSize;
+    size_t currentSize;
+    uint8_t buf[HTTP_UPLOAD_BUFLEN];
+} HTTPUpload;
+
+typedef struct {
+    HTTPRawStatus status;
+    size_t totalSize;
+    size_t currentSize;
+    uint8_t buf[HTTP_RAW_BUFLEN];
+} HTTPRaw;
+
+class WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    WebServer(int port = 80);
+    virtual ~WebServer();
+
+    void begin();
+    void begin(uint16_t port);
+    void stop();
+    void close() { stop(); }
+    void handleClient();
+
+    void on(const String& uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+    void on(const String& uri, HTTPMethod method, THandlerFunction handler) { on(uri, method, handler, nullptr); }
+    void on(const String& uri, HTTPMethod method, THandlerFunction handler, THandlerFunction upload);
+    void onNotFound(THandlerFunction handler) { notFound = handler; }
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+
+    String uri() { return currentUri; }
+    HTTPMethod method() { return currentMethod; }
+    WiFiClient client() { return currentClient; }
+    HTTPUpload& upload() { return currentUpload; }
+    HTTPRaw& raw() { return currentRaw; }
+
+    String arg(const String& name);
+    String arg(int index);
+    String argName(int index);
+    int args() { return (int)arguments.size(); }
+    bool hasArg(const String& name);
+    String header(const String& name);
+    String header(int index);
+    String headerName(int index);
+    int headers() { return (int)collected.size(); }
+    bool hasHeader(const String& name);
+    String hostHeader() { return header("Host"); }
+
+    void send(int code, const char* contentType = nullptr, const String& content = String(""));
+    void send(int code, char* contentType, const String& content) { send(code, (const char*)contentType, content); }
+    void send(int code, const String& contentType, const String& content) { send(code, contentType.c_str(), content); }
+    void send_P(int code, PGM_P contentType, PGM_P content);
+    void send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength);
+    void setContentLength(const size_t contentLength) { this->contentLength = contentLength; }
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char* content, size_t size);
+    void sendContent_P(PGM_P content) { sendContent(content, strlen(content)); }
+    void sendContent_P(PGM_P content, size_t size) { sendContent(content, size); }
+
+private:
+    struct Route {
+        String uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+        THandlerFunction upload;
+    };
+    struct Pair {
+        String name;
+        String value;
+    };
+
+    WiFiServer server;
+    std::vector<Route> routes;
+    THandlerFunction notFound;
+    WiFiClient currentClient;
+    HTTPMethod currentMethod;
+    String currentUri;
+    std::vector<Pair> arguments;
+    std::vector<Pair> collected;
+    HTTPUpload currentUpload;
+    HTTPRaw currentRaw;
+    String responseHeaders;
+    size_t contentLength;
+    bool chunked;
+    bool headersSent;
+
+    bool readLine(String& line);
+    bool parseRequest();
+    void parseArguments(const String& query);
+    const Route* findRoute();
+    void readRawBody(const Route& route, size_t length);
+    void readMultipartBody(const Route& route, const String& boundary);
+    void sendHead(int code, const char* contentType, size_t length);
+    void finishChunked();
+};
+
+#endif // AVISHA_HOST_WEBSERVER_H
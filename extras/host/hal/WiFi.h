@@ -0,0 +1,76 @@
+// WiFi.h - Host stand-in. begin() "associates" at once on 127.0.0.1, so
+// every server the library starts is reachable over loopback.
+#ifndef AVISHA_HOST_WIFI_H
+#define AVISHA_HOST_WIFI_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "WiFiClient.h"
+#include "WiFiServer.h"
+#include "WiFiUdp.h"
+
+typedef enum { WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA } WiFiMode_t;
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL,
+    WL_SCAN_COMPLETED,
+    WL_CONNECTED,
+    WL_CONNECT_FAILED,
+    WL_CONNECTION_LOST,
+    WL_DISCONNECTED
+} wl_status_t;
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_STA_START,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP,
+    ARDUINO_EVENT_MAX
+} arduino_event_id_t;
+typedef arduino_event_id_t WiFiEvent_t;
+typedef void (*WiFiEventCb)(arduino_event_id_t event);
+
+// Names of the 1.0.x core, still accepted by 2.x
+#define SYSTEM_EVENT_STA_START ARDUINO_EVENT_WIFI_STA_START
+#define SYSTEM_EVENT_STA_CONNECTED ARDUINO_EVENT_WIFI_STA_CONNECTED
+#define SYSTEM_EVENT_STA_DISCONNECTED ARDUINO_EVENT_WIFI_STA_DISCONNECTED
+#define SYSTEM_EVENT_STA_GOT_IP ARDUINO_EVENT_WIFI_STA_GOT_IP
+#define SYSTEM_EVENT_STA_LOST_IP ARDUINO_EVENT_WIFI_STA_LOST_IP
+
+class WiFiClass {
+public:
+    bool mode(WiFiMode_t mode);
+    WiFiMode_t getMode();
+    int onEvent(WiFiEventCb callback, arduino_event_id_t event = ARDUINO_EVENT_MAX);
+    bool setAutoReconnect(bool autoReconnect) { return true; }
+    void persistent(bool persistent) {}
+    bool setHostname(const char* hostname) { return true; }
+    bool setSleep(bool enabled) { return true; }
+
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr, int32_t channel = 0,
+                      const uint8_t* bssid = nullptr, bool connect = true);
+    bool config(IPAddress localIP, IPAddress gateway, IPAddress subnet, IPAddress dns1 = IPAddress(),
+                IPAddress dns2 = IPAddress());
+    bool disconnect(bool wifiOff = false, bool eraseAP = false);
+    bool reconnect();
+    wl_status_t status();
+
+    IPAddress localIP();
+    IPAddress subnetMask();
+    IPAddress gatewayIP();
+    IPAddress dnsIP(uint8_t index = 0);
+    String macAddress();
+    uint8_t* macAddress(uint8_t* mac);
+    uint8_t* BSSID();
+    String SSID();
+    int32_t channel();
+    int8_t RSSI();
+    int hostByName(const char* host, IPAddress& result);
+
+private:
+    void dispatch(arduino_event_id_t event);
+};
+extern WiFiClass WiFi;
+
+#endif // AVISHA_HOST_WIFI_H
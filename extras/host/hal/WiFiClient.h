@@ -0,0 +1,60 @@
+// WiFiClient.h - Host stand-in over a POSIX TCP socket
+#ifndef AVISHA_HOST_WIFICLIENT_H
+#define AVISHA_HOST_WIFICLIENT_H
+
+#include <memory>
+#include "Arduino.h"
+#include "IPAddress.h"
+
+class Client : public Stream {
+public:
+    virtual int connect(IPAddress ip, uint16_t port) = 0;
+    virtual int connect(const char* host, uint16_t port) = 0;
+    virtual int read(uint8_t* buffer, size_t size) = 0;
+    virtual uint8_t connected() = 0;
+    virtual void stop() = 0;
+    virtual operator bool() = 0;
+    using Stream::read;
+    using Print::write;
+};
+
+// Copies share the socket, as in the core. Reads never block; writes block
+// until the kernel has taken everything, like lwIP with its send timeout.
+class WiFiClient : public Client {
+public:
+    WiFiClient();
+    explicit WiFiClient(int fd);
+    ~WiFiClient() override;
+
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char* host, uint16_t port) override;
+    int connect(IPAddress ip, uint16_t port, int32_t timeout);
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int available() override;
+    int read() override;
+    int read(uint8_t* buffer, size_t size) override;
+    int peek() override;
+    void flush() override {}
+    void stop() override;
+    uint8_t connected() override;
+    operator bool() override { return connected(); }
+    bool operator==(const WiFiClient& other) const { return socket == other.socket; }
+
+    int fd() const;
+    int setNoDelay(bool noDelay);
+    int setTimeout(uint32_t seconds);
+    IPAddress remoteIP() const;
+    uint16_t remotePort() const;
+    IPAddress localIP() const;
+    uint16_t localPort() const;
+
+    using Print::write;
+
+private:
+    struct Socket;
+    std::shared_ptr<Socket> socket;
+    int peeked;
+};
+
+#endif // AVISHA_HOST_WIFICLIENT_H
@@ -0,0 +1,30 @@
+// WiFiServer.h - Host stand-in, listens on the loopback interface
+#ifndef AVISHA_HOST_WIFISERVER_H
+#define AVISHA_HOST_WIFISERVER_H
+
+#include "WiFiClient.h"
+
+class WiFiServer {
+public:
+    WiFiServer(uint16_t port = 80, uint8_t maxClients = 4);
+    ~WiFiServer();
+
+    void begin(uint16_t port = 0);
+    void end();
+    void stop() { end(); }
+    void close() { end(); }
+    WiFiClient available();
+    WiFiClient accept() { return available(); }
+    bool hasClient();
+    void setNoDelay(bool noDelay) { this->noDelay = noDelay; }
+    bool getNoDelay() const { return noDelay; }
+    operator bool() const { return listener >= 0; }
+
+private:
+    uint16_t port;
+    uint8_t maxClients;
+    int listener;
+    bool noDelay;
+};
+
+#endif // AVISHA_HOST_WIFISERVER_H
@@ -0,0 +1,31 @@
+// WiFiUdp.h - Host stand-in. No packets arrive, so beacon wake never fires.
+#ifndef AVISHA_HOST_WIFIUDP_H
+#define AVISHA_HOST_WIFIUDP_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+class WiFiUDP : public Stream {
+public:
+    uint8_t begin(uint16_t port) { return 1; }
+    uint8_t begin(IPAddress address, uint16_t port) { return 1; }
+    uint8_t beginMulticast(IPAddress address, uint16_t port) { return 1; }
+    void stop() {}
+    int beginPacket(IPAddress ip, uint16_t port) { return 1; }
+    int beginPacket(const char* host, uint16_t port) { return 1; }
+    int beginMulticastPacket() { return 1; }
+    int endPacket() { return 1; }
+    size_t write(uint8_t c) override { return 1; }
+    size_t write(const uint8_t* buffer, size_t size) override { return size; }
+    int parsePacket() { return 0; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int read(uint8_t* buffer, size_t len) { return 0; }
+    int read(char* buffer, size_t len) { return 0; }
+    int peek() override { return -1; }
+    IPAddress remoteIP() { return IPAddress(); }
+    uint16_t remotePort() { return 0; }
+    using Print::write;
+};
+
+#endif // AVISHA_HOST_WIFIUDP_H
@@ -0,0 +1,388 @@
+// arduino.cpp - Core functions, the ESP object and heap accounting
+#include <Arduino.h>
+#include <esp_partition.h>
+#include <esp_ota_ops.h>
+#include <esp_system.h>
+#include <MD5Builder.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <new>
+#include <random>
+#include <thread>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include "sim.h"
+
+#define SIM_HEAP_SIZE (320 * 1024)   // Internal DRAM left to an Arduino sketch
+#define SIM_SKETCH_SIZE (900 * 1024)  // The "running" app in app0
+
+HardwareSerial Serial;
+EspClass ESP;
+
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+static std::function<void()> restartHandler;
+
+// Heap accounting. Every allocation made by the library or the HAL goes
+// through trackedAlloc(): operator new directly, malloc and friends when
+// the link wraps them (AVISHA_HOST_WRAP_MALLOC).
+static std::atomic<size_t> heapUsed(0);
+static std::atomic<size_t> heapHigh(0);
+static std::atomic<size_t> heapLow(SIM_HEAP_SIZE);
+
+#if AVISHA_HOST_WRAP_MALLOC
+extern "C" void* __real_malloc(size_t size);
+extern "C" void* __real_calloc(size_t count, size_t size);
+extern "C" void* __real_realloc(void* ptr, size_t size);
+extern "C" void __real_free(void* ptr);
+#define REAL_MALLOC __real_malloc
+#define REAL_CALLOC __real_calloc
+#define REAL_REALLOC __real_realloc
+#define REAL_FREE __real_free
+#else
+#define REAL_MALLOC malloc
+#define REAL_CALLOC calloc
+#define REAL_REALLOC realloc
+#define REAL_FREE free
+#endif
+
+static size_t blockSize(void* ptr) {
+#if defined(__GLIBC__)
+    return ptr ? malloc_usable_size(ptr) : 0;
+#else
+    return 0;
+#endif
+}
+
+static void countAlloc(size_t size) {
+    size_t now = heapUsed.fetch_add(size) + size;
+    size_t high = heapHigh.load();
+    while (now > high && !heapHigh.compare_exchange_weak(high, now)) {
+    }
+    size_t left = now < SIM_HEAP_SIZE ? SIM_HEAP_SIZE - now : 0;
+    size_t low = heapLow.load();
+    while (left < low && !heapLow.compare_exchange_weak(low, left)) {
+    }
+}
+
+static void countFree(size_t size) {
+    heapUsed.fetch_sub(size);
+}
+
+static void* trackedAlloc(size_t size) {
+    void* ptr = REAL_MALLOC(size);
+    countAlloc(blockSize(ptr));
+    return ptr;
+}
+
+static void trackedFree(void* ptr) {
+    countFree(blockSize(ptr));
+    REAL_FREE(ptr);
+}
+
+#if AVISHA_HOST_WRAP_MALLOC
+extern "C" void* __wrap_malloc(size_t size) {
+    return trackedAlloc(size);
+}
+
+extern "C" void* __wrap_calloc(size_t count, size_t size) {
+    void* ptr = REAL_CALLOC(count, size);
+    countAlloc(blockSize(ptr));
+    return ptr;
+}
+
+extern "C" void* __wrap_realloc(void* ptr, size_t size) {
+    size_t before = blockSize(ptr);
+    void* moved = REAL_REALLOC(ptr, size);
+    if (moved || size == 0) {
+        countFree(before);
+        countAlloc(blockSize(moved));
+    }
+    return moved;
+}
+
+extern "C" void __wrap_free(void* ptr) {
+    trackedFree(ptr);
+}
+#endif
+
+void* operator new(size_t size) {
+    void* ptr = trackedAlloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept {
+    trackedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    trackedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    trackedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    trackedFree(ptr);
+}
+
+namespace sim {
+
+void heapCharge(size_t bytes) {
+    countAlloc(bytes);
+}
+
+void heapRefund(size_t bytes) {
+    countFree(bytes);
+}
+
+size_t heapSize() {
+    return SIM_HEAP_SIZE;
+}
+
+size_t heapInUse() {
+    return heapUsed.load();
+}
+
+size_t heapPeak() {
+    return heapHigh.load();
+}
+
+void resetHeapPeak() {
+    size_t now = heapUsed.load();
+    heapHigh = now;
+    heapLow = now < SIM_HEAP_SIZE ? SIM_HEAP_SIZE - now : 0;
+}
+
+bool heapTracked() {
+#if defined(__GLIBC__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void onRestart(const std::function<void()>& handler) {
+    restartHandler = handler;
+}
+
+} // namespace sim
+
+// Print and Stream
+
+size_t Print::printf(const char* format, ...) {
+    char small[128];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (len < 0) {
+        return 0;
+    }
+    if ((size_t)len < sizeof(small)) {
+        return write((const uint8_t*)small, len);
+    }
+    std::string large(len + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&large[0], large.size(), format, args);
+    va_end(args);
+    return write((const uint8_t*)large.data(), len);
+}
+
+int Stream::timedRead() {
+    unsigned long start = millis();
+    do {
+        int c = read();
+        if (c >= 0) {
+            return c;
+        }
+        yield();
+    } while (millis() - start < timeout);
+    return -1;
+}
+
+size_t Stream::readBytes(uint8_t* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0) {
+            break;
+        }
+        buffer[count++] = (uint8_t)c;
+    }
+    return count;
+}
+
+String Stream::readString() {
+    String result;
+    for (int c = timedRead(); c >= 0; c = timedRead()) {
+        result += (char)c;
+    }
+    return result;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String result;
+    for (int c = timedRead(); c >= 0 && c != terminator; c = timedRead()) {
+        result += (char)c;
+    }
+    return result;
+}
+
+// Time and pins
+
+unsigned long millis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
+
+unsigned long micros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+static std::mt19937& generator() {
+    static std::mt19937 rng(std::random_device{}());
+    return rng;
+}
+
+static std::mutex randomLock;
+
+void randomSeed(unsigned long seed) {
+    std::lock_guard<std::mutex> lock(randomLock);
+    generator().seed(seed);
+}
+
+long random(long max) {
+    return max > 0 ? random(0, max) : 0;
+}
+
+long random(long min, long max) {
+    if (max <= min) {
+        return min;
+    }
+    std::lock_guard<std::mutex> lock(randomLock);
+    return std::uniform_int_distribution<long>(min, max - 1)(generator());
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {}
+void digitalWrite(uint8_t pin, uint8_t value) {}
+int digitalRead(uint8_t pin) { return HIGH; }
+
+// ESP object and system calls
+
+void EspClass::restart() {
+    esp_restart();
+}
+
+uint32_t EspClass::getHeapSize() {
+    return SIM_HEAP_SIZE;
+}
+
+uint32_t EspClass::getFreeHeap() {
+    size_t used = heapUsed.load();
+    return used < SIM_HEAP_SIZE ? SIM_HEAP_SIZE - used : 0;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    return heapLow.load();
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+    // Fragmentation is not modelled, the largest block is most of what is free
+    return getFreeHeap() * 3 / 4;
+}
+
+uint32_t EspClass::getSketchSize() {
+    return SIM_SKETCH_SIZE;
+}
+
+uint32_t EspClass::getFreeSketchSpace() {
+    const esp_partition_t* next = esp_ota_get_next_update_partition(nullptr);
+    return next ? next->size : 0;
+}
+
+String EspClass::getSketchMD5() {
+    static String cached;
+    if (cached.length() > 0) {
+        return cached;
+    }
+    const esp_partition_t* running = esp_ota_get_running_partition();
+    MD5Builder md5;
+    md5.begin();
+    uint8_t chunk[1024];
+    for (uint32_t offset = 0; offset < SIM_SKETCH_SIZE; offset += sizeof(chunk)) {
+        esp_partition_read(running, offset, chunk, sizeof(chunk));
+        md5.add(chunk, sizeof(chunk));
+    }
+    md5.calculate();
+    cached = md5.toString();
+    return cached;
+}
+
+uint32_t esp_random() {
+    std::lock_guard<std::mutex> lock(randomLock);
+    return (uint32_t)generator()();
+}
+
+void esp_fill_random(void* buf, size_t len) {
+    uint8_t* out = (uint8_t*)buf;
+    for (size_t i = 0; i < len; i++) {
+        out[i] = (uint8_t)esp_random();
+    }
+}
+
+esp_reset_reason_t esp_reset_reason() {
+    return ESP_RST_POWERON;
+}
+
+// Without a handler the process ends, the closest thing to a reset
+void esp_restart() {
+    if (restartHandler) {
+        restartHandler();
+        return;
+    }
+    fflush(stdout);
+    exit(0);
+}
+
+const char* esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK: return "ESP_OK";
+        case ESP_FAIL: return "ESP_FAIL";
+        case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_OTA_VALIDATE_FAILED: return "ESP_ERR_OTA_VALIDATE_FAILED";
+        default: return "UNKNOWN ERROR";
+    }
+}
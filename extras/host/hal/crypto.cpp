@@ -0,0 +1,419 @@
+// crypto.cpp - SHA-256, HMAC, MD5, the ROM CRC, the inflater and the
+// signature stubs
+#include <MD5Builder.h>
+#include <mbedtls/md.h>
+#include <mbedtls/pk.h>
+#include <mbedtls/sha256.h>
+#include <rom/crc.h>
+#include <rom/miniz.h>
+#if AVISHA_HOST_ZLIB
+#include <zlib.h>
+#endif
+
+// SHA-256 (FIPS 180-4)
+
+static const uint32_t sha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+static void sha256Block(uint32_t state[8], const unsigned char* block) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t)block[i * 4] << 24 | (uint32_t)block[i * 4 + 1] << 16 | (uint32_t)block[i * 4 + 2] << 8 |
+               block[i * 4 + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + sha256K[i] + w[i];
+        uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+void mbedtls_sha256_init(mbedtls_sha256_context* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context* ctx) {
+    if (ctx) {
+        memset(ctx, 0, sizeof(*ctx));
+    }
+}
+
+int mbedtls_sha256_starts(mbedtls_sha256_context* ctx, int is224) {
+    static const uint32_t initial[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    if (is224) {
+        return -1;
+    }
+    ctx->total[0] = ctx->total[1] = 0;
+    memcpy(ctx->state, initial, sizeof(initial));
+    ctx->is224 = 0;
+    return 0;
+}
+
+int mbedtls_sha256_update(mbedtls_sha256_context* ctx, const unsigned char* input, size_t len) {
+    size_t fill = ctx->total[0] & 63;
+    uint64_t total = ((uint64_t)ctx->total[1] << 32 | ctx->total[0]) + len;
+    ctx->total[0] = (uint32_t)total;
+    ctx->total[1] = (uint32_t)(total >> 32);
+    if (fill && fill + len >= 64) {
+        memcpy(ctx->buffer + fill, input, 64 - fill);
+        sha256Block(ctx->state, ctx->buffer);
+        input += 64 - fill;
+        len -= 64 - fill;
+        fill = 0;
+    }
+    for (; len >= 64 && fill == 0; input += 64, len -= 64) {
+        sha256Block(ctx->state, input);
+    }
+    memcpy(ctx->buffer + fill, input, len);
+    return 0;
+}
+
+int mbedtls_sha256_finish(mbedtls_sha256_context* ctx, unsigned char output[32]) {
+    uint64_t bits = ((uint64_t)ctx->total[1] << 32 | ctx->total[0]) * 8;
+    unsigned char pad[72] = {0x80};
+    size_t fill = ctx->total[0] & 63;
+    size_t padLen = fill < 56 ? 56 - fill : 120 - fill;
+    for (int i = 0; i < 8; i++) {
+        pad[padLen + i] = (unsigned char)(bits >> (56 - 8 * i));
+    }
+    mbedtls_sha256_update(ctx, pad, padLen + 8);
+    for (int i = 0; i < 8; i++) {
+        output[i * 4] = (unsigned char)(ctx->state[i] >> 24);
+        output[i * 4 + 1] = (unsigned char)(ctx->state[i] >> 16);
+        output[i * 4 + 2] = (unsigned char)(ctx->state[i] >> 8);
+        output[i * 4 + 3] = (unsigned char)ctx->state[i];
+    }
+    return 0;
+}
+
+int mbedtls_sha256(const unsigned char* input, size_t len, unsigned char output[32], int is224) {
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+    if (mbedtls_sha256_starts(&ctx, is224) != 0) {
+        return -1;
+    }
+    mbedtls_sha256_update(&ctx, input, len);
+    mbedtls_sha256_finish(&ctx, output);
+    mbedtls_sha256_free(&ctx);
+    return 0;
+}
+
+// HMAC-SHA256 (RFC 2104)
+
+struct mbedtls_md_info_t {
+    mbedtls_md_type_t type;
+};
+
+static const mbedtls_md_info_t sha256Info = {MBEDTLS_MD_SHA256};
+
+const mbedtls_md_info_t* mbedtls_md_info_from_type(mbedtls_md_type_t type) {
+    return type == MBEDTLS_MD_SHA256 ? &sha256Info : nullptr;
+}
+
+int mbedtls_md_hmac(const mbedtls_md_info_t* info, const unsigned char* key, size_t keyLen,
+                    const unsigned char* input, size_t len, unsigned char* output) {
+    if (info != &sha256Info) {
+        return -1;
+    }
+    unsigned char block[64] = {0};
+    if (keyLen > sizeof(block)) {
+        mbedtls_sha256(key, keyLen, block, 0);
+    } else if (keyLen > 0) {
+        memcpy(block, key, keyLen);
+    }
+    unsigned char pad[64];
+    unsigned char inner[32];
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+
+    for (int i = 0; i < 64; i++) {
+        pad[i] = block[i] ^ 0x36;
+    }
+    mbedtls_sha256_starts(&ctx, 0);
+    mbedtls_sha256_update(&ctx, pad, sizeof(pad));
+    mbedtls_sha256_update(&ctx, input, len);
+    mbedtls_sha256_finish(&ctx, inner);
+
+    for (int i = 0; i < 64; i++) {
+        pad[i] = block[i] ^ 0x5c;
+    }
+    mbedtls_sha256_starts(&ctx, 0);
+    mbedtls_sha256_update(&ctx, pad, sizeof(pad));
+    mbedtls_sha256_update(&ctx, inner, sizeof(inner));
+    mbedtls_sha256_finish(&ctx, output);
+    mbedtls_sha256_free(&ctx);
+    return 0;
+}
+
+// Signatures: no key parses, so verification never runs
+
+void mbedtls_pk_init(mbedtls_pk_context* ctx) {
+    ctx->pk_info = nullptr;
+    ctx->pk_ctx = nullptr;
+}
+
+void mbedtls_pk_free(mbedtls_pk_context* ctx) {
+    mbedtls_pk_init(ctx);
+}
+
+int mbedtls_pk_parse_public_key(mbedtls_pk_context* ctx, const unsigned char* key, size_t keyLen) {
+    return -1;
+}
+
+int mbedtls_pk_can_do(const mbedtls_pk_context* ctx, mbedtls_pk_type_t type) {
+    return 0;
+}
+
+mbedtls_ecp_keypair* mbedtls_pk_ec(const mbedtls_pk_context pk) {
+    static mbedtls_ecp_keypair none;
+    return &none;
+}
+
+void mbedtls_mpi_init(mbedtls_mpi* x) {
+    memset(x, 0, sizeof(*x));
+}
+
+void mbedtls_mpi_free(mbedtls_mpi* x) {
+    memset(x, 0, sizeof(*x));
+}
+
+int mbedtls_mpi_read_binary(mbedtls_mpi* x, const unsigned char* buf, size_t len) {
+    return -1;
+}
+
+int mbedtls_ecdsa_verify(mbedtls_ecp_group* grp, const unsigned char* hash, size_t len, const mbedtls_ecp_point* q,
+                         const mbedtls_mpi* r, const mbedtls_mpi* s) {
+    return -1;
+}
+
+// MD5 (RFC 1321)
+
+static const uint32_t md5K[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391,
+};
+static const uint8_t md5R[64] = {
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21,
+};
+
+void MD5Builder::transform(const uint8_t* chunk) {
+    uint32_t m[16];
+    for (int i = 0; i < 16; i++) {
+        m[i] = chunk[i * 4] | (uint32_t)chunk[i * 4 + 1] << 8 | (uint32_t)chunk[i * 4 + 2] << 16 |
+               (uint32_t)chunk[i * 4 + 3] << 24;
+    }
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    for (int i = 0; i < 64; i++) {
+        uint32_t f;
+        int g;
+        if (i < 16) {
+            f = (b & c) | (~b & d);
+            g = i;
+        } else if (i < 32) {
+            f = (d & b) | (~d & c);
+            g = (5 * i + 1) % 16;
+        } else if (i < 48) {
+            f = b ^ c ^ d;
+            g = (3 * i + 5) % 16;
+        } else {
+            f = c ^ (b | ~d);
+            g = (7 * i) % 16;
+        }
+        uint32_t next = d;
+        d = c;
+        c = b;
+        uint32_t x = a + f + md5K[i] + m[g];
+        b = b + ((x << md5R[i]) | (x >> (32 - md5R[i])));
+        a = next;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+}
+
+void MD5Builder::begin() {
+    state[0] = 0x67452301;
+    state[1] = 0xefcdab89;
+    state[2] = 0x98badcfe;
+    state[3] = 0x10325476;
+    count = 0;
+    memset(digest, 0, sizeof(digest));
+}
+
+void MD5Builder::add(const uint8_t* data, uint16_t len) {
+    size_t fill = count & 63;
+    count += len;
+    for (uint16_t i = 0; i < len; i++) {
+        block[fill++] = data[i];
+        if (fill == 64) {
+            transform(block);
+            fill = 0;
+        }
+    }
+}
+
+void MD5Builder::calculate() {
+    uint64_t bits = count * 8;
+    uint8_t pad[72] = {0x80};
+    size_t fill = count & 63;
+    size_t padLen = fill < 56 ? 56 - fill : 120 - fill;
+    for (int i = 0; i < 8; i++) {
+        pad[padLen + i] = (uint8_t)(bits >> (8 * i));
+    }
+    add(pad, padLen + 8);
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            digest[i * 4 + j] = (uint8_t)(state[i] >> (8 * j));
+        }
+    }
+}
+
+void MD5Builder::getChars(char* output) {
+    for (int i = 0; i < 16; i++) {
+        sprintf(output + i * 2, "%02x", digest[i]);
+    }
+}
+
+String MD5Builder::toString() {
+    char out[33];
+    getChars(out);
+    return String(out);
+}
+
+// CRC-32 as in the ROM: the running value is passed in and out inverted,
+// so crc32_le(0, ...) is the usual zlib/gzip CRC
+
+uint32_t crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len) {
+    static uint32_t table[256];
+    static bool ready = []() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        return true;
+    }();
+    (void)ready;
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++) {
+        crc = table[(crc ^ buf[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+// tinfl on zlib. The z_stream lives behind the decompressor and is
+// released when the stream ends or fails; an inflater freed halfway
+// through leaks it, which the harness accepts.
+
+#if AVISHA_HOST_ZLIB
+static void inflateRelease(tinfl_decompressor* r) {
+    z_stream* stream = (z_stream*)r->stream;
+    if (stream) {
+        inflateEnd(stream);
+        delete stream;
+        r->stream = nullptr;
+    }
+}
+
+tinfl_status tinfl_decompress(tinfl_decompressor* r, const mz_uint8* pIn_buf_next, size_t* pIn_buf_size,
+                              mz_uint8* pOut_buf_start, mz_uint8* pOut_buf_next, size_t* pOut_buf_size,
+                              const mz_uint32 decomp_flags) {
+    if (decomp_flags & TINFL_FLAG_PARSE_ZLIB_HEADER) {
+        return TINFL_STATUS_BAD_PARAM;
+    }
+    if (r->m_state == 1) {
+        *pIn_buf_size = 0;
+        *pOut_buf_size = 0;
+        return TINFL_STATUS_DONE;
+    }
+    if (!r->stream) {
+        z_stream* stream = new z_stream();
+        // Raw deflate, as tinfl without a zlib header
+        if (inflateInit2(stream, -15) != Z_OK) {
+            delete stream;
+            return TINFL_STATUS_FAILED;
+        }
+        r->stream = stream;
+    }
+    z_stream* stream = (z_stream*)r->stream;
+    stream->next_in = (Bytef*)pIn_buf_next;
+    stream->avail_in = (uInt)*pIn_buf_size;
+    stream->next_out = pOut_buf_next;
+    stream->avail_out = (uInt)*pOut_buf_size;
+    int result = inflate(stream, Z_NO_FLUSH);
+    *pIn_buf_size -= stream->avail_in;
+    *pOut_buf_size -= stream->avail_out;
+
+    if (result == Z_STREAM_END) {
+        inflateRelease(r);
+        r->m_state = 1;
+        return TINFL_STATUS_DONE;
+    }
+    if (result != Z_OK && result != Z_BUF_ERROR) {
+        inflateRelease(r);
+        return TINFL_STATUS_FAILED;
+    }
+    if (stream->avail_out == 0) {
+        return TINFL_STATUS_HAS_MORE_OUTPUT;
+    }
+    if (decomp_flags & TINFL_FLAG_HAS_MORE_INPUT) {
+        return TINFL_STATUS_NEEDS_MORE_INPUT;
+    }
+    // The input ended inside the stream
+    inflateRelease(r);
+    return TINFL_STATUS_FAILED;
+}
+#else
+tinfl_status tinfl_decompress(tinfl_decompressor* r, const mz_uint8* pIn_buf_next, size_t* pIn_buf_size,
+                              mz_uint8* pOut_buf_start, mz_uint8* pOut_buf_next, size_t* pOut_buf_size,
+                              const mz_uint32 decomp_flags) {
+    *pIn_buf_size = 0;
+    *pOut_buf_size = 0;
+    return TINFL_STATUS_FAILED;
+}
+#endif
@@ -0,0 +1,7 @@
+// esp_image_format.h - Host stand-in
+#ifndef AVISHA_HOST_ESP_IMAGE_FORMAT_H
+#define AVISHA_HOST_ESP_IMAGE_FORMAT_H
+
+#define ESP_IMAGE_HEADER_MAGIC 0xE9
+
+#endif // AVISHA_HOST_ESP_IMAGE_FORMAT_H
@@ -0,0 +1,27 @@
+// esp_ota_ops.h - Host stand-in. app0 runs; setting a boot partition checks
+// the image magic byte, as the bootloader's validation would reject it.
+#ifndef AVISHA_HOST_ESP_OTA_OPS_H
+#define AVISHA_HOST_ESP_OTA_OPS_H
+
+#include "esp_partition.h"
+
+typedef uint32_t esp_ota_handle_t;
+typedef enum {
+    ESP_OTA_IMG_NEW = 0x0,
+    ESP_OTA_IMG_PENDING_VERIFY = 0x1,
+    ESP_OTA_IMG_VALID = 0x2,
+    ESP_OTA_IMG_INVALID = 0x3,
+    ESP_OTA_IMG_ABORTED = 0x4,
+    ESP_OTA_IMG_UNDEFINED = 0xFFFFFFFF
+} esp_ota_img_states_t;
+
+const esp_partition_t* esp_ota_get_running_partition();
+const esp_partition_t* esp_ota_get_boot_partition();
+const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t* start);
+const esp_partition_t* esp_ota_get_last_invalid_partition();
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t* partition);
+esp_err_t esp_ota_get_state_partition(const esp_partition_t* partition, esp_ota_img_states_t* state);
+esp_err_t esp_ota_mark_app_valid_cancel_rollback();
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot();
+
+#endif // AVISHA_HOST_ESP_OTA_OPS_H
@@ -0,0 +1,28 @@
+// esp_system.h - Host stand-in
+#ifndef AVISHA_HOST_ESP_SYSTEM_H
+#define AVISHA_HOST_ESP_SYSTEM_H
+
+#include <cstddef>
+#include <cstdint>
+#include "esp_err.h"
+
+typedef enum {
+    ESP_RST_UNKNOWN,
+    ESP_RST_POWERON,
+    ESP_RST_EXT,
+    ESP_RST_SW,
+    ESP_RST_PANIC,
+    ESP_RST_INT_WDT,
+    ESP_RST_TASK_WDT,
+    ESP_RST_WDT,
+    ESP_RST_DEEPSLEEP,
+    ESP_RST_BROWNOUT,
+    ESP_RST_SDIO
+} esp_reset_reason_t;
+
+uint32_t esp_random();
+void esp_fill_random(void* buf, size_t len);
+esp_reset_reason_t esp_reset_reason();
+void esp_restart();
+
+#endif // AVISHA_HOST_ESP_SYSTEM_H
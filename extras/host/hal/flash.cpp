@@ -0,0 +1,601 @@
+// flash.cpp - The simulated 4 MB flash, its partitions, OTA selection,
+// UpdateClass and Preferences
+#include <Update.h>
+#include <Preferences.h>
+#include <esp_ota_ops.h>
+#include <esp_image_format.h>
+#include <esp_system.h>
+#include <sys/mman.h>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "sim.h"
+
+#define SIM_FLASH_SIZE (4 * 1024 * 1024)
+#define SIM_SECTOR_SIZE 4096
+#define SIM_BLOCK_SIZE 65536
+#define SIM_PAGE_SIZE 256
+
+UpdateClass Update;
+
+static esp_partition_t partitionTable[] = {
+    {nullptr, ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_NVS, 0x9000, 0x5000, SIM_SECTOR_SIZE, "nvs", false},
+    {nullptr, ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_OTA, 0xE000, 0x2000, SIM_SECTOR_SIZE, "otadata", false},
+    {nullptr, ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_0, 0x10000, 0x140000, SIM_SECTOR_SIZE, "app0", false},
+    {nullptr, ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_APP_OTA_1, 0x150000, 0x140000, SIM_SECTOR_SIZE, "app1", false},
+    {nullptr, ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, 0x290000, 0x160000, SIM_SECTOR_SIZE, "spiffs", false},
+};
+#define SIM_PARTITIONS (sizeof(partitionTable) / sizeof(partitionTable[0]))
+static const esp_partition_t* const app0 = &partitionTable[2];
+static const esp_partition_t* const app1 = &partitionTable[3];
+
+// Timings in the range of the ESP32 modules' GD25Q32/W25Q32 parts
+static sim::FlashTiming timing = {25000, 150000, 400, 25};
+static sim::FlashCounters counters;
+static std::mutex flashLock;
+static const esp_partition_t* bootPartition = app0;
+
+// Kept outside the heap accounting, flash is not RAM
+static uint8_t* flashMemory() {
+    static uint8_t* memory = []() {
+        void* mapped = mmap(nullptr, SIM_FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED) {
+            perror("sim: flash mmap");
+            abort();
+        }
+        uint8_t* bytes = (uint8_t*)mapped;
+        memset(bytes, 0xFF, SIM_FLASH_SIZE);
+        // The running sketch: an image header and repeatable contents
+        uint32_t seed = 0x12345678;
+        for (uint32_t i = 0; i < 900 * 1024; i++) {
+            seed = seed * 1103515245 + 12345;
+            bytes[app0->address + i] = (uint8_t)(seed >> 16);
+        }
+        bytes[app0->address] = ESP_IMAGE_HEADER_MAGIC;
+        return bytes;
+    }();
+    return memory;
+}
+
+// Called with flashLock held, so concurrent users wait as they would
+static void flashBusy(uint64_t us) {
+    counters.busyUs += us;
+    if (us > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+}
+
+namespace sim {
+
+void setFlashTiming(const FlashTiming& value) {
+    std::lock_guard<std::mutex> lock(flashLock);
+    timing = value;
+}
+
+FlashTiming getFlashTiming() {
+    std::lock_guard<std::mutex> lock(flashLock);
+    return timing;
+}
+
+FlashCounters getFlashCounters() {
+    std::lock_guard<std::mutex> lock(flashLock);
+    return counters;
+}
+
+void resetFlash() {
+    {
+        std::lock_guard<std::mutex> lock(flashLock);
+        memset(flashMemory() + app1->address, 0xFF, app1->size);
+        counters = FlashCounters();
+        bootPartition = app0;
+    }
+    Preferences prefs;
+    prefs.begin("", false);
+    prefs.clear();
+}
+
+} // namespace sim
+
+// Partitions
+
+struct esp_partition_iterator_opaque_ {
+    esp_partition_type_t type;
+    esp_partition_subtype_t subtype;
+    std::string label;
+    bool anyLabel;
+    size_t index;
+};
+
+static bool partitionMatches(const esp_partition_iterator_opaque_* it, const esp_partition_t* partition) {
+    return partition->type == it->type &&
+           (it->subtype == ESP_PARTITION_SUBTYPE_ANY || partition->subtype == it->subtype) &&
+           (it->anyLabel || it->label == partition->label);
+}
+
+// Leaves the iterator on the next match at or after index, or releases it
+static esp_partition_iterator_t partitionSeek(esp_partition_iterator_t it) {
+    for (; it->index < SIM_PARTITIONS; it->index++) {
+        if (partitionMatches(it, &partitionTable[it->index])) {
+            return it;
+        }
+    }
+    delete it;
+    return nullptr;
+}
+
+esp_partition_iterator_t esp_partition_find(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                            const char* label) {
+    esp_partition_iterator_t it = new esp_partition_iterator_opaque_();
+    it->type = type;
+    it->subtype = subtype;
+    it->anyLabel = label == nullptr;
+    it->label = label ? label : "";
+    it->index = 0;
+    return partitionSeek(it);
+}
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+    esp_partition_iterator_t it = esp_partition_find(type, subtype, label);
+    if (!it) {
+        return nullptr;
+    }
+    const esp_partition_t* partition = esp_partition_get(it);
+    esp_partition_iterator_release(it);
+    return partition;
+}
+
+const esp_partition_t* esp_partition_get(esp_partition_iterator_t it) {
+    return &partitionTable[it->index];
+}
+
+esp_partition_iterator_t esp_partition_next(esp_partition_iterator_t it) {
+    it->index++;
+    return partitionSeek(it);
+}
+
+void esp_partition_iterator_release(esp_partition_iterator_t it) {
+    delete it;
+}
+
+static bool partitionRange(const esp_partition_t* partition, size_t offset, size_t size) {
+    return partition && offset <= partition->size && size <= partition->size - offset;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t offset, void* dst, size_t size) {
+    if (!dst || !partitionRange(partition, offset, size)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::lock_guard<std::mutex> lock(flashLock);
+    memcpy(dst, flashMemory() + partition->address + offset, size);
+    flashBusy((uint64_t)timing.readKBUs * ((size + 1023) / 1024));
+    return ESP_OK;
+}
+
+// NOR flash: programming only clears bits, an erase sets them again
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t offset, const void* src, size_t size) {
+    if (!src || !partitionRange(partition, offset, size)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (size == 0) {
+        return ESP_OK;
+    }
+    std::lock_guard<std::mutex> lock(flashLock);
+    uint8_t* dst = flashMemory() + partition->address + offset;
+    const uint8_t* in = (const uint8_t*)src;
+    for (size_t i = 0; i < size; i++) {
+        dst[i] &= in[i];
+    }
+    size_t start = partition->address + offset;
+    uint32_t pages = (start + size - 1) / SIM_PAGE_SIZE - start / SIM_PAGE_SIZE + 1;
+    counters.pagesProgrammed += pages;
+    flashBusy((uint64_t)timing.programPageUs * pages);
+    return ESP_OK;
+}
+
+// Whole aligned 64 KB blocks take a block erase, the rest go by sector,
+// as esp_flash_erase_region() does
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t offset, size_t size) {
+    if (!partitionRange(partition, offset, size)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (offset % SIM_SECTOR_SIZE || size % SIM_SECTOR_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    std::lock_guard<std::mutex> lock(flashLock);
+    size_t address = partition->address + offset;
+    size_t end = address + size;
+    memset(flashMemory() + address, 0xFF, size);
+    uint64_t us = 0;
+    while (address < end) {
+        if (address % SIM_BLOCK_SIZE == 0 && end - address >= SIM_BLOCK_SIZE) {
+            counters.blocksErased++;
+            us += timing.eraseBlockUs;
+            address += SIM_BLOCK_SIZE;
+        } else {
+            counters.sectorsErased++;
+            us += timing.eraseSectorUs;
+            address += SIM_SECTOR_SIZE;
+        }
+    }
+    flashBusy(us);
+    return ESP_OK;
+}
+
+// OTA selection. The device never reboots here, app0 keeps running and
+// app1 is always the next update partition.
+
+const esp_partition_t* esp_ota_get_running_partition() {
+    return app0;
+}
+
+const esp_partition_t* esp_ota_get_boot_partition() {
+    std::lock_guard<std::mutex> lock(flashLock);
+    return bootPartition;
+}
+
+const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t* start) {
+    return (start ? start : app0) == app0 ? app1 : app0;
+}
+
+const esp_partition_t* esp_ota_get_last_invalid_partition() {
+    return nullptr;
+}
+
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t* partition) {
+    if (!partition || partition->type != ESP_PARTITION_TYPE_APP) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint8_t magic = 0;
+    esp_partition_read(partition, 0, &magic, 1);
+    if (magic != ESP_IMAGE_HEADER_MAGIC) {
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+    std::lock_guard<std::mutex> lock(flashLock);
+    bootPartition = partition;
+    return ESP_OK;
+}
+
+// Only the running image has a state, and it is already confirmed
+esp_err_t esp_ota_get_state_partition(const esp_partition_t* partition, esp_ota_img_states_t* state) {
+    if (!partition || !state) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (partition != app0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    *state = ESP_OTA_IMG_VALID;
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_mark_app_valid_cancel_rollback() {
+    return ESP_OK;
+}
+
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot() {
+    esp_restart();
+    return ESP_OK;
+}
+
+// UpdateClass, after the 2.x core
+
+static const char* const updateErrors[] = {
+    "No Error", "Flash Write Failed", "Flash Erase Failed", "Flash Read Failed", "Not Enough Space",
+    "Bad Size Given", "Stream Read Timeout", "MD5 Check Failed", "Wrong Magic Byte",
+    "Could Not Activate The Firmware", "Partition Could Not be Found", "Bad Argument", "Aborted",
+};
+
+UpdateClass::UpdateClass() {
+    this->buffer = nullptr;
+    this->bufferLen = 0;
+    this->totalSize = 0;
+    this->progressSize = 0;
+    this->erasedTo = 0;
+    this->error = UPDATE_ERROR_OK;
+    this->partition = nullptr;
+}
+
+UpdateClass::~UpdateClass() {
+    reset();
+}
+
+void UpdateClass::reset() {
+    free(buffer);
+    buffer = nullptr;
+    bufferLen = 0;
+    totalSize = 0;
+    progressSize = 0;
+    erasedTo = 0;
+}
+
+void UpdateClass::fail(uint8_t code) {
+    reset();
+    error = code;
+}
+
+const char* UpdateClass::errorString() {
+    return error < sizeof(updateErrors) / sizeof(updateErrors[0]) ? updateErrors[error] : "UNKNOWN";
+}
+
+bool UpdateClass::begin(size_t size, int command, int ledPin, uint8_t ledOn, const char* label) {
+    if (totalSize > 0) {
+        return false;
+    }
+    reset();
+    error = UPDATE_ERROR_OK;
+    target = String();
+    if (size == 0) {
+        error = UPDATE_ERROR_SIZE;
+        return false;
+    }
+    if (command != U_FLASH) {
+        error = UPDATE_ERROR_BAD_ARGUMENT;
+        return false;
+    }
+    partition = esp_ota_get_next_update_partition(nullptr);
+    if (size == UPDATE_SIZE_UNKNOWN) {
+        size = partition->size;
+    } else if (size > partition->size) {
+        error = UPDATE_ERROR_SIZE;
+        return false;
+    }
+    buffer = (uint8_t*)malloc(SIM_SECTOR_SIZE);
+    if (!buffer) {
+        error = UPDATE_ERROR_ABORT;
+        return false;
+    }
+    totalSize = size;
+    md5.begin();
+    return true;
+}
+
+bool UpdateClass::setMD5(const char* expectedMD5) {
+    if (strlen(expectedMD5) != 32) {
+        return false;
+    }
+    target = expectedMD5;
+    target.toLowerCase();
+    return true;
+}
+
+// One sector at a time. A block is erased when the write reaches an aligned
+// 64 KB boundary with that much left, sectors otherwise; the first 16 bytes
+// are written last so a partial image never boots.
+bool UpdateClass::writeBuffer() {
+    size_t skip = 0;
+    if (progressSize == 0) {
+        if (buffer[0] != ESP_IMAGE_HEADER_MAGIC) {
+            fail(UPDATE_ERROR_MAGIC_BYTE);
+            return false;
+        }
+        skip = sizeof(skipBuffer);
+        memcpy(skipBuffer, buffer, skip);
+    }
+    if (progressSize >= erasedTo) {
+        size_t address = partition->address + progressSize;
+        size_t span = address % SIM_BLOCK_SIZE == 0 && totalSize - progressSize >= SIM_BLOCK_SIZE ? SIM_BLOCK_SIZE
+                                                                                                 : SIM_SECTOR_SIZE;
+        if (esp_partition_erase_range(partition, progressSize, span) != ESP_OK) {
+            fail(UPDATE_ERROR_ERASE);
+            return false;
+        }
+        erasedTo = progressSize + span;
+    }
+    if (esp_partition_write(partition, progressSize + skip, buffer + skip, bufferLen - skip) != ESP_OK) {
+        fail(UPDATE_ERROR_WRITE);
+        return false;
+    }
+    md5.add(buffer, bufferLen);
+    progressSize += bufferLen;
+    bufferLen = 0;
+    if (progressCallback) {
+        progressCallback(progressSize, totalSize);
+    }
+    return true;
+}
+
+size_t UpdateClass::write(uint8_t* data, size_t len) {
+    if (hasError() || !isRunning()) {
+        return 0;
+    }
+    if (len > remaining()) {
+        fail(UPDATE_ERROR_SPACE);
+        return 0;
+    }
+    size_t left = len;
+    while (bufferLen + left > SIM_SECTOR_SIZE) {
+        size_t take = SIM_SECTOR_SIZE - bufferLen;
+        memcpy(buffer + bufferLen, data + (len - left), take);
+        bufferLen += take;
+        if (!writeBuffer()) {
+            return len - left;
+        }
+        left -= take;
+    }
+    memcpy(buffer + bufferLen, data + (len - left), left);
+    bufferLen += left;
+    if (bufferLen == remaining() && !writeBuffer()) {
+        return len - left;
+    }
+    return len;
+}
+
+size_t UpdateClass::writeStream(Stream& data) {
+    size_t written = 0;
+    uint8_t chunk[512];
+    while (isRunning() && remaining() > 0) {
+        size_t want = std::min(remaining(), sizeof(chunk));
+        size_t got = data.readBytes(chunk, want);
+        if (got == 0) {
+            fail(UPDATE_ERROR_STREAM);
+            break;
+        }
+        if (write(chunk, got) != got) {
+            break;
+        }
+        written += got;
+    }
+    return written;
+}
+
+bool UpdateClass::end(bool evenIfRemaining) {
+    if (hasError() || totalSize == 0) {
+        return false;
+    }
+    if (!isFinished() && !evenIfRemaining) {
+        fail(UPDATE_ERROR_ABORT);
+        return false;
+    }
+    if (evenIfRemaining) {
+        if (bufferLen > 0 && !writeBuffer()) {
+            return false;
+        }
+        totalSize = progressSize;
+    }
+    md5.calculate();
+    if (target.length() > 0 && target != md5.toString()) {
+        fail(UPDATE_ERROR_MD5);
+        return false;
+    }
+    if (esp_partition_write(partition, 0, skipBuffer, sizeof(skipBuffer)) != ESP_OK) {
+        fail(UPDATE_ERROR_WRITE);
+        return false;
+    }
+    if (esp_ota_set_boot_partition(partition) != ESP_OK) {
+        fail(UPDATE_ERROR_ACTIVATE);
+        return false;
+    }
+    reset();
+    return true;
+}
+
+void UpdateClass::abort() {
+    fail(UPDATE_ERROR_ABORT);
+}
+
+bool UpdateClass::canRollBack() {
+    if (buffer) {
+        return false;
+    }
+    uint8_t magic = 0;
+    esp_partition_read(esp_ota_get_next_update_partition(nullptr), 0, &magic, 1);
+    return magic == ESP_IMAGE_HEADER_MAGIC;
+}
+
+bool UpdateClass::rollBack() {
+    return canRollBack() && esp_ota_set_boot_partition(esp_ota_get_next_update_partition(nullptr)) == ESP_OK;
+}
+
+// Preferences: one NVS for every instance, gone with the process
+
+static std::mutex nvsLock;
+static std::map<std::string, std::map<std::string, std::string>> nvs;
+
+bool Preferences::begin(const char* name, bool readOnly, const char* partitionLabel) {
+    if (open || !name) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(nvsLock);
+    // Like nvs_open(), a read-only handle needs the namespace to exist
+    if (readOnly && nvs.find(name) == nvs.end()) {
+        return false;
+    }
+    space = name;
+    this->readOnly = readOnly;
+    open = true;
+    return true;
+}
+
+void Preferences::end() {
+    open = false;
+}
+
+bool Preferences::clear() {
+    if (!open || readOnly) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(nvsLock);
+    // The empty namespace stands for the whole store, see sim::resetFlash()
+    if (space.length() == 0) {
+        nvs.clear();
+    } else {
+        nvs[space.c_str()].clear();
+    }
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (!open || readOnly) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(nvsLock);
+    return nvs[space.c_str()].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+    std::lock_guard<std::mutex> lock(nvsLock);
+    auto found = nvs.find(space.c_str());
+    return open && found != nvs.end() && found->second.count(key) > 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t len) {
+    if (!open || readOnly || !key) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(nvsLock);
+    nvs[space.c_str()][key] = std::string((const char*)value, len);
+    return len;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    if (!open || !key) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(nvsLock);
+    auto found = nvs.find(space.c_str());
+    if (found == nvs.end()) {
+        return 0;
+    }
+    auto value = found->second.find(key);
+    return value == found->second.end() ? 0 : value->second.size();
+}
+
+// A value longer than the buffer reads as nothing, as nvs_get_blob() fails
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+    if (!open || !key || !buf) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(nvsLock);
+    auto found = nvs.find(space.c_str());
+    if (found == nvs.end()) {
+        return 0;
+    }
+    auto value = found->second.find(key);
+    if (value == found->second.end() || value->second.size() > maxLen) {
+        return 0;
+    }
+    memcpy(buf, value->second.data(), value->second.size());
+    return value->second.size();
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) {
+    uint32_t value;
+    return getBytesLength(key) == sizeof(value) && getBytes(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+bool Preferences::getBool(const char* key, bool defaultValue) {
+    bool value;
+    return getBytesLength(key) == sizeof(value) && getBytes(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+    size_t len = getBytesLength(key);
+    if (len == 0) {
+        return isKey(key) ? String() : defaultValue;
+    }
+    std::string value(len, '\0');
+    getBytes(key, &value[0], len);
+    return String(value);
+}
@@ -0,0 +1,379 @@
+// freertos.cpp - Tasks, queues, semaphores, ring buffers, critical sections
+// and esp_timer on host threads
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/ringbuf.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
+#include <Arduino.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sim.h"
+
+// Thrown by vTaskDelete(nullptr) so the task never returns into its caller
+struct SimTaskExit {};
+
+struct SimTask {
+    std::string name;
+    uint32_t stackDepth;
+    std::mutex lock;
+    std::condition_variable notified;
+    uint32_t notifications = 0;
+};
+
+static thread_local SimTask* currentTask = nullptr;
+
+// Waits on cond until ready() or the ticks run out, portMAX_DELAY is forever
+template <typename Ready>
+static bool waitTicks(std::condition_variable& cond, std::unique_lock<std::mutex>& lock, TickType_t ticks,
+                      Ready ready) {
+    if (ticks == portMAX_DELAY) {
+        cond.wait(lock, ready);
+        return true;
+    }
+    return cond.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+// Tasks
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char* name, uint32_t stackDepth, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t core) {
+    SimTask* task = new SimTask();
+    task->name = name ? name : "";
+    task->stackDepth = stackDepth;
+    if (created) {
+        *created = task;
+    }
+    sim::heapCharge(stackDepth);
+    // The handle stays valid after the task ends, as a stale handle would
+    // on the device until its memory is reused
+    std::thread([task, code, arg]() {
+        currentTask = task;
+        try {
+            code(arg);
+        } catch (const SimTaskExit&) {
+        }
+        sim::heapRefund(task->stackDepth);
+    }).detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char* name, uint32_t stackDepth, void* arg,
+                       UBaseType_t priority, TaskHandle_t* created) {
+    return xTaskCreatePinnedToCore(code, name, stackDepth, arg, priority, created, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (!task || task == currentTask) {
+        throw SimTaskExit();
+    }
+    // Threads cannot be killed from outside; the library never tries
+    fprintf(stderr, "sim: vTaskDelete() of another task is not supported\n");
+    abort();
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    static SimTask loopTask;
+    return currentTask ? currentTask : &loopTask;
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)millis();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    // Host stacks are not measured; report the stack as half used
+    SimTask* target = task ? task : xTaskGetCurrentTaskHandle();
+    return target->stackDepth / 2;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    SimTask* task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(task->lock);
+    if (!waitTicks(task->notified, lock, ticks, [task]() { return task->notifications > 0; })) {
+        return 0;
+    }
+    uint32_t value = task->notifications;
+    task->notifications = clearOnExit ? 0 : value - 1;
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    {
+        std::lock_guard<std::mutex> lock(task->lock);
+        task->notifications++;
+    }
+    task->notified.notify_all();
+    return pdPASS;
+}
+
+// Queues, and semaphores as queues of empty items
+
+struct SimQueue {
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    std::deque<std::string> items;
+    std::mutex lock;
+    std::condition_variable changed;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    if (length == 0) {
+        return nullptr;
+    }
+    SimQueue* queue = new SimQueue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(queue->lock);
+    if (!waitTicks(queue->changed, lock, ticks, [queue]() { return queue->items.size() < queue->length; })) {
+        return pdFALSE;
+    }
+    queue->items.emplace_back((const char*)item, queue->itemSize);
+    lock.unlock();
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(queue->lock);
+    if (!waitTicks(queue->changed, lock, ticks, [queue]() { return !queue->items.empty(); })) {
+        return pdFALSE;
+    }
+    if (queue->itemSize > 0) {
+        memcpy(item, queue->items.front().data(), queue->itemSize);
+    }
+    queue->items.pop_front();
+    lock.unlock();
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    return queue->items.size();
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+    {
+        std::lock_guard<std::mutex> lock(queue->lock);
+        queue->items.clear();
+    }
+    queue->changed.notify_all();
+    return pdPASS;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return xQueueCreate(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    SemaphoreHandle_t mutex = xQueueCreate(1, 0);
+    xSemaphoreGive(mutex);
+    return mutex;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    return xQueueReceive(semaphore, nullptr, ticks);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    return xQueueSend(semaphore, nullptr, 0);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    vQueueDelete(semaphore);
+}
+
+// Byte ring buffers
+
+struct SimRingbuf {
+    std::vector<uint8_t> data;
+    size_t head = 0;
+    size_t used = 0;
+    std::mutex lock;
+    std::condition_variable changed;
+};
+
+RingbufHandle_t xRingbufferCreate(size_t size, RingbufferType_t type) {
+    if (type != RINGBUF_TYPE_BYTEBUF || size == 0) {
+        return nullptr;
+    }
+    SimRingbuf* ringbuf = new SimRingbuf();
+    ringbuf->data.resize(size);
+    return ringbuf;
+}
+
+BaseType_t xRingbufferSend(RingbufHandle_t ringbuf, const void* item, size_t size, TickType_t ticks) {
+    if (size > ringbuf->data.size()) {
+        return pdFALSE;
+    }
+    std::unique_lock<std::mutex> lock(ringbuf->lock);
+    if (!waitTicks(ringbuf->changed, lock, ticks,
+                   [ringbuf, size]() { return ringbuf->data.size() - ringbuf->used >= size; })) {
+        return pdFALSE;
+    }
+    const uint8_t* in = (const uint8_t*)item;
+    size_t capacity = ringbuf->data.size();
+    for (size_t i = 0; i < size; i++) {
+        ringbuf->data[(ringbuf->head + ringbuf->used + i) % capacity] = in[i];
+    }
+    ringbuf->used += size;
+    lock.unlock();
+    ringbuf->changed.notify_all();
+    return pdTRUE;
+}
+
+// The item is a copy, returned with vRingbufferReturnItem()
+void* xRingbufferReceiveUpTo(RingbufHandle_t ringbuf, size_t* size, TickType_t ticks, size_t maxSize) {
+    std::unique_lock<std::mutex> lock(ringbuf->lock);
+    if (maxSize == 0 || !waitTicks(ringbuf->changed, lock, ticks, [ringbuf]() { return ringbuf->used > 0; })) {
+        return nullptr;
+    }
+    // Like the IDF, a wrapped region comes out in two pieces
+    size_t capacity = ringbuf->data.size();
+    size_t n = std::min(std::min(ringbuf->used, maxSize), capacity - ringbuf->head);
+    uint8_t* item = (uint8_t*)malloc(n);
+    if (!item) {
+        return nullptr;
+    }
+    memcpy(item, ringbuf->data.data() + ringbuf->head, n);
+    ringbuf->head = (ringbuf->head + n) % capacity;
+    ringbuf->used -= n;
+    *size = n;
+    lock.unlock();
+    ringbuf->changed.notify_all();
+    return item;
+}
+
+void vRingbufferReturnItem(RingbufHandle_t ringbuf, void* item) {
+    free(item);
+}
+
+void vRingbufferDelete(RingbufHandle_t ringbuf) {
+    delete ringbuf;
+}
+
+// Critical sections
+
+static uintptr_t threadTag() {
+    static thread_local char tag;
+    return (uintptr_t)&tag;
+}
+
+void vPortEnterCritical(portMUX_TYPE* mux) {
+    uintptr_t self = threadTag();
+    if (__atomic_load_n(&mux->owner, __ATOMIC_ACQUIRE) == self) {
+        mux->count++;
+        return;
+    }
+    uintptr_t expected = 0;
+    while (!__atomic_compare_exchange_n(&mux->owner, &expected, self, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        expected = 0;
+        std::this_thread::yield();
+    }
+    mux->count = 1;
+}
+
+void vPortExitCritical(portMUX_TYPE* mux) {
+    if (--mux->count == 0) {
+        __atomic_store_n(&mux->owner, 0, __ATOMIC_RELEASE);
+    }
+}
+
+// esp_timer. Each start arms a thread; stop and delete disarm it through
+// the shared state, which lives on until the last thread lets go.
+
+struct SimTimerState {
+    esp_timer_cb_t callback;
+    void* arg;
+    std::mutex lock;
+    std::condition_variable changed;
+    uint64_t generation = 0;
+    bool armed = false;
+};
+
+struct esp_timer {
+    std::shared_ptr<SimTimerState> state;
+};
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle) {
+    if (!args || !args->callback || !handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_timer* timer = new esp_timer();
+    timer->state = std::make_shared<SimTimerState>();
+    timer->state->callback = args->callback;
+    timer->state->arg = args->arg;
+    *handle = timer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs) {
+    std::shared_ptr<SimTimerState> state = timer->state;
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(state->lock);
+        if (state->armed) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        state->armed = true;
+        generation = ++state->generation;
+    }
+    std::thread([state, generation, timeoutUs]() {
+        std::unique_lock<std::mutex> lock(state->lock);
+        bool cancelled = state->changed.wait_for(lock, std::chrono::microseconds(timeoutUs),
+                                                 [&]() { return state->generation != generation; });
+        if (cancelled) {
+            return;
+        }
+        state->armed = false;
+        lock.unlock();
+        state->callback(state->arg);
+    }).detach();
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    std::shared_ptr<SimTimerState> state = timer->state;
+    {
+        std::lock_guard<std::mutex> lock(state->lock);
+        if (!state->armed) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        state->armed = false;
+        state->generation++;
+    }
+    state->changed.notify_all();
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    if (timer->state->armed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    delete timer;
+    return ESP_OK;
+}
+
+int64_t esp_timer_get_time() {
+    return (int64_t)micros();
+}
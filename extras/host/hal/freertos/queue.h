@@ -0,0 +1,15 @@
+// queue.h - Host stand-in
+#ifndef AVISHA_HOST_QUEUE_H
+#define AVISHA_HOST_QUEUE_H
+
+#include "FreeRTOS.h"
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+BaseType_t xQueueReset(QueueHandle_t queue);
+void vQueueDelete(QueueHandle_t queue);
+#define xQueueSendToBack xQueueSend
+
+#endif // AVISHA_HOST_QUEUE_H
@@ -0,0 +1,16 @@
+// ringbuf.h - Host stand-in, byte buffers only
+#ifndef AVISHA_HOST_RINGBUF_H
+#define AVISHA_HOST_RINGBUF_H
+
+#include "FreeRTOS.h"
+
+typedef struct SimRingbuf* RingbufHandle_t;
+typedef enum { RINGBUF_TYPE_NOSPLIT = 0, RINGBUF_TYPE_ALLOWSPLIT, RINGBUF_TYPE_BYTEBUF } RingbufferType_t;
+
+RingbufHandle_t xRingbufferCreate(size_t size, RingbufferType_t type);
+BaseType_t xRingbufferSend(RingbufHandle_t ringbuf, const void* item, size_t size, TickType_t ticks);
+void* xRingbufferReceiveUpTo(RingbufHandle_t ringbuf, size_t* size, TickType_t ticks, size_t maxSize);
+void vRingbufferReturnItem(RingbufHandle_t ringbuf, void* item);
+void vRingbufferDelete(RingbufHandle_t ringbuf);
+
+#endif // AVISHA_HOST_RINGBUF_H
@@ -0,0 +1,13 @@
+// semphr.h - Host stand-in, semaphores are queues of empty items
+#ifndef AVISHA_HOST_SEMPHR_H
+#define AVISHA_HOST_SEMPHR_H
+
+#include "queue.h"
+
+SemaphoreHandle_t xSemaphoreCreateBinary();
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+void vSemaphoreDelete(SemaphoreHandle_t semaphore);
+
+#endif // AVISHA_HOST_SEMPHR_H
@@ -0,0 +1,11 @@
+// sockets.h - Host stand-in, lwIP's BSD API is the host's own
+#ifndef AVISHA_HOST_LWIP_SOCKETS_H
+#define AVISHA_HOST_LWIP_SOCKETS_H
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#endif // AVISHA_HOST_LWIP_SOCKETS_H
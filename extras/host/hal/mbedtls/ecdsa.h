@@ -0,0 +1,32 @@
+// ecdsa.h - Host stand-in. Verification always fails, see pk.h.
+#ifndef AVISHA_HOST_MBEDTLS_ECDSA_H
+#define AVISHA_HOST_MBEDTLS_ECDSA_H
+
+#include <cstddef>
+#include <cstdint>
+
+typedef struct {
+    int s;
+    size_t n;
+    uint32_t* p;
+} mbedtls_mpi;
+typedef enum { MBEDTLS_ECP_DP_NONE = 0, MBEDTLS_ECP_DP_SECP256R1 = 3 } mbedtls_ecp_group_id;
+typedef struct {
+    mbedtls_ecp_group_id id;
+} mbedtls_ecp_group;
+typedef struct {
+    mbedtls_mpi X, Y, Z;
+} mbedtls_ecp_point;
+typedef struct {
+    mbedtls_ecp_group grp;
+    mbedtls_mpi d;
+    mbedtls_ecp_point Q;
+} mbedtls_ecp_keypair;
+
+void mbedtls_mpi_init(mbedtls_mpi* x);
+void mbedtls_mpi_free(mbedtls_mpi* x);
+int mbedtls_mpi_read_binary(mbedtls_mpi* x, const unsigned char* buf, size_t len);
+int mbedtls_ecdsa_verify(mbedtls_ecp_group* grp, const unsigned char* hash, size_t len, const mbedtls_ecp_point* q,
+                         const mbedtls_mpi* r, const mbedtls_mpi* s);
+
+#endif // AVISHA_HOST_MBEDTLS_ECDSA_H
@@ -0,0 +1,14 @@
+// md.h - Host stand-in, HMAC over SHA-256 only
+#ifndef AVISHA_HOST_MBEDTLS_MD_H
+#define AVISHA_HOST_MBEDTLS_MD_H
+
+#include <cstddef>
+
+typedef enum { MBEDTLS_MD_NONE = 0, MBEDTLS_MD_SHA256 = 6 } mbedtls_md_type_t;
+typedef struct mbedtls_md_info_t mbedtls_md_info_t;
+
+const mbedtls_md_info_t* mbedtls_md_info_from_type(mbedtls_md_type_t type);
+int mbedtls_md_hmac(const mbedtls_md_info_t* info, const unsigned char* key, size_t keyLen,
+                    const unsigned char* input, size_t len, unsigned char* output);
+
+#endif // AVISHA_HOST_MBEDTLS_MD_H
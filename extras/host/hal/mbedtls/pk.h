@@ -0,0 +1,21 @@
+// pk.h - Host stand-in. No key parses, so setSigningKey() reports failure
+// and signed updates are out of the harness's reach.
+#ifndef AVISHA_HOST_MBEDTLS_PK_H
+#define AVISHA_HOST_MBEDTLS_PK_H
+
+#include "ecdsa.h"
+#include "md.h"
+
+typedef enum { MBEDTLS_PK_NONE = 0, MBEDTLS_PK_RSA, MBEDTLS_PK_ECKEY, MBEDTLS_PK_ECKEY_DH, MBEDTLS_PK_ECDSA } mbedtls_pk_type_t;
+typedef struct {
+    const void* pk_info;
+    void* pk_ctx;
+} mbedtls_pk_context;
+
+void mbedtls_pk_init(mbedtls_pk_context* ctx);
+void mbedtls_pk_free(mbedtls_pk_context* ctx);
+int mbedtls_pk_parse_public_key(mbedtls_pk_context* ctx, const unsigned char* key, size_t keyLen);
+int mbedtls_pk_can_do(const mbedtls_pk_context* ctx, mbedtls_pk_type_t type);
+mbedtls_ecp_keypair* mbedtls_pk_ec(const mbedtls_pk_context pk);
+
+#endif // AVISHA_HOST_MBEDTLS_PK_H
@@ -0,0 +1,22 @@
+// sha256.h - Host stand-in, a portable SHA-256
+#ifndef AVISHA_HOST_MBEDTLS_SHA256_H
+#define AVISHA_HOST_MBEDTLS_SHA256_H
+
+#include <cstddef>
+#include <cstdint>
+
+typedef struct {
+    uint32_t total[2];
+    uint32_t state[8];
+    unsigned char buffer[64];
+    int is224;
+} mbedtls_sha256_context;
+
+void mbedtls_sha256_init(mbedtls_sha256_context* ctx);
+void mbedtls_sha256_free(mbedtls_sha256_context* ctx);
+int mbedtls_sha256_starts(mbedtls_sha256_context* ctx, int is224);
+int mbedtls_sha256_update(mbedtls_sha256_context* ctx, const unsigned char* input, size_t len);
+int mbedtls_sha256_finish(mbedtls_sha256_context* ctx, unsigned char output[32]);
+int mbedtls_sha256(const unsigned char* input, size_t len, unsigned char output[32], int is224);
+
+#endif // AVISHA_HOST_MBEDTLS_SHA256_H
@@ -0,0 +1,422 @@
+// network.cpp - WiFi, WiFiClient and WiFiServer over loopback sockets, and
+// the ArduinoOTA and MDNS objects
+#include <ArduinoOTA.h>
+#include <ESPmDNS.h>
+#include <WiFi.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <vector>
+
+#define SIM_TCP_WINDOW 5744  // CONFIG_LWIP_TCP_WND_DEFAULT
+
+WiFiClass WiFi;
+ArduinoOTAClass ArduinoOTA;
+MDNSResponder MDNS;
+
+// The socket closes when the last copy of the client lets go of it, or on
+// stop(), which every copy then sees
+struct WiFiClient::Socket {
+    int fd;
+    explicit Socket(int fd) : fd(fd) {}
+    ~Socket() { close(); }
+    void close() {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+};
+
+static sockaddr_in loopback(uint16_t port) {
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return addr;
+}
+
+WiFiClient::WiFiClient() : peeked(-1) {}
+
+WiFiClient::WiFiClient(int fd) : socket(std::make_shared<Socket>(fd)), peeked(-1) {}
+
+WiFiClient::~WiFiClient() {}
+
+int WiFiClient::fd() const {
+    return socket ? socket->fd : -1;
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+    return connect(ip, port, 3000);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+    IPAddress ip;
+    if (WiFi.hostByName(host, ip) != 1) {
+        return 0;
+    }
+    return connect(ip, port);
+}
+
+// Everything the simulated device reaches is on this machine
+int WiFiClient::connect(IPAddress ip, uint16_t port, int32_t timeout) {
+    stop();
+    if (ip != IPAddress(127, 0, 0, 1)) {
+        return 0;
+    }
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    sockaddr_in addr = loopback(port);
+    if (::connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        ::close(fd);
+        return 0;
+    }
+    socket = std::make_shared<Socket>(fd);
+    peeked = -1;
+    return 1;
+}
+
+size_t WiFiClient::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    int fd = this->fd();
+    size_t sent = 0;
+    while (fd >= 0 && sent < size) {
+        ssize_t n = ::send(fd, buffer + sent, size - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        sent += n;
+    }
+    return sent;
+}
+
+int WiFiClient::available() {
+    int fd = this->fd();
+    if (fd < 0) {
+        return 0;
+    }
+    int pending = 0;
+    if (ioctl(fd, FIONREAD, &pending) != 0) {
+        pending = 0;
+    }
+    return pending + (peeked >= 0 ? 1 : 0);
+}
+
+int WiFiClient::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+    size_t count = 0;
+    if (peeked >= 0) {
+        buffer[count++] = (uint8_t)peeked;
+        peeked = -1;
+    }
+    int fd = this->fd();
+    if (fd < 0 || count == size) {
+        return count > 0 ? (int)count : -1;
+    }
+    ssize_t n = ::recv(fd, buffer + count, size - count, MSG_DONTWAIT);
+    if (n > 0) {
+        count += n;
+    }
+    return count > 0 ? (int)count : -1;
+}
+
+int WiFiClient::peek() {
+    if (peeked < 0) {
+        int fd = this->fd();
+        uint8_t c;
+        if (fd >= 0 && ::recv(fd, &c, 1, MSG_DONTWAIT) == 1) {
+            peeked = c;
+        }
+    }
+    return peeked;
+}
+
+void WiFiClient::stop() {
+    if (socket) {
+        socket->close();
+        socket.reset();
+    }
+    peeked = -1;
+}
+
+uint8_t WiFiClient::connected() {
+    int fd = this->fd();
+    if (fd < 0) {
+        return 0;
+    }
+    if (peeked >= 0) {
+        return 1;
+    }
+    uint8_t c;
+    ssize_t n = ::recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n > 0) {
+        return 1;
+    }
+    // Zero is an orderly close; anything but "nothing yet" is a dead socket
+    return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+}
+
+int WiFiClient::setNoDelay(bool noDelay) {
+    int flag = noDelay ? 1 : 0;
+    return setsockopt(fd(), IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+}
+
+int WiFiClient::setTimeout(uint32_t seconds) {
+    Stream::setTimeout(seconds * 1000);
+    timeval tv = {(time_t)seconds, 0};
+    return setsockopt(fd(), SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+static bool endpoint(int fd, bool remote, sockaddr_in& addr) {
+    socklen_t len = sizeof(addr);
+    if (fd < 0) {
+        return false;
+    }
+    int result = remote ? getpeername(fd, (sockaddr*)&addr, &len) : getsockname(fd, (sockaddr*)&addr, &len);
+    return result == 0;
+}
+
+IPAddress WiFiClient::remoteIP() const {
+    sockaddr_in addr;
+    return endpoint(fd(), true, addr) ? IPAddress(addr.sin_addr.s_addr) : IPAddress();
+}
+
+uint16_t WiFiClient::remotePort() const {
+    sockaddr_in addr;
+    return endpoint(fd(), true, addr) ? ntohs(addr.sin_port) : 0;
+}
+
+IPAddress WiFiClient::localIP() const {
+    sockaddr_in addr;
+    return endpoint(fd(), false, addr) ? IPAddress(addr.sin_addr.s_addr) : IPAddress();
+}
+
+uint16_t WiFiClient::localPort() const {
+    sockaddr_in addr;
+    return endpoint(fd(), false, addr) ? ntohs(addr.sin_port) : 0;
+}
+
+// WiFiServer
+
+WiFiServer::WiFiServer(uint16_t port, uint8_t maxClients) {
+    this->port = port;
+    this->maxClients = maxClients;
+    this->listener = -1;
+    this->noDelay = false;
+}
+
+WiFiServer::~WiFiServer() {
+    end();
+}
+
+void WiFiServer::begin(uint16_t port) {
+    if (port) {
+        this->port = port;
+    }
+    end();
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return;
+    }
+    int flag = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+    // About the receive window of lwIP in the 2.x core, inherited by the
+    // accepted sockets, so senders are held back as the device holds them
+    int window = SIM_TCP_WINDOW;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &window, sizeof(window));
+    sockaddr_in addr = loopback(this->port);
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, maxClients) != 0) {
+        fprintf(stderr, "sim: cannot listen on 127.0.0.1:%u: %s\n", this->port, strerror(errno));
+        ::close(fd);
+        return;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    listener = fd;
+}
+
+void WiFiServer::end() {
+    if (listener >= 0) {
+        ::close(listener);
+        listener = -1;
+    }
+}
+
+bool WiFiServer::hasClient() {
+    if (listener < 0) {
+        return false;
+    }
+    pollfd pfd = {listener, POLLIN, 0};
+    return poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN);
+}
+
+WiFiClient WiFiServer::available() {
+    if (listener < 0) {
+        return WiFiClient();
+    }
+    int fd = ::accept(listener, nullptr, nullptr);
+    if (fd < 0) {
+        return WiFiClient();
+    }
+    // Accepted sockets do not inherit O_NONBLOCK on Linux, writes block
+    if (noDelay) {
+        int flag = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    }
+    return WiFiClient(fd);
+}
+
+// WiFiClass. The station is up as soon as begin() is called.
+
+static WiFiMode_t wifiMode = WIFI_OFF;
+static wl_status_t wifiStatus = WL_IDLE_STATUS;
+struct EventRegistration {
+    WiFiEventCb callback;
+    arduino_event_id_t event;
+};
+static std::vector<EventRegistration> eventCallbacks;
+
+bool WiFiClass::mode(WiFiMode_t mode) {
+    wifiMode = mode;
+    return true;
+}
+
+WiFiMode_t WiFiClass::getMode() {
+    return wifiMode;
+}
+
+// Like the core, the same callback registered twice is called twice
+int WiFiClass::onEvent(WiFiEventCb callback, arduino_event_id_t event) {
+    if (!callback) {
+        return 0;
+    }
+    eventCallbacks.push_back({callback, event});
+    return (int)eventCallbacks.size();
+}
+
+void WiFiClass::dispatch(arduino_event_id_t event) {
+    for (const EventRegistration& registration : eventCallbacks) {
+        if (registration.event == ARDUINO_EVENT_MAX || registration.event == event) {
+            registration.callback(event);
+        }
+    }
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* passphrase, int32_t channel, const uint8_t* bssid,
+                             bool connect) {
+    if (wifiMode == WIFI_OFF) {
+        wifiMode = WIFI_STA;
+    }
+    // Already associated: nothing changes, no events, as for a repeated
+    // begin() with the same network
+    if (!connect || wifiStatus == WL_CONNECTED) {
+        return wifiStatus;
+    }
+    wifiStatus = WL_CONNECTED;
+    dispatch(ARDUINO_EVENT_WIFI_STA_START);
+    dispatch(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+    dispatch(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    return wifiStatus;
+}
+
+bool WiFiClass::config(IPAddress localIP, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2) {
+    return true;
+}
+
+bool WiFiClass::disconnect(bool wifiOff, bool eraseAP) {
+    if (wifiStatus == WL_CONNECTED) {
+        wifiStatus = WL_DISCONNECTED;
+        dispatch(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    }
+    if (wifiOff) {
+        wifiMode = WIFI_OFF;
+    }
+    return true;
+}
+
+bool WiFiClass::reconnect() {
+    return begin("sim") == WL_CONNECTED;
+}
+
+wl_status_t WiFiClass::status() {
+    return wifiStatus;
+}
+
+IPAddress WiFiClass::localIP() {
+    return wifiStatus == WL_CONNECTED ? IPAddress(127, 0, 0, 1) : IPAddress();
+}
+
+IPAddress WiFiClass::subnetMask() {
+    return IPAddress(255, 0, 0, 0);
+}
+
+IPAddress WiFiClass::gatewayIP() {
+    return IPAddress(127, 0, 0, 1);
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t index) {
+    return IPAddress(127, 0, 0, 1);
+}
+
+static const uint8_t simMac[6] = {0x24, 0x0A, 0xC4, 0x00, 0x00, 0x01};
+
+String WiFiClass::macAddress() {
+    char buf[18];
+    snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X", simMac[0], simMac[1], simMac[2], simMac[3],
+             simMac[4], simMac[5]);
+    return String(buf);
+}
+
+uint8_t* WiFiClass::macAddress(uint8_t* mac) {
+    memcpy(mac, simMac, sizeof(simMac));
+    return mac;
+}
+
+uint8_t* WiFiClass::BSSID() {
+    static uint8_t bssid[6] = {0x02, 0, 0, 0, 0, 0x01};
+    return bssid;
+}
+
+String WiFiClass::SSID() {
+    return wifiStatus == WL_CONNECTED ? String("sim") : String("");
+}
+
+int32_t WiFiClass::channel() {
+    return 1;
+}
+
+int8_t WiFiClass::RSSI() {
+    return wifiStatus == WL_CONNECTED ? -40 : 0;
+}
+
+// Names resolve to loopback, or not at all
+int WiFiClass::hostByName(const char* host, IPAddress& result) {
+    if (result.fromString(host)) {
+        return 1;
+    }
+    if (strcmp(host, "localhost") == 0) {
+        result = IPAddress(127, 0, 0, 1);
+        return 1;
+    }
+    return 0;
+}
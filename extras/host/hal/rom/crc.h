@@ -0,0 +1,9 @@
+// crc.h - Host stand-in for the ROM CRC routines
+#ifndef AVISHA_HOST_ROM_CRC_H
+#define AVISHA_HOST_ROM_CRC_H
+
+#include <cstdint>
+
+uint32_t crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len);
+
+#endif // AVISHA_HOST_ROM_CRC_H
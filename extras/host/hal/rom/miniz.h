@@ -0,0 +1,47 @@
+// miniz.h - Host stand-in for the ROM inflater, built on zlib when the host
+// has it. Without zlib every call fails, and gzip uploads with it.
+#ifndef AVISHA_HOST_ROM_MINIZ_H
+#define AVISHA_HOST_ROM_MINIZ_H
+
+#include <cstddef>
+#include <cstdint>
+
+typedef unsigned char mz_uint8;
+typedef uint32_t mz_uint32;
+
+enum {
+    TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+    TINFL_FLAG_HAS_MORE_INPUT = 2,
+    TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4,
+    TINFL_FLAG_COMPUTE_ADLER32 = 8
+};
+#define TINFL_LZ_DICT_SIZE 32768
+
+typedef enum {
+    TINFL_STATUS_BAD_PARAM = -3,
+    TINFL_STATUS_ADLER32_MISMATCH = -2,
+    TINFL_STATUS_FAILED = -1,
+    TINFL_STATUS_DONE = 0,
+    TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+    TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+// The same size as the ROM's, so the library's allocation is realistic
+struct tinfl_decompressor_tag {
+    mz_uint32 m_state;
+    void* stream;
+    uint8_t reserved[10992];
+};
+typedef struct tinfl_decompressor_tag tinfl_decompressor;
+
+#define tinfl_init(r) \
+    do { \
+        (r)->m_state = 0; \
+        (r)->stream = nullptr; \
+    } while (0)
+
+tinfl_status tinfl_decompress(tinfl_decompressor* r, const mz_uint8* pIn_buf_next, size_t* pIn_buf_size,
+                              mz_uint8* pOut_buf_start, mz_uint8* pOut_buf_next, size_t* pOut_buf_size,
+                              const mz_uint32 decomp_flags);
+
+#endif // AVISHA_HOST_ROM_MINIZ_H
@@ -0,0 +1,51 @@
+// sim.h - Controls and counters of the simulated ESP32, for the host harness
+#ifndef AVISHA_HOST_SIM_H
+#define AVISHA_HOST_SIM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace sim {
+
+// Flash timing, roughly a 4 MB QIO part on an ESP32 at 80 MHz. Every
+// erase and program sleeps for its share and holds the flash lock, so
+// two tasks writing at once queue up as they do behind the SPI driver.
+struct FlashTiming {
+    uint32_t eraseSectorUs;  // One 4 KB sector
+    uint32_t eraseBlockUs;   // One 64 KB block, used for aligned whole blocks
+    uint32_t programPageUs;  // One 256 byte page
+    uint32_t readKBUs;       // One KB read back
+};
+
+struct FlashCounters {
+    uint32_t sectorsErased;
+    uint32_t blocksErased;
+    uint32_t pagesProgrammed;
+    uint64_t busyUs;          // Time spent inside erase, program and read
+};
+
+void setFlashTiming(const FlashTiming& timing);
+FlashTiming getFlashTiming();
+FlashCounters getFlashCounters();
+void resetFlash();            // Blank app1 and NVS, zero the counters, boot app0
+
+// ESP.restart() and a rollback reboot call this instead of resetting
+void onRestart(const std::function<void()>& handler);
+
+// Heap use is counted across new, malloc (when the link wraps it) and their
+// frees, for the library and the HAL alike. The simulated
+// heap is heapSize() bytes, ESP.getFreeHeap() reports what is left of it.
+size_t heapSize();
+size_t heapInUse();
+size_t heapPeak();
+void resetHeapPeak();
+bool heapTracked();           // False without glibc's malloc_usable_size()
+
+// Task stacks come out of the heap on the ESP32, the HAL charges them here
+void heapCharge(size_t bytes);
+void heapRefund(size_t bytes);
+
+} // namespace sim
+
+#endif // AVISHA_HOST_SIM_H
@@ -0,0 +1,520 @@
+// webserver.cpp - The WebServer stand-in, one request per connection
+#include <WebServer.h>
+#include <poll.h>
+
+// Waits for a byte the way the core does, giving up after
+// HTTP_MAX_DATA_WAIT or when the peer has gone
+static int readByte(WiFiClient& client) {
+    unsigned long start = millis();
+    while (millis() - start < HTTP_MAX_DATA_WAIT) {
+        int c = client.read();
+        if (c >= 0) {
+            return c;
+        }
+        if (!client.connected()) {
+            return -1;
+        }
+        pollfd pfd = {client.fd(), POLLIN, 0};
+        poll(&pfd, 1, 10);
+    }
+    return -1;
+}
+
+WebServer::WebServer(int port) : server(port) {
+    this->currentMethod = HTTP_ANY;
+    this->contentLength = CONTENT_LENGTH_NOT_SET;
+    this->chunked = false;
+    this->headersSent = false;
+}
+
+WebServer::~WebServer() {
+    stop();
+}
+
+void WebServer::begin() {
+    server.begin();
+    server.setNoDelay(true);
+}
+
+void WebServer::begin(uint16_t port) {
+    server.begin(port);
+    server.setNoDelay(true);
+}
+
+void WebServer::stop() {
+    currentClient.stop();
+    server.end();
+}
+
+void WebServer::on(const String& uri, HTTPMethod method, THandlerFunction handler, THandlerFunction upload) {
+    routes.push_back({uri, method, handler, upload});
+}
+
+// Only these headers are kept, as in the core, plus the two it always keeps
+void WebServer::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+    collected.clear();
+    collected.push_back({"Content-Type", ""});
+    collected.push_back({"Content-Length", ""});
+    for (size_t i = 0; i < headerKeysCount; i++) {
+        collected.push_back({headerKeys[i], ""});
+    }
+}
+
+String WebServer::arg(const String& name) {
+    for (const Pair& pair : arguments) {
+        if (pair.name == name) {
+            return pair.value;
+        }
+    }
+    return String();
+}
+
+String WebServer::arg(int index) {
+    return index >= 0 && index < args() ? arguments[index].value : String();
+}
+
+String WebServer::argName(int index) {
+    return index >= 0 && index < args() ? arguments[index].name : String();
+}
+
+bool WebServer::hasArg(const String& name) {
+    for (const Pair& pair : arguments) {
+        if (pair.name == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+String WebServer::header(const String& name) {
+    for (const Pair& pair : collected) {
+        if (pair.name.equalsIgnoreCase(name)) {
+            return pair.value;
+        }
+    }
+    return String();
+}
+
+String WebServer::header(int index) {
+    return index >= 0 && index < headers() ? collected[index].value : String();
+}
+
+String WebServer::headerName(int index) {
+    return index >= 0 && index < headers() ? collected[index].name : String();
+}
+
+bool WebServer::hasHeader(const String& name) {
+    return header(name).length() > 0;
+}
+
+void WebServer::handleClient() {
+    currentClient = server.available();
+    if (!currentClient) {
+        return;
+    }
+    responseHeaders = String();
+    contentLength = CONTENT_LENGTH_NOT_SET;
+    chunked = false;
+    headersSent = false;
+    if (parseRequest() && currentClient.connected()) {
+        const Route* route = findRoute();
+        if (route) {
+            route->handler();
+        } else if (notFound) {
+            notFound();
+        } else {
+            send(404, "text/plain", String("Not found: ") + currentUri);
+        }
+        finishChunked();
+    }
+    currentClient.stop();
+}
+
+bool WebServer::readLine(String& line) {
+    line = String();
+    for (;;) {
+        int c = readByte(currentClient);
+        if (c < 0) {
+            return false;
+        }
+        if (c == '\n') {
+            break;
+        }
+        if (c != '\r') {
+            line += (char)c;
+        }
+    }
+    return true;
+}
+
+static String urlDecode(const String& text) {
+    String decoded;
+    for (unsigned int i = 0; i < text.length(); i++) {
+        char c = text[i];
+        if (c == '+') {
+            decoded += ' ';
+        } else if (c == '%' && i + 2 < text.length()) {
+            char hex[3] = {text[i + 1], text[i + 2], 0};
+            decoded += (char)strtol(hex, nullptr, 16);
+            i += 2;
+        } else {
+            decoded += c;
+        }
+    }
+    return decoded;
+}
+
+void WebServer::parseArguments(const String& query) {
+    int start = 0;
+    while (start < (int)query.length()) {
+        int end = query.indexOf('&', start);
+        if (end < 0) {
+            end = query.length();
+        }
+        String pair = query.substring(start, end);
+        int equals = pair.indexOf('=');
+        if (pair.length() > 0) {
+            if (equals < 0) {
+                arguments.push_back({urlDecode(pair), String()});
+            } else {
+                arguments.push_back({urlDecode(pair.substring(0, equals)), urlDecode(pair.substring(equals + 1))});
+            }
+        }
+        start = end + 1;
+    }
+}
+
+bool WebServer::parseRequest() {
+    String line;
+    if (!readLine(line)) {
+        return false;
+    }
+    int first = line.indexOf(' ');
+    int second = line.indexOf(' ', first + 1);
+    if (first < 0 || second < 0) {
+        return false;
+    }
+    String method = line.substring(0, first);
+    String url = line.substring(first + 1, second);
+    currentMethod = method == "GET" ? HTTP_GET : method == "POST" ? HTTP_POST : method == "PUT" ? HTTP_PUT
+                  : method == "HEAD" ? HTTP_HEAD : method == "DELETE" ? HTTP_DELETE
+                  : method == "PATCH" ? HTTP_PATCH : method == "OPTIONS" ? HTTP_OPTIONS : HTTP_ANY;
+    arguments.clear();
+    int query = url.indexOf('?');
+    currentUri = query < 0 ? url : url.substring(0, query);
+    if (query >= 0) {
+        parseArguments(url.substring(query + 1));
+    }
+
+    for (Pair& pair : collected) {
+        pair.value = String();
+    }
+    if (collected.empty()) {
+        collectHeaders(nullptr, 0);
+    }
+    for (;;) {
+        if (!readLine(line)) {
+            return false;
+        }
+        if (line.length() == 0) {
+            break;
+        }
+        int colon = line.indexOf(':');
+        if (colon < 0) {
+            continue;
+        }
+        String name = line.substring(0, colon);
+        String value = line.substring(colon + 1);
+        value.trim();
+        for (Pair& pair : collected) {
+            if (pair.name.equalsIgnoreCase(name)) {
+                pair.value = value;
+            }
+        }
+    }
+
+    const Route* route = findRoute();
+    if (!route || (currentMethod != HTTP_POST && currentMethod != HTTP_PUT && currentMethod != HTTP_PATCH)) {
+        return true;
+    }
+    String type = header("Content-Type");
+    size_t length = header("Content-Length").toInt();
+    if (type.startsWith("multipart/")) {
+        int at = type.indexOf("boundary=");
+        if (at < 0) {
+            return false;
+        }
+        String boundary = type.substring(at + 9);
+        if (boundary.startsWith("\"") && boundary.endsWith("\"")) {
+            boundary = boundary.substring(1, boundary.length() - 1);
+        }
+        readMultipartBody(*route, boundary);
+        return true;
+    }
+    if (route->upload && !type.startsWith("application/x-www-form-urlencoded")) {
+        readRawBody(*route, length);
+        return true;
+    }
+    // A small body, kept whole: form fields become arguments, anything
+    // else is the "plain" argument
+    String body;
+    for (size_t i = 0; i < length; i++) {
+        int c = readByte(currentClient);
+        if (c < 0) {
+            return false;
+        }
+        body += (char)c;
+    }
+    if (type.startsWith("application/x-www-form-urlencoded")) {
+        parseArguments(body);
+    } else {
+        arguments.push_back({"plain", body});
+    }
+    return true;
+}
+
+const WebServer::Route* WebServer::findRoute() {
+    for (const Route& route : routes) {
+        if (route.uri == currentUri && (route.method == HTTP_ANY || route.method == currentMethod)) {
+            return &route;
+        }
+    }
+    return nullptr;
+}
+
+// RAW_START, RAW_WRITE per piece, RAW_END. A handler that reads the body
+// itself at RAW_START sets totalSize to the length, and the loop ends.
+void WebServer::readRawBody(const Route& route, size_t length) {
+    currentRaw.status = RAW_START;
+    currentRaw.totalSize = 0;
+    currentRaw.currentSize = 0;
+    route.upload();
+    currentRaw.status = RAW_WRITE;
+    while (currentRaw.totalSize < length) {
+        size_t want = std::min(length - currentRaw.totalSize, (size_t)HTTP_RAW_BUFLEN);
+        size_t got = 0;
+        while (got < want) {
+            int c = readByte(currentClient);
+            if (c < 0) {
+                currentRaw.status = RAW_ABORTED;
+                currentRaw.currentSize = 0;
+                route.upload();
+                return;
+            }
+            currentRaw.buf[got++] = (uint8_t)c;
+        }
+        currentRaw.currentSize = got;
+        currentRaw.totalSize += got;
+        route.upload();
+    }
+    currentRaw.status = RAW_END;
+    currentRaw.currentSize = 0;
+    route.upload();
+}
+
+static String partField(const String& disposition, const String& field) {
+    int at = disposition.indexOf(field + "=\"");
+    if (at < 0) {
+        return String();
+    }
+    int start = at + field.length() + 2;
+    int end = disposition.indexOf('"', start);
+    return end < 0 ? String() : disposition.substring(start, end);
+}
+
+// Each part: headers, then data up to CRLF--boundary. Files go to the
+// upload handler in HTTP_UPLOAD_BUFLEN pieces, fields become arguments.
+void WebServer::readMultipartBody(const Route& route, const String& boundary) {
+    String line;
+    String delimiter = String("\r\n--") + boundary;
+    // The first delimiter has no CRLF in front of it
+    do {
+        if (!readLine(line)) {
+            return;
+        }
+    } while (line != String("--") + boundary);
+
+    for (;;) {
+        String disposition;
+        String type;
+        for (;;) {
+            if (!readLine(line)) {
+                return;
+            }
+            if (line.length() == 0) {
+                break;
+            }
+            int colon = line.indexOf(':');
+            String name = line.substring(0, colon);
+            String value = line.substring(colon + 1);
+            value.trim();
+            if (name.equalsIgnoreCase("Content-Disposition")) {
+                disposition = value;
+            } else if (name.equalsIgnoreCase("Content-Type")) {
+                type = value;
+            }
+        }
+        String name = partField(disposition, "name");
+        String filename = partField(disposition, "filename");
+        bool isFile = disposition.indexOf("filename=") >= 0 && route.upload;
+
+        if (isFile) {
+            currentUpload.status = UPLOAD_FILE_START;
+            currentUpload.name = name;
+            currentUpload.filename = filename;
+            currentUpload.type = type;
+            currentUpload.totalSize = 0;
+            currentUpload.currentSize = 0;
+            route.upload();
+            currentUpload.status = UPLOAD_FILE_WRITE;
+        }
+
+        // Bytes that might start the delimiter are held back until they
+        // turn out not to
+        String value;
+        std::string held;
+        for (;;) {
+            int c = readByte(currentClient);
+            if (c < 0) {
+                if (isFile) {
+                    currentUpload.status = UPLOAD_FILE_ABORTED;
+                    route.upload();
+                }
+                return;
+            }
+            held += (char)c;
+            if (delimiter.startsWith(String(held))) {
+                if (held.size() == delimiter.length()) {
+                    break;
+                }
+                continue;
+            }
+            // Not the delimiter: the first held byte is data, the rest may
+            // still start it
+            size_t keep = 1;
+            while (keep < held.size() && !delimiter.startsWith(String(held.substr(keep)))) {
+                keep++;
+            }
+            for (size_t i = 0; i < keep; i++) {
+                if (!isFile) {
+                    value += held[i];
+                    continue;
+                }
+                currentUpload.buf[currentUpload.currentSize++] = (uint8_t)held[i];
+                currentUpload.totalSize++;
+                if (currentUpload.currentSize == HTTP_UPLOAD_BUFLEN) {
+                    route.upload();
+                    currentUpload.currentSize = 0;
+                }
+            }
+            held.erase(0, keep);
+        }
+
+        if (isFile) {
+            if (currentUpload.currentSize > 0) {
+                route.upload();
+                currentUpload.currentSize = 0;
+            }
+            currentUpload.status = UPLOAD_FILE_END;
+            route.upload();
+        } else {
+            arguments.push_back({name, value});
+        }
+
+        // "--" closes the body, CRLF opens the next part
+        int a = readByte(currentClient);
+        int b = readByte(currentClient);
+        if (a == '-' && b == '-') {
+            readLine(line);
+            return;
+        }
+        if (a != '\r' || b != '\n') {
+            return;
+        }
+    }
+}
+
+static const char* statusText(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 409: return "Conflict";
+        case 413: return "Payload Too Large";
+        case 416: return "Range Not Satisfiable";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default: return "";
+    }
+}
+
+void WebServer::sendHeader(const String& name, const String& value, bool first) {
+    String line = name + ": " + value + "\r\n";
+    responseHeaders = first ? line + responseHeaders : responseHeaders + line;
+}
+
+void WebServer::sendHead(int code, const char* contentType, size_t length) {
+    String head = String("HTTP/1.1 ") + String(code) + " " + statusText(code) + "\r\n";
+    if (contentType && *contentType) {
+        head += String("Content-Type: ") + contentType + "\r\n";
+    }
+    if (contentLength != CONTENT_LENGTH_NOT_SET) {
+        length = contentLength;
+    }
+    if (length == CONTENT_LENGTH_UNKNOWN) {
+        chunked = true;
+        head += "Transfer-Encoding: chunked\r\n";
+    } else {
+        head += String("Content-Length: ") + String((unsigned long)length) + "\r\n";
+    }
+    if (responseHeaders.indexOf("Connection:") < 0) {
+        head += "Connection: close\r\n";
+    }
+    head += responseHeaders;
+    head += "\r\n";
+    currentClient.write((const uint8_t*)head.c_str(), head.length());
+    responseHeaders = String();
+    headersSent = true;
+}
+
+void WebServer::send(int code, const char* contentType, const String& content) {
+    sendHead(code, contentType, content.length());
+    if (content.length() > 0) {
+        sendContent(content);
+    }
+}
+
+void WebServer::send_P(int code, PGM_P contentType, PGM_P content) {
+    send_P(code, contentType, content, strlen(content));
+}
+
+void WebServer::send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength) {
+    sendHead(code, contentType, contentLength);
+    sendContent(content, contentLength);
+}
+
+void WebServer::sendContent(const char* content, size_t size) {
+    if (!chunked) {
+        currentClient.write((const uint8_t*)content, size);
+        return;
+    }
+    if (size == 0) {
+        return;
+    }
+    char head[24];
+    snprintf(head, sizeof(head), "%zx\r\n", size);
+    currentClient.write((const uint8_t*)head, strlen(head));
+    currentClient.write((const uint8_t*)content, size);
+    currentClient.write((const uint8_t*)"\r\n", 2);
+}
+
+void WebServer::finishChunked() {
+    if (chunked && headersSent) {
+        currentClient.write((const uint8_t*)"0\r\n\r\n", 5);
+    }
+    chunked = false;
+}
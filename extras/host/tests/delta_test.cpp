@@ -0,0 +1,247 @@
+// delta_test.cpp - Delta updates through the push pipeline on the host HAL
+//
+// The source of a delta update is the running image, app0 of the simulated
+// flash. The test derives a new image from it, sends a detools sequential
+// patch with PUSH_FLAG_DELTA and checks that app1 ends up byte for byte
+// equal to the new image. Without a patch file the patch is built here with
+// detools' layout: a LEB128 to_size, then diff, extra and adjustment sizes
+// as detools' signed varints, with diffs and adjustments big and negative
+// enough to need every varint length the library decodes.
+//
+//   delta_test [--port PORT]
+//   delta_test --write FROM TO             the two images, for detools
+//   delta_test --patch PATCH --to TO [--port PORT]
+//
+// See detools_delta.py for the round trip through detools itself.
+#include <AViShaOTA.h>
+#include <MD5Builder.h>
+#include <esp_ota_ops.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "push_client.h"
+#include "sim.h"
+
+typedef std::vector<uint8_t> Bytes;
+
+#define SOURCE_SIZE (256 * 1024)
+
+// detools pack_usize(): 7 bits per byte, low bits first
+static void packUnsigned(Bytes& out, uint64_t value) {
+    while (value > 0x7F) {
+        out.push_back(0x80 | (value & 0x7F));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+// detools pack_size(): sign in bit 6 and 6 value bits in the first byte,
+// then 7 bits per byte
+static void packSigned(Bytes& out, int64_t value) {
+    uint64_t magnitude = value < 0 ? -value : value;
+    out.push_back((value < 0 ? 0x40 : 0) | (magnitude & 0x3F));
+    magnitude >>= 6;
+    while (magnitude > 0) {
+        out.back() |= 0x80;
+        out.push_back(magnitude & 0x7F);
+        magnitude >>= 7;
+    }
+}
+
+static Bytes readSource() {
+    Bytes source(SOURCE_SIZE);
+    esp_partition_read(esp_ota_get_running_partition(), 0, source.data(), source.size());
+    return source;
+}
+
+// Builds the new image from the source and the patch between them in one
+// pass: each step copies a stretch of the source with some bytes changed,
+// appends new bytes and then jumps forward or back in the source
+static void buildImages(const Bytes& source, Bytes& image, Bytes& patch) {
+    uint32_t seed = 0xD317A5;
+    auto next = [&seed]() {
+        seed = seed * 1664525 + 1013904223;
+        return seed >> 8;
+    };
+    // diff, extra, adjustment: 1 to 3 byte varints, both signs, zero sizes
+    static const int64_t steps[][3] = {
+        {70000, 40, -50000},
+        {300, 0, 12},
+        {0, 5000, 0},
+        {1, 1, -1},
+        {63, 64, 8191},
+        {8192, 63, -8192},
+        {40000, 200, -60000},
+        {2000, 1, 0},
+    };
+    Bytes body;
+    int64_t fromPos = 0;
+    for (const auto& step : steps) {
+        int64_t diff = step[0];
+        int64_t extra = step[1];
+        packSigned(body, diff);
+        for (int64_t i = 0; i < diff; i++) {
+            uint8_t delta = next() % 16 == 0 ? (uint8_t)next() : 0;
+            image.push_back(source[fromPos + i] + delta);
+            body.push_back(delta);
+        }
+        fromPos += diff;
+        packSigned(body, extra);
+        for (int64_t i = 0; i < extra; i++) {
+            uint8_t byte = (uint8_t)next();
+            image.push_back(byte);
+            body.push_back(byte);
+        }
+        fromPos += step[2];
+        packSigned(body, step[2]);
+    }
+    image[0] = source[0];  // ESP_IMAGE_HEADER_MAGIC
+
+    // Header: sequential patch type, no compression
+    patch.push_back(0x00);
+    packUnsigned(patch, image.size());
+    patch.insert(patch.end(), body.begin(), body.end());
+}
+
+static bool readFile(const char* path, Bytes& data) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+        data.insert(data.end(), buffer, buffer + n);
+    }
+    fclose(f);
+    return true;
+}
+
+static bool writeFile(const char* path, const Bytes& data) {
+    FILE* f = fopen(path, "wb");
+    if (!f || fwrite(data.data(), 1, data.size(), f) != data.size()) {
+        perror(path);
+        if (f) {
+            fclose(f);
+        }
+        return false;
+    }
+    return fclose(f) == 0;
+}
+
+// Pushes the patch to a fresh device and compares app1 with the image
+static bool applyPatch(const Bytes& patch, const Bytes& image, uint16_t port) {
+    sim::resetFlash();
+    std::atomic<bool> restarted(false);
+    sim::onRestart([&restarted]() { restarted = true; });
+
+    uint8_t md5[16];
+    MD5Builder builder;
+    builder.begin();
+    for (size_t offset = 0; offset < image.size(); offset += 4096) {
+        builder.add(image.data() + offset, (uint16_t)std::min<size_t>(4096, image.size() - offset));
+    }
+    builder.calculate();
+    builder.getBytes(md5);
+    uint8_t sha256[32];
+    mbedtls_sha256(image.data(), image.size(), sha256, 0);
+
+    AViShaOTA* ota = new AViShaOTA("avisha-delta", port);
+    ota->setLogLevel(AViShaOTALog::LEVEL_WARN);
+    ota->enableMDNS(false);
+    ota->enablePushServer(true, port + 1);
+    if (!ota->begin("sim", "")) {
+        printf("FAILED: begin() failed\n");
+        delete ota;
+        return false;
+    }
+
+    PushResult result;
+    PushPayload payload = {patch.data(), patch.size(), PUSH_CLIENT_DELTA | PUSH_CLIENT_RAW, md5, sha256};
+    std::atomic<bool> clientDone(false);
+    std::thread client([&]() {
+        pushImage(port + 1, payload, 1460, result);
+        clientDone = true;
+    });
+    while (!clientDone || (result.ok && !restarted)) {
+        ota->handle();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    client.join();
+    delete ota;
+    sim::onRestart(nullptr);
+
+    if (!result.ok) {
+        printf("FAILED: %s\n", result.error.c_str());
+        return false;
+    }
+    const esp_partition_t* boot = esp_ota_get_boot_partition();
+    Bytes written(image.size());
+    if (!boot || strcmp(boot->label, "app1") != 0 ||
+        esp_partition_read(boot, 0, written.data(), written.size()) != ESP_OK) {
+        printf("FAILED: app1 is not the boot partition\n");
+        return false;
+    }
+    auto mismatch = std::mismatch(image.begin(), image.end(), written.begin());
+    if (mismatch.first != image.end()) {
+        printf("FAILED: app1 differs from the image at offset %u\n", (unsigned)(mismatch.first - image.begin()));
+        return false;
+    }
+    printf("ok: %u byte patch, %u byte image matches\n", (unsigned)patch.size(), (unsigned)image.size());
+    return true;
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: delta_test [--port PORT]\n"
+            "       delta_test --write FROM TO\n"
+            "       delta_test --patch PATCH --to TO [--port PORT]\n");
+}
+
+int main(int argc, char** argv) {
+    uint16_t port = 18350;
+    const char* patchPath = nullptr;
+    const char* imagePath = nullptr;
+    const char* writeFrom = nullptr;
+    const char* writeTo = nullptr;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--write" && i + 2 < argc) {
+            writeFrom = argv[++i];
+            writeTo = argv[++i];
+        } else if (arg == "--patch" && i + 1 < argc) {
+            patchPath = argv[++i];
+        } else if (arg == "--to" && i + 1 < argc) {
+            imagePath = argv[++i];
+        } else if (arg == "--port" && i + 1 < argc) {
+            port = (uint16_t)atoi(argv[++i]);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (!patchPath != !imagePath) {
+        usage();
+        return 2;
+    }
+
+    Bytes source = readSource();
+    Bytes image;
+    Bytes patch;
+    if (patchPath) {
+        if (!readFile(patchPath, patch) || !readFile(imagePath, image)) {
+            return 1;
+        }
+    } else {
+        buildImages(source, image, patch);
+    }
+    if (writeFrom) {
+        return writeFile(writeFrom, source) && writeFile(writeTo, image) ? 0 : 1;
+    }
+    return applyPatch(patch, image, port) ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+"""Round trip through detools: delta_test writes its source and new image,
+detools makes a sequential patch without compression (the layout
+AViShaOTADelta takes) and delta_test applies it.
+
+    python3 extras/host/tests/detools_delta.py build-host/delta_test
+"""
+
+import os
+import subprocess
+import sys
+import tempfile
+
+import detools
+
+
+def main():
+    delta_test = sys.argv[1]
+    extra = sys.argv[2:]
+    with tempfile.TemporaryDirectory() as tmp:
+        source = os.path.join(tmp, "from.bin")
+        image = os.path.join(tmp, "to.bin")
+        patch = os.path.join(tmp, "patch.bin")
+        subprocess.run([delta_test, "--write", source, image], check=True)
+        with open(source, "rb") as ffrom, open(image, "rb") as fto, open(patch, "wb") as fpatch:
+            detools.create_patch(ffrom, fto, fpatch, compression="none", patch_type="sequential")
+        return subprocess.run([delta_test, "--patch", patch, "--to", image] + extra).returncode
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""Latency of small requests while a firmware upload is running.
+
+Streams a firmware image to /update at a limited rate and, while it is in
+flight, keeps several clients polling / and /info and fires a second
+upload, which should be turned away with 409 right away.
+
+    python3 extras/http_load_test.py 192.168.1.50 firmware.bin
+    python3 extras/http_load_test.py 192.168.1.50 firmware.bin --clients 4 --rate 64
+    python3 extras/http_load_test.py 192.168.1.50 firmware.bin --rate 0 --raw
+
+Run it once against the default WebServer and once with
+enableAsyncServer(). With the blocking server the probes time out or wait
+for the whole upload. A successful upload restarts the device; use --abort
+to drop the connection at 90 % instead. --raw sends the image as an
+application/octet-stream body instead of a multipart form; compare the
+"Received as" line in the device log for both.
+"""
+
+import argparse
+import hashlib
+import hmac
+import http.client
+import threading
+import time
+import uuid
+
+BOUNDARY = "----avisha" + uuid.uuid4().hex
+
+
+# X-OTA-Auth: a single-use nonce from /auth and its HMAC-SHA256 under the password
+def auth_header(host, port, password):
+    conn = http.client.HTTPConnection(host, port, timeout=10)
+    conn.request("GET", "/auth")
+    nonce = conn.getresponse().read().decode()
+    conn.close()
+    return nonce + ":" + hmac.new(password.encode(), nonce.encode(), hashlib.sha256).hexdigest()
+
+
+def multipart_head(filename):
+    head = ("--%s\r\nContent-Disposition: form-data; name=\"firmware\"; filename=\"%s\"\r\n"
+             "Content-Type: application/octet-stream\r\n\r\n" % (BOUNDARY, filename)).encode()
+    return head
+
+
+def multipart_tail():
+    return ("\r\n--%s--\r\n" % BOUNDARY).encode()
+
+
+def upload(host, port, image, password, rate, abort, raw, started, result):
+    auth = auth_header(host, port, password) if password else None
+    conn = http.client.HTTPConnection(host, port, timeout=60)
+    conn.putrequest("POST", "/update")
+    if raw:
+        head, tail = b"", b""
+        conn.putheader("Content-Type", "application/octet-stream")
+    else:
+        head, tail = multipart_head("firmware.bin"), multipart_tail()
+        conn.putheader("Content-Type", "multipart/form-data; boundary=" + BOUNDARY)
+    if auth:
+        conn.putheader("X-OTA-Auth", auth)
+    conn.putheader("Content-Length", str(len(head) + len(image) + len(tail)))
+    conn.endheaders()
+    conn.send(head)
+
+    begin = time.monotonic()
+    chunk = 1436
+    sent = 0
+    stop_at = int(len(image) * 0.9) if abort else len(image)
+    while sent < stop_at:
+        piece = image[sent:min(sent + chunk, stop_at)]
+        conn.send(piece)
+        sent += len(piece)
+        if sent >= 64 * 1024:
+            started.set()
+        # Throttle so the upload stays active for the probes
+        if rate:
+            lag = sent / (rate * 1024.0) - (time.monotonic() - begin)
+            if lag > 0:
+                time.sleep(lag)
+    started.set()
+    if abort:
+        conn.close()
+        result["status"] = "aborted"
+    else:
+        conn.send(tail)
+        result["status"] = conn.getresponse().status
+    result["seconds"] = time.monotonic() - begin
+    result["bytes"] = sent
+
+
+def second_upload(host, port, image, password, result):
+    head, tail = multipart_head("second.bin"), multipart_tail()
+    conn = http.client.HTTPConnection(host, port, timeout=30)
+    begin = time.monotonic()
+    try:
+        auth = auth_header(host, port, password) if password else None
+        conn.putrequest("POST", "/update")
+        conn.putheader("Content-Type", "multipart/form-data; boundary=" + BOUNDARY)
+        if auth:
+            conn.putheader("X-OTA-Auth", auth)
+        conn.putheader("Content-Length", str(len(head) + len(image) + len(tail)))
+        conn.endheaders()
+        conn.send(head + image[:4096])
+        # The device answers without waiting for the rest of the body
+        result["status"] = conn.getresponse().status
+    except (OSError, http.client.HTTPException) as e:
+        result["status"] = type(e).__name__
+    result["ms"] = (time.monotonic() - begin) * 1000
+    conn.close()
+
+
+def probe(host, port, paths, done, samples, errors):
+    i = 0
+    while not done.is_set():
+        path = paths[i % len(paths)]
+        i += 1
+        begin = time.monotonic()
+        try:
+            conn = http.client.HTTPConnection(host, port, timeout=10)
+            conn.request("GET", path, headers={"Accept-Encoding": "gzip"})
+            conn.getresponse().read()
+            conn.close()
+            samples.append((path, (time.monotonic() - begin) * 1000))
+        except (OSError, http.client.HTTPException):
+            errors.append(path)
+        time.sleep(0.05)
+
+
+def percentile(values, p):
+    if not values:
+        return float("nan")
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * p / 100))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("host")
+    parser.add_argument("firmware")
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("--password", default="")
+    parser.add_argument("--clients", type=int, default=2, help="concurrent GET clients")
+    parser.add_argument("--rate", type=float, default=100, help="upload rate in KB/s, 0 = unlimited")
+    parser.add_argument("--abort", action="store_true", help="drop the upload at 90 %% instead of finishing it")
+    parser.add_argument("--raw", action="store_true", help="send an application/octet-stream body")
+    args = parser.parse_args()
+
+    with open(args.firmware, "rb") as f:
+        image = f.read()
+
+    started, done = threading.Event(), threading.Event()
+    upload_result, second_result = {}, {}
+    samples, errors = [], []
+
+    uploader = threading.Thread(target=upload, args=(args.host, args.port, image, args.password,
+                                                     args.rate, args.abort, args.raw, started,
+                                                     upload_result))
+    uploader.start()
+    started.wait()
+
+    probes = [threading.Thread(target=probe, args=(args.host, args.port, ["/", "/info"], done, samples, errors))
+              for _ in range(args.clients)]
+    for t in probes:
+        t.start()
+    second_upload(args.host, args.port, image, args.password, second_result)
+
+    uploader.join()
+    done.set()
+    for t in probes:
+        t.join()
+
+    print("upload:        %s, %d bytes in %.1f s (%.1f KB/s)" % (
+        upload_result.get("status"), upload_result.get("bytes", 0), upload_result.get("seconds", 0),
+        upload_result.get("bytes", 0) / 1024.0 / max(upload_result.get("seconds", 1), 1e-3)))
+    print("second upload: %s after %.0f ms" % (second_result.get("status"), second_result.get("ms", 0)))
+    for path in ("/", "/info"):
+        ms = [m for p, m in samples if p == path]
+        print("GET %-6s     %4d ok, %3d failed, p50 %6.1f ms, p95 %6.1f ms, max %6.1f ms" % (
+            path, len(ms), errors.count(path), percentile(ms, 50), percentile(ms, 95), max(ms or [0])))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""Serve a firmware image and its manifest for AViShaOTA pull mode.
+
+Writes manifest.json next to the image and serves the directory with
+ETag / If-None-Match support, so polling devices get 304 until the image
+changes. Point the device at it with:
+
+    ota.setFirmwareVersion("1.0.0");
+    ota.setPullURL("http://<host>:8000/manifest.json", 60000);
+
+    python3 extras/manifest_server.py firmware.bin 1.0.1 [--port 8000] [--encoding gzip]
+"""
+
+import argparse
+import hashlib
+import http.server
+import json
+import os
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("image")
+    parser.add_argument("version")
+    parser.add_argument("--port", type=int, default=8000)
+    parser.add_argument("--encoding", default="")
+    parser.add_argument("--delta", action="store_true")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+    directory = os.path.dirname(os.path.abspath(args.image))
+    manifest = {
+        "version": args.version,
+        "url": os.path.basename(args.image),
+        "size": len(image),
+        "sha256": hashlib.sha256(image).hexdigest(),
+    }
+    if not args.encoding and not args.delta:
+        # md5 lets devices without a version string skip the image they run
+        manifest["md5"] = hashlib.md5(image).hexdigest()
+    if args.encoding:
+        manifest["encoding"] = args.encoding
+    if args.delta:
+        manifest["delta"] = True
+    with open(os.path.join(directory, "manifest.json"), "w") as f:
+        json.dump(manifest, f)
+
+    class Handler(http.server.SimpleHTTPRequestHandler):
+        def __init__(self, *a, **kw):
+            super().__init__(*a, directory=directory, **kw)
+
+        def send_head(self):
+            path = self.translate_path(self.path)
+            if os.path.isfile(path):
+                with open(path, "rb") as f:
+                    etag = '"%s"' % hashlib.sha256(f.read()).hexdigest()[:16]
+                if self.headers.get("If-None-Match") == etag:
+                    self.send_response(304)
+                    self.send_header("ETag", etag)
+                    self.end_headers()
+                    return None
+                self.etag = etag
+            return super().send_head()
+
+        def end_headers(self):
+            if getattr(self, "etag", None):
+                self.send_header("ETag", self.etag)
+                self.etag = None
+            super().end_headers()
+
+    print("manifest: %s" % json.dumps(manifest))
+    http.server.ThreadingHTTPServer(("", args.port), Handler).serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Simulate a fleet rollout: one-by-one uploads versus peer sharing.
+
+Every node is emulated as a small state machine (waiting, receiving,
+rebooting, updated). Transfers share the access point's airtime; a
+device-to-device transfer crosses the air twice (up to the AP and back
+down). A device serves one peer at a time, like the synchronous web server,
+and looks for peers every --interval seconds with a random phase.
+
+    python3 extras/peer_rollout_sim.py --nodes 10 25 50
+
+Star: the laptop uploads to each device in turn, as in
+examples/Multiple_Device_Management. Tree: the laptop updates one device,
+then every updated device serves the image to the next one.
+"""
+
+import argparse
+import random
+
+
+class Node:
+    def __init__(self, name):
+        self.name = name
+        self.state = "waiting"
+        self.remaining = 0.0
+        self.source = None
+        self.busy = False       # Serving a peer
+        self.next_check = 0.0
+        self.done_at = None
+
+
+def run(nodes, args, tree, seed):
+    rng = random.Random(seed)
+    image = args.image_kb * 1024.0
+    device_rate = args.device_kbps * 1024.0
+    airtime = args.ap_mbps * 1e6 / 8
+    laptop = Node("laptop")
+    laptop.state = "updated"
+    fleet = [Node("node%02d" % i) for i in range(nodes)]
+    for node in fleet:
+        node.next_check = rng.uniform(0, args.interval) if tree else 0.0
+
+    now = 0.0
+    dt = 0.05
+    queue = list(fleet)
+    while any(n.state != "updated" for n in fleet):
+        # Start new transfers
+        if tree:
+            sources = [laptop] + [n for n in fleet if n.state == "updated"]
+            for node in fleet:
+                if node.state != "waiting" or now < node.next_check:
+                    continue
+                node.next_check = now + args.interval
+                idle = [s for s in sources if not s.busy]
+                if idle:
+                    source = rng.choice(idle)
+                    source.busy = True
+                    node.source = source
+                    node.state = "receiving"
+                    node.remaining = image
+        elif not laptop.busy and queue and now >= laptop.next_check:
+            node = queue.pop(0)
+            laptop.busy = True
+            node.source = laptop
+            node.state = "receiving"
+            node.remaining = image
+
+        # Airtime is split evenly per hop, a relayed transfer uses two
+        active = [n for n in fleet if n.state == "receiving"]
+        hops = sum(1 if n.source is laptop else 2 for n in active)
+        share = airtime / hops if hops else 0
+        for node in active:
+            node.remaining -= min(device_rate, share) * dt
+            if node.remaining <= 0:
+                node.source.busy = False
+                if node.source is laptop:
+                    laptop.next_check = now + args.operator_s  # Operator moves to the next device
+                node.source = None
+                node.state = "rebooting"
+                node.remaining = args.reboot_s
+
+        for node in fleet:
+            if node.state == "rebooting":
+                node.remaining -= dt
+                if node.remaining <= 0:
+                    node.state = "updated"
+                    node.done_at = now
+                    node.next_check = now
+        now += dt
+    return now
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--nodes", type=int, nargs="+", default=[5, 10, 25, 50])
+    parser.add_argument("--image-kb", type=float, default=1400)
+    parser.add_argument("--device-kbps", type=float, default=120, help="per-device OTA throughput")
+    parser.add_argument("--ap-mbps", type=float, default=20, help="usable access point airtime")
+    parser.add_argument("--reboot-s", type=float, default=4)
+    parser.add_argument("--interval", type=float, default=30, help="peer check interval")
+    parser.add_argument("--operator-s", type=float, default=5, help="star: time to start each upload")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    print("%6s %12s %12s %8s" % ("nodes", "star (s)", "tree (s)", "speedup"))
+    for nodes in args.nodes:
+        star = run(nodes, args, False, args.seed)
+        tree = run(nodes, args, True, args.seed)
+        print("%6d %12.0f %12.0f %7.1fx" % (nodes, star, tree, star / tree))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+"""Push firmware to AViShaOTA over its native TCP protocol.
+
+The device must call enablePushServer(). The image goes out as one stream
+behind a small binary header; the device answers only before and after
+it, so throughput is bounded by TCP and the flash, not by round trips.
+
+    python3 extras/push_upload.py 192.168.1.50 firmware.bin
+    python3 extras/push_upload.py 192.168.1.50 firmware.bin.gz --password secret
+    python3 extras/push_upload.py 192.168.1.50 patch.bin --delta --md5 <md5 of the new image>
+
+Benchmark against ArduinoOTA: upload the same image the given number of
+times with each method and compare throughput and total update time,
+from connect until the device is reachable again after its restart.
+Point --espota at espota.py from the arduino-esp32 tools directory.
+
+    python3 extras/push_upload.py 192.168.1.50 firmware.bin --benchmark 3 --espota path/to/espota.py
+"""
+
+import argparse
+import gzip
+import hashlib
+import hmac
+import socket
+import struct
+import subprocess
+import sys
+import time
+
+PORT = 3233             # AVISHA_OTA_PUSH_PORT
+ARDUINO_OTA_PORT = 3232
+SIGNATURE_SIZE = 64     # AVISHA_OTA_SIGNATURE_SIZE
+
+FLAG_DELTA = 0x01
+FLAG_RAW = 0x02
+
+# PushHeader and PushStatus in AViShaOTAPush.cpp
+HEADER = struct.Struct("<4sBBHI16s32s")
+STATUS = struct.Struct("<B3xI")
+CODES = ["ready", "ok", "authentication failed", "busy", "bad header", "image too large",
+         "update could not start", "transfer incomplete", "image rejected"]
+
+
+class PushError(Exception):
+    pass
+
+
+def recv_exactly(sock, size):
+    data = b""
+    while len(data) < size:
+        chunk = sock.recv(size - len(data))
+        if not chunk:
+            raise PushError("connection closed by the device")
+        data += chunk
+    return data
+
+
+def read_status(sock, start=b""):
+    code, value = STATUS.unpack(start + recv_exactly(sock, STATUS.size - len(start)))
+    return code, value
+
+
+def status_error(code):
+    return PushError(CODES[code] if code < len(CODES) else "error %d" % code)
+
+
+def image_digest(image, args):
+    """SHA-256 the device computes: over the decoded image, without a signature."""
+    if args.sha256:
+        return bytes.fromhex(args.sha256)
+    if args.delta:
+        return b""
+    data = image[:-SIGNATURE_SIZE] if args.signed else image
+    if data[:2] == b"\x1f\x8b" and not args.raw:
+        data = gzip.decompress(data)
+    return hashlib.sha256(data).digest()
+
+
+def push(host, image, args):
+    """Uploads one image, returns (transfer seconds, total seconds)."""
+    flags = (FLAG_DELTA if args.delta else 0) | (FLAG_RAW if args.raw else 0)
+    md5 = bytes.fromhex(args.md5) if args.md5 else b""
+    sha256 = image_digest(image, args)
+
+    begin = time.monotonic()
+    sock = socket.create_connection((host, args.port), timeout=args.timeout)
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    try:
+        # The device only hands out a nonce for a header it accepts
+        sock.sendall(HEADER.pack(b"AVPU", 2, flags, 0, len(image), md5, sha256))
+        hello = recv_exactly(sock, 4)
+        if hello != b"AVP2":
+            code, _ = read_status(sock, hello)
+            raise status_error(code)
+        nonce = recv_exactly(sock, 32)
+        mac = hmac.new(args.password.encode(), nonce, hashlib.sha256).digest() if args.password else bytes(32)
+
+        sock.sendall(mac)
+        code, buffer_size = read_status(sock)
+        if code != 0:
+            raise status_error(code)
+
+        transfer = time.monotonic()
+        sent = 0
+        chunk = args.chunk
+        while sent < len(image):
+            sock.sendall(image[sent:sent + chunk])
+            sent = min(sent + chunk, len(image))
+            if not args.quiet:
+                sys.stderr.write("\r%3d %%  %d / %d bytes" % (sent * 100 // len(image), sent, len(image)))
+        if not args.quiet:
+            sys.stderr.write("\n")
+
+        # Flashing and verifying the tail still takes a moment
+        sock.settimeout(max(args.timeout, 30))
+        code, received = read_status(sock)
+        transfer = time.monotonic() - transfer
+        if code != 1:
+            raise PushError("%s after %d bytes" % (CODES[code] if code < len(CODES) else "error %d" % code,
+                                                   received))
+    finally:
+        sock.close()
+    return transfer, time.monotonic() - begin
+
+
+def wait_for_device(host, port, timeout):
+    """Seconds until the port accepts connections again after a restart."""
+    begin = time.monotonic()
+    time.sleep(1)
+    while time.monotonic() - begin < timeout:
+        try:
+            socket.create_connection((host, port), timeout=1).close()
+            return time.monotonic() - begin
+        except OSError:
+            time.sleep(0.2)
+    raise PushError("device did not come back within %d s" % timeout)
+
+
+def espota(host, firmware, args):
+    """Uploads with espota.py, returns its run time in seconds."""
+    command = [sys.executable, args.espota, "-i", host, "-p", str(ARDUINO_OTA_PORT), "-f", firmware]
+    if args.password:
+        command += ["-a", args.password]
+    begin = time.monotonic()
+    result = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+    if result.returncode != 0:
+        raise PushError("espota.py failed: %s" % result.stderr.decode().strip().splitlines()[-1:])
+    return time.monotonic() - begin
+
+
+def benchmark(host, firmware, image, args):
+    size_kb = len(image) / 1024.0
+    results = {"push": [], "espota": []}
+    for i in range(args.benchmark):
+        transfer, total = push(host, image, args)
+        back = wait_for_device(host, args.port, args.reboot_timeout)
+        results["push"].append((size_kb / transfer, total + back))
+        print("push   run %d: %7.1f KB/s, update %5.1f s, back after %4.1f s" % (i + 1, size_kb / transfer,
+                                                                                  total, back))
+        if args.espota:
+            total = espota(host, firmware, args)
+            back = wait_for_device(host, args.port, args.reboot_timeout)
+            results["espota"].append((size_kb / total, total + back))
+            print("espota run %d: %7.1f KB/s, update %5.1f s, back after %4.1f s" % (i + 1, size_kb / total,
+                                                                                     total, back))
+
+    print("\n%d bytes, %d runs each, medians:" % (len(image), args.benchmark))
+    for name, runs in results.items():
+        if runs:
+            rates = sorted(r for r, _ in runs)
+            totals = sorted(t for _, t in runs)
+            print("  %-6s %7.1f KB/s, %5.1f s until running the new image" % (
+                name, rates[len(rates) // 2], totals[len(totals) // 2]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("host")
+    parser.add_argument("firmware")
+    parser.add_argument("--port", type=int, default=PORT)
+    parser.add_argument("--password", default="")
+    parser.add_argument("--delta", action="store_true", help="image is a patch against the running app")
+    parser.add_argument("--md5", help="MD5 of the resulting image, required with --delta")
+    parser.add_argument("--sha256", help="SHA-256 of the resulting image, computed from the file by default")
+    parser.add_argument("--signed", action="store_true", help="file ends in a signature from sign_firmware.py")
+    parser.add_argument("--raw", action="store_true", help="write the file as is, no codec detection")
+    parser.add_argument("--chunk", type=int, default=64 * 1024, help="bytes per send() call")
+    parser.add_argument("--timeout", type=float, default=10)
+    parser.add_argument("--quiet", action="store_true")
+    parser.add_argument("--benchmark", type=int, default=0, metavar="RUNS",
+                        help="upload RUNS times and report medians")
+    parser.add_argument("--espota", help="espota.py to benchmark ArduinoOTA against")
+    parser.add_argument("--reboot-timeout", type=float, default=60)
+    args = parser.parse_args()
+
+    if args.delta and not args.md5:
+        parser.error("--delta needs --md5 of the resulting image")
+
+    with open(args.firmware, "rb") as f:
+        image = f.read()
+
+    try:
+        if args.benchmark:
+            args.quiet = True
+            benchmark(args.host, args.firmware, image, args)
+        else:
+            transfer, total = push(args.host, image, args)
+            print("%d bytes in %.1f s (%.1f KB/s), %.1f s in total, device restarting" % (
+                len(image), transfer, len(image) / 1024.0 / transfer, total))
+    except (OSError, PushError) as e:
+        sys.exit("push failed: %s" % e)
+
+
+if __name__ == "__main__":
+    main()
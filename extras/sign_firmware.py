@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+"""Append an ECDSA P-256 signature to a firmware image for AViShaOTA.
+
+The device hashes the image with SHA-256 while it streams to flash and
+checks the 64-byte raw r||s signature found at the end of the upload
+against the public key given in Config::signingKey.
+
+    openssl ecparam -name prime256v1 -genkey -noout -out signing_key.pem
+    openssl ec -in signing_key.pem -pubout -out signing_pub.pem
+    python3 extras/sign_firmware.py signing_key.pem firmware.bin firmware.signed.bin
+
+Requires the "cryptography" package.
+"""
+
+import sys
+
+from cryptography.hazmat.primitives import hashes, serialization
+from cryptography.hazmat.primitives.asymmetric import ec
+from cryptography.hazmat.primitives.asymmetric.utils import decode_dss_signature
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.exit("usage: sign_firmware.py <private_key.pem> <firmware.bin> <output.bin>")
+
+    with open(sys.argv[1], "rb") as f:
+        key = serialization.load_pem_private_key(f.read(), password=None)
+    if not isinstance(key, ec.EllipticCurvePrivateKey) or key.curve.name != "secp256r1":
+        sys.exit("signing key must be an ECDSA P-256 private key")
+
+    with open(sys.argv[2], "rb") as f:
+        image = f.read()
+
+    r, s = decode_dss_signature(key.sign(image, ec.ECDSA(hashes.SHA256())))
+    with open(sys.argv[3], "wb") as f:
+        f.write(image + r.to_bytes(32, "big") + s.to_bytes(32, "big"))
+
+    print("%s: %d bytes + 64 byte signature" % (sys.argv[3], len(image)))
+
+
+if __name__ == "__main__":
+    main()
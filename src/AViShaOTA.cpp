@@ -1,9 +1,183 @@
-// AViShaOTA.cpp - Fixed Password Validation
+// AViShaOTA.cpp - WiFi and service setup, upload routes and the update pipeline
 #include "AViShaOTA.h"
+#include "AViShaOTAGzip.h"
+#include "AViShaOTADelta.h"
+#include "AViShaOTAWriter.h"
+#include "AViShaOTAUI.h"
+#include <WebServer.h>
+#include <esp_system.h>
+#include <esp_ota_ops.h>
+#include <Preferences.h>
+#include <HTTPClient.h>
+#include <StreamString.h>
+#include <lwip/sockets.h>
+#include <mbedtls/md.h>
+#include <mbedtls/ecdsa.h>
+#if __has_include("esp32/rom/crc.h")
+#include "esp32/rom/crc.h"
+#else
+#include "rom/crc.h"
+#endif
+
+// Strong validator for the upload page, changes with the library or the page
+#define AVISHA_OTA_UI_ETAG "\"" AVISHA_OTA_VERSION "-" AVISHA_OTA_UI_HASH "\""
+
+// Buffers Print output and sends it as HTTP chunks, so large responses are
+// streamed instead of built in a String. Send headers with
+// CONTENT_LENGTH_UNKNOWN first and finish with sendContent("").
+class ChunkedResponse : public Print {
+public:
+  explicit ChunkedResponse(WebServer* server) : server(server), len(0) {}
+  ~ChunkedResponse() { send(); }
+
+  size_t write(uint8_t c) override {
+    if (len == sizeof(buffer)) {
+      send();
+    }
+    buffer[len++] = c;
+    return 1;
+  }
+
+  size_t write(const uint8_t* data, size_t size) override {
+    for (size_t done = 0; done < size; ) {
+      if (len == sizeof(buffer)) {
+        send();
+      }
+      size_t n = min(size - done, sizeof(buffer) - len);
+      memcpy(buffer + len, data + done, n);
+      len += n;
+      done += n;
+    }
+    return size;
+  }
+
+  void send() {
+    if (len > 0) {
+      server->sendContent_P((const char*)buffer, len);
+      len = 0;
+    }
+  }
+
+private:
+  WebServer* server;
+  uint8_t buffer[512];
+  size_t len;
+};
+
+// Info page, renders the JSON from /info
+static const char AVISHA_OTA_INFO_HTML[] PROGMEM = R"rawliteral(<!DOCTYPE html>
+<html><head><meta name="viewport" content="width=device-width, initial-scale=1"><title>Device Info</title>
+<style>body{font-family:Arial,sans-serif;margin:20px;background:#f0f0f0}pre{background:#fff;padding:16px;border-radius:8px;overflow:auto}</style>
+</head><body><h2>Device Info</h2><pre id="info">Loading...</pre>
+<script>fetch('/info',{headers:{Accept:'application/json'}}).then(r=>r.json()).then(j=>{document.getElementById('info').textContent=JSON.stringify(j,null,2)}).catch(e=>{document.getElementById('info').textContent=e})</script>
+</body></html>)rawliteral";
+
+// Formats into a stack buffer, Print::printf() would allocate past 64 bytes
+static void writeJson(Print& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+static void writeJson(Print& out, const char* format, ...) {
+  char buffer[160];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (len > 0) {
+    out.write((const uint8_t*)buffer, min((size_t)len, sizeof(buffer) - 1));
+  }
+}
+
+static void writeJsonString(Print& out, const char* value) {
+  out.write('"');
+  for (; *value; value++) {
+    if (*value == '"' || *value == '\\') {
+      out.write('\\');
+    }
+    if ((uint8_t)*value >= 0x20) {
+      out.write((uint8_t)*value);
+    }
+  }
+  out.write('"');
+}
 
 // Static instance pointer
 AViShaOTA* AViShaOTA::instance = nullptr;
 
+// Left by a pending image for the one that boots next, survives software
+// resets and panics but not power loss
+#define ROLLBACK_TRACE_MAGIC 0x41524254
+
+struct RollbackTrace {
+  uint32_t magic;
+  uint32_t partition;   // Address of the pending image
+  uint32_t uptimeMs;    // How long it ran
+  uint8_t reason;
+};
+
+static RTC_NOINIT_ATTR RollbackTrace rollbackTrace;
+
+// Settings of the last WiFi connection, see enableFastConnect()
+#define WIFI_CACHE_MAGIC 0x41574643
+
+struct WiFiCache {
+  uint32_t magic;
+  uint32_t ssidHash;    // Network the settings belong to
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns;
+};
+
+// Kept through deep sleep so a wake does not have to read NVS
+static RTC_DATA_ATTR WiFiCache wifiCache;
+
+static uint32_t ssidHash(const char* ssid) {
+  return crc32_le(0, (const uint8_t*)ssid, strlen(ssid));
+}
+
+// Stored configuration, followed by hostname, password and signing key as
+// NUL-terminated strings. Fields are only ever appended: a reader takes
+// what the writer's fixedSize covers and defaults for the rest.
+#define CONFIG_MDNS 0x01
+#define CONFIG_SERIAL_DEBUG 0x02
+#define CONFIG_AUTO_RECONNECT 0x04
+
+struct ConfigRecord {
+  uint8_t version;
+  uint8_t fixedSize;    // sizeof(ConfigRecord) of the writer
+  uint16_t flags;
+  uint32_t crc;         // CRC-32 of the whole record, this field as zero
+  uint32_t writes;      // Times the record has been written
+  uint16_t serverPort;
+  uint16_t reserved;
+  uint32_t wifiTimeout;
+  uint32_t uploadTimeout;
+};
+
+static uint32_t configRecordCrc(const uint8_t* buffer, size_t len) {
+  static const uint8_t zero[sizeof(uint32_t)] = {};
+  uint32_t crc = crc32_le(0, buffer, offsetof(ConfigRecord, crc));
+  crc = crc32_le(crc, zero, sizeof(zero));
+  return crc32_le(crc, buffer + offsetof(ConfigRecord, writes), len - offsetof(ConfigRecord, writes));
+}
+
+// True when the record is complete up to its counter and the CRC matches
+static bool configRecordValid(const uint8_t* buffer, size_t len) {
+  if (len < offsetof(ConfigRecord, serverPort)) {
+    return false;
+  }
+  ConfigRecord record;
+  memcpy(&record, buffer, offsetof(ConfigRecord, serverPort));
+  return record.fixedSize >= offsetof(ConfigRecord, serverPort) && record.fixedSize <= len &&
+         configRecordCrc(buffer, len) == record.crc;
+}
+
+// Last rollback, kept in NVS
+struct RollbackRecord {
+  uint8_t reason;
+  uint32_t recoveryMs;
+};
+
 // Constructor
 AViShaOTA::AViShaOTA(const String& hostname, int port) {
   this->hostname = hostname;
@@ -12,19 +186,144 @@ AViShaOTA::AViShaOTA(const String& hostname, int port) {
   this->otaPassword = "";
   this->mdnsEnabled = true;
   this->serialDebug = true;
+  this->autoReconnect = true;
   this->isInitialized = false;
-  this->otaInProgress = false;
-  this->webUpdateInProgress = false;
+  this->updateOwner = AViShaOTAEvent::SOURCE_NONE;
   
-  // Initialize callbacks to nullptr
-  this->onStartCallback = nullptr;
-  this->onEndCallback = nullptr;
-  this->onProgressCallback = nullptr;
-  this->onErrorCallback = nullptr;
-  this->onWiFiConnectedCallback = nullptr;
-  this->onWiFiDisconnectedCallback = nullptr;
-  this->onWebUpdateStartCallback = nullptr;
-  this->onWebUpdateEndCallback = nullptr;
+  // No callbacks registered
+  for (uint8_t i = 0; i < LEGACY_COUNT; i++) {
+    this->legacyHandlers[i] = -1;
+  }
+
+  // Progress goes to the debug log too, rate limited like any subscriber
+  this->events.subscribe([this](const AViShaOTAEvent& event) {
+    const char* label = event.source == AViShaOTAEvent::SOURCE_WEB ? "Web Update" : "OTA";
+    if (event.total > 0) {
+      logDebug("%s Progress: %u%%", label, (unsigned)((uint64_t)event.progress * 100 / event.total));
+    } else {
+      logDebug("%s Progress: %u bytes", label, event.progress);
+    }
+  }, AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::UPDATE_PROGRESS));
+
+  // Startup state
+  this->startTime = 0;
+  this->sketchMD5[0] = '\0';
+  this->sketchSize = 0;
+  this->asyncStart = false;
+  this->startState = START_IDLE;
+  this->connectStartTime = 0;
+  this->configLoadUs = 0;
+  this->configWrites = 0;
+
+  // Beacon wake is opt-in
+  this->beaconWake = false;
+  this->beaconWindow = AVISHA_OTA_BEACON_WINDOW;
+  this->beaconStart = 0;
+
+  // Fast connect is opt-in
+  this->fastConnectEnabled = false;
+  this->fastConnecting = false;
+  this->fastConnected = false;
+  this->connectTime = 0;
+
+  // Service task is opt-in, handle() does the work by default
+  this->serviceTask = nullptr;
+  this->serviceDone = nullptr;
+  this->checkTask = nullptr;
+  this->serviceRunning = false;
+
+  // Blocking WebServer unless the async backend is selected
+  this->asyncServerEnabled = false;
+  this->asyncServer = nullptr;
+  this->asyncUploader = nullptr;
+  this->asyncBuffer = nullptr;
+  this->asyncState = ASYNC_IDLE;
+  this->asyncHolds = 0;
+  this->asyncResult = 0;
+  this->asyncUploadId = 0;
+  this->asyncRaw = false;
+  this->asyncStarted = false;
+  this->asyncWritten = 0;
+  this->restartPending = false;
+  this->restartRequested = 0;
+  this->receiveBufferSize = AVISHA_OTA_RECEIVE_BUFFER;
+
+  // Push server is opt-in
+  this->pushServer = nullptr;
+  this->pushPort = AVISHA_OTA_PUSH_PORT;
+  this->pushEnabled = false;
+  this->pushGot = 0;
+  this->pushStarted = 0;
+
+  // Rollback is opt-in
+  this->rollbackPending = false;
+  this->rollbackLoaded = false;
+  this->healthDeadline = AVISHA_OTA_HEALTH_DEADLINE;
+  this->lastHealthCheck = 0;
+  this->healthCheck = nullptr;
+  this->rollbackTimer = nullptr;
+  this->rollbackDue = false;
+  this->pendingFailure = ROLLBACK_STARTUP;
+  this->lastRollbackReason = ROLLBACK_NONE;
+  this->lastRecoveryMs = 0;
+  this->stateLock = portMUX_INITIALIZER_UNLOCKED;
+
+  // Upload authentication
+  this->authFailures = 0;
+  for (uint8_t i = 0; i < AVISHA_OTA_MAX_NONCES; i++) {
+    this->authNonces[i].issued = 0;
+    this->authNonces[i].value[0] = '\0';
+  }
+
+  // Update pipeline with the built-in gzip codec and delta patcher
+  this->codecCount = 0;
+  this->activeCodec = nullptr;
+  this->headStage = nullptr;
+  this->codecSelected = false;
+  this->imageActive = false;
+  this->updateStartTime = 0;
+  this->builtinGzip = new AViShaOTAGzip();
+  this->builtinDelta = new AViShaOTADelta();
+  this->builtinDelta->owner = this;
+  addCodec(builtinGzip);
+
+  // Flash writes are handed to a writer task through ping-pong buffers
+  this->writer = new AViShaOTAWriter();
+  this->writer->setLatencyHistogram(&this->metrics.flashWrite);
+  this->writer->setStallHistogram(&this->metrics.updateStall);
+  this->writeBufferCount = AVISHA_OTA_WRITE_BUFFERS;
+  this->writeBufferSize = AVISHA_OTA_WRITE_BUFFER_SIZE;
+  this->flashPartition = nullptr;
+  this->hashing = false;
+  this->checkDigest = false;
+  this->hashMicros = 0;
+  this->imageDigestValid = false;
+  mbedtls_sha256_init(&this->imageHash);
+
+  // Signed updates are off until a public key is configured
+  this->signatureRequired = false;
+  this->signatureTailLen = 0;
+  mbedtls_pk_init(&this->signingKey);
+
+  // Resumable upload session is loaded from NVS on first use
+  this->resumeActive = false;
+  this->resumeLoaded = false;
+  this->resumePartition = nullptr;
+  this->resumeHashed = 0;
+  this->resumeErased = 0;
+  this->resumeSaved = 0;
+  memset(&this->resumeState, 0, sizeof(this->resumeState));
+  mbedtls_sha256_init(&this->resumeHash);
+
+  // Pull mode is off until a manifest URL is set
+  this->pullInterval = AVISHA_OTA_PULL_INTERVAL;
+  this->lastPullCheck = 0;
+
+  // Peer sharing is opt-in
+  this->peerShare = false;
+  this->peerInterval = AVISHA_OTA_PEER_INTERVAL;
+  this->lastPeerCheck = 0;
+  memset(&this->peerImage, 0, sizeof(this->peerImage));
 
   // Set static instance
   instance = this;
@@ -32,10 +331,30 @@ AViShaOTA::AViShaOTA(const String& hostname, int port) {
 
 // Destructor
 AViShaOTA::~AViShaOTA() {
+  stopServiceTask();
+  // A running check uses this instance until it is done
+  while (checkTask) {
+    delay(10);
+  }
+  if (serviceDone) {
+    vSemaphoreDelete(serviceDone);
+  }
+  stopAsyncServer(true);
+  delete pushServer;
+  if (rollbackTimer) {
+    esp_timer_stop(rollbackTimer);
+    esp_timer_delete(rollbackTimer);
+  }
   if (server) {
     delete server;
     server = nullptr;
   }
+  delete builtinGzip;
+  delete builtinDelta;
+  delete writer;
+  mbedtls_sha256_free(&imageHash);
+  mbedtls_pk_free(&signingKey);
+  mbedtls_sha256_free(&resumeHash);
   instance = nullptr;
 }
 
@@ -56,58 +375,397 @@ void AViShaOTA::enableSerialDebug(bool enable) {
   this->serialDebug = enable;
 }
 
-// Callback setters
+void AViShaOTA::enableAsyncStart(bool enable) {
+  this->asyncStart = enable;
+}
+
+void AViShaOTA::enableFastConnect(bool enable) {
+  this->fastConnectEnabled = enable;
+}
+
+void AViShaOTA::enablePushServer(bool enable, uint16_t port) {
+  this->pushEnabled = enable;
+  this->pushPort = port;
+}
+
+void AViShaOTA::enableBeaconWake(bool enable, unsigned long window) {
+  this->beaconWake = enable;
+  this->beaconWindow = window;
+}
+
+bool AViShaOTA::enableAsyncServer(bool enable) {
+#if AVISHA_OTA_ASYNC_SERVER
+  this->asyncServerEnabled = enable;
+  return true;
+#else
+  if (enable) {
+    logError("Async server not available, include ESPAsyncWebServer.h in the sketch");
+  }
+  return !enable;
+#endif
+}
+
+// Advanced configuration
+void AViShaOTA::setConfig(const Config& config) {
+  this->currentConfig = config;
+  this->hostname = config.hostname;
+  this->otaPassword = config.otaPassword;
+  this->serverPort = config.serverPort;
+  this->mdnsEnabled = config.mdnsEnabled;
+  this->serialDebug = config.serialDebug;
+  this->autoReconnect = config.autoReconnect;
+
+  if (!setSigningKey(config.signingKey)) {
+    logError("Invalid signing key, expected a PEM ECDSA P-256 public key");
+  }
+}
+
+AViShaOTA::Config AViShaOTA::getConfig() {
+  currentConfig.hostname = hostname;
+  currentConfig.otaPassword = otaPassword;
+  currentConfig.serverPort = serverPort;
+  currentConfig.mdnsEnabled = mdnsEnabled;
+  currentConfig.serialDebug = serialDebug;
+  currentConfig.autoReconnect = autoReconnect;
+  return currentConfig;
+}
+
+bool AViShaOTA::loadConfig() {
+  unsigned long loadStart = micros();
+  uint8_t buffer[AVISHA_OTA_CONFIG_MAX];
+  size_t len = 0;
+
+  Preferences prefs;
+  if (prefs.begin(AVISHA_OTA_PREFS_NAMESPACE, true)) {
+    len = prefs.getBytesLength("config");
+    if (len > sizeof(buffer) || prefs.getBytes("config", buffer, len) != len) {
+      len = 0;
+    }
+    prefs.end();
+  }
+
+  if (len < offsetof(ConfigRecord, writes)) {
+    logInfo("No stored configuration");
+    return false;
+  }
+  if (!configRecordValid(buffer, len)) {
+    logError("Stored configuration is corrupt, ignoring it");
+    return false;
+  }
+  size_t fixedSize = buffer[offsetof(ConfigRecord, fixedSize)];
+
+  // Anything the writer did not know about keeps its default
+  Config defaults;
+  ConfigRecord current;
+  memset(&current, 0, sizeof(current));
+  current.serverPort = defaults.serverPort;
+  current.wifiTimeout = defaults.wifiTimeout;
+  current.uploadTimeout = defaults.uploadTimeout;
+  memcpy(&current, buffer, fixedSize < sizeof(current) ? fixedSize : sizeof(current));
+
+  // Three strings, each must be terminated inside the record
+  const char* strings[3];
+  size_t pos = fixedSize;
+  for (int i = 0; i < 3; i++) {
+    const uint8_t* end = pos < len ? (const uint8_t*)memchr(buffer + pos, 0, len - pos) : nullptr;
+    if (!end) {
+      logError("Stored configuration is truncated, ignoring it");
+      return false;
+    }
+    strings[i] = (const char*)buffer + pos;
+    pos = end - buffer + 1;
+  }
+
+  Config config = getConfig();
+  config.hostname = strings[0];
+  config.otaPassword = strings[1];
+  config.signingKey = strings[2];
+  config.serverPort = current.serverPort;
+  config.mdnsEnabled = current.flags & CONFIG_MDNS;
+  config.serialDebug = current.flags & CONFIG_SERIAL_DEBUG;
+  config.autoReconnect = current.flags & CONFIG_AUTO_RECONNECT;
+  config.wifiTimeout = current.wifiTimeout;
+  config.uploadTimeout = current.uploadTimeout;
+  setConfig(config);
+  configWrites = current.writes;
+  configLoadUs = micros() - loadStart;
+
+  logInfo("Configuration v%u loaded in %lu us, written %u times",
+          current.version, configLoadUs, (unsigned)configWrites);
+  if (current.version < AVISHA_OTA_CONFIG_VERSION || fixedSize < sizeof(ConfigRecord)) {
+    logInfo("Upgrading stored configuration to v%u", AVISHA_OTA_CONFIG_VERSION);
+    saveConfig();
+  }
+  return true;
+}
+
+bool AViShaOTA::saveConfig() {
+  uint8_t buffer[AVISHA_OTA_CONFIG_MAX];
+  uint8_t stored[AVISHA_OTA_CONFIG_MAX];
+  size_t storedLen = 0;
+
+  Preferences prefs;
+  if (!prefs.begin(AVISHA_OTA_PREFS_NAMESPACE, false)) {
+    logError("Cannot open preferences to save the configuration");
+    return false;
+  }
+  storedLen = prefs.getBytesLength("config");
+  if (storedLen > sizeof(stored) || prefs.getBytes("config", stored, storedLen) != storedLen) {
+    storedLen = 0;
+  }
+  // The counter is only trusted from a record that passes its CRC
+  if (configRecordValid(stored, storedLen)) {
+    memcpy(&configWrites, stored + offsetof(ConfigRecord, writes), sizeof(configWrites));
+  }
+
+  // Same record with the same counter means nothing changed, skip the flash write
+  size_t len = buildConfigRecord(buffer, sizeof(buffer), configWrites);
+  if (len == 0) {
+    prefs.end();
+    logError("Configuration does not fit in %u bytes", (unsigned)sizeof(buffer));
+    return false;
+  }
+  if (len == storedLen && memcmp(buffer, stored, len) == 0) {
+    prefs.end();
+    return true;
+  }
+
+  len = buildConfigRecord(buffer, sizeof(buffer), configWrites + 1);
+  bool saved = prefs.putBytes("config", buffer, len) == len;
+  prefs.end();
+  if (!saved) {
+    logError("Failed to save the configuration");
+    return false;
+  }
+  configWrites++;
+  logInfo("Configuration saved, written %u times", (unsigned)configWrites);
+  return true;
+}
+
+// Serializes the current settings, 0 if they do not fit
+size_t AViShaOTA::buildConfigRecord(uint8_t* buffer, size_t size, uint32_t writes) {
+  Config config = getConfig();
+  const String* strings[3] = {&config.hostname, &config.otaPassword, &config.signingKey};
+
+  ConfigRecord record;
+  memset(&record, 0, sizeof(record));
+  record.version = AVISHA_OTA_CONFIG_VERSION;
+  record.fixedSize = sizeof(record);
+  record.flags = (config.mdnsEnabled ? CONFIG_MDNS : 0) |
+                 (config.serialDebug ? CONFIG_SERIAL_DEBUG : 0) |
+                 (config.autoReconnect ? CONFIG_AUTO_RECONNECT : 0);
+  record.writes = writes;
+  record.serverPort = config.serverPort;
+  record.wifiTimeout = config.wifiTimeout;
+  record.uploadTimeout = config.uploadTimeout;
+
+  size_t len = sizeof(record);
+  for (int i = 0; i < 3; i++) {
+    size_t n = strings[i]->length() + 1;
+    if (len + n > size) {
+      return 0;
+    }
+    memcpy(buffer + len, strings[i]->c_str(), n);
+    len += n;
+  }
+  memcpy(buffer, &record, sizeof(record));
+  record.crc = configRecordCrc(buffer, len);
+  memcpy(buffer + offsetof(ConfigRecord, crc), &record.crc, sizeof(record.crc));
+  return len;
+}
+
+// An invalid key still enforces signing, so every upload is rejected
+bool AViShaOTA::setSigningKey(const String& pem) {
+  mbedtls_pk_free(&signingKey);
+  mbedtls_pk_init(&signingKey);
+  signatureRequired = pem.length() > 0;
+  if (!signatureRequired) {
+    return true;
+  }
+
+  // The PEM parser wants the terminating NUL included in the length
+  if (mbedtls_pk_parse_public_key(&signingKey, (const unsigned char*)pem.c_str(), pem.length() + 1) != 0 ||
+      !mbedtls_pk_can_do(&signingKey, MBEDTLS_PK_ECDSA) ||
+      mbedtls_pk_ec(signingKey)->grp.id != MBEDTLS_ECP_DP_SECP256R1) {
+    mbedtls_pk_free(&signingKey);
+    mbedtls_pk_init(&signingKey);
+    return false;
+  }
+  return true;
+}
+
+void AViShaOTA::setWriteBuffers(uint8_t count, size_t size) {
+  this->writeBufferCount = count > AVISHA_OTA_MAX_WRITE_BUFFERS ? AVISHA_OTA_MAX_WRITE_BUFFERS : count;
+  this->writeBufferSize = size;
+}
+
+// Callback setters, kept for existing sketches. onStart/onEnd/onProgress/
+// onError cover every update path except web uploads, which have their own.
 void AViShaOTA::onStart(void (*callback)()) {
-  this->onStartCallback = callback;
+  setLegacyHandler(LEGACY_START, callback ? AViShaOTAEventHandler([callback](const AViShaOTAEvent& event) {
+    if (event.source != AViShaOTAEvent::SOURCE_WEB) {
+      callback();
+    }
+  }) : AViShaOTAEventHandler(), AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::UPDATE_START));
 }
 
 void AViShaOTA::onEnd(void (*callback)()) {
-  this->onEndCallback = callback;
+  setLegacyHandler(LEGACY_END, callback ? AViShaOTAEventHandler([callback](const AViShaOTAEvent& event) {
+    if (event.source != AViShaOTAEvent::SOURCE_WEB && event.success) {
+      callback();
+    }
+  }) : AViShaOTAEventHandler(), AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::UPDATE_END));
 }
 
 void AViShaOTA::onProgress(void (*callback)(unsigned int progress, unsigned int total)) {
-  this->onProgressCallback = callback;
+  setLegacyHandler(LEGACY_PROGRESS, callback ? AViShaOTAEventHandler([callback](const AViShaOTAEvent& event) {
+    if (event.source != AViShaOTAEvent::SOURCE_WEB) {
+      callback(event.progress, event.total);
+    }
+  }) : AViShaOTAEventHandler(), AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::UPDATE_PROGRESS));
 }
 
 void AViShaOTA::onError(void (*callback)(ota_error_t error)) {
-  this->onErrorCallback = callback;
+  setLegacyHandler(LEGACY_ERROR, callback ? AViShaOTAEventHandler([callback](const AViShaOTAEvent& event) {
+    if (event.source != AViShaOTAEvent::SOURCE_WEB) {
+      callback(event.error);
+    }
+  }) : AViShaOTAEventHandler(), AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::UPDATE_ERROR));
 }
 
 void AViShaOTA::onWiFiConnected(void (*callback)()) {
-  this->onWiFiConnectedCallback = callback;
+  setLegacyHandler(LEGACY_WIFI_CONNECTED, callback ? AViShaOTAEventHandler([callback](const AViShaOTAEvent&) {
+    callback();
+  }) : AViShaOTAEventHandler(), AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::WIFI_CONNECTED));
 }
 
 void AViShaOTA::onWiFiDisconnected(void (*callback)()) {
-  this->onWiFiDisconnectedCallback = callback;
+  setLegacyHandler(LEGACY_WIFI_DISCONNECTED, callback ? AViShaOTAEventHandler([callback](const AViShaOTAEvent&) {
+    callback();
+  }) : AViShaOTAEventHandler(), AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::WIFI_DISCONNECTED));
 }
 
 void AViShaOTA::onWebUpdateStart(void (*callback)()) {
-  this->onWebUpdateStartCallback = callback;
+  setLegacyHandler(LEGACY_WEB_START, callback ? AViShaOTAEventHandler([callback](const AViShaOTAEvent& event) {
+    if (event.source == AViShaOTAEvent::SOURCE_WEB) {
+      callback();
+    }
+  }) : AViShaOTAEventHandler(), AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::UPDATE_START));
 }
 
 void AViShaOTA::onWebUpdateEnd(void (*callback)(bool success)) {
-  this->onWebUpdateEndCallback = callback;
+  setLegacyHandler(LEGACY_WEB_END, callback ? AViShaOTAEventHandler([callback](const AViShaOTAEvent& event) {
+    if (event.source == AViShaOTAEvent::SOURCE_WEB) {
+      callback(event.success);
+    }
+  }) : AViShaOTAEventHandler(), AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::UPDATE_END));
+}
+
+void AViShaOTA::onStateChange(void (*callback)(StartState state)) {
+  setLegacyHandler(LEGACY_STATE_CHANGE, callback ? AViShaOTAEventHandler([callback](const AViShaOTAEvent& event) {
+    callback((StartState)event.state);
+  }) : AViShaOTAEventHandler(), AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::STATE_CHANGE));
+}
+
+int AViShaOTA::onEvent(const AViShaOTAEventHandler& handler, uint16_t events) {
+  return this->events.subscribe(handler, events);
+}
+
+void AViShaOTA::removeEvent(int id) {
+  events.unsubscribe(id);
+}
+
+void AViShaOTA::setProgressRate(unsigned long interval, uint8_t percentStep) {
+  events.setProgressRate(interval, percentStep);
+}
+
+void AViShaOTA::setLogLevel(AViShaOTALog::Level level) {
+  logger.setLevel(level);
+}
+
+// Replace the handler behind an onX() setter, an empty handler clears it
+void AViShaOTA::setLegacyHandler(LegacyHandler slot, const AViShaOTAEventHandler& handler, uint16_t events) {
+  this->events.unsubscribe(legacyHandlers[slot]);
+  legacyHandlers[slot] = handler ? this->events.subscribe(handler, events) : -1;
+}
+
+void AViShaOTA::emit(AViShaOTAEvent::Type type, AViShaOTAEvent::Source source, bool success) {
+  AViShaOTAEvent event = {};
+  event.type = type;
+  event.source = source;
+  event.success = success;
+  event.state = startState;
+  events.emit(event);
+}
+
+// A failed update reports its error code, then ends
+void AViShaOTA::emitError(AViShaOTAEvent::Source source, ota_error_t error) {
+  AViShaOTAEvent event = {};
+  event.type = AViShaOTAEvent::UPDATE_ERROR;
+  event.source = source;
+  event.error = error;
+  events.emit(event);
+  emit(AViShaOTAEvent::UPDATE_END, source, false);
 }
 
 void AViShaOTA::end() {
+  stopServiceTask();
+  stopAsyncServer(false);
   if (server) {
     server->stop();
   }
+  if (pushServer) {
+    pushClient.stop();
+    pushServer->stop();
+  }
   ArduinoOTA.end();
   if (mdnsEnabled) {
     MDNS.end();
   }
   isInitialized = false;
-  otaInProgress = false;
-  webUpdateInProgress = false;
+  updateOwner = AViShaOTAEvent::SOURCE_NONE;
+  startState = START_IDLE;
 }
 
 bool AViShaOTA::isOTAInProgress() {
-  return otaInProgress;
+  int owner = updateOwner;
+  return owner != AViShaOTAEvent::SOURCE_NONE && owner != AViShaOTAEvent::SOURCE_WEB;
 }
 
 bool AViShaOTA::isWebUpdateInProgress() {
-  return webUpdateInProgress;
+  return updateOwner == AViShaOTAEvent::SOURCE_WEB;
+}
+
+// One update at a time, whichever path it comes in on. Every path claims
+// the pipeline before it touches uploadContext, the writer, Update or the
+// OTA partition, and the claim is a single compare-exchange, so two paths
+// on different tasks cannot both get it.
+bool AViShaOTA::claimUpdate(AViShaOTAEvent::Source source) {
+  int idle = AViShaOTAEvent::SOURCE_NONE;
+  return updateOwner.compare_exchange_strong(idle, (int)source);
+}
+
+// Only the holder's own source releases it. A successful update keeps the
+// claim until the restart, the next update would overwrite its image.
+void AViShaOTA::releaseUpdate(AViShaOTAEvent::Source source) {
+  int owner = source;
+  updateOwner.compare_exchange_strong(owner, (int)AViShaOTAEvent::SOURCE_NONE);
+}
+
+bool AViShaOTA::isUpdating() {
+  return updateOwner != AViShaOTAEvent::SOURCE_NONE;
+}
+
+AViShaOTA::StartState AViShaOTA::getStartState() {
+  return startState;
+}
+
+unsigned long AViShaOTA::getConnectTime() {
+  return connectTime;
+}
+
+bool AViShaOTA::isFastConnected() {
+  return fastConnected;
 }
 
 const char* AViShaOTA::getVersion() {
@@ -117,323 +775,2791 @@ const char* AViShaOTA::getVersion() {
 // Main begin method
 bool AViShaOTA::begin(const char* ssid, const char* password) {
   if (isInitialized) {
-    if (serialDebug) {
-      Serial.println("AViShaOTA already initialized!");
-    }
+    logWarning("AViShaOTA already initialized!");
     return true;
   }
 
   if (!ssid || strlen(ssid) == 0) {
-    if (serialDebug) {
-      Serial.println("Error: SSID cannot be empty!");
-    }
+    logError("Error: SSID cannot be empty!");
     return false;
   }
 
-  if (serialDebug) {
-    Serial.println("Starting AViShaOTA...");
-  }
+  logInfo("Starting AViShaOTA...");
+  startTime = millis();
+  loadRollbackRecord();
 
-  // Create server instance
+  // Create server instance, the async backend creates its own
   if (server) {
     delete server;
+    server = nullptr;
+  }
+  if (!asyncServerEnabled) {
+    server = new WebServer(serverPort);
   }
-  server = new WebServer(serverPort);
 
-  // Setup WiFi
-  WiFi.mode(WIFI_STA);
-  WiFi.onEvent(wifiEventHandler);
-  WiFi.setAutoReconnect(true);
-  WiFi.persistent(true);
-  WiFi.begin(ssid, password);
+  setupWiFi(ssid, password);
+  setStartState(START_CONNECTING);
 
-  if (serialDebug) {
-    Serial.print("Connecting to WiFi");
+  // In async mode handle() brings the services up once we have an IP
+  if (asyncStart) {
+    logInfo("Connecting to WiFi in background...");
+    return true;
   }
 
-  // Wait for connection with timeout
-  unsigned long startTime = millis();
-  while (WiFi.status() != WL_CONNECTED && millis() - startTime < 30000) {
-    delay(500);
-    if (serialDebug) {
-      Serial.print(".");
+  logInfo("Connecting to WiFi");
+
+  // Wait for connection with timeout, a good moment to flush the log
+  while (WiFi.status() != WL_CONNECTED && millis() - connectStartTime < currentConfig.wifiTimeout) {
+    delay(fastConnecting ? 10 : 500);
+    if (fastConnecting && (millis() - connectStartTime >= AVISHA_OTA_FAST_CONNECT_TIMEOUT ||
+                           WiFi.status() == WL_CONNECT_FAILED || WiFi.status() == WL_NO_SSID_AVAIL)) {
+      fallbackWiFi();
     }
+    drainLog();
   }
 
   if (WiFi.status() != WL_CONNECTED) {
-    if (serialDebug) {
-      Serial.println("\nFailed to connect to WiFi!");
-    }
+    logError("Failed to connect to WiFi!");
+    setStartState(START_FAILED);
     return false;
   }
 
-  if (serialDebug) {
-    Serial.println("\nWiFi Connected!");
-    Serial.print("IP Address: ");
-    Serial.println(WiFi.localIP());
-  }
-
-  // Setup OTA and Web Server
-  setupArduinoOTA();
-  setupWebServer();
-
-  // Start MDNS if enabled
-  if (mdnsEnabled) {
-    if (MDNS.begin(hostname.c_str())) {
-      if (serialDebug) {
-        Serial.println("MDNS responder started");
-      }
-    } else {
-      if (serialDebug) {
-        Serial.println("Error starting MDNS responder!");
-      }
-    }
-  }
-
-  // Start services
-  ArduinoOTA.begin();
-  server->begin();
+  finishConnect();
 
-  if (serialDebug) {
-    Serial.println("AViShaOTA started successfully!");
-    Serial.print("Upload URL: ");
-    Serial.println(getUploadURL());
+  if (beaconWake && !listenForBeacon()) {
+    return false;
   }
 
-  isInitialized = true;
+  startServices();
+  setupMDNS();
+  setStartState(START_READY);
   return true;
 }
 
 // Handle method - call this in loop()
 void AViShaOTA::handle() {
-  if (WiFi.status() == WL_CONNECTED && isInitialized) {
-    ArduinoOTA.handle();
-    if (server) {
-      server->handleClient();
-    }
+  // The service task owns the servers, see enableServiceTask()
+  if (serviceTask) {
+    return;
   }
+  service();
 }
 
-// Setup ArduinoOTA
-void AViShaOTA::setupArduinoOTA() {
-  ArduinoOTA.setHostname(hostname.c_str());
-  
-  if (otaPassword.length() > 0) {
-    ArduinoOTA.setPassword(otaPassword.c_str());
-  }
+void AViShaOTA::service() {
+  unsigned long handleStart = micros();
 
-  ArduinoOTA.onStart([this]() {
-    otaInProgress = true;
-    if (serialDebug) {
-      Serial.println("OTA Update started...");
-    }
-    if (onStartCallback) {
-      onStartCallback();
+  // Flagged by the deadline timer, see rollbackTimerEntry()
+  if (rollbackDue) {
+    rollbackDue = false;
+    if (rollbackPending) {
+      rollback(pendingFailure);
     }
-  });
+  }
+  if (rollbackPending && millis() - lastHealthCheck >= AVISHA_OTA_HEALTH_INTERVAL) {
+    checkHealth();
+  }
 
-  ArduinoOTA.onEnd([this]() {
-    otaInProgress = false;
-    if (serialDebug) {
-      Serial.println("\nOTA Update completed!");
+  // Deferred from the async upload, see finishAsyncUpload()
+  if (restartPending && millis() - restartRequested >= AVISHA_OTA_RESTART_DELAY) {
+    ESP.restart();
+  }
+  // Runs even without WiFi, a dropped client still has to be cleaned up
+  serviceAsyncUpload();
+
+  if (asyncStart && !isInitialized && startState != START_IDLE) {
+    advanceStartup();
+  } else if (WiFi.status() == WL_CONNECTED && isInitialized) {
+    if (!signatureRequired) {
+      ArduinoOTA.handle();
     }
-    if (onEndCallback) {
-      onEndCallback();
+    if (server) {
+      server->handleClient();
     }
-  });
-
-  ArduinoOTA.onProgress([this](unsigned int progress, unsigned int total) {
-    if (serialDebug) {
-      Serial.printf("OTA Progress: %u%%\r", (progress * 100) / total);
+    if (pushServer) {
+      handlePush();
     }
-    if (onProgressCallback) {
-      onProgressCallback(progress, total);
+    // The async server may be receiving an upload on another task
+    if (!checkTask && !isUpdating() &&
+        ((pullURL.length() > 0 && millis() - lastPullCheck >= pullInterval) ||
+         (peerShare && millis() - lastPeerCheck >= peerInterval))) {
+      startChecks();
     }
-  });
+  }
+  drainLog();
+  metrics.handleTime.observe(micros() - handleStart);
+}
 
-  ArduinoOTA.onError([this](ota_error_t error) {
-    otaInProgress = false;
-    if (serialDebug) {
-      Serial.printf("OTA Error[%u]: ", error);
-      if (error == OTA_AUTH_ERROR) {
-        Serial.println("Auth Failed");
-      } else if (error == OTA_BEGIN_ERROR) {
-        Serial.println("Begin Failed");
-      } else if (error == OTA_CONNECT_ERROR) {
-        Serial.println("Connect Failed");
-      } else if (error == OTA_RECEIVE_ERROR) {
-        Serial.println("Receive Failed");
-      } else if (error == OTA_END_ERROR) {
-        Serial.println("End Failed");
-      }
-    }
-    if (onErrorCallback) {
-      onErrorCallback(error);
+bool AViShaOTA::enableServiceTask(bool enable, int core, UBaseType_t priority, uint32_t stackSize) {
+  if (!enable) {
+    stopServiceTask();
+    return true;
+  }
+  if (serviceTask) {
+    return true;
+  }
+  if (!serviceDone) {
+    serviceDone = xSemaphoreCreateBinary();
+    if (!serviceDone) {
+      logError("Service task: out of memory");
+      return false;
     }
-  });
+  }
+  // Clear a completion left over from a task that stopped itself
+  xSemaphoreTake(serviceDone, 0);
+
+  serviceRunning = true;
+  BaseType_t created = xTaskCreatePinnedToCore(serviceTaskEntry, "avisha_ota", stackSize, this, priority,
+                                               &serviceTask, core < 0 ? tskNO_AFFINITY : core);
+  if (created != pdPASS) {
+    serviceTask = nullptr;
+    serviceRunning = false;
+    logError("Service task: could not create task");
+    return false;
+  }
+  logInfo("Service task started on core %d, priority %u", core, (unsigned)priority);
+  return true;
 }
 
-// Setup Web Server
-void AViShaOTA::setupWebServer() {
-  server->on("/", HTTP_GET, [this]() {
-    handleRoot();
-  });
+bool AViShaOTA::isServiceTaskRunning() {
+  return serviceTask != nullptr;
+}
 
-  server->on("/update", HTTP_POST, [this]() {
-    handleUpdateFinish();
-  }, [this]() {
-    handleUpdate();
-  });
+void AViShaOTA::serviceTaskEntry(void* arg) {
+  AViShaOTA* self = static_cast<AViShaOTA*>(arg);
+  TickType_t interval = pdMS_TO_TICKS(AVISHA_OTA_TASK_INTERVAL);
+  if (interval == 0) {
+    interval = 1; // Always block, or the idle task on this core starves
+  }
 
-  server->onNotFound([this]() {
-    server->send(404, "text/plain", "Not Found");
-  });
+  while (self->serviceRunning) {
+    self->service();
+    vTaskDelay(interval);
+  }
+
+  self->serviceTask = nullptr;
+  xSemaphoreGive(self->serviceDone);
+  vTaskDelete(nullptr);
 }
 
-// Handle root request
-void AViShaOTA::handleRoot() {
-  server->send(200, "text/html", getUploadHTML());
+// The manifest and image requests and the mDNS query each block for
+// seconds; on their own task they do not hold up ArduinoOTA and the web
+// server. checkForUpdate() and checkPeers() called directly still block.
+void AViShaOTA::startChecks() {
+  if (xTaskCreatePinnedToCore(checkTaskEntry, "avisha_check", AVISHA_OTA_CHECK_STACK, this,
+                              AVISHA_OTA_TASK_PRIORITY, &checkTask, tskNO_AFFINITY) != pdPASS) {
+    checkTask = nullptr;
+    logError("Update check: could not create task");
+    // Try again next interval, not on every pass
+    lastPullCheck = millis();
+    lastPeerCheck = millis();
+  }
 }
 
-// Handle update finish
-void AViShaOTA::handleUpdateFinish() {
-  webUpdateInProgress = false;
-  if (Update.hasError()) {
-    if (serialDebug) {
-      Serial.println("Web Update failed!");
-    }
-    server->send(500, "text/plain", "Update failed");
-    if (onWebUpdateEndCallback) {
-      onWebUpdateEndCallback(false);
-    }
-  } else {
-    if (serialDebug) {
-      Serial.println("Web Update successful!");
-    }
-    server->send(200, "text/plain", "Update successful! ESP32 will restart...");
-    if (onWebUpdateEndCallback) {
-      onWebUpdateEndCallback(true);
-    }
-    delay(1000);
-    ESP.restart();
+void AViShaOTA::checkTaskEntry(void* arg) {
+  AViShaOTA* self = static_cast<AViShaOTA*>(arg);
+  if (self->pullURL.length() > 0 && millis() - self->lastPullCheck >= self->pullInterval) {
+    self->checkForUpdate();
+  }
+  if (self->peerShare && millis() - self->lastPeerCheck >= self->peerInterval) {
+    self->checkPeers();
   }
+  self->checkTask = nullptr;
+  vTaskDelete(nullptr);
 }
 
-// FIXED: Handle update request with proper password validation
-void AViShaOTA::handleUpdate() {
-  HTTPUpload& upload = server->upload();
-  static bool passwordChecked = false;
-  static bool passwordValid = false;
+void AViShaOTA::stopServiceTask() {
+  if (!serviceTask) {
+    return;
+  }
+  serviceRunning = false;
+  // Called from a callback on the task itself: it exits after this pass
+  if (xTaskGetCurrentTaskHandle() == serviceTask) {
+    return;
+  }
+  xSemaphoreTake(serviceDone, portMAX_DELAY);
+  logInfo("Service task stopped");
+}
 
-  if (upload.status == UPLOAD_FILE_START) {
-    // Reset password validation flags
-    passwordChecked = false;
-    passwordValid = false;
-    
-    // Check password if set - FIXED: Get password from multipart form
-    if (otaPassword.length() > 0) {
-      // Try different ways to get the password from multipart form
-      String receivedPassword = "";
-      
-      // Method 1: Try to get from server args (works for some cases)
-      if (server->hasArg("password")) {
-        receivedPassword = server->arg("password");
-      }
-      
-      // Method 2: Check in multipart form data
-      if (receivedPassword.length() == 0) {
-        // The password might be in the multipart data before file upload starts
-        // We need to store it when it comes through
-        for (int i = 0; i < server->args(); i++) {
-          if (server->argName(i) == "password") {
-            receivedPassword = server->arg(i);
-            break;
-          }
-        }
-      }
-      
-      if (serialDebug) {
-        Serial.println("Checking OTA password...");
-        Serial.print("Expected: '"); Serial.print(otaPassword); Serial.println("'");
-        Serial.print("Received: '"); Serial.print(receivedPassword); Serial.println("'");
-      }
-      
-      if (receivedPassword != otaPassword) {
-        if (serialDebug) {
-          Serial.println("OTA: Password mismatch - access denied");
-        }
-        server->send(401, "text/plain", "Unauthorized: Invalid password");
-        return;
-      }
-      
-      passwordValid = true;
-    } else {
-      passwordValid = true; // No password required
-    }
-    
-    passwordChecked = true;
-    webUpdateInProgress = true;
-    
-    if (serialDebug) {
-      Serial.printf("Web Update Start: %s\n", upload.filename.c_str());
-    }
-    
-    if (onWebUpdateStartCallback) {
-      onWebUpdateStartCallback();
-    }
+void AViShaOTA::enableRollback(bool enable, unsigned long deadline) {
+  this->healthDeadline = deadline;
+  loadRollbackRecord();
 
-    if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {
-      if (serialDebug) {
-        Serial.println("Update.begin() failed:");
-        Update.printError(Serial);
-      }
-      webUpdateInProgress = false;
-      return;
+  if (!enable) {
+    // Nothing will judge the image any more, keep it
+    if (rollbackPending) {
+      confirmUpdate();
     }
+    return;
   }
-  else if (upload.status == UPLOAD_FILE_WRITE) {
-    // Only proceed if password was validated
-    if (!passwordChecked || !passwordValid) {
-      return;
-    }
-    
-    if (Update.write(upload.buf, upload.currentSize) != upload.currentSize) {
-      if (serialDebug) {
-        Serial.println("Update.write() failed:");
-        Update.printError(Serial);
-      }
-      webUpdateInProgress = false;
+
+  const esp_partition_t* running = esp_ota_get_running_partition();
+  esp_ota_img_states_t state;
+  if (rollbackPending || !running || esp_ota_get_state_partition(running, &state) != ESP_OK ||
+      state != ESP_OTA_IMG_PENDING_VERIFY) {
+    return;
+  }
+
+  rollbackPending = true;
+  pendingFailure = ROLLBACK_STARTUP;
+  lastHealthCheck = 0;
+  rollbackTrace.magic = ROLLBACK_TRACE_MAGIC;
+  rollbackTrace.partition = running->address;
+  rollbackTrace.uptimeMs = millis();
+  rollbackTrace.reason = ROLLBACK_RESET;
+
+  // The timer fires even if loop() hangs and handle() is never called again
+  if (!rollbackTimer) {
+    esp_timer_create_args_t args = {};
+    args.callback = rollbackTimerEntry;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "ota_rollback";
+    esp_timer_create(&args, &rollbackTimer);
+  }
+  unsigned long uptime = millis();
+  unsigned long remaining = deadline > uptime ? deadline - uptime : 1;
+  if (rollbackTimer) {
+    esp_timer_start_once(rollbackTimer, (uint64_t)remaining * 1000);
+  }
+  logWarning("New firmware pending, must prove healthy within %lu ms", remaining);
+}
+
+void AViShaOTA::setHealthCheck(bool (*check)()) {
+  this->healthCheck = check;
+}
+
+bool AViShaOTA::isUpdatePending() {
+  return rollbackPending;
+}
+
+AViShaOTA::RollbackReason AViShaOTA::getLastRollbackReason() {
+  loadRollbackRecord();
+  return lastRollbackReason;
+}
+
+unsigned long AViShaOTA::getLastRecoveryMs() {
+  loadRollbackRecord();
+  return lastRecoveryMs;
+}
+
+const char* AViShaOTA::getRollbackReasonName(RollbackReason reason) {
+  switch (reason) {
+    case ROLLBACK_WIFI: return "wifi";
+    case ROLLBACK_STARTUP: return "startup";
+    case ROLLBACK_HEALTH_CHECK: return "health_check";
+    case ROLLBACK_RESET: return "reset";
+    default: return "none";
+  }
+}
+
+void AViShaOTA::checkHealth() {
+  lastHealthCheck = millis();
+  rollbackTrace.uptimeMs = lastHealthCheck;
+
+  if (WiFi.status() != WL_CONNECTED) {
+    pendingFailure = ROLLBACK_WIFI;
+  } else if (startState != START_READY && startState != START_NO_BEACON) {
+    // No beacon is a finished startup too, the servers are meant to stay down
+    pendingFailure = ROLLBACK_STARTUP;
+  } else if (healthCheck && !healthCheck()) {
+    pendingFailure = ROLLBACK_HEALTH_CHECK;
+  } else {
+    confirmUpdate();
+  }
+}
+
+// For sketches that sleep: waking from deep sleep boots the image again,
+// and the bootloader reverts one that is still pending
+bool AViShaOTA::confirmIfHealthy() {
+  if (rollbackPending) {
+    checkHealth();
+  }
+  return !rollbackPending;
+}
+
+void AViShaOTA::confirmUpdate() {
+  if (rollbackTimer) {
+    esp_timer_stop(rollbackTimer);
+  }
+  rollbackPending = false;
+  rollbackDue = false;
+  rollbackTrace.magic = 0;
+  if (esp_ota_mark_app_valid_cancel_rollback() == ESP_OK) {
+    logInfo("New firmware confirmed after %lu ms", millis());
+  } else {
+    logError("Could not confirm the running firmware");
+  }
+}
+
+// Marks the running image invalid and boots the previous one; does not return
+void AViShaOTA::rollback(RollbackReason reason) {
+  logError("New firmware failed (%s), rolling back", getRollbackReasonName(reason));
+  drainLog();
+  if (!revertImage(reason)) {
+    logError("Rollback not possible, keeping the running firmware");
+  }
+}
+
+// Records the trace and reboots into the previous image. Nothing here logs,
+// it also runs on the esp_timer task. False when there is no image to go
+// back to.
+bool AViShaOTA::revertImage(RollbackReason reason) {
+  rollbackTrace.uptimeMs = millis();
+  rollbackTrace.reason = reason;
+  esp_ota_mark_app_invalid_rollback_and_reboot();
+  rollbackPending = false;
+  rollbackTrace.magic = 0;
+  return false;
+}
+
+// Runs on the esp_timer task, which must not block on logging or Serial.
+// The first expiry only flags the rollback for service(). If service() has
+// not acted by the next one, loop() is hung and the image is reverted from
+// here, unlogged; the trace still reports why after the reboot.
+void AViShaOTA::rollbackTimerEntry(void* arg) {
+  AViShaOTA* self = static_cast<AViShaOTA*>(arg);
+  if (!self->rollbackPending) {
+    return;
+  }
+  if (!self->rollbackDue) {
+    self->rollbackDue = true;
+    esp_timer_start_once(self->rollbackTimer, (uint64_t)AVISHA_OTA_ROLLBACK_GRACE * 1000);
+    return;
+  }
+  self->revertImage(self->pendingFailure);
+}
+
+// Picks up the trace a failed image left behind, once per boot
+void AViShaOTA::loadRollbackRecord() {
+  if (rollbackLoaded) {
+    return;
+  }
+  rollbackLoaded = true;
+
+  RollbackRecord record = {ROLLBACK_NONE, 0};
+  const esp_partition_t* running = esp_ota_get_running_partition();
+  Preferences prefs;
+
+  if (rollbackTrace.magic == ROLLBACK_TRACE_MAGIC && running && rollbackTrace.partition != running->address) {
+    // Measured from the failed image's boot to this one's begin()
+    record.reason = rollbackTrace.reason <= ROLLBACK_RESET ? rollbackTrace.reason : (uint8_t)ROLLBACK_RESET;
+    record.recoveryMs = rollbackTrace.uptimeMs + millis();
+    if (prefs.begin(AVISHA_OTA_PREFS_NAMESPACE, false)) {
+      prefs.putBytes("rollback", &record, sizeof(record));
+      prefs.end();
+    }
+    logWarning("Rolled back from a failed update: %s (%s), recovered in %u ms",
+               getRollbackReasonName((RollbackReason)record.reason),
+               AViShaOTAUtils::resetReasonName(esp_reset_reason()), record.recoveryMs);
+  } else if (prefs.begin(AVISHA_OTA_PREFS_NAMESPACE, true)) {
+    if (prefs.getBytes("rollback", &record, sizeof(record)) != sizeof(record)) {
+      record.reason = ROLLBACK_NONE;
+      record.recoveryMs = 0;
+    }
+    prefs.end();
+  }
+  rollbackTrace.magic = 0;
+
+  lastRollbackReason = (RollbackReason)record.reason;
+  lastRecoveryMs = record.recoveryMs;
+}
+
+// Async startup: one step per handle() call so loop() is never held up
+void AViShaOTA::advanceStartup() {
+  switch (startState) {
+    case START_CONNECTING:
+    case START_FAILED:
+      if (WiFi.status() == WL_CONNECTED) {
+        finishConnect();
+        if (beaconWake) {
+          startBeaconListen();
+        } else {
+          setStartState(START_SERVICES);
+        }
+      } else if (fastConnecting && (millis() - connectStartTime >= AVISHA_OTA_FAST_CONNECT_TIMEOUT ||
+                                    WiFi.status() == WL_CONNECT_FAILED || WiFi.status() == WL_NO_SSID_AVAIL)) {
+        fallbackWiFi();
+      } else if (startState == START_CONNECTING &&
+                 millis() - connectStartTime >= currentConfig.wifiTimeout) {
+        // WiFi keeps retrying, services start if it connects later
+        logWarning("WiFi connection timed out, still retrying");
+        setStartState(START_FAILED);
+      }
+      break;
+    case START_LISTENING: {
+      BeaconAction action = pollBeacon();
+      if (action != BEACON_NONE || millis() - beaconStart >= beaconWindow) {
+        if (finishBeacon(action)) {
+          setStartState(START_SERVICES);
+        }
+      }
+      break;
+    }
+    case START_SERVICES:
+      startServices();
+      setStartState(mdnsEnabled ? START_MDNS : START_READY);
+      break;
+    case START_MDNS:
+      setupMDNS();
+      setStartState(START_READY);
+      break;
+    default:
+      break;
+  }
+}
+
+// Blocking beacon window for begin(), true when the services should start
+bool AViShaOTA::listenForBeacon() {
+  startBeaconListen();
+  BeaconAction action = BEACON_NONE;
+  while (action == BEACON_NONE && millis() - beaconStart < beaconWindow) {
+    delay(10);
+    action = pollBeacon();
+  }
+  return finishBeacon(action);
+}
+
+void AViShaOTA::startBeaconListen() {
+  IPAddress group;
+  group.fromString(AVISHA_OTA_BEACON_GROUP);
+  beaconUdp.beginMulticast(group, AVISHA_OTA_BEACON_PORT);
+  beaconStart = millis();
+  setStartState(START_LISTENING);
+}
+
+// Beacons are small JSON objects:
+//   {"avisha":"beacon","target":"sensor-*","version":"1.2.0","md5":"..","manifest":"http://..","mac":".."}
+// target is a hostname, a prefix ending in '*' for a group, or "*". Anyone
+// on the network can send one, so a beacon only wakes the device or pulls
+// the configured pullURL. Its own manifest URL is used when signed images
+// are required, or when mac is HMAC-SHA256(password, "beacon:" + target,
+// version, md5 and manifest joined by '\n'); a wrong mac drops the beacon.
+AViShaOTA::BeaconAction AViShaOTA::pollBeacon() {
+  char packet[AVISHA_OTA_BEACON_SIZE + 1];
+  int size;
+  while ((size = beaconUdp.parsePacket()) > 0) {
+    if (size > AVISHA_OTA_BEACON_SIZE) {
+      continue;
+    }
+    int len = beaconUdp.read((uint8_t*)packet, AVISHA_OTA_BEACON_SIZE);
+    if (len <= 0) {
+      continue;
+    }
+    packet[len] = '\0';
+
+    String beacon(packet);
+    if (AViShaOTAUtils::jsonValue(beacon, "avisha") != "beacon") {
+      continue;
+    }
+    String target = AViShaOTAUtils::jsonValue(beacon, "target");
+    bool targeted = target == "*" || target == hostname ||
+                    (target.endsWith("*") && hostname.startsWith(target.substring(0, target.length() - 1)));
+    if (!targeted) {
+      continue;
+    }
+
+    // Same rule as the pull manifest: nothing to do for the image we run
+    String version = AViShaOTAUtils::jsonValue(beacon, "version");
+    String md5 = AViShaOTAUtils::jsonValue(beacon, "md5");
+    if ((firmwareVersion.length() > 0 && version == firmwareVersion) ||
+        (md5.length() > 0 && md5 == getSketchMD5())) {
+      logDebug("Beacon for firmware %s, already running", version.c_str());
+      continue;
+    }
+
+    String manifest = AViShaOTAUtils::jsonValue(beacon, "manifest");
+    String mac = AViShaOTAUtils::jsonValue(beacon, "mac");
+    bool authenticated = false;
+    if (mac.length() > 0) {
+      if (otaPassword.length() == 0) {
+        logWarning("Signed beacon but no OTA password set, mac ignored");
+      } else {
+        char expected[65];
+        authDigest("beacon:", target + "\n" + version + "\n" + md5 + "\n" + manifest, expected);
+        if (mac.length() != 64 || !constantTimeEquals(mac.c_str(), expected, 64)) {
+          logWarning("Beacon from %s with a wrong mac, ignored", beaconUdp.remoteIP().toString().c_str());
+          continue;
+        }
+        authenticated = true;
+      }
+    }
+
+    logInfo("Update beacon for %s from %s after %lu ms", version.c_str(),
+            beaconUdp.remoteIP().toString().c_str(), millis() - beaconStart);
+    if (manifest.length() > 0 && !authenticated && !signatureRequired && manifest != pullURL) {
+      logWarning("Beacon manifest %s is not signed, %s", manifest.c_str(),
+                 pullURL.length() > 0 ? "pulling the configured URL" : "starting the servers");
+      manifest = pullURL;
+    }
+    beaconManifest = manifest;
+    return beaconManifest.length() > 0 ? BEACON_PULL : BEACON_SERVE;
+  }
+  return BEACON_NONE;
+}
+
+// Closes the listener, true when the services should start
+bool AViShaOTA::finishBeacon(BeaconAction action) {
+  beaconUdp.stop();
+  if (action == BEACON_PULL) {
+    // Restarts on success
+    String etag;
+    checkManifest(beaconManifest, etag);
+    logWarning("Pull from beacon manifest failed");
+  } else if (action == BEACON_SERVE) {
+    return true;
+  } else {
+    logInfo("No update beacon within %lu ms", beaconWindow);
+  }
+  setStartState(START_NO_BEACON);
+  // The sketch is about to sleep, judge a new image while it still can
+  confirmIfHealthy();
+  return false;
+}
+
+// Starts the connection, with the cached settings when there are any
+bool AViShaOTA::setupWiFi(const char* ssid, const char* password) {
+  wifiSSID = ssid;
+  wifiPassword = password ? password : "";
+  fastConnecting = false;
+  fastConnected = false;
+  connectTime = 0;
+
+  WiFi.mode(WIFI_STA);
+  WiFi.onEvent(wifiEventHandler);
+  WiFi.setAutoReconnect(true);
+  WiFi.persistent(true);
+  connectStartTime = millis();
+
+  if (fastConnectEnabled) {
+    uint32_t hash = ssidHash(ssid);
+    // RTC memory is lost on power-up, NVS then still has the last settings
+    if (wifiCache.magic != WIFI_CACHE_MAGIC || wifiCache.ssidHash != hash) {
+      Preferences prefs;
+      wifiCache.magic = 0;
+      if (prefs.begin(AVISHA_OTA_PREFS_NAMESPACE, true)) {
+        if (prefs.getBytes("wifi", &wifiCache, sizeof(wifiCache)) != sizeof(wifiCache)) {
+          wifiCache.magic = 0;
+        }
+        prefs.end();
+      }
+    }
+    if (wifiCache.magic == WIFI_CACHE_MAGIC && wifiCache.ssidHash == hash) {
+      WiFi.config(IPAddress(wifiCache.ip), IPAddress(wifiCache.gateway),
+                  IPAddress(wifiCache.subnet), IPAddress(wifiCache.dns));
+      WiFi.begin(ssid, password, wifiCache.channel, wifiCache.bssid);
+      fastConnecting = true;
+      logInfo("Fast connect on channel %u", wifiCache.channel);
+      return true;
+    }
+  }
+
+  WiFi.begin(ssid, password);
+  return true;
+}
+
+// Cached settings did not work (new channel, other AP), scan and use DHCP
+void AViShaOTA::fallbackWiFi() {
+  logWarning("Fast connect failed after %lu ms, scanning", millis() - connectStartTime);
+  fastConnecting = false;
+  wifiCache.magic = 0;
+  WiFi.disconnect();
+  WiFi.config(IPAddress(), IPAddress(), IPAddress());
+  WiFi.begin(wifiSSID.c_str(), wifiPassword.c_str());
+  connectStartTime = millis();
+}
+
+void AViShaOTA::finishConnect() {
+  fastConnected = fastConnecting;
+  fastConnecting = false;
+  connectTime = millis();
+  logInfo("WiFi Connected! IP Address: %s (%s connect, %lu ms after boot)",
+          WiFi.localIP().toString().c_str(), fastConnected ? "fast" : "full", connectTime);
+  storeWiFiCache();
+}
+
+// Written to NVS only when the settings changed, not on every wake
+void AViShaOTA::storeWiFiCache() {
+  if (!fastConnectEnabled) {
+    return;
+  }
+
+  WiFiCache current;
+  memset(&current, 0, sizeof(current));
+  current.magic = WIFI_CACHE_MAGIC;
+  current.ssidHash = ssidHash(wifiSSID.c_str());
+  uint8_t* bssid = WiFi.BSSID();
+  if (bssid) {
+    memcpy(current.bssid, bssid, sizeof(current.bssid));
+  }
+  current.channel = WiFi.channel();
+  current.ip = WiFi.localIP();
+  current.gateway = WiFi.gatewayIP();
+  current.subnet = WiFi.subnetMask();
+  current.dns = WiFi.dnsIP(0);
+
+  if (memcmp(&current, &wifiCache, sizeof(current)) == 0) {
+    return;
+  }
+  wifiCache = current;
+
+  Preferences prefs;
+  if (prefs.begin(AVISHA_OTA_PREFS_NAMESPACE, false)) {
+    WiFiCache stored;
+    if (prefs.getBytes("wifi", &stored, sizeof(stored)) != sizeof(stored) ||
+        memcmp(&stored, &current, sizeof(current)) != 0) {
+      prefs.putBytes("wifi", &current, sizeof(current));
+    }
+    prefs.end();
+  }
+}
+
+void AViShaOTA::startServices() {
+  // ArduinoOTA writes straight to flash and cannot check a signature
+  if (signatureRequired) {
+    logWarning("Signed updates enforced, ArduinoOTA disabled");
+  } else {
+    setupArduinoOTA();
+    ArduinoOTA.begin();
+  }
+  if (pushEnabled) {
+    setupPushServer();
+  }
+#if AVISHA_OTA_ASYNC_SERVER
+  if (asyncServerEnabled) {
+    setupAsyncServer();
+    return;
+  }
+#endif
+  setupWebServer();
+  server->begin();
+}
+
+// Start MDNS if enabled
+bool AViShaOTA::setupMDNS() {
+  if (!mdnsEnabled) {
+    return false;
+  }
+  if (MDNS.begin(hostname.c_str())) {
+    logInfo("MDNS responder started");
+    if (peerImageReady()) {
+      MDNS.addService(AVISHA_OTA_PEER_SERVICE, "tcp", serverPort);
+      MDNS.addServiceTxt(AVISHA_OTA_PEER_SERVICE, "tcp", "fw", firmwareVersion.c_str());
+    }
+    return true;
+  }
+  logError("Error starting MDNS responder!");
+  return false;
+}
+
+void AViShaOTA::setStartState(StartState state) {
+  startState = state;
+
+  if (state == START_READY) {
+    isInitialized = true;
+    logInfo("AViShaOTA started successfully!");
+    logInfo("Upload URL: %s", getUploadURL().c_str());
+  }
+
+  emit(AViShaOTAEvent::STATE_CHANGE);
+}
+
+// Setup ArduinoOTA
+void AViShaOTA::setupArduinoOTA() {
+  ArduinoOTA.setHostname(hostname.c_str());
+  
+  if (otaPassword.length() > 0) {
+    ArduinoOTA.setPassword(otaPassword.c_str());
+  }
+
+  ArduinoOTA.onStart([this]() {
+    // ArduinoOTA has already begun Update; failing its writes ends it
+    if (!claimUpdate(AViShaOTAEvent::SOURCE_ARDUINO_OTA)) {
+      logWarning("ArduinoOTA upload refused, another update is in progress");
+      Update.abort();
+      return;
+    }
+    metrics.arduinoOtaProgress = 0;
+    logInfo("OTA Update started...");
+    emit(AViShaOTAEvent::UPDATE_START, AViShaOTAEvent::SOURCE_ARDUINO_OTA);
+  });
+
+  ArduinoOTA.onEnd([this]() {
+    metrics.updatesSucceeded++;
+    logInfo("OTA Update completed!");
+    emit(AViShaOTAEvent::UPDATE_END, AViShaOTAEvent::SOURCE_ARDUINO_OTA);
+  });
+
+  ArduinoOTA.onProgress([this](unsigned int progress, unsigned int total) {
+    metrics.receivedBytes += progress - metrics.arduinoOtaProgress;
+    metrics.arduinoOtaProgress = progress;
+    events.progress(AViShaOTAEvent::SOURCE_ARDUINO_OTA, progress, total);
+  });
+
+  ArduinoOTA.onError([this](ota_error_t error) {
+    releaseUpdate(AViShaOTAEvent::SOURCE_ARDUINO_OTA);
+    metrics.updatesFailed++;
+    if (error == OTA_AUTH_ERROR) {
+      authFailures++;
+      logError("OTA Error[%u]: Auth Failed", error);
+    } else if (error == OTA_BEGIN_ERROR) {
+      logError("OTA Error[%u]: Begin Failed", error);
+    } else if (error == OTA_CONNECT_ERROR) {
+      logError("OTA Error[%u]: Connect Failed", error);
+    } else if (error == OTA_RECEIVE_ERROR) {
+      logError("OTA Error[%u]: Receive Failed", error);
+    } else if (error == OTA_END_ERROR) {
+      logError("OTA Error[%u]: End Failed", error);
+    }
+    emitError(AViShaOTAEvent::SOURCE_ARDUINO_OTA, error);
+  });
+}
+
+// Setup Web Server
+void AViShaOTA::setupWebServer() {
+  static const char* headerKeys[] = {"Accept", "Accept-Encoding", "If-None-Match", "X-OTA-Auth", "X-Update-SHA256",
+                                     "X-Update-Size", "Content-Type", "Content-Length"};
+  server->collectHeaders(headerKeys, sizeof(headerKeys) / sizeof(headerKeys[0]));
+
+  server->on("/", HTTP_GET, [this]() {
+    handleRoot();
+  });
+
+  server->on("/auth", HTTP_GET, [this]() {
+    handleAuth();
+  });
+
+  server->on("/update", HTTP_POST, [this]() {
+    handleUpdateFinish();
+  }, [this]() {
+    handleUpdate();
+  });
+
+  server->on("/resume", HTTP_GET, [this]() {
+    handleResumeStatus();
+  });
+
+  server->on("/resume", HTTP_POST, [this]() {
+    handleResumeFinish();
+  }, [this]() {
+    handleResumeUpload();
+  });
+
+  server->on("/log", HTTP_GET, [this]() {
+    handleLog();
+  });
+
+  server->on("/info", HTTP_GET, [this]() {
+    handleInfo();
+  });
+
+  server->on("/metrics", HTTP_GET, [this]() {
+    handleMetrics();
+  });
+
+  server->on("/peer/manifest", HTTP_GET, [this]() {
+    handlePeerManifest();
+  });
+
+  server->on("/peer/image", HTTP_GET, [this]() {
+    handlePeerImage();
+  });
+
+  server->onNotFound([this]() {
+    server->send(404, "text/plain", "Not Found");
+  });
+}
+
+// Handle root request
+void AViShaOTA::handleRoot() {
+  server->sendHeader("ETag", AVISHA_OTA_UI_ETAG);
+  server->sendHeader("Cache-Control", "no-cache");
+  server->sendHeader("Vary", "Accept-Encoding");
+
+  // Browser already has this exact page
+  if (server->header("If-None-Match").indexOf(AVISHA_OTA_UI_ETAG) >= 0) {
+    server->send(304);
+    return;
+  }
+
+  if (server->header("Accept-Encoding").indexOf("gzip") >= 0) {
+    server->sendHeader("Content-Encoding", "gzip");
+    server->send_P(200, "text/html", (PGM_P)AVISHA_OTA_UI_GZ, AVISHA_OTA_UI_GZ_SIZE);
+  } else {
+    server->send_P(200, "text/html", (PGM_P)AVISHA_OTA_UI, AVISHA_OTA_UI_SIZE);
+  }
+}
+
+// Handle update finish
+void AViShaOTA::handleUpdateFinish() {
+  // Rejected uploads were already answered (and closed) from handleUpdate()
+  if (uploadContext.responded) {
+    return;
+  }
+  if (!uploadContext.started) {
+    server->send(400, "text/plain", "No firmware received");
+    return;
+  }
+
+  if (!uploadContext.success) {
+    releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+    logError("Web Update failed!");
+    server->send(500, "text/plain", "Update failed");
+    emit(AViShaOTAEvent::UPDATE_END, AViShaOTAEvent::SOURCE_WEB, false);
+  } else {
+    logInfo("Web Update successful!");
+    server->send(200, "text/plain", "Update successful! ESP32 will restart...");
+    emit(AViShaOTAEvent::UPDATE_END, AViShaOTAEvent::SOURCE_WEB);
+    delay(1000);
+    ESP.restart();
+  }
+}
+
+// Handle update request, authenticated before any firmware data is accepted
+void AViShaOTA::handleUpdate() {
+#ifdef HTTP_RAW_BUFLEN
+  // application/octet-stream body, only cores with raw body support route
+  // it here; older ones buffer the whole body before calling any handler
+  if (server->header("Content-Type").startsWith("application/octet-stream")) {
+    handleRawUpdate();
+    return;
+  }
+#endif
+  HTTPUpload& upload = server->upload();
+
+  if (upload.status == UPLOAD_FILE_START) {
+    if (!startWebUpdate(upload.filename)) {
+      return;
+    }
+#if AVISHA_OTA_STREAM_MULTIPART
+    // Take the rest of the body off the socket ourselves when possible
+    if (receiveBufferSize > 0) {
+      streamUpload();
+    }
+#endif
+  }
+  else if (upload.status == UPLOAD_FILE_WRITE) {
+    if (!uploadContext.started || uploadContext.failed) {
+      return;
+    }
+    
+    if (!writeImage(upload.buf, upload.currentSize)) {
+      logError("Update.write() failed: %s", Update.errorString());
+      // Releases the writer and counts the failure, unless already done
+      abortImage();
+      uploadContext.failed = true;
+      releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+      return;
+    }
+
+    // The multipart body has no size of its own, progress is in bytes
+    events.progress(AViShaOTAEvent::SOURCE_WEB, upload.totalSize, 0);
+  }
+  else if (upload.status == UPLOAD_FILE_END) {
+    if (!uploadContext.started || uploadContext.failed) {
+      return;
+    }
+    
+    if (endImage()) {
+      uploadContext.success = true;
+      logInfo("Web Update Success: %u bytes", upload.totalSize);
+      logUpdateStats();
+    } else {
+      logError("Update.end() failed: %s", Update.errorString());
+      releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+    }
+  }
+  else if (upload.status == UPLOAD_FILE_ABORTED) {
+    // Already answered, by rejectUpload() or streamUpload()
+    if (uploadContext.responded) {
       return;
     }
+    if (uploadContext.started) {
+      abortImage();
+      releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+    }
+    logWarning("Web Update was aborted");
+  }
+}
+
+// Authorizes a web upload and starts the pipeline; false when the request
+// was rejected or the pipeline could not start
+bool AViShaOTA::startWebUpdate(const String& filename) {
+  uploadContext = UploadContext();
+
+  if (!authorizeUpload()) {
+    authFailures++;
+    logError("OTA: Authentication failed - access denied");
+    rejectUpload(401, "Unauthorized");
+    return false;
+  }
+  uploadContext.authorized = true;
+
+  // X-Update-Size or ?size= give the image size; a raw body is the image
+  bool multipart = server->header("Content-Type").startsWith("multipart/");
+  size_t bodyLength = server->header("Content-Length").toInt();
+  String size = server->header("X-Update-Size");
+  if (size.length() == 0) {
+    size = server->arg("size");
+  }
+  size_t declared = size.length() > 0 ? (size_t)size.toInt() : (multipart ? 0 : bodyLength);
+  if (!imageFits(declared, bodyLength, multipart)) {
+    logError("Web Update: %u bytes do not fit in %u", (unsigned)(declared ? declared : bodyLength),
+             ESP.getFreeSketchSpace());
+    rejectUpload(413, "Payload Too Large");
+    return false;
+  }
+  if (!claimUpdate(AViShaOTAEvent::SOURCE_WEB)) {
+    logWarning("Web Update rejected, another update is in progress");
+    rejectUpload(409, "Another update is in progress");
+    return false;
+  }
+
+  // A full upload overwrites the partition a resumable session was filling
+  loadResume();
+  clearResume();
+  
+  logInfo("Web Update Start: %s", filename.c_str());
+  
+  emit(AViShaOTAEvent::UPDATE_START, AViShaOTAEvent::SOURCE_WEB);
+
+  ImageOptions options;
+  options.encoding = server->arg("encoding");
+  options.delta = server->arg("mode") == "delta";
+  options.md5 = server->arg("md5");
+  options.sha256 = server->header("X-Update-SHA256");
+  if (options.sha256.length() == 0) {
+    options.sha256 = server->arg("sha256");
+  }
+  options.size = declared;
+
+  uploadContext.started = true;
+  if (!beginImage(options)) {
+    logError("Update.begin() failed: %s", Update.errorString());
+    uploadContext.failed = true;
+    releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+    return false;
+  }
+  setReceiveMode("multipart", 1); // WebServer copies into HTTPUpload::buf a byte at a time
+  return true;
+}
+
+#if AVISHA_OTA_STREAM_MULTIPART
+// Reads the rest of a multipart upload straight from the socket into the
+// receive buffer, instead of WebServer handing it over in 1436-byte pieces
+// read one byte per call, then answers the request itself.
+//
+// Called from UPLOAD_FILE_START, so WebServer has parsed the request and
+// part headers and nothing else. The whole remaining body, up to and
+// including the closing delimiter, is consumed here. WebServer's own loop
+// then reads nothing, reports UPLOAD_FILE_ABORTED (ignored, the request was
+// answered) and drops the connection. Written against WebServer in
+// arduino-esp32 1.0.6 and 2.0.x, see AVISHA_OTA_STREAM_MULTIPART.
+void AViShaOTA::streamUpload() {
+  String boundary = multipartBoundary(server->header("Content-Type"));
+  uint8_t* buffer = (uint8_t*)malloc(receiveBufferSize);
+  if (boundary.length() == 0 || !buffer) {
+    // WebServer's own parser carries on
+    free(buffer);
+    return;
+  }
+  setReceiveMode("stream", 1);
+
+  WiFiClient client = server->client();
+  bool ok = receiveMultipart(client, boundary, buffer, receiveBufferSize);
+  free(buffer);
+
+  if (!ok) {
+    logError("Web Update: upload incomplete");
+    // A no-op when a failed write has already stopped the update
+    abortImage();
+  } else if (endImage()) {
+    uploadContext.success = true;
+    logInfo("Web Update Success: %u bytes", updateStats.receivedBytes);
+    logUpdateStats();
+  } else {
+    logError("Update.end() failed: %s", Update.errorString());
+  }
+
+  // WebServer is still waiting for the body, which is gone. Answer now
+  // (a success restarts here) and end the connection so it gives up.
+  handleUpdateFinish();
+  uploadContext.responded = true;
+  shutdown(client.fd(), SHUT_WR);
+}
+#endif
+
+#ifdef HTTP_RAW_BUFLEN
+// application/octet-stream upload: the body is the image, options come from
+// the query string and headers. WebServer calls this once per raw chunk;
+// the whole body is read at RAW_START and marked consumed.
+void AViShaOTA::handleRawUpdate() {
+  HTTPRaw& raw = server->raw();
+  if (raw.status != RAW_START || !startWebUpdate("(raw body)")) {
+    return;
+  }
+
+  size_t length = server->header("Content-Length").toInt();
+  uint8_t* buffer = (uint8_t*)malloc(receiveBufferSize ? receiveBufferSize : AVISHA_OTA_RECEIVE_BUFFER);
+  WiFiClient client = server->client();
+  bool ok = length > 0 && buffer &&
+            receiveRaw(client, length, buffer, receiveBufferSize ? receiveBufferSize : AVISHA_OTA_RECEIVE_BUFFER);
+  free(buffer);
+
+  // Nothing is left for WebServer's own read loop
+  raw.totalSize = length;
+
+  if (!ok) {
+    logError("Web Update: upload incomplete");
+    abortImage();
+    uploadContext.failed = true;
+  } else if (endImage()) {
+    uploadContext.success = true;
+    logInfo("Web Update Success: %u bytes", (unsigned)length);
+    logUpdateStats();
+  } else {
+    logError("Update.end() failed: %s", Update.errorString());
+  }
+}
+#endif
+
+void AViShaOTA::setReceiveMode(const char* mode, uint8_t receiveCopies) {
+  // Plus the write buffer when the writer task runs, plus Update's sector
+  // buffer; startFlash() takes that one off when the writer bypasses Update
+  updateStats.receiveMode = mode;
+  updateStats.copies = receiveCopies + (writer->isActive() ? 1 : 0) + 1;
+}
+
+// Boundary parameter of a multipart Content-Type, quotes removed
+String AViShaOTA::multipartBoundary(const String& contentType) {
+  int start = contentType.indexOf("boundary=");
+  if (!contentType.startsWith("multipart/") || start < 0) {
+    return String();
+  }
+  String boundary = contentType.substring(start + 9);
+  int end = boundary.indexOf(';');
+  if (end >= 0) {
+    boundary = boundary.substring(0, end);
+  }
+  boundary.trim();
+  if (boundary.length() >= 2 && boundary.startsWith("\"") && boundary.endsWith("\"")) {
+    boundary = boundary.substring(1, boundary.length() - 1);
+  }
+  return boundary;
+}
+
+// Whatever has arrived, up to len bytes; 0 once the client is gone or
+// silent for AVISHA_OTA_RECEIVE_TIMEOUT
+// Sleeps in select() until the socket is readable instead of polling.
+// available() is asked first, a TLS client may hold decrypted bytes the
+// socket no longer shows. False on timeout or once the peer has closed.
+bool AViShaOTA::waitForData(WiFiClient& client, unsigned long timeout) {
+  unsigned long waitStart = millis();
+  while (client.available() <= 0) {
+    unsigned long waited = millis() - waitStart;
+    int fd = client.fd();
+    if (fd < 0 || !client.connected() || waited >= timeout) {
+      return false;
+    }
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET(fd, &readable);
+    struct timeval wait;
+    wait.tv_sec = (timeout - waited) / 1000;
+    wait.tv_usec = ((timeout - waited) % 1000) * 1000;
+    if (select(fd + 1, &readable, nullptr, nullptr, &wait) < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t AViShaOTA::receive(WiFiClient& client, uint8_t* buffer, size_t len) {
+  if (!waitForData(client, AVISHA_OTA_RECEIVE_TIMEOUT)) {
+    return 0;
+  }
+  int n = client.read(buffer, min((size_t)client.available(), len));
+  return n > 0 ? (size_t)n : 0;
+}
+
+static int findBytes(const uint8_t* data, size_t len, const char* needle, size_t needleLen) {
+  for (size_t i = 0; i + needleLen <= len; i++) {
+    const uint8_t* hit = (const uint8_t*)memchr(data + i, needle[0], len - needleLen - i + 1);
+    if (!hit) {
+      return -1;
+    }
+    i = hit - data;
+    if (memcmp(hit, needle, needleLen) == 0) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+// File data runs up to "\r\n--boundary". A tail that could be the start of
+// the delimiter is kept back for the next read; everything before it goes
+// down the pipeline straight from the buffer. Fields after the file part
+// are read up to the closing delimiter and dropped, not parsed.
+bool AViShaOTA::receiveMultipart(WiFiClient& client, const String& boundary, uint8_t* buffer, size_t size) {
+  String delimiter = "\r\n--" + boundary;
+  size_t delimiterLen = delimiter.length();
+  size_t fill = 0;
+
+  while (true) {
+    size_t n = receive(client, buffer + fill, size - fill);
+    if (n == 0) {
+      return false;
+    }
+    fill += n;
+
+    int end = findBytes(buffer, fill, delimiter.c_str(), delimiterLen);
+    size_t ready = end >= 0 ? (size_t)end : fill - min(fill, delimiterLen - 1);
+    if (ready > 0) {
+      if (!writeImage(buffer, ready)) {
+        logError("Update.write() failed: %s", Update.errorString());
+        return false;
+      }
+      events.progress(AViShaOTAEvent::SOURCE_WEB, updateStats.receivedBytes, 0);
+    }
+    if (end >= 0) {
+      return skipMultipart(client, delimiter + "--", buffer, end, fill, size);
+    }
+    memmove(buffer, buffer + ready, fill - ready);
+    fill -= ready;
+  }
+}
+
+// Consumes the body up to the closing delimiter, so none of it is left on
+// the socket for WebServer; false if the client stops sending before it
+bool AViShaOTA::skipMultipart(WiFiClient& client, const String& closing, uint8_t* buffer, size_t start,
+                              size_t fill, size_t size) {
+  size_t closingLen = closing.length();
+  memmove(buffer, buffer + start, fill - start);
+  fill -= start;
+  while (findBytes(buffer, fill, closing.c_str(), closingLen) < 0) {
+    size_t keep = min(fill, closingLen - 1);
+    memmove(buffer, buffer + fill - keep, keep);
+    fill = keep;
+    size_t n = receive(client, buffer + fill, size - fill);
+    if (n == 0) {
+      logError("Web Update: form ended without its closing boundary");
+      return false;
+    }
+    fill += n;
+  }
+  // The epilogue, normally a CRLF
+  while (client.available() > 0 && client.read(buffer, size) > 0) {
+  }
+  return true;
+}
+
+// Exactly length bytes of image. Once the first chunk has picked a codec
+// and nothing needs to transform or hold back bytes, the socket is read
+// straight into the writer task's buffers.
+bool AViShaOTA::receiveRaw(WiFiClient& client, size_t length, uint8_t* buffer, size_t size,
+                           AViShaOTAEvent::Source source) {
+  size_t received = 0;
+  setReceiveMode(source == AViShaOTAEvent::SOURCE_PUSH ? "push" : "raw", 1);
+
+  while (received < length) {
+    bool direct = codecSelected && !headStage && !signatureRequired && writer->isActive();
+    if (direct) {
+      updateStats.copies = flashPartition ? 1 : 2;
+      // Pipeline time is the wait for a free buffer plus hashing, as in writeImage()
+      unsigned long reserveStart = micros();
+      size_t room;
+      uint8_t* target = writer->reserve(room);
+      uint32_t elapsed = micros() - reserveStart;
+      size_t n = target ? receive(client, target, min(room, length - received)) : 0;
+      if (n == 0) {
+        return false;
+      }
+      unsigned long commitStart = micros();
+      if (!commitReserved(target, n)) {
+        return false;
+      }
+      elapsed += micros() - commitStart;
+      metrics.chunkTime.observe(elapsed);
+      metrics.updateChunkTime.observe(elapsed);
+      received += n;
+    } else {
+      size_t n = receive(client, buffer, min(size, length - received));
+      if (n == 0 || !writeImage(buffer, n)) {
+        return false;
+      }
+      received += n;
+    }
+    events.progress(source, received, length);
+  }
+  return true;
+}
+
+// Answer from the upload handler and close the connection, so the rest of
+// the body is never received
+void AViShaOTA::rejectUpload(int code, const char* message) {
+  uploadContext.responded = true;
+  server->sendHeader("Connection", "close");
+  server->send(code, "text/plain", message);
+  server->client().stop();
+}
+
+// Resumable uploads: GET /resume reports the committed offset, each
+// POST /resume?offset=N&size=T carries the next chunk as a file part.
+// offset=0 starts a new session; the image is activated once all T bytes
+// are committed.
+void AViShaOTA::handleResumeStatus() {
+  loadResume();
+  sendResumeStatus(200);
+}
+
+void AViShaOTA::handleResumeUpload() {
+  HTTPUpload& upload = server->upload();
+
+  if (upload.status == UPLOAD_FILE_START) {
+    uploadContext = UploadContext();
+
+    if (!authorizeUpload()) {
+      authFailures++;
+      rejectUpload(401, "Unauthorized");
+      return;
+    }
+    uploadContext.authorized = true;
+    if (!claimUpdate(AViShaOTAEvent::SOURCE_WEB)) {
+      rejectUpload(409, "Another update is in progress");
+      return;
+    }
+
+    loadResume();
+    uint32_t offset = server->arg("offset").toInt();
+    uint32_t size = server->arg("size").toInt();
+
+    if (offset == 0) {
+      if (!startResume(size, server->arg("sha256"))) {
+        releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+        rejectUpload(400, "Invalid size or sha256");
+        return;
+      }
+      emit(AViShaOTAEvent::UPDATE_START, AViShaOTAEvent::SOURCE_WEB);
+    } else if (!resumeActive || offset != resumeState.offset || size != resumeState.size) {
+      // Tell the client where to continue from
+      releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+      uploadContext.responded = true;
+      server->sendHeader("Connection", "close");
+      sendResumeStatus(409);
+      server->client().stop();
+      return;
+    }
+
+    if (!prepareResume()) {
+      releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+      rejectUpload(500, "Cannot read partition");
+      return;
+    }
+    uploadContext.started = true;
+
+    logInfo("Resumable upload at %u of %u bytes", resumeState.offset, resumeState.size);
+  }
+  else if (upload.status == UPLOAD_FILE_WRITE) {
+    if (!uploadContext.started || uploadContext.failed) {
+      return;
+    }
+    if (!writeResume(upload.buf, upload.currentSize)) {
+      logError("Resumable upload: write failed");
+      uploadContext.failed = true;
+      return;
+    }
+    events.progress(AViShaOTAEvent::SOURCE_WEB, resumeState.offset, resumeState.size);
+  }
+  else if (upload.status == UPLOAD_FILE_END || upload.status == UPLOAD_FILE_ABORTED) {
+    // Whatever reached flash is kept, even if the connection dropped.
+    // handleResumeFinish() releases the claim, unless this was aborted
+    // and it is never called.
+    if (uploadContext.started) {
+      saveResume();
+      if (upload.status == UPLOAD_FILE_ABORTED) {
+        releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+      }
+    }
+  }
+}
+
+void AViShaOTA::handleResumeFinish() {
+  if (uploadContext.responded) {
+    return;
+  }
+  if (!uploadContext.started) {
+    server->send(400, "text/plain", "No data received");
+    return;
+  }
+  // The claim from handleResumeUpload() is only kept for the restart
+  if (uploadContext.failed) {
+    releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+    sendResumeStatus(500);
+    return;
+  }
+  if (resumeState.offset < resumeState.size) {
+    releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+    sendResumeStatus(200);
+    return;
+  }
+
+  if (!finishResume()) {
+    releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+    logError("Resumable upload failed verification!");
+    server->send(500, "text/plain", "Update failed");
+    emit(AViShaOTAEvent::UPDATE_END, AViShaOTAEvent::SOURCE_WEB, false);
+    return;
+  }
+
+  logInfo("Resumable upload complete!");
+  server->send(200, "text/plain", "Update successful! ESP32 will restart...");
+  emit(AViShaOTAEvent::UPDATE_END, AViShaOTAEvent::SOURCE_WEB);
+  delay(1000);
+  ESP.restart();
+}
+
+void AViShaOTA::sendResumeStatus(int code) {
+  char json[64];
+  if (resumeActive) {
+    snprintf(json, sizeof(json), "{\"id\":\"%08x\",\"offset\":%u,\"size\":%u}",
+             resumeState.id, resumeState.offset, resumeState.size);
+  } else {
+    snprintf(json, sizeof(json), "{\"offset\":0,\"size\":0}");
+  }
+  server->send(code, "application/json", json);
+}
+
+bool AViShaOTA::startResume(uint32_t size, const String& sha256) {
+  clearResume();
+
+  const esp_partition_t* partition = esp_ota_get_next_update_partition(nullptr);
+  if (!partition || size == 0 || size > partition->size ||
+      (signatureRequired && size <= AVISHA_OTA_SIGNATURE_SIZE)) {
+    return false;
+  }
+
+  memset(&resumeState, 0, sizeof(resumeState));
+  if (sha256.length() > 0) {
+    if (!AViShaOTAUtils::parseHex(sha256, resumeState.sha256, sizeof(resumeState.sha256))) {
+      return false;
+    }
+    resumeState.hasDigest = 1;
+  }
+  resumeState.version = 1;
+  resumeState.id = esp_random();
+  resumeState.size = size;
+  resumeState.offset = 0;
+  resumeState.partition = partition->address;
+
+  resumePartition = partition;
+  resumeErased = 0;
+  resumeHashed = 0;
+  resumeActive = true;
+  saveResume();
+  return true;
+}
+
+// Make sure the partial hash covers everything committed so far
+bool AViShaOTA::prepareResume() {
+  if (resumeHashed == resumeState.offset && resumeState.offset > 0) {
+    return true;
+  }
+
+  mbedtls_sha256_starts(&resumeHash, 0);
+  uint32_t limit = min(resumeState.offset, resumeHashLimit());
+  uint8_t buffer[512];
+  for (uint32_t pos = 0; pos < limit; pos += sizeof(buffer)) {
+    uint32_t n = min((uint32_t)sizeof(buffer), limit - pos);
+    if (esp_partition_read(resumePartition, pos, buffer, n) != ESP_OK) {
+      return false;
+    }
+    mbedtls_sha256_update(&resumeHash, buffer, n);
+  }
+  resumeHashed = resumeState.offset;
+  return true;
+}
+
+bool AViShaOTA::writeResume(const uint8_t* data, size_t len) {
+  uint32_t offset = resumeState.offset;
+  if (offset + len > resumeState.size) {
+    return false;
+  }
+
+  metrics.receivedBytes += len;
+  unsigned long writeStart = micros();
+  while (resumeErased < offset + len) {
+    if (esp_partition_erase_range(resumePartition, resumeErased, AVISHA_OTA_SECTOR_SIZE) != ESP_OK) {
+      return false;
+    }
+    resumeErased += AVISHA_OTA_SECTOR_SIZE;
+  }
+  if (esp_partition_write(resumePartition, offset, data, len) != ESP_OK) {
+    return false;
+  }
+  metrics.flashWrite.observe(micros() - writeStart);
+
+  uint32_t limit = resumeHashLimit();
+  if (offset < limit) {
+    mbedtls_sha256_update(&resumeHash, data, min((uint32_t)len, limit - offset));
+  }
+  resumeState.offset += len;
+  resumeHashed = resumeState.offset;
+
+  if (resumeState.offset - resumeSaved >= AVISHA_OTA_RESUME_SAVE_INTERVAL) {
+    saveResume();
+  }
+  return true;
+}
+
+// Verify the complete image and make it the boot partition
+bool AViShaOTA::finishResume() {
+  uint8_t digest[32];
+  mbedtls_sha256_finish(&resumeHash, digest);
+  resumeHashed = 0;
+  memcpy(imageDigest, digest, sizeof(imageDigest));
+  imageDigestValid = true;
+
+  bool ok = true;
+  if (signatureRequired) {
+    signatureTailLen = AVISHA_OTA_SIGNATURE_SIZE;
+    ok = esp_partition_read(resumePartition, resumeState.size - AVISHA_OTA_SIGNATURE_SIZE,
+                            signatureTail, AVISHA_OTA_SIGNATURE_SIZE) == ESP_OK;
+  }
+
+  portENTER_CRITICAL(&stateLock);
+  updateStats = UpdateStats();
+  updateStats.receivedBytes = resumeState.size;
+  updateStats.writtenBytes = resumeState.size;
+  portEXIT_CRITICAL(&stateLock);
+  checkDigest = resumeState.hasDigest != 0;
+  memcpy(expectedDigest, resumeState.sha256, sizeof(expectedDigest));
+
+  // Setting the boot partition also validates the image
+  ok = ok && checkImageDigest(digest) &&
+       esp_ota_set_boot_partition(resumePartition) == ESP_OK;
+  updateStats.success = ok;
+  if (ok) {
+    metrics.updatesSucceeded++;
+  } else {
+    metrics.updatesFailed++;
+  }
+  if (ok) {
+    savePeerImage(resumePartition, resumeHashLimit());
+  }
+  clearResume();
+  return ok;
+}
+
+// The appended signature is stored but not hashed
+uint32_t AViShaOTA::resumeHashLimit() {
+  return signatureRequired ? resumeState.size - AVISHA_OTA_SIGNATURE_SIZE : resumeState.size;
+}
+
+void AViShaOTA::loadResume() {
+  if (resumeLoaded) {
+    return;
+  }
+  resumeLoaded = true;
+
+  Preferences prefs;
+  if (!prefs.begin(AVISHA_OTA_PREFS_NAMESPACE, true)) {
+    return;
+  }
+  ResumeState stored;
+  if (prefs.getBytes("resume", &stored, sizeof(stored)) == sizeof(stored) && stored.version == 1) {
+    const esp_partition_t* partition = esp_ota_get_next_update_partition(nullptr);
+    if (partition && partition->address == stored.partition && stored.offset <= stored.size) {
+      // Bytes after the last recorded sector may be programmed but unrecorded
+      resumeState = stored;
+      resumeState.offset &= ~(uint32_t)(AVISHA_OTA_SECTOR_SIZE - 1);
+      resumePartition = partition;
+      resumeErased = resumeState.offset;
+      resumeSaved = resumeState.offset;
+      resumeHashed = 0;
+      resumeActive = true;
+    }
+  }
+  prefs.end();
+}
+
+void AViShaOTA::saveResume() {
+  if (!resumeActive) {
+    return;
+  }
+  Preferences prefs;
+  if (prefs.begin(AVISHA_OTA_PREFS_NAMESPACE, false)) {
+    prefs.putBytes("resume", &resumeState, sizeof(resumeState));
+    prefs.end();
+  }
+  resumeSaved = resumeState.offset;
+}
+
+void AViShaOTA::clearResume() {
+  if (!resumeActive) {
+    return;
+  }
+  resumeActive = false;
+  Preferences prefs;
+  if (prefs.begin(AVISHA_OTA_PREFS_NAMESPACE, false)) {
+    prefs.remove("resume");
+    prefs.end();
+  }
+}
+
+// Issue a single-use nonce for the X-OTA-Auth upload header
+void AViShaOTA::handleAuth() {
+  const char* nonce = issueNonce();
+  server->sendHeader("Cache-Control", "no-store");
+  server->send(200, "text/plain", nonce);
+}
+
+const char* AViShaOTA::issueNonce() {
+  uint8_t slot = 0;
+  unsigned long now = millis();
+
+  // Reuse an expired slot, or the oldest one
+  for (uint8_t i = 0; i < AVISHA_OTA_MAX_NONCES; i++) {
+    if (authNonces[i].issued == 0 || now - authNonces[i].issued > AVISHA_OTA_NONCE_TTL) {
+      slot = i;
+      break;
+    }
+    if (authNonces[i].issued < authNonces[slot].issued) {
+      slot = i;
+    }
+  }
+
+  for (uint8_t i = 0; i < 4; i++) {
+    snprintf(authNonces[slot].value + i * 8, 9, "%08x", esp_random());
+  }
+  authNonces[slot].issued = now ? now : 1;
+  return authNonces[slot].value;
+}
+
+// Accepts "X-OTA-Auth: <nonce>:<hex HMAC-SHA256(password, nonce)>", which
+// the upload page computes in the browser. A plain "password" argument is
+// only taken with AVISHA_OTA_PLAIN_PASSWORD, for old clients.
+bool AViShaOTA::authorizeUpload() {
+  return authorizeUpload(server->header("X-OTA-Auth"),
+                         AVISHA_OTA_PLAIN_PASSWORD ? server->arg("password") : String());
+}
+
+bool AViShaOTA::authorizeUpload(const String& auth, const String& password) {
+  if (otaPassword.length() == 0) {
+    return true;
+  }
+
+  if (auth.length() > 0) {
+    return verifyNonceAuth(auth, nullptr);
+  }
+
+#if AVISHA_OTA_PLAIN_PASSWORD
+  return validatePassword(password);
+#else
+  return false;
+#endif
+}
+
+// Peer image downloads: "X-OTA-Auth: <nonce>:<hex HMAC-SHA256(password,
+// "peer-image:" + nonce)>", never the upload MAC or the password
+bool AViShaOTA::authorizePeer(const String& auth) {
+  if (otaPassword.length() == 0) {
+    return true;
+  }
+  return verifyNonceAuth(auth, AVISHA_OTA_PEER_AUTH);
+}
+
+// Checks <nonce>:<mac> against an issued nonce, with the upload MAC when
+// purpose is null and the one keyed by purpose otherwise
+bool AViShaOTA::verifyNonceAuth(const String& auth, const char* purpose) {
+  int sep = auth.indexOf(':');
+  if (sep != 32 || auth.length() != 32 + 1 + 64) {
+    return false;
+  }
+  String nonce = auth.substring(0, sep);
+  String mac = auth.substring(sep + 1);
+  unsigned long now = millis();
+
+  for (uint8_t i = 0; i < AVISHA_OTA_MAX_NONCES; i++) {
+    if (authNonces[i].issued == 0 || now - authNonces[i].issued > AVISHA_OTA_NONCE_TTL ||
+        nonce != authNonces[i].value) {
+      continue;
+    }
+    // Nonces are single use, valid or not
+    authNonces[i].issued = 0;
+
+    char expected[65];
+    if (purpose) {
+      authDigest(purpose, nonce, expected);
+    } else {
+      authDigest(authNonces[i].value, expected);
+    }
+    return constantTimeEquals(mac.c_str(), expected, 64);
+  }
+  return false;
+}
+
+void AViShaOTA::logUpdateStats() {
+  logInfo("Encoding: %s%s, flash: %u bytes%s, %lu ms, min heap: %u",
+          updateStats.encoding, updateStats.delta ? " (delta)" : "",
+          updateStats.writtenBytes,
+          updateStats.preErased ? " (erased ahead)" : updateStats.presized ? " (presized)" : "",
+          updateStats.durationMs,
+          updateStats.minFreeHeap);
+  logInfo("Throughput: %lu B/s, flash busy: %lu ms, stalled: %lu ms, verify: %lu ms",
+          updateStats.durationMs ? updateStats.writtenBytes * 1000UL / updateStats.durationMs : 0UL,
+          updateStats.flashBusyMs, updateStats.stallMs, updateStats.verifyMs);
+  logInfo("Received as %s, %u copies per byte", updateStats.receiveMode, updateStats.copies);
+  logInfo("Chunks: %u, latency p50 <= %u us, p99 <= %u us, max %u us",
+          updateStats.chunks, updateStats.chunkP50Us, updateStats.chunkP99Us, updateStats.chunkMaxUs);
+  logInfo("Buffer waits: p50 <= %u us, p99 <= %u us, max %u us",
+          updateStats.stallP50Us, updateStats.stallP99Us, updateStats.stallMaxUs);
+}
+
+// Device information as JSON. Browsers asking for HTML get a small page that
+// renders the same data.
+void AViShaOTA::handleInfo() {
+  if (server->header("Accept").indexOf("text/html") >= 0) {
+    server->send_P(200, "text/html", getInfoHTML());
+    return;
+  }
+
+  server->sendHeader("Cache-Control", "no-store");
+  server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server->send(200, "application/json", "");
+
+  ChunkedResponse out(server);
+  writeSystemInfo(out);
+  out.send();
+  server->sendContent("");
+}
+
+String AViShaOTA::getSystemInfo() {
+  StreamString info;
+  writeSystemInfo(info);
+  return info;
+}
+
+const char* AViShaOTA::getInfoHTML() {
+  return AVISHA_OTA_INFO_HTML;
+}
+
+String AViShaOTA::getInfoURL() {
+  return "http://" + getLocalIP() + ":" + String(serverPort) + "/info";
+}
+
+String AViShaOTA::getChipID() {
+  char id[13];
+  snprintf(id, sizeof(id), "%012llx", (unsigned long long)ESP.getEfuseMac());
+  return id;
+}
+
+String AViShaOTA::getMACAddress() {
+  return WiFi.macAddress();
+}
+
+uint32_t AViShaOTA::getFreeHeap() {
+  return ESP.getFreeHeap();
+}
+
+uint32_t AViShaOTA::getFlashChipSize() {
+  return ESP.getFlashChipSize();
+}
+
+String AViShaOTA::getSketchMD5() {
+  cacheSketchInfo();
+  return sketchMD5;
+}
+
+// Both read the whole app partition, so they are worked out once per boot
+void AViShaOTA::cacheSketchInfo() {
+  if (sketchMD5[0]) {
+    return;
+  }
+  sketchSize = ESP.getSketchSize();
+  strncpy(sketchMD5, ESP.getSketchMD5().c_str(), sizeof(sketchMD5) - 1);
+  sketchMD5[sizeof(sketchMD5) - 1] = '\0';
+}
+
+// Writes the info object piecewise through a small stack buffer, nothing is
+// allocated per request once the sketch values are cached
+void AViShaOTA::writeSystemInfo(Print& out) {
+  cacheSketchInfo();
+
+  uint8_t mac[6];
+  WiFi.macAddress(mac);
+  IPAddress ip = WiFi.localIP();
+  const esp_partition_t* running = esp_ota_get_running_partition();
+  const esp_partition_t* boot = esp_ota_get_boot_partition();
+
+  writeJson(out, "{\"library\":\"AViSha OTA\",\"version\":\"%s\",\"hostname\":", AVISHA_OTA_VERSION);
+  writeJsonString(out, hostname.c_str());
+  writeJson(out, ",\"firmware_version\":");
+  writeJsonString(out, firmwareVersion.c_str());
+  writeJson(out, ",\"chip_id\":\"%012llx\",\"chip_revision\":%u,\"cpu_mhz\":%u,\"sdk\":\"%s\"",
+            (unsigned long long)ESP.getEfuseMac(), ESP.getChipRevision(),
+            (unsigned)ESP.getCpuFreqMHz(), ESP.getSdkVersion());
+  writeJson(out, ",\"mac\":\"%02x:%02x:%02x:%02x:%02x:%02x\",\"ip\":\"%u.%u.%u.%u\",\"rssi\":%d",
+            mac[0], mac[1], mac[2], mac[3], mac[4], mac[5], ip[0], ip[1], ip[2], ip[3], WiFi.RSSI());
+  writeJson(out, ",\"connect\":{\"fast\":%s,\"ms\":%lu}", fastConnected ? "true" : "false", connectTime);
+  writeJson(out, ",\"heap\":{\"free\":%u,\"min_free\":%u,\"max_alloc\":%u}",
+            ESP.getFreeHeap(), ESP.getMinFreeHeap(), ESP.getMaxAllocHeap());
+  writeJson(out, ",\"flash_size\":%u,\"sketch\":{\"size\":%u,\"free\":%u,\"md5\":\"%s\"}",
+            ESP.getFlashChipSize(), sketchSize, ESP.getFreeSketchSpace(), sketchMD5);
+  writeJson(out, ",\"reset_reason\":\"%s\",\"uptime\":%lu",
+            AViShaOTAUtils::resetReasonName(esp_reset_reason()), (millis() - startTime) / 1000);
+
+  writeJson(out, ",\"config\":{\"load_us\":%lu,\"writes\":%u}", configLoadUs, (unsigned)configWrites);
+
+  writeJson(out, ",\"rollback\":{\"pending\":%s,\"last_reason\":\"%s\",\"recovery_ms\":%u}",
+            rollbackPending ? "true" : "false", getRollbackReasonName(getLastRollbackReason()),
+            (unsigned)getLastRecoveryMs());
+
+  writeJson(out, ",\"partitions\":[");
+  bool first = true;
+  for (uint8_t type = ESP_PARTITION_TYPE_APP; type <= ESP_PARTITION_TYPE_DATA; type++) {
+    esp_partition_iterator_t it = esp_partition_find((esp_partition_type_t)type, ESP_PARTITION_SUBTYPE_ANY, nullptr);
+    for (; it; it = esp_partition_next(it)) {
+      const esp_partition_t* partition = esp_partition_get(it);
+      writeJson(out, "%s{\"label\":\"%s\",\"type\":\"%s\",\"subtype\":%u,\"address\":%u,\"size\":%u",
+                first ? "" : ",", partition->label, type == ESP_PARTITION_TYPE_APP ? "app" : "data",
+                partition->subtype, partition->address, partition->size);
+      writeJson(out, ",\"running\":%s,\"boot\":%s}",
+                running && partition->address == running->address ? "true" : "false",
+                boot && partition->address == boot->address ? "true" : "false");
+      first = false;
+    }
+    esp_partition_iterator_release(it);
+  }
+  writeJson(out, "]}");
+}
+
+// Prometheus text exposition, streamed in chunks
+void AViShaOTA::handleMetrics() {
+  server->sendHeader("Cache-Control", "no-store");
+  server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server->send(200, "text/plain; version=0.0.4", "");
+
+  ChunkedResponse out(server);
+  writeMetrics(out);
+  out.send();
+  server->sendContent("");
+}
+
+void AViShaOTA::writeMetrics(Print& out) {
+  // A consistent copy, the pipeline may be filling it in on another task
+  UpdateStats stats = getLastUpdateStats();
+  AViShaOTAMetrics::writeHeader(out, "avisha_ota_received_bytes_total", "counter",
+                                "Firmware bytes received over all update paths");
+  AViShaOTAMetrics::writeValue(out, "avisha_ota_received_bytes_total", metrics.receivedBytes);
+
+  AViShaOTAMetrics::writeHeader(out, "avisha_ota_updates_total", "counter", "Finished updates by result");
+  AViShaOTAMetrics::writeValue(out, "avisha_ota_updates_total", metrics.updatesSucceeded, "{result=\"success\"}");
+  AViShaOTAMetrics::writeValue(out, "avisha_ota_updates_total", metrics.updatesFailed, "{result=\"failure\"}");
+
+  AViShaOTAMetrics::writeHeader(out, "avisha_ota_update_throughput_bytes_per_second", "gauge",
+                                "Flash throughput of the last streamed update");
+  AViShaOTAMetrics::writeValue(out, "avisha_ota_update_throughput_bytes_per_second",
+                               stats.durationMs ? (uint64_t)stats.writtenBytes * 1000 / stats.durationMs : 0);
+
+  AViShaOTAMetrics::writeHeader(out, "avisha_ota_update_heap_min_free_bytes", "gauge",
+                                "Lowest free heap seen during the last streamed update");
+  AViShaOTAMetrics::writeValue(out, "avisha_ota_update_heap_min_free_bytes", stats.minFreeHeap);
+
+  metrics.flashWrite.write(out, "avisha_ota_flash_write_seconds", "Latency of each flash write call");
+  metrics.handleTime.write(out, "avisha_ota_handle_seconds", "Duration of handle() calls");
+  metrics.chunkTime.write(out, "avisha_ota_chunk_seconds", "Time each received upload chunk spent in the pipeline");
+
+  AViShaOTAMetrics::writeHeader(out, "avisha_ota_auth_failures_total", "counter", "Rejected update or log requests");
+  AViShaOTAMetrics::writeValue(out, "avisha_ota_auth_failures_total", authFailures);
+
+  AViShaOTAMetrics::writeHeader(out, "avisha_ota_wifi_reconnects_total", "counter", "WiFi connections regained after a loss");
+  AViShaOTAMetrics::writeValue(out, "avisha_ota_wifi_reconnects_total", metrics.wifiReconnects);
+
+  AViShaOTAMetrics::writeHeader(out, "avisha_ota_heap_free_bytes", "gauge", "Free heap");
+  AViShaOTAMetrics::writeValue(out, "avisha_ota_heap_free_bytes", ESP.getFreeHeap());
+  AViShaOTAMetrics::writeHeader(out, "avisha_ota_heap_min_free_bytes", "gauge", "Lowest free heap since boot");
+  AViShaOTAMetrics::writeValue(out, "avisha_ota_heap_min_free_bytes", ESP.getMinFreeHeap());
+
+  AViShaOTAMetrics::writeHeader(out, "avisha_ota_uptime_seconds", "gauge", "Time since begin()");
+  AViShaOTAMetrics::writeValue(out, "avisha_ota_uptime_seconds", (millis() - startTime) / 1000);
+}
+
+// Log records since ?since=<seq>, one "seq millis level message" line each.
+// X-Log-Next is the sequence number to ask for next time.
+void AViShaOTA::handleLog() {
+  if (!authorizeUpload()) {
+    authFailures++;
+    server->send(401, "text/plain", "Authentication failed");
+    return;
+  }
+
+  uint32_t next = logger.next();
+  uint32_t seq = logger.first();
+  if (server->hasArg("since")) {
+    seq = max(seq, (uint32_t)strtoul(server->arg("since").c_str(), nullptr, 10));
+  }
+
+  server->sendHeader("Cache-Control", "no-store");
+  server->sendHeader("X-Log-Next", String(next));
+  server->sendHeader("X-Log-Dropped", String(logger.getDropped()));
+  server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server->send(200, "text/plain", "");
+
+  ChunkedResponse out(server);
+  writeLog(out, seq, next);
+  out.send();
+  server->sendContent("");
+}
+
+void AViShaOTA::writeLog(Print& out, uint32_t seq, uint32_t next) {
+  static const char levels[] = "EWID";
+  char line[AVISHA_OTA_LOG_LINE + 32];
+  for (; seq < next; seq++) {
+    AViShaOTALog::Record record;
+    if (!logger.read(seq, record)) {
+      continue;
+    }
+    size_t len = snprintf(line, sizeof(line), "%u %u %c ", seq, record.time, levels[record.level & 3]);
+    len += AViShaOTALog::format(record, line + len, sizeof(line) - len - 1);
+    line[len++] = '\n';
+    out.write((const uint8_t*)line, len);
+  }
+}
+
+// Hex HMAC-SHA256(password, nonce) for a 32 character nonce
+void AViShaOTA::authDigest(const char* nonce, char* out) {
+  uint8_t digest[32];
+  mbedtls_md_hmac(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256),
+                  (const uint8_t*)otaPassword.c_str(), otaPassword.length(),
+                  (const uint8_t*)nonce, 32, digest);
+  for (uint8_t j = 0; j < sizeof(digest); j++) {
+    snprintf(out + j * 2, 3, "%02x", digest[j]);
+  }
+}
+
+// Keyed by purpose, so a MAC made for one message type is never accepted
+// as another, in particular not as X-OTA-Auth or a push response
+void AViShaOTA::authDigest(const char* purpose, const String& message, char* out) {
+  String input = String(purpose) + message;
+  uint8_t digest[32];
+  mbedtls_md_hmac(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256),
+                  (const uint8_t*)otaPassword.c_str(), otaPassword.length(),
+                  (const uint8_t*)input.c_str(), input.length(), digest);
+  for (uint8_t j = 0; j < sizeof(digest); j++) {
+    snprintf(out + j * 2, 3, "%02x", digest[j]);
+  }
+}
+
+void AViShaOTA::logMessage(const String& message) {
+  logger.write(AViShaOTALog::LEVEL_INFO, "%s", message.c_str());
+}
+
+void AViShaOTA::logError(const String& error) {
+  logger.write(AViShaOTALog::LEVEL_ERROR, "%s", error.c_str());
+}
+
+void AViShaOTA::logError(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  logger.vwrite(AViShaOTALog::LEVEL_ERROR, format, args);
+  va_end(args);
+}
+
+void AViShaOTA::logWarning(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  logger.vwrite(AViShaOTALog::LEVEL_WARN, format, args);
+  va_end(args);
+}
+
+void AViShaOTA::logInfo(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  logger.vwrite(AViShaOTALog::LEVEL_INFO, format, args);
+  va_end(args);
+}
+
+void AViShaOTA::logDebug(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  logger.vwrite(AViShaOTALog::LEVEL_DEBUG, format, args);
+  va_end(args);
+}
+
+// Print queued log records, but never while an update is writing flash
+void AViShaOTA::drainLog() {
+  if (!serialDebug) {
+    logger.skip();
+    return;
+  }
+  if (isUpdating()) {
+    return;
+  }
+  logger.drain(Serial, AVISHA_OTA_LOG_DRAIN);
+}
+
+bool AViShaOTA::validatePassword(const String& password) {
+  if (password.length() != otaPassword.length()) {
+    return false;
+  }
+  return constantTimeEquals(password.c_str(), otaPassword.c_str(), password.length());
+}
+
+bool AViShaOTA::constantTimeEquals(const char* a, const char* b, size_t len) {
+  uint8_t diff = 0;
+  for (size_t i = 0; i < len; i++) {
+    diff |= (uint8_t)a[i] ^ (uint8_t)b[i];
+  }
+  return diff == 0;
+}
+
+// Pull mode: poll a JSON manifest and stream a newer image straight to flash.
+// Manifest fields: version, url (absolute or relative to the manifest),
+// size, sha256, md5, encoding, delta. The version is compared with
+// setFirmwareVersion(), or else the md5 of a full image with the sketch.
+void AViShaOTA::setPullURL(const String& manifestURL, unsigned long interval) {
+  this->pullURL = manifestURL;
+  this->pullInterval = interval;
+  this->pullETag = "";
+  this->lastPullCheck = millis() - interval; // Check on the next handle()
+}
+
+void AViShaOTA::setReceiveBuffer(size_t size) {
+  // Room for the longest multipart delimiter, in whole words
+  if (size > 0 && size < 1024) {
+    size = 1024;
+  }
+  this->receiveBufferSize = (size + 3) & ~(size_t)3;
+}
+
+void AViShaOTA::setFirmwareVersion(const String& version) {
+  this->firmwareVersion = version;
+}
+
+bool AViShaOTA::checkForUpdate() {
+  if (pullURL.length() == 0 || WiFi.status() != WL_CONNECTED || isUpdating()) {
+    return false;
+  }
+  lastPullCheck = millis();
+  return checkManifest(pullURL, pullETag);
+}
+
+// Fetches a manifest and installs the image it names when that is new
+bool AViShaOTA::checkManifest(const String& manifestURL, String& etag) {
+  HTTPClient http;
+  static const char* headerKeys[] = {"ETag"};
+  if (!http.begin(manifestURL)) {
+    return false;
+  }
+  http.collectHeaders(headerKeys, 1);
+  if (etag.length() > 0) {
+    http.addHeader("If-None-Match", etag);
+  }
+
+  int code = http.GET();
+  if (code == HTTP_CODE_NOT_MODIFIED) {
+    http.end();
+    return false;
+  }
+  if (code != HTTP_CODE_OK) {
+    logError("Manifest request failed: %d", code);
+    http.end();
+    return false;
+  }
+
+  String manifest = http.getString();
+  String manifestETag = http.header("ETag");
+  http.end();
+
+  String version = AViShaOTAUtils::jsonValue(manifest, "version");
+  String url = AViShaOTAUtils::jsonValue(manifest, "url");
+  ImageOptions options;
+  options.encoding = AViShaOTAUtils::jsonValue(manifest, "encoding");
+  options.delta = AViShaOTAUtils::jsonValue(manifest, "delta") == "true";
+  options.md5 = AViShaOTAUtils::jsonValue(manifest, "md5");
+  options.sha256 = AViShaOTAUtils::jsonValue(manifest, "sha256");
+
+  // Remember the manifest even if it names the image we already run
+  etag = manifestETag;
+  if (url.length() == 0) {
+    return false;
+  }
+  // Only an image that can be told apart from the running one is installed,
+  // otherwise the same image would be pulled again after every restart
+  bool byVersion = firmwareVersion.length() > 0 && version.length() > 0;
+  bool byMD5 = !options.delta && options.md5.length() > 0;
+  if (!byVersion && !byMD5) {
+    logWarning("Manifest has no version or md5 to compare with the running image, not installing");
+    return false;
+  }
+  if (byVersion ? version == firmwareVersion : options.md5.equalsIgnoreCase(getSketchMD5())) {
+    return false;
+  }
+
+  // Relative image URLs are resolved against the manifest location
+  if (url.indexOf("://") < 0) {
+    int schemeEnd = manifestURL.indexOf("://");
+    if (url.startsWith("/")) {
+      int hostEnd = manifestURL.indexOf('/', schemeEnd >= 0 ? schemeEnd + 3 : 0);
+      url = (hostEnd >= 0 ? manifestURL.substring(0, hostEnd) : manifestURL) + url;
+    } else {
+      int lastSlash = manifestURL.lastIndexOf('/');
+      url = manifestURL.substring(0, lastSlash + 1) + url;
+    }
+  }
+
+  logInfo("Pulling firmware %s from %s", version.c_str(), url.c_str());
+
+  bool success = pullImage(url, options, AViShaOTAUtils::jsonValue(manifest, "size").toInt(),
+                           AViShaOTAEvent::SOURCE_PULL);
+  if (!success) {
+    // Retry the same manifest on the next check
+    etag = "";
+    return false;
+  }
+
+  logInfo("Pull update successful! Restarting...");
+  delay(1000);
+  ESP.restart();
+  return true;
+}
+
+bool AViShaOTA::pullImage(const String& url, const ImageOptions& options, size_t expectedSize,
+                          AViShaOTAEvent::Source source, const String& auth) {
+  HTTPClient http;
+  if (!http.begin(url)) {
+    emitError(source, OTA_CONNECT_ERROR);
+    return false;
+  }
+  if (auth.length() > 0) {
+    http.addHeader("X-OTA-Auth", auth);
+  }
+  // The body is read raw below; a chunked reply would put its chunk
+  // headers into the image
+  http.useHTTP10(true);
+
+  int code = http.GET();
+  if (code != HTTP_CODE_OK) {
+    logError("Image request failed: %d", code);
+    http.end();
+    emitError(source, OTA_CONNECT_ERROR);
+    return false;
+  }
+
+  int contentLength = http.getSize();
+  size_t total = contentLength > 0 ? (size_t)contentLength : expectedSize;
+  if ((expectedSize > 0 && contentLength > 0 && (size_t)contentLength != expectedSize) ||
+      !imageFits(total, 0, false)) {
+    logError("Image of %u bytes rejected, %u fit", (unsigned)total, ESP.getFreeSketchSpace());
+    http.end();
+    emitError(source, OTA_BEGIN_ERROR);
+    return false;
+  }
+
+  // Taken only now: fetching the manifest and headers leaves the pipeline alone
+  if (!claimUpdate(source)) {
+    logWarning("Pull skipped, another update is in progress");
+    http.end();
+    return false;
+  }
+  emit(AViShaOTAEvent::UPDATE_START, source);
+
+  ImageOptions sized = options;
+  sized.size = total;
+  if (!beginImage(sized)) {
+    releaseUpdate(source);
+    http.end();
+    emitError(source, OTA_BEGIN_ERROR);
+    return false;
+  }
+
+  // Stream from the socket into the update pipeline, nothing is buffered
+  WiFiClient* stream = http.getStreamPtr();
+  uint8_t buffer[1024];
+  size_t received = 0;
+  bool ok = true;
+
+  // Without a length the body ends when the server closes, HTTP/1.0 style.
+  // A stalled server is given up on after AVISHA_OTA_RECEIVE_TIMEOUT of
+  // silence, a slow one once the whole transfer passes uploadTimeout.
+  unsigned long transferStart = millis();
+  while (ok && (total == 0 || received < total)) {
+    unsigned long elapsed = millis() - transferStart;
+    if (elapsed >= currentConfig.uploadTimeout) {
+      logError("Image download took longer than %lu ms", currentConfig.uploadTimeout);
+      ok = false;
+      break;
+    }
+    unsigned long remaining = currentConfig.uploadTimeout - elapsed;
+    if (!waitForData(*stream, min((unsigned long)AVISHA_OTA_RECEIVE_TIMEOUT, remaining))) {
+      break;
+    }
+    size_t n = stream->readBytes(buffer, min((size_t)stream->available(), sizeof(buffer)));
+    received += n;
+    ok = writeImage(buffer, n);
+    if (ok) {
+      events.progress(source, received, total);
+    }
+  }
+  http.end();
+
+  if (!ok || (total > 0 && received != total)) {
+    abortImage();
+    releaseUpdate(source);
+    emitError(source, OTA_RECEIVE_ERROR);
+    return false;
+  }
+
+  if (!endImage()) {
+    releaseUpdate(source);
+    emitError(source, OTA_END_ERROR);
+    return false;
+  }
+
+  // The claim stays until the caller restarts
+  emit(AViShaOTAEvent::UPDATE_END, source);
+  return true;
+}
+
+// Peer sharing: a device serves the image it booted from, straight out of the
+// OTA slot it was written to, and pulls newer images from peers found over
+// mDNS. Each updated device becomes a source, so a rollout fans out.
+void AViShaOTA::enablePeerShare(bool enable, unsigned long interval) {
+  this->peerShare = enable;
+  this->peerInterval = interval;
+  // Spread the first query so a fleet powered on together does not collide
+  this->lastPeerCheck = millis() - (interval ? esp_random() % interval : 0);
+  if (enable) {
+    loadPeerImage();
+  }
+}
+
+bool AViShaOTA::checkPeers() {
+  if (!peerShare || !mdnsEnabled || firmwareVersion.length() == 0 ||
+      WiFi.status() != WL_CONNECTED || isUpdating()) {
+    return false;
+  }
+  lastPeerCheck = millis();
+  // Any device on the network can announce itself, so only images that
+  // carry a valid signature are taken from peers
+  if (!signatureRequired) {
+    logDebug("Peer pulls need signed images, set Config::signingKey");
+    return false;
+  }
+
+  // Pick a random peer among those with a newer image to spread the load
+  int found = MDNS.queryService(AVISHA_OTA_PEER_SERVICE, "tcp");
+  int candidate = -1;
+  int candidates = 0;
+  String bestVersion = firmwareVersion;
+  for (int i = 0; i < found; i++) {
+    String version = MDNS.txt(i, "fw");
+    int order = AViShaOTAUtils::compareVersions(version, bestVersion);
+    if (order > 0) {
+      bestVersion = version;
+      candidate = i;
+      candidates = 1;
+    } else if (order == 0 && candidate >= 0 && esp_random() % ++candidates == 0) {
+      candidate = i;
+    }
+  }
+  if (candidate < 0) {
+    return false;
+  }
 
-    if (serialDebug) {
-      Serial.printf("Web Update Progress: %d%%\r", (Update.progress() * 100) / Update.size());
+  String base = "http://" + MDNS.IP(candidate).toString() + ":" + String(MDNS.port(candidate));
+  logInfo("Peer %s offers firmware %s", MDNS.hostname(candidate).c_str(), bestVersion.c_str());
+
+  HTTPClient http;
+  if (!http.begin(base + "/peer/manifest")) {
+    return false;
+  }
+  int code = http.GET();
+  String manifest = code == HTTP_CODE_OK ? http.getString() : String();
+  http.end();
+  if (AViShaOTAUtils::jsonValue(manifest, "version") != bestVersion) {
+    return false;
+  }
+
+  ImageOptions options;
+  options.sha256 = AViShaOTAUtils::jsonValue(manifest, "sha256");
+  size_t size = AViShaOTAUtils::jsonValue(manifest, "size").toInt();
+
+  // The peer appends its stored signature, pullImage() verifies it
+  if (AViShaOTAUtils::jsonValue(manifest, "signed") != "true") {
+    return false;
+  }
+  String url = base + "/peer/image?signature=1";
+  size += AVISHA_OTA_SIGNATURE_SIZE;
+
+  // Fleet devices share the OTA password and answer the same nonce
+  // challenge, with a MAC /update does not accept: a peer relaying another
+  // device's nonce gets nothing it can upload with
+  String auth;
+  if (otaPassword.length() > 0) {
+    if (!http.begin(base + "/auth")) {
+      return false;
+    }
+    String nonce = http.GET() == HTTP_CODE_OK ? http.getString() : String();
+    http.end();
+    if (nonce.length() != 32) {
+      return false;
     }
+    char mac[65];
+    authDigest(AVISHA_OTA_PEER_AUTH, nonce, mac);
+    auth = nonce + ":" + mac;
   }
-  else if (upload.status == UPLOAD_FILE_END) {
-    if (!passwordChecked || !passwordValid) {
+
+  if (!pullImage(url, options, size, AViShaOTAEvent::SOURCE_PEER, auth)) {
+    return false;
+  }
+
+  logInfo("Peer update successful! Restarting...");
+  delay(1000);
+  ESP.restart();
+  return true;
+}
+
+void AViShaOTA::handlePeerManifest() {
+  if (!peerImageReady()) {
+    server->send(404, "text/plain", "No image to share");
+    return;
+  }
+
+  server->sendHeader("Cache-Control", "no-store");
+  server->send(200, "application/json", peerManifest());
+}
+
+String AViShaOTA::peerManifest() {
+  char digest[65];
+  for (uint8_t i = 0; i < sizeof(peerImage.sha256); i++) {
+    snprintf(digest + i * 2, 3, "%02x", peerImage.sha256[i]);
+  }
+  return "{\"version\":\"" + firmwareVersion + "\",\"size\":" + String(peerImage.size) +
+         ",\"sha256\":\"" + digest + "\",\"signed\":" +
+         (peerImage.hasSignature ? "true" : "false") + "}";
+}
+
+void AViShaOTA::handlePeerImage() {
+  if (!peerImageReady()) {
+    server->send(404, "text/plain", "No image to share");
+    return;
+  }
+  if (!authorizePeer(server->header("X-OTA-Auth"))) {
+    authFailures++;
+    server->send(401, "text/plain", "Authentication failed");
+    return;
+  }
+
+  bool withSignature = server->arg("signature") == "1";
+  if (withSignature && !peerImage.hasSignature) {
+    server->send(404, "text/plain", "Image is not signed");
+    return;
+  }
+
+  const esp_partition_t* partition = esp_ota_get_running_partition();
+  size_t total = peerImage.size + (withSignature ? AVISHA_OTA_SIGNATURE_SIZE : 0);
+  server->setContentLength(total);
+  server->send(200, "application/octet-stream", "");
+
+  WiFiClient client = server->client();
+  uint8_t buffer[1024];
+  for (size_t offset = 0; offset < peerImage.size; ) {
+    size_t n = min(sizeof(buffer), (size_t)peerImage.size - offset);
+    if (esp_partition_read(partition, offset, buffer, n) != ESP_OK ||
+        client.write(buffer, n) != n) {
+      logWarning("Peer transfer aborted");
+      client.stop();
       return;
     }
-    
-    if (Update.end(true)) {
-      if (serialDebug) {
-        Serial.printf("\nWeb Update Success: %u bytes\n", upload.totalSize);
+    offset += n;
+  }
+  if (withSignature) {
+    client.write(peerImage.signature, sizeof(peerImage.signature));
+  }
+}
+
+// Only an image that has booted is shared, a staged one may never start
+bool AViShaOTA::peerImageReady() {
+  const esp_partition_t* running = esp_ota_get_running_partition();
+  return peerShare && firmwareVersion.length() > 0 && peerImage.version == 1 &&
+         running && running->address == peerImage.partition;
+}
+
+void AViShaOTA::loadPeerImage() {
+  Preferences prefs;
+  if (prefs.begin(AVISHA_OTA_PREFS_NAMESPACE, true)) {
+    if (prefs.getBytes("peer", &peerImage, sizeof(peerImage)) != sizeof(peerImage)) {
+      peerImage.version = 0;
+    }
+    prefs.end();
+  }
+}
+
+// Remember what was written to the update slot so it can be served after reboot
+void AViShaOTA::savePeerImage(const esp_partition_t* partition, uint32_t size) {
+  if (!peerShare || !partition || !imageDigestValid) {
+    return;
+  }
+  peerImage.version = 1;
+  peerImage.partition = partition->address;
+  peerImage.size = size;
+  memcpy(peerImage.sha256, imageDigest, sizeof(peerImage.sha256));
+  peerImage.hasSignature = signatureRequired && updateStats.signatureValid;
+  if (peerImage.hasSignature) {
+    memcpy(peerImage.signature, signatureTail, sizeof(peerImage.signature));
+  }
+
+  Preferences prefs;
+  if (prefs.begin(AVISHA_OTA_PREFS_NAMESPACE, false)) {
+    prefs.putBytes("peer", &peerImage, sizeof(peerImage));
+    prefs.end();
+  }
+}
+
+// Update pipeline: upload -> codec (optional) -> delta patcher (optional) -> Update.write()
+bool AViShaOTA::addCodec(Codec* codec) {
+  if (!codec || codecCount >= AVISHA_OTA_MAX_CODECS) {
+    return false;
+  }
+  codec->owner = this;
+  codecs[codecCount++] = codec;
+  return true;
+}
+
+AViShaOTA::UpdateStats AViShaOTA::getLastUpdateStats() {
+  // Copied under the lock, the service task may be starting an update
+  portENTER_CRITICAL(&stateLock);
+  UpdateStats stats = updateStats;
+  portEXIT_CRITICAL(&stateLock);
+  return stats;
+}
+
+bool AViShaOTA::Codec::output(const uint8_t* data, size_t len) {
+  if (next) {
+    return next->write(data, len);
+  }
+  return owner && owner->writeFirmware(data, len);
+}
+
+bool AViShaOTA::beginImage(const ImageOptions& options) {
+  activeCodec = nullptr;
+  headStage = nullptr;
+  codecSelected = false;
+  imageOptions = options;
+  flashPartition = nullptr;
+  uint32_t freeHeap = ESP.getFreeHeap();
+  portENTER_CRITICAL(&stateLock);
+  updateStats = UpdateStats();
+  updateStats.delta = options.delta;
+  updateStats.minFreeHeap = freeHeap;
+  portEXIT_CRITICAL(&stateLock);
+  metrics.updateChunkTime.reset();
+  metrics.updateStall.reset();
+  updateStartTime = millis();
+
+  // A patch applied to the wrong base must never be activated
+  if (options.delta && options.md5.length() != 32) {
+    logError("Delta update requires the md5 of the resulting image");
+    return false;
+  }
+
+  // The digest is computed over the final image as it is written
+  hashing = false;
+  checkDigest = options.sha256.length() > 0;
+  hashMicros = 0;
+  signatureTailLen = 0;
+  if (checkDigest && !AViShaOTAUtils::parseHex(options.sha256, expectedDigest, sizeof(expectedDigest))) {
+    logError("Invalid sha256, expected 64 hex digits");
+    return false;
+  }
+  imageDigestValid = false;
+  if (checkDigest || signatureRequired || peerShare) {
+    mbedtls_sha256_starts(&imageHash, 0);
+    hashing = true;
+  }
+
+  // Update.begin() waits for the first chunk, see startFlash()
+  if (!esp_ota_get_next_update_partition(nullptr)) {
+    logError("No OTA partition to update");
+    return false;
+  }
+
+  // Fall back to inline writes if the buffers or task cannot be created
+  if (writeBufferCount > 0 && !writer->begin(writeBufferCount, writeBufferSize)) {
+    logWarning("Write buffers unavailable, writing inline");
+  }
+  imageActive = true;
+  return true;
+}
+
+// Checked before any data is accepted: declared is the image size the
+// client announced, 0 if unknown; a multipart body also carries the form
+bool AViShaOTA::imageFits(size_t declared, size_t bodyLength, bool multipart) {
+  size_t capacity = ESP.getFreeSketchSpace() + (signatureRequired ? AVISHA_OTA_SIGNATURE_SIZE : 0);
+  if (declared > 0) {
+    return declared <= capacity;
+  }
+  return bodyLength <= capacity + (multipart ? AVISHA_OTA_FORM_OVERHEAD : 0);
+}
+
+// Starts Update once the codec is known. A plain image's size is then exact,
+// so Update checks it against the slot up front, erases only the range the
+// image covers and refuses bytes past the announced end.
+bool AViShaOTA::startFlash() {
+  size_t tail = signatureRequired ? AVISHA_OTA_SIGNATURE_SIZE : 0;
+  size_t size = UPDATE_SIZE_UNKNOWN;
+  if (!headStage && imageOptions.size > tail) {
+    size = imageOptions.size - tail;
+  }
+  updateStats.presized = size != UPDATE_SIZE_UNKNOWN;
+
+  // With the size known the writer task erases the partition ahead of the
+  // data and writes it itself, Update would erase each sector on reaching it
+  if (updateStats.presized && writer->isActive()) {
+    const esp_partition_t* partition = esp_ota_get_next_update_partition(nullptr);
+    if (size > partition->size) {
+      logError("Image of %u bytes does not fit the %u byte partition", (unsigned)size,
+               (unsigned)partition->size);
+      return false;
+    }
+    if (writer->setPartition(partition, size, imageOptions.md5.length() > 0)) {
+      flashPartition = partition;
+      updateStats.preErased = true;
+      updateStats.copies--;
+      return true;
+    }
+  }
+
+  if (!Update.begin(size)) {
+    logError("Update.begin() failed: %s", Update.errorString());
+    return false;
+  }
+  if (imageOptions.md5.length() > 0 && !Update.setMD5(imageOptions.md5.c_str())) {
+    Update.abort();
+    return false;
+  }
+  return true;
+}
+
+// Every receive path hands its chunks over here; the time spent is what
+// the network side waits for before it can read the next one
+bool AViShaOTA::writeImage(const uint8_t* data, size_t len) {
+  unsigned long chunkStart = micros();
+  bool ok = feedImage(data, len);
+  uint32_t elapsed = micros() - chunkStart;
+  metrics.chunkTime.observe(elapsed);
+  metrics.updateChunkTime.observe(elapsed);
+  return ok;
+}
+
+bool AViShaOTA::feedImage(const uint8_t* data, size_t len) {
+  if (!codecSelected) {
+    if (!selectCodec(data, len) || !startFlash()) {
+      abortImage();
+      return false;
+    }
+  } else if (!flashPartition && Update.hasError()) {
+    return false;
+  }
+
+  updateStats.receivedBytes += len;
+  metrics.receivedBytes += len;
+  if (headStage) {
+    if (!headStage->write(data, len)) {
+      logError("%s: corrupt stream", activeCodec ? activeCodec->name() : headStage->name());
+      abortImage();
+      return false;
+    }
+    return true;
+  }
+  return writeFirmware(data, len);
+}
+
+// Strip the trailing signature off the image stream when signing is enforced
+bool AViShaOTA::writeFirmware(const uint8_t* data, size_t len) {
+  if (!signatureRequired) {
+    return commitFirmware(data, len);
+  }
+
+  if (signatureTailLen + len <= sizeof(signatureTail)) {
+    memcpy(signatureTail + signatureTailLen, data, len);
+    signatureTailLen += len;
+    return true;
+  }
+
+  size_t release = signatureTailLen + len - sizeof(signatureTail);
+  size_t fromTail = release < signatureTailLen ? release : signatureTailLen;
+  if (fromTail > 0 && !commitFirmware(signatureTail, fromTail)) {
+    return false;
+  }
+  memmove(signatureTail, signatureTail + fromTail, signatureTailLen - fromTail);
+  signatureTailLen -= fromTail;
+  release -= fromTail;
+
+  if (release > 0 && !commitFirmware(data, release)) {
+    return false;
+  }
+  memcpy(signatureTail + signatureTailLen, data + release, len - release);
+  signatureTailLen += len - release;
+  return true;
+}
+
+bool AViShaOTA::commitFirmware(const uint8_t* data, size_t len) {
+  hashFirmware(data, len);
+  if (writer->isActive()) {
+    if (!writer->write(data, len)) {
+      return false;
+    }
+  } else {
+    unsigned long writeStart = micros();
+    if (Update.write(const_cast<uint8_t*>(data), len) != len) {
+      return false;
+    }
+    metrics.flashWrite.observe(micros() - writeStart);
+  }
+  countFirmware(len);
+  return true;
+}
+
+// Data read straight into the writer's current buffer by receiveRaw()
+bool AViShaOTA::commitReserved(const uint8_t* data, size_t len) {
+  updateStats.receivedBytes += len;
+  metrics.receivedBytes += len;
+  hashFirmware(data, len);
+  if (!writer->commit(len)) {
+    return false;
+  }
+  countFirmware(len);
+  return true;
+}
+
+void AViShaOTA::hashFirmware(const uint8_t* data, size_t len) {
+  if (hashing) {
+    unsigned long hashStart = micros();
+    mbedtls_sha256_update(&imageHash, data, len);
+    hashMicros += micros() - hashStart;
+  }
+}
+
+void AViShaOTA::countFirmware(size_t len) {
+  updateStats.writtenBytes += len;
+
+  uint32_t freeHeap = ESP.getFreeHeap();
+  if (freeHeap < updateStats.minFreeHeap) {
+    updateStats.minFreeHeap = freeHeap;
+  }
+}
+
+bool AViShaOTA::endImage() {
+  imageActive = false;
+  // Flush each stage in order, the codec may still feed the patcher
+  for (Codec* stage = headStage; stage; stage = stage->next) {
+    if (!stage->end()) {
+      logError("%s: truncated stream or checksum mismatch", stage->name());
+      for (Codec* rest = stage->next; rest; rest = rest->next) {
+        rest->abort();
       }
-    } else {
-      if (serialDebug) {
-        Serial.println("Update.end() failed:");
-        Update.printError(Serial);
+      headStage = nullptr;
+      activeCodec = nullptr;
+      stopWriter(false);
+      flashPartition = nullptr;
+      Update.abort();
+      finishStats(false);
+      return false;
+    }
+  }
+  headStage = nullptr;
+  activeCodec = nullptr;
+
+  if (!stopWriter(true) || !verifyImage()) {
+    flashPartition = nullptr;
+    Update.abort();
+    finishStats(false);
+    return false;
+  }
+
+  const esp_partition_t* partition = esp_ota_get_next_update_partition(nullptr);
+  bool success = flashPartition ? finishPartition() : Update.end(true);
+  finishStats(success);
+  if (success) {
+    savePeerImage(partition, updateStats.writtenBytes);
+  }
+  return success;
+}
+
+void AViShaOTA::abortImage() {
+  if (!imageActive) {
+    return;
+  }
+  imageActive = false;
+  for (Codec* stage = headStage; stage; stage = stage->next) {
+    stage->abort();
+  }
+  headStage = nullptr;
+  activeCodec = nullptr;
+  stopWriter(false);
+  flashPartition = nullptr;
+  hashing = false;
+  Update.abort();
+  finishStats(false);
+}
+
+// What Update.end() does after its last write, for an image the writer
+// task wrote to the partition itself
+bool AViShaOTA::finishPartition() {
+  const esp_partition_t* partition = flashPartition;
+  flashPartition = nullptr;
+  if (imageOptions.md5.length() > 0 && !imageOptions.md5.equalsIgnoreCase(writer->getMD5())) {
+    logError("MD5 mismatch, image not activated");
+    return false;
+  }
+  // Setting the boot partition also validates the image
+  if (esp_ota_set_boot_partition(partition) != ESP_OK) {
+    logError("Image failed validation, not activated");
+    return false;
+  }
+  return true;
+}
+
+bool AViShaOTA::selectCodec(const uint8_t* data, size_t len) {
+  const String& encoding = imageOptions.encoding;
+  codecSelected = true;
+
+  if (encoding.length() > 0 && encoding != "raw" && encoding != "identity") {
+    for (uint8_t i = 0; i < codecCount; i++) {
+      if (encoding == codecs[i]->name()) {
+        activeCodec = codecs[i];
+        break;
+      }
+    }
+    if (!activeCodec) {
+      logError("Unsupported encoding: %s", encoding.c_str());
+      return false;
+    }
+  } else if (encoding.length() == 0) {
+    for (uint8_t i = 0; i < codecCount; i++) {
+      if (codecs[i]->detect(data, len)) {
+        activeCodec = codecs[i];
+        break;
       }
-      webUpdateInProgress = false;
     }
   }
-  else if (upload.status == UPLOAD_FILE_ABORTED) {
-    Update.end();
-    webUpdateInProgress = false;
-    if (serialDebug) {
-      Serial.println("Web Update was aborted");
+
+  // Chain the stages: codec -> patcher -> flash
+  Codec* patcher = imageOptions.delta ? builtinDelta : nullptr;
+  if (patcher && !patcher->begin()) {
+    logError("delta: running partition not found");
+    return false;
+  }
+  if (activeCodec) {
+    if (!activeCodec->begin()) {
+      logError("%s: not enough memory", activeCodec->name());
+      if (patcher) {
+        patcher->abort();
+      }
+      activeCodec = nullptr;
+      return false;
+    }
+    activeCodec->next = patcher;
+    updateStats.encoding = activeCodec->name();
+    headStage = activeCodec;
+  } else {
+    headStage = patcher;
+  }
+  return true;
+}
+
+// Drain (or drop) the queued buffers; Update must not be touched before this
+bool AViShaOTA::stopWriter(bool flush) {
+  if (!writer->isActive()) {
+    return true;
+  }
+  bool ok = true;
+  if (flush) {
+    ok = writer->finish();
+  } else {
+    writer->abort();
+  }
+  updateStats.flashBusyMs = writer->getBusyMs();
+  updateStats.stallMs = writer->getStallMs();
+  return ok;
+}
+
+// Check the streamed SHA-256 and the signature before activation
+bool AViShaOTA::verifyImage() {
+  if (!hashing) {
+    return true;
+  }
+  hashing = false;
+
+  unsigned long verifyStart = micros();
+  uint8_t digest[32];
+  mbedtls_sha256_finish(&imageHash, digest);
+  memcpy(imageDigest, digest, sizeof(imageDigest));
+  imageDigestValid = true;
+
+  bool ok = checkImageDigest(digest);
+  updateStats.verifyMs = (hashMicros + (micros() - verifyStart)) / 1000;
+  return ok;
+}
+
+// Compare against the expected digest and check the signature, if enabled
+bool AViShaOTA::checkImageDigest(const uint8_t* digest) {
+  bool ok = true;
+  if (checkDigest) {
+    if (constantTimeEquals((const char*)digest, (const char*)expectedDigest, sizeof(expectedDigest))) {
+      updateStats.verified = true;
+    } else {
+      logError("SHA-256 mismatch, image rejected");
+      ok = false;
+    }
+  }
+
+  if (ok && signatureRequired) {
+    mbedtls_ecp_keypair* key = mbedtls_pk_ec(signingKey);
+    mbedtls_mpi r, s;
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+
+    ok = key && signatureTailLen == sizeof(signatureTail) &&
+         mbedtls_mpi_read_binary(&r, signatureTail, 32) == 0 &&
+         mbedtls_mpi_read_binary(&s, signatureTail + 32, 32) == 0 &&
+         mbedtls_ecdsa_verify(&key->grp, digest, 32, &key->Q, &r, &s) == 0;
+
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&s);
+    updateStats.signatureValid = ok;
+    if (!ok) {
+      logError("Signature invalid, image rejected");
     }
   }
+  return ok;
+}
+
+void AViShaOTA::finishStats(bool success) {
+  unsigned long duration = millis() - updateStartTime;
+  const AViShaOTAHistogram& chunks = metrics.updateChunkTime;
+  uint32_t chunkP50 = chunks.quantile(0.5f);
+  uint32_t chunkP99 = chunks.quantile(0.99f);
+  const AViShaOTAHistogram& stalls = metrics.updateStall;
+  uint32_t stallP50 = stalls.quantile(0.5f);
+  uint32_t stallP99 = stalls.quantile(0.99f);
+  portENTER_CRITICAL(&stateLock);
+  updateStats.durationMs = duration;
+  updateStats.chunks = chunks.count();
+  updateStats.chunkP50Us = chunkP50;
+  updateStats.chunkP99Us = chunkP99;
+  updateStats.chunkMaxUs = chunks.peak();
+  updateStats.stallP50Us = stallP50;
+  updateStats.stallP99Us = stallP99;
+  updateStats.stallMaxUs = stalls.peak();
+  updateStats.success = success;
+  portEXIT_CRITICAL(&stateLock);
+  if (success) {
+    metrics.updatesSucceeded++;
+  } else {
+    metrics.updatesFailed++;
+  }
 }
 
 // Static WiFi event handler
@@ -447,28 +3573,21 @@ void AViShaOTA::wifiEventHandler(WiFiEvent_t event) {
 void AViShaOTA::handleWiFiEvent(WiFiEvent_t event) {
   switch (event) {
     case SYSTEM_EVENT_STA_DISCONNECTED:
-      if (serialDebug) {
-        Serial.println("WiFi disconnected, attempting to reconnect...");
-      }
-      if (onWiFiDisconnectedCallback) {
-        onWiFiDisconnectedCallback();
-      }
+      logWarning("WiFi disconnected, attempting to reconnect...");
+      metrics.wifiLost = true;
+      emit(AViShaOTAEvent::WIFI_DISCONNECTED);
       break;
     case SYSTEM_EVENT_STA_CONNECTED:
-      if (serialDebug) {
-        Serial.println("WiFi connected!");
-      }
+      logInfo("WiFi connected!");
       break;
     case SYSTEM_EVENT_STA_GOT_IP:
-      if (serialDebug) {
-        Serial.print("IP Address: ");
-        Serial.println(WiFi.localIP());
-        Serial.print("Upload URL: ");
-        Serial.println(getUploadURL());
-      }
-      if (onWiFiConnectedCallback) {
-        onWiFiConnectedCallback();
+      if (metrics.wifiLost) {
+        metrics.wifiReconnects++;
+        metrics.wifiLost = false;
       }
+      logInfo("IP Address: %s", WiFi.localIP().toString().c_str());
+      logInfo("Upload URL: %s", getUploadURL().c_str());
+      emit(AViShaOTAEvent::WIFI_CONNECTED);
       break;
     default:
       break;
@@ -492,263 +3611,121 @@ void AViShaOTA::restart() {
   ESP.restart();
 }
 
-// FIXED: Updated HTML with better password handling
+// Minified upload page, see extras/ui/upload.html
 const char* AViShaOTA::getUploadHTML() {
-  static const char* uploadHTML = R"(
-<!DOCTYPE html>
-<html lang="id">
-<head>
-  <meta charset="UTF-8" />
-  <meta name="viewport" content="width=device-width, initial-scale=1.0" />
-  <title>AViSha OTA Update</title>
-  <style>
-    body {
-      font-family: -apple-system, BlinkMacSystemFont, "Segoe UI", Roboto, Oxygen,
-        Ubuntu, Cantarell, "Open Sans", "Helvetica Neue", sans-serif;
-      margin: 0;
-      padding: 0;
-      background: #f2f2f7;
-    }
-
-    .container {
-      max-width: 400px;
-      margin: 80px auto;
-      background: #fff;
-      border-radius: 20px;
-      box-shadow: 0 8px 20px rgba(0, 0, 0, 0.08);
-      padding: 30px;
-      text-align: center;
-    }
-
-    h1 {
-      font-size: 24px;
-      margin-bottom: 10px;
-      color: #111;
-    }
-
-    p {
-      color: #555;
-      font-size: 14px;
-      margin-bottom: 20px;
-    }
-
-    .upload-area {
-      border: 2px dashed #d1d1d6;
-      border-radius: 12px;
-      padding: 30px 10px;
-      background-color: #fafafa;
-      transition: background 0.3s ease;
-    }
-
-    .upload-area:hover {
-      background: #f0f0f5;
-    }
+  return (const char*)AVISHA_OTA_UI;
+}
 
-    input[type="password"], input[type="file"] {
-      margin-top: 15px;
-      padding: 10px;
-      border: 1px solid #d1d1d6;
-      border-radius: 8px;
-      font-size: 14px;
-      width: 80%;
-      max-width: 250px;
-    }
-
-    input[type="file"] {
-      cursor: pointer;
-      padding: 8px;
-    }
-
-    button {
-      margin-top: 20px;
-      background-color: #007aff;
-      color: white;
-      border: none;
-      padding: 12px 24px;
-      font-size: 16px;
-      border-radius: 12px;
-      cursor: pointer;
-      transition: background 0.3s ease;
-      min-width: 150px;
-    }
-
-    button:hover:not(:disabled) {
-      background-color: #005ed9;
-    }
-
-    button:disabled {
-      background-color: #8e8e93;
-      cursor: not-allowed;
-    }
-
-    .progress {
-      width: 100%;
-      background-color: #e5e5ea;
-      border-radius: 12px;
-      margin-top: 25px;
-      height: 12px;
-      overflow: hidden;
-      display: none;
-    }
-
-    .progress-bar {
-      height: 100%;
-      width: 0%;
-      background-color: #34c759;
-      transition: width 0.3s ease;
-    }
-
-    #status {
-      margin-top: 25px;
-      font-size: 14px;
-      color: #333;
-    }
+// The page is only linked into this file, the async backend asks for it
+const uint8_t* AViShaOTA::getUploadPage(bool gzip, size_t& len) {
+  len = gzip ? AVISHA_OTA_UI_GZ_SIZE : AVISHA_OTA_UI_SIZE;
+  return gzip ? AVISHA_OTA_UI_GZ : AVISHA_OTA_UI;
+}
 
-    .status-success {
-      color: #28a745;
-    }
+const char* AViShaOTA::getUploadETag() {
+  return AVISHA_OTA_UI_ETAG;
+}
 
-    .status-error {
-      color: #ff3b30;
-    }
+// Global helper functions
+namespace AViShaOTAUtils {
 
-    .file-info {
-      margin-top: 10px;
-      font-size: 12px;
-      color: #666;
+// Decode exactly len bytes from a hex string
+bool parseHex(const String& hex, uint8_t* out, size_t len) {
+  if (hex.length() != len * 2) {
+    return false;
+  }
+  for (size_t i = 0; i < len * 2; i++) {
+    char c = hex[i];
+    uint8_t nibble;
+    if (c >= '0' && c <= '9') {
+      nibble = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      nibble = c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      nibble = c - 'A' + 10;
+    } else {
+      return false;
     }
-  </style>
-</head>
-<body>
-  <div class="container">
-    <h1>ESP32 OTA Update</h1>
-    <p>Select a .bin file to update your device's firmware.</p>
+    out[i / 2] = (i % 2) ? (out[i / 2] | nibble) : (nibble << 4);
+  }
+  return true;
+}
 
-    <div class="upload-area">
-      <form id="uploadForm" enctype="multipart/form-data">
-        <input type="password" name="password" id="passwordInput" placeholder="Enter OTA Password" />
-        <br />
-        <input type="file" name="update" id="fileInput" accept=".bin" required />
-        <div class="file-info" id="fileInfo"></div>
-        <br />
-        <button type="submit" id="uploadBtn">Upload and Update</button>
-      </form>
-    </div>
+// Value of a top-level "key" in a flat JSON object, without quotes.
+// Enough for small manifests, not a general JSON parser.
+String jsonValue(const String& json, const char* key) {
+  String pattern = String("\"") + key + "\"";
+  int pos = json.indexOf(pattern);
+  if (pos < 0) {
+    return "";
+  }
+  pos = json.indexOf(':', pos + pattern.length());
+  if (pos < 0) {
+    return "";
+  }
+  pos++;
+  while (pos < (int)json.length() && (json[pos] == ' ' || json[pos] == '\t' ||
+                                      json[pos] == '\r' || json[pos] == '\n')) {
+    pos++;
+  }
+  if (pos >= (int)json.length()) {
+    return "";
+  }
 
-    <div class="progress" id="progressContainer">
-      <div class="progress-bar" id="progressBar"></div>
-    </div>
+  if (json[pos] == '"') {
+    int end = json.indexOf('"', pos + 1);
+    return end < 0 ? "" : json.substring(pos + 1, end);
+  }
+  int end = pos;
+  while (end < (int)json.length() && json[end] != ',' && json[end] != '}' &&
+         json[end] != ' ' && json[end] != '\r' && json[end] != '\n') {
+    end++;
+  }
+  return json.substring(pos, end);
+}
 
-    <div id="status"></div>
-  </div>
-
-  <script>
-    const uploadForm = document.getElementById("uploadForm");
-    const fileInput = document.getElementById("fileInput");
-    const passwordInput = document.getElementById("passwordInput");
-    const progressContainer = document.getElementById("progressContainer");
-    const progressBar = document.getElementById("progressBar");
-    const status = document.getElementById("status");
-    const uploadBtn = document.getElementById("uploadBtn");
-    const fileInfo = document.getElementById("fileInfo");
+const char* resetReasonName(int reason) {
+  switch (reason) {
+    case ESP_RST_POWERON: return "power_on";
+    case ESP_RST_EXT: return "external";
+    case ESP_RST_SW: return "software";
+    case ESP_RST_PANIC: return "panic";
+    case ESP_RST_INT_WDT: return "interrupt_watchdog";
+    case ESP_RST_TASK_WDT: return "task_watchdog";
+    case ESP_RST_WDT: return "watchdog";
+    case ESP_RST_DEEPSLEEP: return "deep_sleep";
+    case ESP_RST_BROWNOUT: return "brownout";
+    case ESP_RST_SDIO: return "sdio";
+    default: return "unknown";
+  }
+}
 
-    fileInput.addEventListener("change", function() {
-      const file = this.files[0];
-      if (file) {
-        const sizeMB = (file.size / (1024 * 1024)).toFixed(2);
-        fileInfo.textContent = `File: ${file.name} (${sizeMB} MB)`;
-      } else {
-        fileInfo.textContent = "";
+// Dotted numeric version order, "1.10.0" > "1.9.2". Missing parts count as 0.
+int compareVersions(const String& a, const String& b) {
+  int i = 0;
+  int j = 0;
+  while (i < (int)a.length() || j < (int)b.length()) {
+    long x = 0;
+    long y = 0;
+    while (i < (int)a.length() && a[i] != '.') {
+      if (isdigit(a[i])) {
+        x = x * 10 + (a[i] - '0');
       }
-    });
-
-    uploadForm.addEventListener("submit", function (e) {
-      e.preventDefault();
-
-      const file = fileInput.files[0];
-      const password = passwordInput.value.trim();
-
-      if (!file || !file.name.endsWith(".bin")) {
-        alert("Please select a valid .bin file.");
-        return;
+      i++;
+    }
+    while (j < (int)b.length() && b[j] != '.') {
+      if (isdigit(b[j])) {
+        y = y * 10 + (b[j] - '0');
       }
+      j++;
+    }
+    if (x != y) {
+      return x < y ? -1 : 1;
+    }
+    i++;
+    j++;
+  }
+  return 0;
+}
 
-      // Create FormData and append fields in correct order
-      const formData = new FormData();
-      
-      // Add password first (if provided)
-      if (password) {
-        formData.append("password", password);
-      }
-      
-      // Then add the file
-      formData.append("update", file);
-
-      const xhr = new XMLHttpRequest();
-      
-      // Disable upload button
-      uploadBtn.disabled = true;
-      uploadBtn.textContent = "Uploading...";
-      progressContainer.style.display = "block";
-      status.innerHTML = "";
-
-      xhr.upload.addEventListener("progress", function (e) {
-        if (e.lengthComputable) {
-          const percent = Math.round((e.loaded / e.total) * 100);
-          progressBar.style.width = percent + "%";
-          status.innerHTML = `<p>Uploading: ${percent}%</p>`;
-        }
-      });
-
-      xhr.addEventListener("load", function () {
-        uploadBtn.disabled = false;
-        uploadBtn.textContent = "Upload and Update";
-        
-        if (xhr.status === 200) {
-          progressBar.style.width = "100%";
-          status.innerHTML = `<p class="status-success">Update successful! Restarting device...</p>`;
-          setTimeout(() => {
-            status.innerHTML = `<p class="status-success">Restarting... Page will reload.</p>`;
-            setTimeout(() => location.reload(), 5000);
-          }, 2000);
-        } else if (xhr.status === 401) {
-          progressContainer.style.display = "none";
-          status.innerHTML = `<p class="status-error">Incorrect password! Please check and try again.</p>`;
-          passwordInput.focus();
-        } else {
-          progressContainer.style.display = "none";
-          status.innerHTML = `<p class="status-error">Update failed: ${xhr.responseText}</p>`;
-        }
-      });
-
-      xhr.addEventListener("error", function () {
-        uploadBtn.disabled = false;
-        uploadBtn.textContent = "Upload and Update";
-        progressContainer.style.display = "none";
-        status.innerHTML = `<p class="status-error">Network error occurred while uploading.</p>`;
-      });
-
-      xhr.addEventListener("timeout", function () {
-        uploadBtn.disabled = false;
-        uploadBtn.textContent = "Upload and Update";
-        progressContainer.style.display = "none";
-        status.innerHTML = `<p class="status-error">Upload timeout - please try again.</p>`;
-      });
-
-      xhr.timeout = 300000; // 5 minutes timeout
-      xhr.open("POST", "/update");
-      xhr.send(formData);
-    });
-
-    // Focus password field on load if needed
-    window.addEventListener('load', function() {
-      if (passwordInput.placeholder) {
-        passwordInput.focus();
-      }
-    });
-  </script>
-</body>
-</html>
-)";
-  return uploadHTML;
-}
\ No newline at end of file
+}
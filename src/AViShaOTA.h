@@ -5,10 +5,21 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <ArduinoOTA.h>
-#include <WebServer.h>
 #include <ESPmDNS.h>
 #include <Update.h>
 #include <WiFiClient.h>
+#include <mbedtls/sha256.h>
+#include <mbedtls/pk.h>
+#include <esp_partition.h>
+#include <esp_timer.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <freertos/ringbuf.h>
+#include "AViShaOTAEvents.h"
+#include "AViShaOTALog.h"
+#include "AViShaOTAMetrics.h"
 
 // Version information
 #define AVISHA_OTA_VERSION "1.2.0"
@@ -17,9 +28,135 @@
 #define AVISHA_OTA_DEFAULT_PORT 80
 #define AVISHA_OTA_DEFAULT_HOSTNAME "AViShaOTA_ESP32"
 #define AVISHA_OTA_WIFI_TIMEOUT 30000
+#define AVISHA_OTA_FAST_CONNECT_TIMEOUT 3000    // ms before a cached connect falls back to a scan
 #define AVISHA_OTA_UPLOAD_TIMEOUT 300000
 
+// Persistent configuration, see loadConfig()
+#define AVISHA_OTA_CONFIG_VERSION 1
+#define AVISHA_OTA_CONFIG_MAX 512       // Largest stored record, read on the stack
+
+// Upload authentication
+#define AVISHA_OTA_MAX_NONCES 4
+#define AVISHA_OTA_NONCE_TTL 30000
+// Also accept the password in cleartext as a "password" form field or
+// query argument, for clients that predate X-OTA-Auth. Off by default.
+#ifndef AVISHA_OTA_PLAIN_PASSWORD
+#define AVISHA_OTA_PLAIN_PASSWORD 0
+#endif
+
+// Signed firmware: raw ECDSA P-256 r||s appended to the image
+#define AVISHA_OTA_SIGNATURE_SIZE 64
+
+// Size check before an upload is accepted, see imageFits()
+#define AVISHA_OTA_FORM_OVERHEAD 4096   // Multipart framing allowed on top of the image
+
+// Resumable uploads
+#define AVISHA_OTA_PREFS_NAMESPACE "avisha_ota"
+#define AVISHA_OTA_RESUME_SAVE_INTERVAL 65536 // Persist the offset every 64 KB
+#define AVISHA_OTA_SECTOR_SIZE 4096
+
+// Debug log
+#define AVISHA_OTA_LOG_DRAIN 4 // Records printed per handle() call at most
+
+// Pull mode
+#define AVISHA_OTA_PULL_INTERVAL 3600000
+
+// Peer sharing
+#define AVISHA_OTA_PEER_INTERVAL 600000
+#define AVISHA_OTA_PEER_SERVICE "avisha-ota" // Advertised as _avisha-ota._tcp
+#define AVISHA_OTA_PEER_AUTH "peer-image:"   // Keys the peer download MAC apart from uploads
+
+// Native push protocol, see enablePushServer() and extras/push_upload.py
+#define AVISHA_OTA_PUSH_PORT 3233       // Next to ArduinoOTA's 3232
+#define AVISHA_OTA_PUSH_TIMEOUT 5000    // ms from connect to the end of the handshake
+
+// Update beacons, see enableBeaconWake() and extras/beacon.py
+#define AVISHA_OTA_BEACON_GROUP "239.255.65.86"
+#define AVISHA_OTA_BEACON_PORT 4586
+#define AVISHA_OTA_BEACON_WINDOW 300    // ms to listen after connecting
+#define AVISHA_OTA_BEACON_SIZE 384      // Longer beacons are ignored
+
+// Service task
+#define AVISHA_OTA_TASK_CORE 0          // Core the service task is pinned to, -1 = either
+#define AVISHA_OTA_TASK_PRIORITY 1      // Same as the loop() task
+#define AVISHA_OTA_TASK_STACK 8192
+#define AVISHA_OTA_TASK_INTERVAL 1      // ms between service passes
+#define AVISHA_OTA_CHECK_STACK 8192     // Pull and peer checks: HTTPClient, TLS, mDNS
+
+// Rollback
+#define AVISHA_OTA_HEALTH_DEADLINE 120000   // ms of uptime to prove a new image healthy
+#define AVISHA_OTA_HEALTH_INTERVAL 1000     // Health checks while pending, at most this often
+#define AVISHA_OTA_ROLLBACK_GRACE 5000      // ms for handle() to act on the deadline before the timer does
+
+// Async web server backend, built when the sketch (or platformio.ini) pulls
+// in ESPAsyncWebServer. Define as 0 to leave it out.
+#ifndef AVISHA_OTA_ASYNC_SERVER
+#if defined(__has_include)
+#if __has_include(<ESPAsyncWebServer.h>)
+#define AVISHA_OTA_ASYNC_SERVER 1
+#endif
+#endif
+#endif
+#ifndef AVISHA_OTA_ASYNC_SERVER
+#define AVISHA_OTA_ASYNC_SERVER 0
+#endif
+#define AVISHA_OTA_RESTART_DELAY 1000 // Lets the success response go out first
+#define AVISHA_OTA_ASYNC_BUFFER 16384   // Upload bytes in flight between AsyncTCP and handle()
+#define AVISHA_OTA_ASYNC_WAIT 1000      // ms AsyncTCP waits for room before failing the upload
+
+// Streaming decompression
+#define AVISHA_OTA_MAX_CODECS 4
+#ifndef AVISHA_OTA_GZIP_WINDOW
+#define AVISHA_OTA_GZIP_WINDOW 32768 // Power of two, >= the compressor window
+#endif
+
+// Web upload receive path
+#define AVISHA_OTA_RECEIVE_BUFFER 8192  // Bytes read from the socket per call
+#define AVISHA_OTA_RECEIVE_TIMEOUT 5000 // Silence before an upload is abandoned
+
+// Multipart uploads read past WebServer's parser, see streamUpload(). This
+// depends on how the arduino-esp32 1.0.x / 2.0.x WebServer carries on after
+// the upload callback; on other cores WebServer keeps parsing the body.
+#ifndef AVISHA_OTA_STREAM_MULTIPART
+#if !defined(ESP_ARDUINO_VERSION_MAJOR) || ESP_ARDUINO_VERSION_MAJOR < 3
+#define AVISHA_OTA_STREAM_MULTIPART 1
+#else
+#define AVISHA_OTA_STREAM_MULTIPART 0
+#endif
+#endif
+
+// Flash write pipeline
+#define AVISHA_OTA_WRITE_BUFFERS 2
+#define AVISHA_OTA_WRITE_BUFFER_SIZE 4096 // One flash sector
+
+class AViShaOTAWriter;
+class WebServer;
+class AsyncWebServer;
+class AsyncWebServerRequest;
+
 class AViShaOTA {
+public:
+    // Startup progress, reported through onStateChange()
+    enum StartState {
+        START_IDLE,         // begin() not called yet
+        START_CONNECTING,   // Waiting for an IP address
+        START_SERVICES,     // Bringing up ArduinoOTA and the web server
+        START_MDNS,         // Starting the MDNS responder
+        START_READY,        // Everything is up
+        START_FAILED,       // WiFi timed out (async mode keeps retrying)
+        START_LISTENING,    // Waiting for an update beacon
+        START_NO_BEACON     // No beacon for this device, services stay down
+    };
+    
+    // Why the previous image was rolled back, see enableRollback()
+    enum RollbackReason {
+        ROLLBACK_NONE,
+        ROLLBACK_WIFI,          // No WiFi connection by the deadline
+        ROLLBACK_STARTUP,       // begin() had not finished by the deadline
+        ROLLBACK_HEALTH_CHECK,  // The health check still failed at the deadline
+        ROLLBACK_RESET          // Crashed or restarted before it was confirmed
+    };
+    
 private:
     // Core components
     WebServer* server;
@@ -31,36 +168,190 @@ private:
     bool mdnsEnabled;
     bool serialDebug;
     bool autoReconnect;
+    bool asyncStart;
+    bool asyncServerEnabled;
+    bool fastConnectEnabled;
+    bool beaconWake;
     
-    // Status tracking
-    bool isInitialized;
-    bool otaInProgress;
-    bool webUpdateInProgress;
+    // Status tracking, read from other tasks when the service task runs
+    std::atomic<bool> isInitialized;
+    std::atomic<int> updateOwner;   // AViShaOTAEvent::Source holding the pipeline, SOURCE_NONE when idle
+    StartState startState;
+    unsigned long connectStartTime;
+    bool claimUpdate(AViShaOTAEvent::Source source);
+    void releaseUpdate(AViShaOTAEvent::Source source);
+    bool isUpdating();
+    
+    // Fast connect, see enableFastConnect()
+    String wifiSSID;
+    String wifiPassword;
+    bool fastConnecting;        // Attempt with cached channel, BSSID and IP running
+    bool fastConnected;
+    unsigned long connectTime;  // ms from boot/wake to an IP address
+    void fallbackWiFi();
+    void finishConnect();
+    void storeWiFiCache();
+    
+    // Update beacon listener, see enableBeaconWake()
+    enum BeaconAction {
+        BEACON_NONE,
+        BEACON_SERVE,       // Bring up ArduinoOTA and the web server
+        BEACON_PULL         // Fetch the manifest named in the beacon
+    };
+    WiFiUDP beaconUdp;
+    unsigned long beaconWindow;
+    unsigned long beaconStart;
+    String beaconManifest;
+    bool listenForBeacon();
+    void startBeaconListen();
+    BeaconAction pollBeacon();
+    bool finishBeacon(BeaconAction action);
     
     // Connection tracking
     unsigned long lastWiFiCheck;
     unsigned long wifiCheckInterval;
     
-    // Callback function pointers
-    void (*onStartCallback)();
-    void (*onEndCallback)();
-    void (*onProgressCallback)(unsigned int progress, unsigned int total);
-    void (*onErrorCallback)(ota_error_t error);
-    void (*onWiFiConnectedCallback)();
-    void (*onWiFiDisconnectedCallback)();
-    void (*onWebUpdateStartCallback)();
-    void (*onWebUpdateEndCallback)(bool success);
+    // Event subscribers; the onX() setters each own one slot
+    enum LegacyHandler {
+        LEGACY_START,
+        LEGACY_END,
+        LEGACY_PROGRESS,
+        LEGACY_ERROR,
+        LEGACY_WIFI_CONNECTED,
+        LEGACY_WIFI_DISCONNECTED,
+        LEGACY_WEB_START,
+        LEGACY_WEB_END,
+        LEGACY_STATE_CHANGE,
+        LEGACY_COUNT
+    };
+    AViShaOTAEvents events;
+    AViShaOTALog logger;
+    AViShaOTAMetrics metrics;
+    int8_t legacyHandlers[LEGACY_COUNT];
     
     // Internal setup methods
     void setupWebServer();
     void setupArduinoOTA();
     bool setupWiFi(const char* ssid, const char* password);
     bool setupMDNS();
+    void startServices();
+    void advanceStartup();
+    void setStartState(StartState state);
+    
+    // Service task
+    TaskHandle_t serviceTask;
+    SemaphoreHandle_t serviceDone;
+    volatile bool serviceRunning;
+    portMUX_TYPE stateLock;     // Guards updateStats against readers on other tasks
+    static void serviceTaskEntry(void* arg);
+    void service();
+    void stopServiceTask();
+    
+    // Pull and peer checks that service() finds due run on a task of their
+    // own, which deletes itself when they are done
+    TaskHandle_t checkTask;
+    static void checkTaskEntry(void* arg);
+    void startChecks();
+    
+    // Rollback state; the deadline timer runs on the esp_timer task
+    bool rollbackPending;       // Running image waits for confirmation
+    bool rollbackLoaded;
+    unsigned long healthDeadline;
+    unsigned long lastHealthCheck;
+    bool (*healthCheck)();
+    esp_timer_handle_t rollbackTimer;
+    volatile RollbackReason pendingFailure; // Check that failed last, used at the deadline
+    volatile bool rollbackDue;  // Deadline passed, service() rolls back
+    RollbackReason lastRollbackReason;
+    uint32_t lastRecoveryMs;
+    void checkHealth();
+    void confirmUpdate();
+    void rollback(RollbackReason reason);
+    bool revertImage(RollbackReason reason);
+    void loadRollbackRecord();
+    static void rollbackTimerEntry(void* arg);
+    
+    // Async web server backend; its handlers run on the AsyncTCP task and
+    // only copy the upload into asyncBuffer, service() runs the pipeline
+    enum AsyncUploadState {
+        ASYNC_IDLE,
+        ASYNC_RECEIVING,    // Body still arriving
+        ASYNC_RECEIVED,     // Last byte is in asyncBuffer
+        ASYNC_ABORTED,      // Client went away, or asyncBuffer stayed full
+        ASYNC_DONE          // service() has published the result
+    };
+    class AsyncUploadReply;
+    AsyncWebServer* asyncServer;
+    AsyncWebServerRequest* asyncUploader;   // Request that owns the update pipeline, AsyncTCP side only
+    RingbufHandle_t asyncBuffer;
+    std::atomic<int> asyncState;
+    std::atomic<uint8_t> asyncHolds;        // Sides still using asyncBuffer, the last one frees it
+    std::atomic<uint32_t> asyncResult;      // Upload id << 16 | HTTP status of the last finished upload
+    uint16_t asyncUploadId;
+    bool asyncRaw;
+    bool asyncStarted;
+    size_t asyncWritten;
+    volatile bool restartPending;
+    volatile unsigned long restartRequested;
+    void setupAsyncServer();
+    void stopAsyncServer(bool release);
+    void asyncHandleRoot(AsyncWebServerRequest* request);
+    void asyncHandleAuth(AsyncWebServerRequest* request);
+    void asyncHandleInfo(AsyncWebServerRequest* request);
+    void asyncHandleMetrics(AsyncWebServerRequest* request);
+    void asyncHandleLog(AsyncWebServerRequest* request);
+    void asyncHandlePeerManifest(AsyncWebServerRequest* request);
+    void asyncHandlePeerImage(AsyncWebServerRequest* request);
+    void asyncHandleUpload(AsyncWebServerRequest* request, const String& filename, size_t index,
+                           uint8_t* data, size_t len, bool final);
+    void asyncHandleBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total);
+    void asyncHandleUpdateFinish(AsyncWebServerRequest* request);
+    void rejectAsyncUpload(AsyncWebServerRequest* request, int code, const char* message);
+    void detachAsyncUpload(AsyncWebServerRequest* request);
+    void serviceAsyncUpload();
+    void finishAsyncUpload(bool success);
+    void dropAsyncHold();
+    
+    // Native push receiver, see AViShaOTAPush.cpp
+    WiFiServer* pushServer;
+    uint16_t pushPort;
+    bool pushEnabled;
+    WiFiClient pushClient;          // Connection going through the handshake
+    uint8_t pushBuffer[96];         // Its header and MAC, as far as received
+    size_t pushGot;
+    unsigned long pushStarted;
+    char pushNonce[33];             // Issued to pushClient alone, not an /auth slot
+    void setupPushServer();
+    void handlePush();
+    void closePush(uint8_t code, uint32_t value);
+    void sendPushStatus(WiFiClient& client, uint8_t code, uint32_t value);
+    
+    // Event helpers
+    void setLegacyHandler(LegacyHandler slot, const AViShaOTAEventHandler& handler, uint16_t events);
+    void emit(AViShaOTAEvent::Type type, AViShaOTAEvent::Source source = AViShaOTAEvent::SOURCE_NONE,
+              bool success = true);
+    void emitError(AViShaOTAEvent::Source source, ota_error_t error);
     
     // HTTP request handlers
     void handleRoot();
     void handleUpdate();
     void handleUpdateFinish();
+    bool startWebUpdate(const String& filename);
+    void streamUpload();
+    void handleRawUpdate();
+    void handleAuth();
+    void handleResumeStatus();
+    void handleResumeUpload();
+    void handleResumeFinish();
+    void handlePeerManifest();
+    void handlePeerImage();
+    void handleLog();
+    void handleMetrics();
+    void writeMetrics(Print& out);
+    void writeLog(Print& out, uint32_t seq, uint32_t next);
+    String peerManifest();
+    void writeSystemInfo(Print& out);
+    void cacheSketchInfo();
     void handleNotFound();
     void handleInfo();
     void handleRestart();
@@ -72,15 +363,31 @@ private:
     
     // Utility methods
     bool validatePassword(const String& password);
+    bool authorizeUpload();
+    bool authorizeUpload(const String& auth, const String& password);
+    bool authorizePeer(const String& auth);
+    bool verifyNonceAuth(const String& auth, const char* purpose);
+    const char* issueNonce();
+    void logUpdateStats();
+    void rejectUpload(int code, const char* message);
+    static bool constantTimeEquals(const char* a, const char* b, size_t len);
     bool validateBinaryFile(const String& filename);
     void logMessage(const String& message);
     void logError(const String& error);
+    // Formats must be literals, see AViShaOTALog
+    void logError(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    void logWarning(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    void logInfo(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    void logDebug(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    void drainLog();
     
     // Static instance for event handling
     static AViShaOTA* instance;
     
     // HTML templates
     const char* getUploadHTML();
+    const uint8_t* getUploadPage(bool gzip, size_t& len);
+    const char* getUploadETag();
     const char* getInfoHTML();
     String getSystemInfo();
 
@@ -103,7 +410,79 @@ public:
     void enableMDNS(bool enable = true);
     void enableSerialDebug(bool enable = true);
     void enableAutoReconnect(bool enable = true);
+    void enableAsyncStart(bool enable = true); // begin() returns at once, handle() finishes startup
+    // Serve the web routes from ESPAsyncWebServer: several clients at once,
+    // a second upload gets 409. /resume answers 501, resumable uploads need
+    // the WebServer backend. Call before begin(); false when the library
+    // was built without it, see AVISHA_OTA_ASYNC_SERVER.
+    bool enableAsyncServer(bool enable = true);
+    // Remember channel, BSSID and IP settings of the last connection (RTC
+    // memory across deep sleep, NVS across power loss) and reuse them in
+    // begin() to skip the scan and DHCP. Falls back to a normal connect
+    // after AVISHA_OTA_FAST_CONNECT_TIMEOUT. The address is reused without
+    // asking the DHCP server, so reserve it for the device on the router.
+    void enableFastConnect(bool enable = true);
+    // Beacon wake for sleeping devices: after connecting, begin() listens
+    // window ms for an update beacon instead of starting the servers. A
+    // beacon for this hostname brings them up, or pulls straight away when
+    // it names a manifest. Without one begin() returns false and the state
+    // is START_NO_BEACON, so the sketch can go back to sleep. Beacons are
+    // unauthenticated: a manifest URL in one is only followed when signed
+    // images are required or the beacon carries a mac made with the OTA
+    // password (extras/beacon.py --password), otherwise the device pulls
+    // setPullURL() if set or just starts the servers.
+    void enableBeaconWake(bool enable = true, unsigned long window = AVISHA_OTA_BEACON_WINDOW);
+    // Native push: a TCP listener that takes a binary header and then the
+    // whole image in one stream, paced by TCP instead of a reply per chunk
+    // as with ArduinoOTA. Uses the OTA password; see extras/push_upload.py.
+    void enablePushServer(bool enable = true, uint16_t port = AVISHA_OTA_PUSH_PORT);
     void setWiFiCheckInterval(unsigned long interval = 10000);
+    void setWriteBuffers(uint8_t count = AVISHA_OTA_WRITE_BUFFERS,
+                         size_t size = AVISHA_OTA_WRITE_BUFFER_SIZE); // 0 = write inline
+    void setFirmwareVersion(const String& version);
+    // Web uploads are read off the socket into a buffer of this size; 0
+    // leaves multipart parsing to WebServer, as do cores other than
+    // arduino-esp32 1.0.x / 2.0.x. Raw application/octet-stream bodies need
+    // arduino-esp32 2.x or the async server.
+    void setReceiveBuffer(size_t size = AVISHA_OTA_RECEIVE_BUFFER);
+    
+    // Pull mode: poll a manifest URL and install newer firmware. A manifest
+    // is only acted on when its version differs from setFirmwareVersion(),
+    // or without one, when the md5 of a full image differs from the sketch.
+    void setPullURL(const String& manifestURL, unsigned long interval = AVISHA_OTA_PULL_INTERVAL);
+    bool checkForUpdate(); // Restarts the device when an update was installed
+    
+    // Peer sharing: serve the running image to, and pull newer images from,
+    // other devices on the network. Needs mDNS and a firmware version; call
+    // before begin(). Only the image the device booted from is served, out
+    // of the running slot; one staged in the inactive slot is not offered
+    // until it has booted. handle() queries mDNS from a task of its own.
+    // Images are only pulled from peers when signed images are required
+    // (Config::signingKey), since any device can announce itself as a peer.
+    void enablePeerShare(bool enable = true, unsigned long interval = AVISHA_OTA_PEER_INTERVAL);
+    bool checkPeers(); // Blocks for the mDNS query; restarts the device when an update was installed
+    
+    // Rollback: a newly installed image boots pending and is confirmed once
+    // WiFi is up, begin() has finished (or found no beacon, see
+    // enableBeaconWake()) and the health check passes. If that
+    // has not happened within deadline ms of boot, or the image resets
+    // first, the previous one is restored, by handle() or, if loop() is
+    // stuck, AVISHA_OTA_ROLLBACK_GRACE ms later. Needs a bootloader with rollback
+    // support; on arduino-esp32 2.x the sketch must also define
+    //   bool verifyRollbackLater() { return true; }
+    // or the core confirms every image before setup() runs.
+    void enableRollback(bool enable = true, unsigned long deadline = AVISHA_OTA_HEALTH_DEADLINE);
+    void setHealthCheck(bool (*check)());
+    bool isUpdatePending();
+    // Runs the health check now instead of waiting for handle(); call it
+    // before deep sleep, since waking is a reboot and the bootloader
+    // reverts an image still pending. begin() does so itself when no
+    // beacon came.
+    // True when no update is pending any more.
+    bool confirmIfHealthy();
+    RollbackReason getLastRollbackReason();
+    unsigned long getLastRecoveryMs();  // Bad image boot to this image running again
+    static const char* getRollbackReasonName(RollbackReason reason);
     
     // Callback registration methods
     void onStart(void (*callback)());
@@ -114,6 +493,30 @@ public:
     void onWiFiDisconnected(void (*callback)());
     void onWebUpdateStart(void (*callback)());
     void onWebUpdateEnd(void (*callback)(bool success));
+    void onStateChange(void (*callback)(StartState state));
+    
+    // Typed event stream with multiple subscribers, no heap allocation.
+    // Handlers may capture up to AVISHA_OTA_HANDLER_SIZE bytes and run in
+    // the context that produced the event: loop() via handle(), or the
+    // service task when it is enabled. WiFi events always come from the
+    // system event task, and the periodic pull and peer checks run on a
+    // task of their own. The onX() callbacks follow the same rules.
+    int onEvent(const AViShaOTAEventHandler& handler, uint16_t events = AVISHA_OTA_ALL_EVENTS); // -1 when full
+    void removeEvent(int id);
+    void setProgressRate(unsigned long interval = 0, uint8_t percentStep = 1); // 0, 0 = every chunk
+    
+    // Debug messages are kept in a RAM ring, printed to Serial from handle()
+    // when no update is running and readable at /log
+    void setLogLevel(AViShaOTALog::Level level);
+    
+    // Service task: ArduinoOTA, the web server and the pull/peer checks run
+    // on their own FreeRTOS task, so a slow loop() does not hold up uploads.
+    // handle() then does nothing. Register callbacks before enabling it and
+    // keep them short, they run on the service task. end() stops the task.
+    bool enableServiceTask(bool enable = true, int core = AVISHA_OTA_TASK_CORE,
+                           UBaseType_t priority = AVISHA_OTA_TASK_PRIORITY,
+                           uint32_t stackSize = AVISHA_OTA_TASK_STACK);
+    bool isServiceTaskRunning();
     
     // Main lifecycle methods
     bool begin(const char* ssid, const char* password = nullptr);
@@ -128,6 +531,9 @@ public:
     bool isConnected();
     bool isOTAInProgress();
     bool isWebUpdateInProgress();
+    StartState getStartState();
+    unsigned long getConnectTime();     // Boot or wake to IP address, 0 until connected
+    bool isFastConnected();             // Connected with the cached settings
     WiFiMode_t getWiFiMode();
     
     // System utility methods
@@ -163,6 +569,7 @@ public:
         bool autoReconnect;
         unsigned long wifiTimeout;
         unsigned long uploadTimeout;
+        String signingKey;      // PEM ECDSA P-256 public key, empty = unsigned
         
         Config() : 
             hostname(AVISHA_OTA_DEFAULT_HOSTNAME),
@@ -172,20 +579,275 @@ public:
             serialDebug(true),
             autoReconnect(true),
             wifiTimeout(AVISHA_OTA_WIFI_TIMEOUT),
-            uploadTimeout(AVISHA_OTA_UPLOAD_TIMEOUT) {}
+            uploadTimeout(AVISHA_OTA_UPLOAD_TIMEOUT),
+            signingKey("") {}
     };
     
     // Advanced configuration methods
     void setConfig(const Config& config);
     Config getConfig();
-    bool loadConfig(); // Load from EEPROM/preferences
-    bool saveConfig(); // Save to EEPROM/preferences
+    // Config is kept in NVS as one CRC-checked binary record. saveConfig()
+    // only writes when a value changed; loadConfig() applies it with
+    // setConfig() and is false, keeping the current settings, when there
+    // is no valid record. Records from older versions are upgraded.
+    bool loadConfig();
+    bool saveConfig();
+    
+    // Stream decoder placed between the received upload and Update.write().
+    // A codec is selected per upload, either by the "encoding" form field or
+    // by detect() on the first received chunk, and pushes its decoded bytes
+    // on with output(), either to the next stage (delta patcher) or to flash.
+    class Codec {
+    public:
+        virtual ~Codec() {}
+        virtual const char* name() const = 0;
+        virtual bool detect(const uint8_t* data, size_t len) const = 0;
+        virtual bool begin() = 0;
+        virtual bool write(const uint8_t* data, size_t len) = 0;
+        virtual bool end() = 0;
+        virtual void abort() {}
+        
+    protected:
+        bool output(const uint8_t* data, size_t len);
+        
+    private:
+        friend class AViShaOTA;
+        AViShaOTA* owner = nullptr;
+        Codec* next = nullptr;
+    };
+    
+    // Statistics of the most recent update
+    struct UpdateStats {
+        const char* encoding;       // Codec name, or "raw"
+        bool delta;                 // Upload was a patch against the running app
+        bool verified;              // Image matched the expected SHA-256
+        bool signatureValid;        // Appended signature checked out
+        size_t receivedBytes;       // Bytes received over the network
+        size_t writtenBytes;        // Bytes written to flash
+        unsigned long durationMs;   // First chunk to Update.end()
+        unsigned long flashBusyMs;  // Time the writer task spent writing and erasing flash
+        unsigned long stallMs;      // Time the receiver waited for a free buffer
+        unsigned long verifyMs;     // Time spent hashing and checking the signature
+        uint32_t minFreeHeap;       // Lowest free heap seen during the update
+        const char* receiveMode;    // "multipart", "stream", "raw", or "-" for other sources
+        uint8_t copies;             // Buffers each byte passed through on its way to flash
+        uint32_t chunks;            // Received chunks handed to the pipeline
+        uint32_t chunkP50Us;        // Per-chunk pipeline latency, bucket resolution
+        uint32_t chunkP99Us;
+        uint32_t chunkMaxUs;
+        uint32_t stallP50Us;        // Per-buffer wait for the writer task, bucket resolution
+        uint32_t stallP99Us;
+        uint32_t stallMaxUs;
+        bool presized;              // The image size was known before the first write
+        bool preErased;             // The writer task erased the partition ahead of the data
+        bool success;
+        
+        UpdateStats() :
+            encoding("raw"),
+            delta(false),
+            verified(false),
+            signatureValid(false),
+            receivedBytes(0),
+            writtenBytes(0),
+            durationMs(0),
+            flashBusyMs(0),
+            stallMs(0),
+            verifyMs(0),
+            minFreeHeap(0),
+            receiveMode("-"),
+            copies(0),
+            chunks(0),
+            chunkP50Us(0),
+            chunkP99Us(0),
+            chunkMaxUs(0),
+            stallP50Us(0),
+            stallP99Us(0),
+            stallMaxUs(0),
+            presized(false),
+            preErased(false),
+            success(false) {}
+    };
+    
+    // Update pipeline methods
+    bool addCodec(Codec* codec); // Codec must outlive this instance
+    UpdateStats getLastUpdateStats();
     
 private:
     // Internal state
     Config currentConfig;
+    unsigned long configLoadUs;     // Time the last loadConfig() took
+    uint32_t configWrites;          // Wear counter of the stored record
+    size_t buildConfigRecord(uint8_t* buffer, size_t size, uint32_t writes);
     String lastError;
     unsigned long startTime;
+    char sketchMD5[33];         // Cached, reading it hashes the whole app
+    uint32_t sketchSize;
+    
+    // Per-upload pipeline options
+    struct ImageOptions {
+        String encoding;    // Forced codec name, "raw", or empty to detect
+        bool delta;         // Upload is a patch against the running app
+        String md5;         // Expected MD5 of the resulting image
+        String sha256;      // Expected SHA-256 of the resulting image (hex)
+        size_t size;        // Bytes the upload carries, 0 = unknown
+        
+        ImageOptions() : delta(false), size(0) {}
+    };
+    
+    // State of the web upload currently being received
+    struct UploadContext {
+        bool authorized;
+        bool responded;     // Response already sent from the upload handler
+        bool started;       // Update pipeline was started
+        bool failed;
+        bool success;
+        
+        UploadContext() :
+            authorized(false),
+            responded(false),
+            started(false),
+            failed(false),
+            success(false) {}
+    };
+    
+    // Outstanding /auth nonces
+    struct AuthNonce {
+        char value[33];
+        unsigned long issued;   // 0 = free
+    };
+    
+    UploadContext uploadContext;
+    ImageOptions asyncOptions;  // Async upload, written before ASYNC_RECEIVING and then read by service()
+    AuthNonce authNonces[AVISHA_OTA_MAX_NONCES];
+    uint32_t authFailures;
+    
+    // Update pipeline state
+    Codec* codecs[AVISHA_OTA_MAX_CODECS];
+    Codec* builtinGzip;
+    Codec* builtinDelta;
+    uint8_t codecCount;
+    Codec* activeCodec;
+    Codec* headStage;
+    bool codecSelected;
+    bool imageActive;           // Between beginImage() and endImage() / abortImage()
+    ImageOptions imageOptions;
+    UpdateStats updateStats;
+    unsigned long updateStartTime;
+    AViShaOTAWriter* writer;
+    const esp_partition_t* flashPartition;  // Written by the writer task, nullptr through Update
+    mbedtls_sha256_context imageHash;
+    bool hashing;
+    bool checkDigest;
+    uint8_t expectedDigest[32];
+    unsigned long hashMicros;
+    uint8_t imageDigest[32];    // Digest of the last image written
+    bool imageDigestValid;
+    
+    // Signature verification
+    mbedtls_pk_context signingKey;
+    bool signatureRequired;
+    uint8_t signatureTail[AVISHA_OTA_SIGNATURE_SIZE];
+    size_t signatureTailLen;
+    
+    // Resumable upload session, persisted in NVS. The partial hash lives in
+    // RAM and is rebuilt from flash after a reboot.
+    struct ResumeState {
+        uint32_t version;
+        uint32_t id;
+        uint32_t size;          // Total upload size
+        uint32_t offset;        // Bytes committed to the partition
+        uint32_t partition;     // Address of the target OTA partition
+        uint8_t sha256[32];
+        uint8_t hasDigest;
+    };
+    
+    ResumeState resumeState;
+    bool resumeActive;
+    bool resumeLoaded;
+    const esp_partition_t* resumePartition;
+    mbedtls_sha256_context resumeHash;
+    uint32_t resumeHashed;      // Stream bytes covered by resumeHash
+    uint32_t resumeErased;      // End of the erased range
+    uint32_t resumeSaved;       // Offset last written to NVS
+    
+    // Pull mode state
+    String pullURL;
+    String pullETag;
+    String firmwareVersion;
+    unsigned long pullInterval;
+    unsigned long lastPullCheck;
+    
+    // Peer sharing state, the shared image record is kept in NVS
+    struct PeerImage {
+        uint8_t version;
+        uint32_t partition;     // Flash address of the OTA slot
+        uint32_t size;          // Image size without the signature
+        uint8_t sha256[32];
+        uint8_t signature[AVISHA_OTA_SIGNATURE_SIZE];
+        uint8_t hasSignature;
+    };
+    PeerImage peerImage;
+    bool peerShare;
+    unsigned long peerInterval;
+    unsigned long lastPeerCheck;
+    uint8_t writeBufferCount;
+    size_t writeBufferSize;
+    
+    // Update pipeline stages
+    bool beginImage(const ImageOptions& options);
+    bool imageFits(size_t declared, size_t bodyLength, bool multipart);
+    bool startFlash();
+    bool writeImage(const uint8_t* data, size_t len);
+    bool feedImage(const uint8_t* data, size_t len);
+    bool writeFirmware(const uint8_t* data, size_t len);
+    bool commitFirmware(const uint8_t* data, size_t len);
+    bool commitReserved(const uint8_t* data, size_t len);
+    void hashFirmware(const uint8_t* data, size_t len);
+    void countFirmware(size_t len);
+    bool endImage();
+    bool finishPartition();
+    void abortImage();
+    bool selectCodec(const uint8_t* data, size_t len);
+    bool stopWriter(bool flush);
+    bool verifyImage();
+    bool checkImageDigest(const uint8_t* digest);
+    bool setSigningKey(const String& pem);
+    void finishStats(bool success);
+    
+    // Upload receive helpers
+    size_t receiveBufferSize;
+    void setReceiveMode(const char* mode, uint8_t receiveCopies);
+    static String multipartBoundary(const String& contentType);
+    static bool waitForData(WiFiClient& client, unsigned long timeout);
+    size_t receive(WiFiClient& client, uint8_t* buffer, size_t len);
+    bool receiveMultipart(WiFiClient& client, const String& boundary, uint8_t* buffer, size_t size);
+    bool skipMultipart(WiFiClient& client, const String& closing, uint8_t* buffer, size_t start, size_t fill,
+                       size_t size);
+    bool receiveRaw(WiFiClient& client, size_t length, uint8_t* buffer, size_t size,
+                    AViShaOTAEvent::Source source = AViShaOTAEvent::SOURCE_WEB);
+    
+    // Resumable upload helpers
+    void sendResumeStatus(int code);
+    bool startResume(uint32_t size, const String& sha256);
+    bool prepareResume();
+    bool writeResume(const uint8_t* data, size_t len);
+    bool finishResume();
+    uint32_t resumeHashLimit();
+    void loadResume();
+    void saveResume();
+    void clearResume();
+    
+    // Pull mode helpers
+    bool checkManifest(const String& manifestURL, String& etag);
+    bool pullImage(const String& url, const ImageOptions& options, size_t expectedSize,
+                   AViShaOTAEvent::Source source, const String& auth = "");
+    
+    // Peer sharing helpers
+    bool peerImageReady();
+    void loadPeerImage();
+    void savePeerImage(const esp_partition_t* partition, uint32_t size);
+    void authDigest(const char* nonce, char* out);
+    void authDigest(const char* purpose, const String& message, char* out);
     
     // Internal helper methods
     void initializeDefaults();
@@ -201,6 +863,10 @@ namespace AViShaOTAUtils {
     String getBootMode();
     bool isValidIPAddress(const String& ip);
     String generateRandomPassword(int length = 8);
+    bool parseHex(const String& hex, uint8_t* out, size_t len);
+    String jsonValue(const String& json, const char* key);
+    int compareVersions(const String& a, const String& b);
+    const char* resetReasonName(int reason);
 }
 
 #endif // AVISHA_OTA_H
\ No newline at end of file
@@ -0,0 +1,527 @@
+// AViShaOTAAsync.cpp - ESPAsyncWebServer backend for the upload routes
+// Kept apart from AViShaOTA.cpp: WebServer.h and ESPAsyncWebServer.h both
+// define HTTP_GET and friends and cannot share a translation unit.
+#include "AViShaOTA.h"
+
+#if AVISHA_OTA_ASYNC_SERVER
+
+#include <ESPAsyncWebServer.h>
+#include <esp_ota_ops.h>
+
+// Form field or query parameter, empty when absent
+static String requestArg(AsyncWebServerRequest* request, const char* name) {
+  if (request->hasParam(name, true)) {
+    return request->getParam(name, true)->value();
+  }
+  if (request->hasParam(name)) {
+    return request->getParam(name)->value();
+  }
+  return String();
+}
+
+static String requestHeader(AsyncWebServerRequest* request, const char* name) {
+  AsyncWebHeader* header = request->getHeader(name);
+  return header ? header->value() : String();
+}
+
+// Cleartext password, only read with AVISHA_OTA_PLAIN_PASSWORD
+static String plainPassword(AsyncWebServerRequest* request) {
+  return AVISHA_OTA_PLAIN_PASSWORD ? requestArg(request, "password") : String();
+}
+
+void AViShaOTA::setupAsyncServer() {
+  if (!asyncServer) {
+    asyncServer = new AsyncWebServer(serverPort);
+    
+    asyncServer->on("/", HTTP_GET, [this](AsyncWebServerRequest* request) {
+      asyncHandleRoot(request);
+    });
+    
+    asyncServer->on("/auth", HTTP_GET, [this](AsyncWebServerRequest* request) {
+      asyncHandleAuth(request);
+    });
+    
+    asyncServer->on("/update", HTTP_POST, [this](AsyncWebServerRequest* request) {
+      asyncHandleUpdateFinish(request);
+    }, [this](AsyncWebServerRequest* request, const String& filename, size_t index,
+              uint8_t* data, size_t len, bool final) {
+      asyncHandleUpload(request, filename, index, data, len, final);
+    }, [this](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+      asyncHandleBody(request, data, len, index, total);
+    });
+    
+    asyncServer->on("/info", HTTP_GET, [this](AsyncWebServerRequest* request) {
+      asyncHandleInfo(request);
+    });
+    
+    asyncServer->on("/metrics", HTTP_GET, [this](AsyncWebServerRequest* request) {
+      asyncHandleMetrics(request);
+    });
+    
+    asyncServer->on("/log", HTTP_GET, [this](AsyncWebServerRequest* request) {
+      asyncHandleLog(request);
+    });
+    
+    asyncServer->on("/peer/manifest", HTTP_GET, [this](AsyncWebServerRequest* request) {
+      asyncHandlePeerManifest(request);
+    });
+    
+    asyncServer->on("/peer/image", HTTP_GET, [this](AsyncWebServerRequest* request) {
+      asyncHandlePeerImage(request);
+    });
+    
+    // Resumable uploads are only implemented on WebServer; say so rather
+    // than 404, so a client can fall back to /update
+    asyncServer->on("/resume", HTTP_ANY, [](AsyncWebServerRequest* request) {
+      request->send(501, "text/plain", "Resumable uploads need the WebServer backend");
+    });
+    
+    asyncServer->onNotFound([](AsyncWebServerRequest* request) {
+      request->send(404, "text/plain", "Not Found");
+    });
+  }
+  asyncServer->begin();
+  logInfo("Async web server started");
+}
+
+void AViShaOTA::stopAsyncServer(bool release) {
+  if (!asyncServer) {
+    return;
+  }
+  asyncServer->end();
+  if (release) {
+    delete asyncServer;
+    asyncServer = nullptr;
+  }
+}
+
+void AViShaOTA::asyncHandleRoot(AsyncWebServerRequest* request) {
+  // Browser already has this exact page
+  if (requestHeader(request, "If-None-Match").indexOf(getUploadETag()) >= 0) {
+    request->send(304);
+    return;
+  }
+
+  bool gzip = requestHeader(request, "Accept-Encoding").indexOf("gzip") >= 0;
+  size_t len;
+  const uint8_t* page = getUploadPage(gzip, len);
+  AsyncWebServerResponse* response = request->beginResponse_P(200, "text/html", page, len);
+  if (gzip) {
+    response->addHeader("Content-Encoding", "gzip");
+  }
+  response->addHeader("ETag", getUploadETag());
+  response->addHeader("Cache-Control", "no-cache");
+  response->addHeader("Vary", "Accept-Encoding");
+  request->send(response);
+}
+
+void AViShaOTA::asyncHandleAuth(AsyncWebServerRequest* request) {
+  AsyncWebServerResponse* response = request->beginResponse_P(200, "text/plain",
+                                                              (const uint8_t*)issueNonce(), 32);
+  response->addHeader("Cache-Control", "no-store");
+  request->send(response);
+}
+
+void AViShaOTA::asyncHandleInfo(AsyncWebServerRequest* request) {
+  if (requestHeader(request, "Accept").indexOf("text/html") >= 0) {
+    request->send_P(200, "text/html", getInfoHTML());
+    return;
+  }
+
+  AsyncResponseStream* response = request->beginResponseStream("application/json");
+  response->addHeader("Cache-Control", "no-store");
+  writeSystemInfo(*response);
+  request->send(response);
+}
+
+void AViShaOTA::asyncHandleMetrics(AsyncWebServerRequest* request) {
+  AsyncResponseStream* response = request->beginResponseStream("text/plain; version=0.0.4");
+  response->addHeader("Cache-Control", "no-store");
+  writeMetrics(*response);
+  request->send(response);
+}
+
+// Same records and headers as handleLog()
+void AViShaOTA::asyncHandleLog(AsyncWebServerRequest* request) {
+  if (!authorizeUpload(requestHeader(request, "X-OTA-Auth"), plainPassword(request))) {
+    authFailures++;
+    request->send(401, "text/plain", "Authentication failed");
+    return;
+  }
+  
+  uint32_t next = logger.next();
+  uint32_t seq = logger.first();
+  String since = requestArg(request, "since");
+  if (since.length() > 0) {
+    seq = max(seq, (uint32_t)strtoul(since.c_str(), nullptr, 10));
+  }
+  
+  AsyncResponseStream* response = request->beginResponseStream("text/plain");
+  response->addHeader("Cache-Control", "no-store");
+  response->addHeader("X-Log-Next", String(next));
+  response->addHeader("X-Log-Dropped", String(logger.getDropped()));
+  writeLog(*response, seq, next);
+  request->send(response);
+}
+
+void AViShaOTA::asyncHandlePeerManifest(AsyncWebServerRequest* request) {
+  if (!peerImageReady()) {
+    request->send(404, "text/plain", "No image to share");
+    return;
+  }
+  AsyncWebServerResponse* response = request->beginResponse(200, "application/json", peerManifest());
+  response->addHeader("Cache-Control", "no-store");
+  request->send(response);
+}
+
+// Read out of the running slot as AsyncTCP asks for more, see handlePeerImage()
+void AViShaOTA::asyncHandlePeerImage(AsyncWebServerRequest* request) {
+  if (!peerImageReady()) {
+    request->send(404, "text/plain", "No image to share");
+    return;
+  }
+  if (!authorizePeer(requestHeader(request, "X-OTA-Auth"))) {
+    authFailures++;
+    request->send(401, "text/plain", "Authentication failed");
+    return;
+  }
+  
+  bool withSignature = requestArg(request, "signature") == "1";
+  if (withSignature && !peerImage.hasSignature) {
+    request->send(404, "text/plain", "Image is not signed");
+    return;
+  }
+  
+  const esp_partition_t* partition = esp_ota_get_running_partition();
+  size_t imageSize = peerImage.size;
+  size_t total = imageSize + (withSignature ? AVISHA_OTA_SIGNATURE_SIZE : 0);
+  request->send(request->beginResponse("application/octet-stream", total,
+                                       [this, partition, imageSize, total](uint8_t* buffer, size_t maxLen,
+                                                                           size_t index) -> size_t {
+    if (index >= imageSize) {
+      size_t n = min(maxLen, total - index);
+      memcpy(buffer, peerImage.signature + (index - imageSize), n);
+      return n;
+    }
+    size_t n = min(maxLen, imageSize - index);
+    if (esp_partition_read(partition, index, buffer, n) != ESP_OK) {
+      logWarning("Peer transfer aborted");
+      return 0;
+    }
+    return n;
+  }));
+}
+
+// Answer to an async upload. The final one is held back until service()
+// has finished the update: AsyncTCP polls a response that has not
+// finished, so the status is picked and written on its own task and no
+// other task touches the request. Either way the connection is closed
+// after the answer, like rejectUpload() does.
+class AViShaOTA::AsyncUploadReply : public AsyncWebServerResponse {
+public:
+  AsyncUploadReply(AViShaOTA* ota, uint16_t id) : ota(ota), id(id), message(nullptr) {
+    _code = 500;
+    _contentType = "text/plain";
+  }
+  
+  AsyncUploadReply(int code, const char* message) : ota(nullptr), id(0), message(message) {
+    _code = code;
+    _contentType = "text/plain";
+  }
+  
+  bool _sourceValid() const override {
+    return true;
+  }
+  
+  void _respond(AsyncWebServerRequest* request) override {
+    _state = RESPONSE_HEADERS;
+    _ack(request, 0, 0);
+  }
+  
+  size_t _ack(AsyncWebServerRequest* request, size_t len, uint32_t time) override {
+    if (_state == RESPONSE_WAIT_ACK) {
+      _ackedLength += len;
+      if (_ackedLength >= _writtenLength) {
+        _state = RESPONSE_END;
+        request->client()->close(true);
+      }
+      return 0;
+    }
+    if (_state != RESPONSE_HEADERS) {
+      return 0;
+    }
+    
+    const char* body = message;
+    if (ota) {
+      uint32_t result = ota->asyncResult;
+      uint16_t done = result >> 16;
+      if (done == id) {
+        _code = result & 0xFFFF;
+      } else if ((uint16_t)(done - id) >= 0x8000) {
+        return 0; // Still writing or verifying
+      }
+      // else a later upload has finished since and this result is gone
+      body = _code == 200 ? "Update successful! ESP32 will restart..." : "Update failed";
+    }
+    _contentLength = strlen(body);
+    addHeader("Connection", "close");
+    String reply = _assembleHead(request->version()) + body;
+    if (request->client()->space() < reply.length()) {
+      return 0;
+    }
+    _writtenLength = request->client()->write(reply.c_str(), reply.length());
+    _state = RESPONSE_WAIT_ACK;
+    if (ota && _code == 200) {
+      // Count the restart delay from the reply, not from Update.end()
+      ota->restartRequested = millis();
+    }
+    return _writtenLength;
+  }
+  
+private:
+  AViShaOTA* ota;     // Null for an answer known up front
+  uint16_t id;
+  const char* message;
+};
+
+// Answered while the client is still sending, instead of after the whole
+// body, and the connection is closed once the client has the answer. The
+// marker tells the finish handler not to respond a second time; the
+// request frees it.
+void AViShaOTA::rejectAsyncUpload(AsyncWebServerRequest* request, int code, const char* message) {
+  request->_tempObject = malloc(1);
+  if (request->_tempObject) {
+    request->send(new AsyncUploadReply(code, message));
+  }
+}
+
+// Runs on the AsyncTCP task, one call per received segment of the file part.
+// The data is only copied into asyncBuffer for service(), so a slow flash
+// holds this task up for AVISHA_OTA_ASYNC_WAIT ms at most.
+void AViShaOTA::asyncHandleUpload(AsyncWebServerRequest* request, const String& filename, size_t index,
+                                  uint8_t* data, size_t len, bool final) {
+  if (index == 0) {
+    if (request->_tempObject) {
+      return;
+    }
+    if (!authorizeUpload(requestHeader(request, "X-OTA-Auth"), plainPassword(request))) {
+      authFailures++;
+      logError("OTA: Authentication failed - access denied");
+      rejectAsyncUpload(request, 401, "Unauthorized");
+      return;
+    }
+    // X-Update-Size or ?size= give the image size; a raw body is the image
+    bool rawBody = request->contentType().startsWith("application/octet-stream");
+    String size = requestHeader(request, "X-Update-Size");
+    if (size.length() == 0) {
+      size = requestArg(request, "size");
+    }
+    size_t declared = size.length() > 0 ? (size_t)size.toInt() : (rawBody ? request->contentLength() : 0);
+    if (!imageFits(declared, request->contentLength(), !rawBody)) {
+      logError("Web Update: %u bytes do not fit in %u", (unsigned)(declared ? declared : request->contentLength()),
+               ESP.getFreeSketchSpace());
+      rejectAsyncUpload(request, 413, "Payload Too Large");
+      return;
+    }
+    // One update at a time, whichever path it comes in on
+    if (!claimUpdate(AViShaOTAEvent::SOURCE_WEB)) {
+      logWarning("Web Update rejected, another update is in progress");
+      rejectAsyncUpload(request, 409, "Another update is in progress");
+      return;
+    }
+    asyncBuffer = xRingbufferCreate(AVISHA_OTA_ASYNC_BUFFER, RINGBUF_TYPE_BYTEBUF);
+    if (!asyncBuffer) {
+      releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+      logError("Web Update: out of memory");
+      rejectAsyncUpload(request, 500, "Out of memory");
+      return;
+    }
+    
+    if (++asyncUploadId == 0) {
+      asyncUploadId = 1; // 0 is the "nothing finished yet" result
+    }
+    asyncUploader = request;
+    asyncHolds = 2;
+    asyncRaw = rawBody;
+    asyncOptions = ImageOptions();
+    asyncOptions.encoding = requestArg(request, "encoding");
+    asyncOptions.delta = requestArg(request, "mode") == "delta";
+    asyncOptions.md5 = requestArg(request, "md5");
+    asyncOptions.sha256 = requestHeader(request, "X-Update-SHA256");
+    if (asyncOptions.sha256.length() == 0) {
+      asyncOptions.sha256 = requestArg(request, "sha256");
+    }
+    asyncOptions.size = declared;
+    logInfo("Web Update Start: %s", filename.c_str());
+    // service() starts the pipeline once it sees this
+    asyncState = ASYNC_RECEIVING;
+    
+    request->onDisconnect([this, request]() {
+      detachAsyncUpload(request);
+    });
+  }
+  
+  if (request != asyncUploader || asyncState != ASYNC_RECEIVING) {
+    return;
+  }
+  
+  if (len > 0 && xRingbufferSend(asyncBuffer, data, len, pdMS_TO_TICKS(AVISHA_OTA_ASYNC_WAIT)) != pdTRUE) {
+    logError("Web Update: no room for %u bytes, flash writes fell behind", (unsigned)len);
+    int expected = ASYNC_RECEIVING;
+    asyncState.compare_exchange_strong(expected, ASYNC_ABORTED);
+    return;
+  }
+  if (final) {
+    int expected = ASYNC_RECEIVING;
+    asyncState.compare_exchange_strong(expected, ASYNC_RECEIVED);
+  }
+}
+
+// application/octet-stream body: the same pipeline, without multipart framing
+void AViShaOTA::asyncHandleBody(AsyncWebServerRequest* request, uint8_t* data, size_t len,
+                                size_t index, size_t total) {
+  if (!request->contentType().startsWith("application/octet-stream")) {
+    return;
+  }
+  asyncHandleUpload(request, "(raw body)", index, data, len, index + len >= total);
+}
+
+void AViShaOTA::asyncHandleUpdateFinish(AsyncWebServerRequest* request) {
+  if (request != asyncUploader) {
+    // Rejected uploads were already answered from the upload handler
+    if (!request->_tempObject) {
+      request->send(400, "text/plain", "No firmware received");
+    }
+    return;
+  }
+  uint16_t id = asyncUploadId;
+  // A body that ended before the file part did is aborted here
+  detachAsyncUpload(request);
+  request->send(new AsyncUploadReply(this, id));
+}
+
+// The request is done with the upload, because the body ended or the client
+// went away. AsyncTCP task only.
+void AViShaOTA::detachAsyncUpload(AsyncWebServerRequest* request) {
+  if (request != asyncUploader) {
+    return;
+  }
+  asyncUploader = nullptr;
+  int expected = ASYNC_RECEIVING;
+  if (asyncState.compare_exchange_strong(expected, ASYNC_ABORTED)) {
+    logWarning("Web Update was aborted");
+  }
+  dropAsyncHold();
+}
+
+// Called from service(): runs the update pipeline on what the AsyncTCP task
+// has put into asyncBuffer, at most one buffer's worth per pass
+void AViShaOTA::serviceAsyncUpload() {
+  int state = asyncState;
+  if (state == ASYNC_IDLE || state == ASYNC_DONE) {
+    return;
+  }
+  if (state == ASYNC_ABORTED) {
+    // Releases the writer and counts the failure, unless never started
+    abortImage();
+    finishAsyncUpload(false);
+    return;
+  }
+  
+  if (!asyncStarted) {
+    asyncStarted = true;
+    asyncWritten = 0;
+    // A full upload overwrites the partition a resumable session was filling
+    loadResume();
+    clearResume();
+    emit(AViShaOTAEvent::UPDATE_START, AViShaOTAEvent::SOURCE_WEB);
+    if (!beginImage(asyncOptions)) {
+      logError("Update.begin() failed: %s", Update.errorString());
+      finishAsyncUpload(false);
+      return;
+    }
+    // Raw bodies arrive as pointers into the TCP buffers, multipart file
+    // data is first collected by the request parser; both pass asyncBuffer
+    setReceiveMode(asyncRaw ? "async-raw" : "async", asyncRaw ? 1 : 2);
+  }
+  
+  bool empty = false;
+  for (size_t drained = 0; drained < AVISHA_OTA_ASYNC_BUFFER;) {
+    size_t len = 0;
+    uint8_t* data = (uint8_t*)xRingbufferReceiveUpTo(asyncBuffer, &len, 0, AVISHA_OTA_WRITE_BUFFER_SIZE);
+    if (!data) {
+      empty = true;
+      break;
+    }
+    bool written = writeImage(data, len);
+    vRingbufferReturnItem(asyncBuffer, data);
+    if (!written) {
+      logError("Update.write() failed: %s", Update.errorString());
+      abortImage();
+      finishAsyncUpload(false);
+      return;
+    }
+    drained += len;
+    asyncWritten += len;
+    events.progress(AViShaOTAEvent::SOURCE_WEB, asyncWritten, 0);
+  }
+  
+  // The state was read before draining, so the last byte has been written
+  if (state == ASYNC_RECEIVED && empty) {
+    bool success = endImage();
+    if (success) {
+      logInfo("Web Update Success: %u bytes", (unsigned)asyncWritten);
+      logUpdateStats();
+    } else {
+      logError("Update.end() failed: %s", Update.errorString());
+    }
+    finishAsyncUpload(success);
+  }
+}
+
+// Publishes the result for AsyncUploadReply, service() side
+void AViShaOTA::finishAsyncUpload(bool success) {
+  if (asyncStarted) {
+    if (success) {
+      logInfo("Web Update successful!");
+    } else {
+      logError("Web Update failed!");
+    }
+    emit(AViShaOTAEvent::UPDATE_END, AViShaOTAEvent::SOURCE_WEB, success);
+  }
+  asyncStarted = false;
+  asyncResult = (uint32_t)asyncUploadId << 16 | (success ? 200 : 500);
+  asyncState = ASYNC_DONE;
+  if (success) {
+    // Blocking here would stall every connection, handle() restarts
+    restartRequested = millis();
+    restartPending = true;
+  }
+  dropAsyncHold();
+}
+
+// The AsyncTCP and the service side each hold asyncBuffer; whichever lets
+// go last frees it and, unless the update went through, the pipeline
+void AViShaOTA::dropAsyncHold() {
+  if (--asyncHolds > 0) {
+    return;
+  }
+  vRingbufferDelete(asyncBuffer);
+  asyncBuffer = nullptr;
+  bool success = (asyncResult & 0xFFFF) == 200;
+  asyncState = ASYNC_IDLE;
+  // A successful update keeps the claim until the restart
+  if (!success) {
+    releaseUpdate(AViShaOTAEvent::SOURCE_WEB);
+  }
+}
+
+#else
+
+void AViShaOTA::stopAsyncServer(bool) {
+}
+
+void AViShaOTA::serviceAsyncUpload() {
+}
+
+#endif // AVISHA_OTA_ASYNC_SERVER
@@ -0,0 +1,192 @@
+// AViShaOTADelta.cpp - Streaming patch applier for delta updates
+#include "AViShaOTADelta.h"
+#include <esp_ota_ops.h>
+
+// Constructor
+AViShaOTADelta::AViShaOTADelta() {
+  this->source = nullptr;
+  this->state = STATE_HEADER;
+  this->value = 0;
+  this->shift = 0;
+  this->negative = false;
+  this->firstByte = true;
+  this->fromPos = 0;
+  this->toPos = 0;
+  this->toSize = 0;
+  this->remaining = 0;
+}
+
+const char* AViShaOTADelta::name() const {
+  return "delta";
+}
+
+// Patches are never sniffed, the uploader has to ask for delta mode
+bool AViShaOTADelta::detect(const uint8_t*, size_t) const {
+  return false;
+}
+
+bool AViShaOTADelta::begin() {
+  source = esp_ota_get_running_partition();
+  state = STATE_HEADER;
+  fromPos = 0;
+  toPos = 0;
+  toSize = 0;
+  remaining = 0;
+  return source != nullptr;
+}
+
+bool AViShaOTADelta::write(const uint8_t* data, size_t len) {
+  size_t pos = 0;
+
+  while (pos < len) {
+    switch (state) {
+      case STATE_HEADER: {
+        uint8_t header = data[pos++];
+        // Sequential patch type, no compression
+        if (((header >> 4) & 0x07) != 0 || (header & 0x0F) != 0) {
+          state = STATE_FAILED;
+          return false;
+        }
+        startSize(STATE_TO_SIZE);
+        break;
+      }
+      case STATE_TO_SIZE:
+        if (!readSize(data[pos++], false)) {
+          break;
+        }
+        if (value <= 0) {
+          state = STATE_FAILED;
+          return false;
+        }
+        toSize = (size_t)value;
+        startSize(STATE_DIFF_SIZE);
+        break;
+      case STATE_DIFF_SIZE:
+      case STATE_EXTRA_SIZE: {
+        bool diff = state == STATE_DIFF_SIZE;
+        if (!readSize(data[pos++], true)) {
+          break;
+        }
+        if (value < 0 || toPos + (size_t)value > toSize) {
+          state = STATE_FAILED;
+          return false;
+        }
+        remaining = (size_t)value;
+        if (remaining > 0) {
+          state = diff ? STATE_DIFF_DATA : STATE_EXTRA_DATA;
+        } else {
+          startSize(diff ? STATE_EXTRA_SIZE : STATE_ADJUSTMENT);
+        }
+        break;
+      }
+      case STATE_DIFF_DATA: {
+        size_t n = min(remaining, min(len - pos, sizeof(buffer)));
+        if (!applyDiff(data + pos, n)) {
+          state = STATE_FAILED;
+          return false;
+        }
+        pos += n;
+        remaining -= n;
+        if (remaining == 0) {
+          startSize(STATE_EXTRA_SIZE);
+        }
+        break;
+      }
+      case STATE_EXTRA_DATA: {
+        size_t n = min(remaining, len - pos);
+        if (!output(data + pos, n)) {
+          state = STATE_FAILED;
+          return false;
+        }
+        pos += n;
+        toPos += n;
+        remaining -= n;
+        if (remaining == 0) {
+          startSize(STATE_ADJUSTMENT);
+        }
+        break;
+      }
+      case STATE_ADJUSTMENT:
+        if (readSize(data[pos++], true)) {
+          fromPos += value;
+          afterAdjustment();
+        }
+        break;
+      default:
+        // Data after the end of the patch, or an earlier failure
+        state = STATE_FAILED;
+        return false;
+    }
+  }
+  return true;
+}
+
+bool AViShaOTADelta::end() {
+  bool ok = state == STATE_DONE && toPos == toSize;
+  source = nullptr;
+  return ok;
+}
+
+void AViShaOTADelta::abort() {
+  source = nullptr;
+  state = STATE_FAILED;
+}
+
+// Feed one byte of a varint, returns true once the value is complete.
+// Unsigned sizes are plain LEB128, signed sizes keep the sign in bit 6 of
+// the first byte followed by 6 value bits.
+bool AViShaOTADelta::readSize(uint8_t b, bool isSigned) {
+  if (firstByte && isSigned) {
+    negative = (b & 0x40) != 0;
+    value = b & 0x3F;
+    shift = 6;
+  } else {
+    if (shift > 56) {
+      state = STATE_FAILED;
+      return false;
+    }
+    value |= (int64_t)(b & 0x7F) << shift;
+    shift += 7;
+  }
+  firstByte = false;
+
+  if (b & 0x80) {
+    return false;
+  }
+  if (negative) {
+    value = -value;
+  }
+  return true;
+}
+
+// Add the patch bytes to the source bytes at fromPos and emit the result
+bool AViShaOTADelta::applyDiff(const uint8_t* data, size_t len) {
+  if (fromPos < 0 || (size_t)fromPos + len > source->size) {
+    return false;
+  }
+  if (esp_partition_read(source, (size_t)fromPos, buffer, len) != ESP_OK) {
+    return false;
+  }
+  for (size_t i = 0; i < len; i++) {
+    buffer[i] += data[i];
+  }
+  fromPos += len;
+  toPos += len;
+  return output(buffer, len);
+}
+
+void AViShaOTADelta::startSize(State next) {
+  state = next;
+  value = 0;
+  shift = 0;
+  negative = false;
+  firstByte = true;
+}
+
+void AViShaOTADelta::afterAdjustment() {
+  if (toPos >= toSize) {
+    state = STATE_DONE;
+  } else {
+    startSize(STATE_DIFF_SIZE);
+  }
+}
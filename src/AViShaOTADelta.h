@@ -0,0 +1,66 @@
+#ifndef AVISHA_OTA_DELTA_H
+#define AVISHA_OTA_DELTA_H
+
+#include "AViShaOTA.h"
+#include <esp_partition.h>
+
+#define AVISHA_OTA_DELTA_BUFFER 256
+
+// Streaming patch applier for delta updates. The patch uses the detools
+// "sequential" layout without compression (compress it with gzip instead):
+//
+//   header   1 byte, patch type (bits 4-6) = 0, compression (bits 0-3) = 0
+//   to_size  unsigned varint, size of the resulting image
+//   repeated until to_size bytes are produced:
+//     diff size, diff bytes      added bytewise to the source at from_pos
+//     extra size, extra bytes    copied verbatim
+//     adjustment                 signed offset added to from_pos
+//
+// The source is the currently running app partition, read in small slices
+// as the diff data streams in.
+class AViShaOTADelta : public AViShaOTA::Codec {
+public:
+    AViShaOTADelta();
+
+    const char* name() const override;
+    bool detect(const uint8_t* data, size_t len) const override;
+    bool begin() override;
+    bool write(const uint8_t* data, size_t len) override;
+    bool end() override;
+    void abort() override;
+
+private:
+    enum State {
+        STATE_HEADER,
+        STATE_TO_SIZE,
+        STATE_DIFF_SIZE,
+        STATE_DIFF_DATA,
+        STATE_EXTRA_SIZE,
+        STATE_EXTRA_DATA,
+        STATE_ADJUSTMENT,
+        STATE_DONE,
+        STATE_FAILED
+    };
+
+    const esp_partition_t* source;
+    State state;
+
+    // Varint being decoded
+    int64_t value;
+    uint8_t shift;
+    bool negative;
+    bool firstByte;
+
+    int64_t fromPos;
+    size_t toPos;
+    size_t toSize;
+    size_t remaining;
+    uint8_t buffer[AVISHA_OTA_DELTA_BUFFER];
+
+    bool readSize(uint8_t b, bool isSigned);
+    bool applyDiff(const uint8_t* data, size_t len);
+    void startSize(State next);
+    void afterAdjustment();
+};
+
+#endif // AVISHA_OTA_DELTA_H
@@ -0,0 +1,104 @@
+// AViShaOTAEvents.cpp - Allocation-free event dispatch
+#include "AViShaOTAEvents.h"
+
+// Constructor
+AViShaOTAEvents::AViShaOTAEvents() {
+  this->subscribed = 0;
+  this->progressInterval = 0;
+  this->progressStep = 1;
+  this->lastProgressTime = 0;
+  this->lastProgress = 0;
+  this->lastPercent = 0;
+  for (uint8_t i = 0; i < AVISHA_OTA_MAX_HANDLERS; i++) {
+    slots[i].mask = 0;
+  }
+}
+
+int AViShaOTAEvents::subscribe(const AViShaOTAEventHandler& handler, uint16_t mask) {
+  if (!handler || mask == 0) {
+    return -1;
+  }
+  for (uint8_t i = 0; i < AVISHA_OTA_MAX_HANDLERS; i++) {
+    if (slots[i].mask == 0) {
+      slots[i].handler = handler;
+      slots[i].mask = mask;
+      updateMask();
+      return i;
+    }
+  }
+  return -1;
+}
+
+void AViShaOTAEvents::unsubscribe(int id) {
+  if (id < 0 || id >= AVISHA_OTA_MAX_HANDLERS) {
+    return;
+  }
+  slots[id].mask = 0;
+  slots[id].handler = AViShaOTAEventHandler();
+  updateMask();
+}
+
+void AViShaOTAEvents::setProgressRate(unsigned long interval, uint8_t percentStep) {
+  this->progressInterval = interval;
+  this->progressStep = percentStep;
+}
+
+void AViShaOTAEvents::emit(const AViShaOTAEvent& event) {
+  if (event.type == AViShaOTAEvent::UPDATE_START) {
+    lastProgressTime = millis();
+    lastProgress = 0;
+    lastPercent = 0;
+  }
+
+  uint16_t bit = AVISHA_OTA_EVENT_MASK(event.type);
+  if (!(subscribed & bit)) {
+    return;
+  }
+  for (uint8_t i = 0; i < AVISHA_OTA_MAX_HANDLERS; i++) {
+    if (slots[i].mask & bit) {
+      slots[i].handler(event);
+    }
+  }
+}
+
+// Deliver a progress event only when it is due, the last one always is
+bool AViShaOTAEvents::progress(AViShaOTAEvent::Source source, uint32_t progress, uint32_t total) {
+  if (!(subscribed & AVISHA_OTA_EVENT_MASK(AViShaOTAEvent::UPDATE_PROGRESS))) {
+    return false;
+  }
+
+  bool due = (progressInterval == 0 && progressStep == 0) || (total > 0 && progress >= total);
+  unsigned long now = millis();
+  if (!due && progressInterval > 0 && now - lastProgressTime >= progressInterval) {
+    due = true;
+  }
+  uint8_t percent = lastPercent;
+  if (total > 0) {
+    percent = (uint64_t)progress * 100 / total;
+    due = due || (progressStep > 0 && percent >= lastPercent + progressStep);
+  } else if (!due && progressStep > 0) {
+    due = progress - lastProgress >= (uint32_t)progressStep * AVISHA_OTA_PROGRESS_BYTES;
+  }
+  if (!due) {
+    return false;
+  }
+
+  lastProgressTime = now;
+  lastProgress = progress;
+  lastPercent = percent;
+
+  AViShaOTAEvent event = {};
+  event.type = AViShaOTAEvent::UPDATE_PROGRESS;
+  event.source = source;
+  event.progress = progress;
+  event.total = total;
+  emit(event);
+  return true;
+}
+
+void AViShaOTAEvents::updateMask() {
+  subscribed = 0;
+  for (uint8_t i = 0; i < AVISHA_OTA_MAX_HANDLERS; i++) {
+    subscribed |= slots[i].mask;
+  }
+}
@@ -0,0 +1,107 @@
+#ifndef AVISHA_OTA_EVENTS_H
+#define AVISHA_OTA_EVENTS_H
+
+#include <Arduino.h>
+#include <ArduinoOTA.h>
+#include <new>
+#include <type_traits>
+
+#ifndef AVISHA_OTA_MAX_HANDLERS
+#define AVISHA_OTA_MAX_HANDLERS 16
+#endif
+#ifndef AVISHA_OTA_HANDLER_SIZE
+#define AVISHA_OTA_HANDLER_SIZE 16 // Bytes of captured state per handler
+#endif
+#define AVISHA_OTA_PROGRESS_BYTES 16384 // One "percent" when the total is unknown
+#define AVISHA_OTA_EVENT_MASK(type) (1u << (type))
+#define AVISHA_OTA_ALL_EVENTS 0xFFFF
+
+// One event stream for every update path and the connection state
+struct AViShaOTAEvent {
+    enum Type : uint8_t {
+        UPDATE_START,
+        UPDATE_PROGRESS,
+        UPDATE_END,         // Every finished update, see success
+        UPDATE_ERROR,       // Sent before a failed UPDATE_END when a code applies
+        WIFI_CONNECTED,
+        WIFI_DISCONNECTED,
+        STATE_CHANGE
+    };
+    enum Source : uint8_t {
+        SOURCE_NONE,
+        SOURCE_ARDUINO_OTA,
+        SOURCE_WEB,
+        SOURCE_PULL,
+        SOURCE_PEER,
+        SOURCE_PUSH
+    };
+
+    Type type;
+    Source source;
+    bool success;
+    uint8_t state;          // AViShaOTA::StartState for STATE_CHANGE
+    ota_error_t error;
+    uint32_t progress;
+    uint32_t total;         // 0 when the size is not known up front
+};
+
+// Callable with up to AVISHA_OTA_HANDLER_SIZE bytes of captured state, kept
+// inline so subscribing never allocates. Captures must be trivially
+// copyable (pointers, integers); capture a pointer to anything larger.
+class AViShaOTAEventHandler {
+public:
+    AViShaOTAEventHandler() : invoker(nullptr) {}
+
+    template <typename Function, typename = typename std::enable_if<
+                  !std::is_same<typename std::decay<Function>::type, AViShaOTAEventHandler>::value>::type>
+    AViShaOTAEventHandler(Function function) {
+        static_assert(sizeof(Function) <= AVISHA_OTA_HANDLER_SIZE, "handler captures too much, capture a pointer");
+        static_assert(alignof(Function) <= alignof(void*), "handler capture is over-aligned");
+        static_assert(std::is_trivially_copyable<Function>::value, "handler captures must be trivially copyable");
+        new (storage) Function(function);
+        invoker = [](const void* stored, const AViShaOTAEvent& event) {
+            (*static_cast<const Function*>(stored))(event);
+        };
+    }
+
+    void operator()(const AViShaOTAEvent& event) const { invoker(storage, event); }
+    explicit operator bool() const { return invoker != nullptr; }
+
+private:
+    void (*invoker)(const void* stored, const AViShaOTAEvent& event);
+    alignas(void*) uint8_t storage[AVISHA_OTA_HANDLER_SIZE];
+};
+
+// Fixed-capacity subscriber table. Progress events are coalesced so a
+// subscriber sees at most one per interval or percent step, however small
+// the chunks are.
+class AViShaOTAEvents {
+public:
+    AViShaOTAEvents();
+
+    int subscribe(const AViShaOTAEventHandler& handler, uint16_t mask = AVISHA_OTA_ALL_EVENTS); // -1 when full
+    void unsubscribe(int id);
+    void setProgressRate(unsigned long interval, uint8_t percentStep); // 0, 0 = every chunk
+
+    void emit(const AViShaOTAEvent& event);
+    bool progress(AViShaOTAEvent::Source source, uint32_t progress, uint32_t total); // true if delivered
+
+private:
+    struct Slot {
+        AViShaOTAEventHandler handler;
+        uint16_t mask;
+    };
+
+    Slot slots[AVISHA_OTA_MAX_HANDLERS];
+    uint16_t subscribed;    // Union of all masks, skips events nobody wants
+
+    unsigned long progressInterval;
+    uint8_t progressStep;
+    unsigned long lastProgressTime;
+    uint32_t lastProgress;
+    uint8_t lastPercent;
+
+    void updateMask();
+};
+
+#endif // AVISHA_OTA_EVENTS_H
@@ -0,0 +1,244 @@
+// AViShaOTAGzip.cpp - Streaming gzip decoder for compressed uploads
+#include "AViShaOTAGzip.h"
+
+#if __has_include("esp32/rom/miniz.h")
+#include "esp32/rom/miniz.h"
+#include "esp32/rom/crc.h"
+#else
+#include "rom/miniz.h"
+#include "rom/crc.h"
+#endif
+
+// gzip header flags (RFC 1952)
+#define GZIP_FHCRC    0x02
+#define GZIP_FEXTRA   0x04
+#define GZIP_FNAME    0x08
+#define GZIP_FCOMMENT 0x10
+
+static uint32_t readLE32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Constructor
+AViShaOTAGzip::AViShaOTAGzip(size_t windowSize) {
+  this->windowSize = windowSize;
+  this->windowPos = 0;
+  this->window = nullptr;
+  this->inflater = nullptr;
+  this->state = STATE_HEADER;
+  this->flags = 0;
+  this->fieldPos = 0;
+  this->extraLen = 0;
+  this->tailLen = 0;
+  this->crc = 0;
+  this->outputSize = 0;
+}
+
+// Destructor
+AViShaOTAGzip::~AViShaOTAGzip() {
+  release();
+}
+
+const char* AViShaOTAGzip::name() const {
+  return "gzip";
+}
+
+bool AViShaOTAGzip::detect(const uint8_t* data, size_t len) const {
+  return len >= 2 && data[0] == 0x1F && data[1] == 0x8B;
+}
+
+bool AViShaOTAGzip::begin() {
+  // The output window doubles as the LZ dictionary and must wrap on a power of two
+  if (windowSize == 0 || (windowSize & (windowSize - 1)) != 0) {
+    return false;
+  }
+
+  release();
+  inflater = (tinfl_decompressor*)malloc(sizeof(tinfl_decompressor));
+  window = (uint8_t*)malloc(windowSize);
+  if (!inflater || !window) {
+    release();
+    return false;
+  }
+
+  tinfl_init(inflater);
+  windowPos = 0;
+  state = STATE_HEADER;
+  flags = 0;
+  fieldPos = 0;
+  extraLen = 0;
+  tailLen = 0;
+  crc = 0;
+  outputSize = 0;
+  return true;
+}
+
+bool AViShaOTAGzip::write(const uint8_t* data, size_t len) {
+  if (!inflater) {
+    return false;
+  }
+
+  // Keep the trailer out of the inflater until we know where the stream ends
+  if (tailLen + len <= sizeof(tail)) {
+    memcpy(tail + tailLen, data, len);
+    tailLen += len;
+    return true;
+  }
+
+  size_t feed = tailLen + len - sizeof(tail);
+  size_t fromTail = feed < tailLen ? feed : tailLen;
+  if (!consume(tail, fromTail)) {
+    return false;
+  }
+  memmove(tail, tail + fromTail, tailLen - fromTail);
+  tailLen -= fromTail;
+  feed -= fromTail;
+
+  if (!consume(data, feed)) {
+    return false;
+  }
+  memcpy(tail + tailLen, data + feed, len - feed);
+  tailLen += len - feed;
+  return true;
+}
+
+bool AViShaOTAGzip::end() {
+  bool ok = inflater && tailLen == sizeof(tail);
+
+  if (ok && state == STATE_INFLATE) {
+    ok = inflate(tail, 0, true);
+  }
+
+  ok = ok && state == STATE_DONE &&
+       readLE32(tail) == crc &&
+       readLE32(tail + 4) == outputSize;
+
+  release();
+  return ok;
+}
+
+void AViShaOTAGzip::abort() {
+  release();
+}
+
+// Parse the gzip header byte by byte, then hand the deflate body to tinfl
+bool AViShaOTAGzip::consume(const uint8_t* data, size_t len) {
+  size_t pos = 0;
+
+  while (pos < len && state != STATE_INFLATE) {
+    uint8_t b = data[pos++];
+
+    switch (state) {
+      case STATE_HEADER:
+        header[fieldPos++] = b;
+        if (fieldPos == sizeof(header)) {
+          // Magic and CM = 8 (deflate)
+          if (header[0] != 0x1F || header[1] != 0x8B || header[2] != 8) {
+            return false;
+          }
+          flags = header[3];
+          state = nextHeaderState();
+        }
+        break;
+      case STATE_EXTRA_LEN:
+        extraLen |= (size_t)b << (8 * fieldPos++);
+        if (fieldPos == 2) {
+          fieldPos = 0;
+          state = extraLen > 0 ? STATE_EXTRA : nextHeaderState();
+        }
+        break;
+      case STATE_EXTRA:
+        if (++fieldPos == extraLen) {
+          state = nextHeaderState();
+        }
+        break;
+      case STATE_NAME:
+      case STATE_COMMENT:
+        if (b == 0) {
+          state = nextHeaderState();
+        }
+        break;
+      case STATE_HCRC:
+        if (++fieldPos == 2) {
+          state = nextHeaderState();
+        }
+        break;
+      default:
+        // Data after the end of the deflate stream
+        return false;
+    }
+  }
+
+  if (pos < len) {
+    return inflate(data + pos, len - pos, false);
+  }
+  return true;
+}
+
+bool AViShaOTAGzip::inflate(const uint8_t* data, size_t len, bool finish) {
+  mz_uint32 decompFlags = finish ? 0 : TINFL_FLAG_HAS_MORE_INPUT;
+
+  for (;;) {
+    size_t inBytes = len;
+    size_t outBytes = windowSize - windowPos;
+    tinfl_status status = tinfl_decompress(inflater, data, &inBytes,
+                                           window, window + windowPos, &outBytes,
+                                           decompFlags);
+    data += inBytes;
+    len -= inBytes;
+
+    if (outBytes > 0) {
+      crc = crc32_le(crc, window + windowPos, outBytes);
+      outputSize += outBytes;
+      if (!output(window + windowPos, outBytes)) {
+        return false;
+      }
+      windowPos = (windowPos + outBytes) & (windowSize - 1);
+    }
+
+    if (status == TINFL_STATUS_DONE) {
+      state = STATE_DONE;
+      return len == 0;
+    }
+    if (status < 0) {
+      return false;
+    }
+    if (status == TINFL_STATUS_NEEDS_MORE_INPUT) {
+      // Only acceptable while more input is still to come
+      return !finish;
+    }
+  }
+}
+
+AViShaOTAGzip::State AViShaOTAGzip::nextHeaderState() {
+  fieldPos = 0;
+  if (flags & GZIP_FEXTRA) {
+    flags &= ~GZIP_FEXTRA;
+    extraLen = 0;
+    return STATE_EXTRA_LEN;
+  }
+  if (flags & GZIP_FNAME) {
+    flags &= ~GZIP_FNAME;
+    return STATE_NAME;
+  }
+  if (flags & GZIP_FCOMMENT) {
+    flags &= ~GZIP_FCOMMENT;
+    return STATE_COMMENT;
+  }
+  if (flags & GZIP_FHCRC) {
+    flags &= ~GZIP_FHCRC;
+    return STATE_HCRC;
+  }
+  return STATE_INFLATE;
+}
+
+void AViShaOTAGzip::release() {
+  if (inflater) {
+    free(inflater);
+    inflater = nullptr;
+  }
+  if (window) {
+    free(window);
+    window = nullptr;
+  }
+}
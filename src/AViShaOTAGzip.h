@@ -0,0 +1,59 @@
+#ifndef AVISHA_OTA_GZIP_H
+#define AVISHA_OTA_GZIP_H
+
+#include "AViShaOTA.h"
+
+// Forward declaration of the ROM inflater state
+struct tinfl_decompressor_tag;
+
+// Streaming gzip decoder built on the ROM tinfl inflater. Memory use is fixed
+// at the inflater state plus one wrapping output window, allocated in begin()
+// and released when the upload ends.
+class AViShaOTAGzip : public AViShaOTA::Codec {
+public:
+    AViShaOTAGzip(size_t windowSize = AVISHA_OTA_GZIP_WINDOW);
+    ~AViShaOTAGzip();
+
+    const char* name() const override;
+    bool detect(const uint8_t* data, size_t len) const override;
+    bool begin() override;
+    bool write(const uint8_t* data, size_t len) override;
+    bool end() override;
+    void abort() override;
+
+private:
+    enum State {
+        STATE_HEADER,
+        STATE_EXTRA_LEN,
+        STATE_EXTRA,
+        STATE_NAME,
+        STATE_COMMENT,
+        STATE_HCRC,
+        STATE_INFLATE,
+        STATE_DONE
+    };
+
+    size_t windowSize;
+    size_t windowPos;
+    uint8_t* window;
+    struct tinfl_decompressor_tag* inflater;
+
+    State state;
+    uint8_t header[10];
+    uint8_t flags;
+    size_t fieldPos;
+    size_t extraLen;
+
+    // The last 8 bytes seen are held back, they are the CRC32/ISIZE trailer
+    uint8_t tail[8];
+    size_t tailLen;
+    uint32_t crc;
+    uint32_t outputSize;
+
+    bool consume(const uint8_t* data, size_t len);
+    bool inflate(const uint8_t* data, size_t len, bool finish);
+    State nextHeaderState();
+    void release();
+};
+
+#endif // AVISHA_OTA_GZIP_H
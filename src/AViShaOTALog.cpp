@@ -0,0 +1,217 @@
+// AViShaOTALog.cpp - Deferred-format log ring buffer
+#include "AViShaOTALog.h"
+
+// Walks one conversion spec starting after '%', returns its conversion char
+static const char* parseSpec(const char* p, char* spec, size_t specSize, bool& isLong) {
+  size_t n = 0;
+  spec[n++] = '%';
+  isLong = false;
+  while (*p && strchr("-+ #0123456789", *p)) {
+    if (n < specSize - 3) {
+      spec[n++] = *p;
+    }
+    p++;
+  }
+  while (*p == 'l') {
+    isLong = true;
+    p++;
+  }
+  if (*p) {
+    spec[n++] = *p;
+  }
+  spec[n] = '\0';
+  return p;
+}
+
+// Constructor
+AViShaOTALog::AViShaOTALog() {
+  this->head = 0;
+  this->drained = 0;
+  this->dropped = 0;
+  this->level = LEVEL_INFO;
+  this->lock = portMUX_INITIALIZER_UNLOCKED;
+}
+
+void AViShaOTALog::setLevel(Level level) {
+  this->level = level;
+}
+
+AViShaOTALog::Level AViShaOTALog::getLevel() const {
+  return level;
+}
+
+void AViShaOTALog::write(Level level, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  vwrite(level, format, args);
+  va_end(args);
+}
+
+void AViShaOTALog::vwrite(Level level, const char* format, va_list args) {
+  if (level > this->level) {
+    return;
+  }
+
+  Record record;
+  record.time = millis();
+  record.format = format;
+  record.level = level;
+  uint8_t argc = 0;
+  size_t textLen = 0;
+  char spec[16];
+
+  for (const char* p = format; *p; p++) {
+    if (*p != '%') {
+      continue;
+    }
+    if (p[1] == '%') {
+      p++;
+      continue;
+    }
+    bool isLong;
+    p = parseSpec(p + 1, spec, sizeof(spec), isLong);
+    if (!*p) {
+      break;
+    }
+
+    if (*p == 's') {
+      const char* text = va_arg(args, const char*);
+      if (!text) {
+        text = "";
+      }
+      // Strings are copied, truncated to what is left of the text field
+      // and then marked, so a cut URL or error does not pass for whole
+      size_t room = sizeof(record.text) - textLen;
+      if (room > 0) {
+        size_t len = strnlen(text, room - 1);
+        memcpy(record.text + textLen, text, len);
+        record.text[textLen + len] = '\0';
+        if (text[len] != '\0' && len >= 3) {
+          memcpy(record.text + textLen + len - 3, "...", 3);
+        }
+        textLen += len + 1;
+      }
+    } else {
+      uint32_t value = isLong ? (uint32_t)va_arg(args, unsigned long) : (uint32_t)va_arg(args, unsigned int);
+      if (argc < AVISHA_OTA_LOG_ARGS) {
+        record.args[argc++] = value;
+      }
+    }
+  }
+
+  portENTER_CRITICAL(&lock);
+  if (head - drained >= AVISHA_OTA_LOG_RECORDS) {
+    drained++;
+    dropped++;
+  }
+  records[head % AVISHA_OTA_LOG_RECORDS] = record;
+  head++;
+  portEXIT_CRITICAL(&lock);
+}
+
+uint32_t AViShaOTALog::first() const {
+  return head > AVISHA_OTA_LOG_RECORDS ? head - AVISHA_OTA_LOG_RECORDS : 0;
+}
+
+uint32_t AViShaOTALog::next() const {
+  return head;
+}
+
+uint32_t AViShaOTALog::getDropped() const {
+  return dropped;
+}
+
+bool AViShaOTALog::read(uint32_t seq, Record& record) const {
+  portENTER_CRITICAL(&lock);
+  bool ok = seq < head && head - seq <= AVISHA_OTA_LOG_RECORDS;
+  if (ok) {
+    record = records[seq % AVISHA_OTA_LOG_RECORDS];
+  }
+  portEXIT_CRITICAL(&lock);
+  return ok;
+}
+
+size_t AViShaOTALog::format(const Record& record, char* out, size_t size) {
+  size_t pos = 0;
+  uint8_t argc = 0;
+  size_t textPos = 0;
+  char spec[16];
+
+  out[0] = '\0';
+  for (const char* p = record.format; *p && pos + 1 < size; p++) {
+    if (*p != '%') {
+      out[pos++] = *p;
+      continue;
+    }
+    if (p[1] == '%') {
+      out[pos++] = '%';
+      p++;
+      continue;
+    }
+    bool isLong;
+    p = parseSpec(p + 1, spec, sizeof(spec), isLong);
+    if (!*p) {
+      break;
+    }
+
+    int n = 0;
+    if (*p == 's') {
+      const char* text = textPos < sizeof(record.text) ? record.text + textPos : "";
+      n = snprintf(out + pos, size - pos, spec, text);
+      textPos += strnlen(text, sizeof(record.text) - textPos) + 1;
+    } else if (argc < AVISHA_OTA_LOG_ARGS) {
+      uint32_t value = record.args[argc++];
+      if (*p == 'd' || *p == 'i') {
+        n = snprintf(out + pos, size - pos, spec, (int)(int32_t)value);
+      } else {
+        n = snprintf(out + pos, size - pos, spec, (unsigned int)value);
+      }
+    }
+    if (n > 0) {
+      pos += min((size_t)n, size - pos - 1);
+    }
+  }
+  out[pos] = '\0';
+  return pos;
+}
+
+size_t AViShaOTALog::drain(Print& out, size_t maxRecords) {
+  char line[AVISHA_OTA_LOG_LINE];
+  size_t written = 0;
+
+  while (written < maxRecords) {
+    Record record;
+    portENTER_CRITICAL(&lock);
+    uint32_t seq = drained;
+    bool pending = seq < head;
+    if (pending) {
+      record = records[seq % AVISHA_OTA_LOG_RECORDS];
+    }
+    portEXIT_CRITICAL(&lock);
+    if (!pending) {
+      break;
+    }
+
+    size_t len = format(record, line, sizeof(line) - 1);
+    line[len++] = '\n';
+    if (out.availableForWrite() < (int)len) {
+      break;
+    }
+    out.write((const uint8_t*)line, len);
+
+    // A writer that overwrote this record meanwhile already moved the cursor
+    portENTER_CRITICAL(&lock);
+    if (drained == seq) {
+      drained++;
+    }
+    portEXIT_CRITICAL(&lock);
+    written++;
+  }
+  return written;
+}
+
+void AViShaOTALog::skip() {
+  portENTER_CRITICAL(&lock);
+  drained = head;
+  portEXIT_CRITICAL(&lock);
+}
@@ -0,0 +1,68 @@
+#ifndef AVISHA_OTA_LOG_H
+#define AVISHA_OTA_LOG_H
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include <freertos/FreeRTOS.h>
+
+#ifndef AVISHA_OTA_LOG_RECORDS
+#define AVISHA_OTA_LOG_RECORDS 32
+#endif
+#define AVISHA_OTA_LOG_ARGS 4
+#ifndef AVISHA_OTA_LOG_TEXT
+#define AVISHA_OTA_LOG_TEXT 96 // Room for %s arguments, NUL separated; cut ones end in "..."
+#endif
+#define AVISHA_OTA_LOG_LINE 160
+
+// Ring buffer of binary log records. Writing stores the format pointer and
+// the raw arguments; text is only produced when a record is drained to
+// Serial or fetched over HTTP, so logging on the update path never waits
+// for the UART. The oldest records are overwritten when the ring is full.
+//
+// Formats must be string literals (they are kept by pointer) and support
+// %d %i %u %x %X %c %s with optional flags, width and the l modifier.
+class AViShaOTALog {
+public:
+    enum Level : uint8_t {
+        LEVEL_ERROR,
+        LEVEL_WARN,
+        LEVEL_INFO,
+        LEVEL_DEBUG
+    };
+
+    struct Record {
+        uint32_t time;
+        const char* format;     // Message id
+        uint32_t args[AVISHA_OTA_LOG_ARGS];
+        char text[AVISHA_OTA_LOG_TEXT];
+        uint8_t level;
+    };
+
+    AViShaOTALog();
+
+    void setLevel(Level level);
+    Level getLevel() const;
+
+    void write(Level level, const char* format, ...) __attribute__((format(printf, 3, 4)));
+    void vwrite(Level level, const char* format, va_list args);
+
+    uint32_t first() const;     // Oldest sequence number still held
+    uint32_t next() const;      // Sequence number of the next record
+    uint32_t getDropped() const; // Records overwritten before they were drained
+    bool read(uint32_t seq, Record& record) const;
+    static size_t format(const Record& record, char* out, size_t size);
+
+    // Print pending records while the TX buffer has room, never blocking
+    size_t drain(Print& out, size_t maxRecords);
+    void skip();                // Mark everything as drained
+
+private:
+    Record records[AVISHA_OTA_LOG_RECORDS];
+    uint32_t head;
+    uint32_t drained;
+    uint32_t dropped;
+    Level level;
+    mutable portMUX_TYPE lock;
+};
+
+#endif // AVISHA_OTA_LOG_H
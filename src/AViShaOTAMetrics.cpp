@@ -0,0 +1,140 @@
+// AViShaOTAMetrics.cpp - Update telemetry counters and histograms
+#include "AViShaOTAMetrics.h"
+
+// Flash writes: a page program is ~1 ms, a sector erase tens of ms
+static const uint32_t FLASH_WRITE_BOUNDS[AVISHA_OTA_HISTOGRAM_BUCKETS] = {
+  100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000
+};
+
+// handle(): idle calls are microseconds, a served request milliseconds
+static const uint32_t HANDLE_BOUNDS[AVISHA_OTA_HISTOGRAM_BUCKETS] = {
+  50, 100, 250, 500, 1000, 5000, 10000, 50000, 100000, 1000000
+};
+
+// Upload chunks: decode and hash are tens of us, a wait for a free write
+// buffer or an inline sector erase is milliseconds
+static const uint32_t CHUNK_BOUNDS[AVISHA_OTA_HISTOGRAM_BUCKETS] = {
+  25, 50, 100, 250, 500, 1000, 2500, 10000, 50000, 250000
+};
+
+// Constructor
+AViShaOTAHistogram::AViShaOTAHistogram(const uint32_t* bounds) {
+  this->bounds = bounds;
+  reset();
+}
+
+void AViShaOTAHistogram::reset() {
+  for (uint8_t i = 0; i <= AVISHA_OTA_HISTOGRAM_BUCKETS; i++) {
+    buckets[i] = 0;
+  }
+  sum = 0;
+  largest = 0;
+}
+
+void AViShaOTAHistogram::observe(uint32_t micros) {
+  uint8_t i = 0;
+  while (i < AVISHA_OTA_HISTOGRAM_BUCKETS && micros > bounds[i]) {
+    i++;
+  }
+  buckets[i]++;
+  sum += micros;
+  if (micros > largest) {
+    largest = micros;
+  }
+}
+
+uint32_t AViShaOTAHistogram::count() const {
+  uint32_t total = 0;
+  for (uint8_t i = 0; i <= AVISHA_OTA_HISTOGRAM_BUCKETS; i++) {
+    total += buckets[i];
+  }
+  return total;
+}
+
+uint32_t AViShaOTAHistogram::peak() const {
+  return largest;
+}
+
+uint32_t AViShaOTAHistogram::quantile(float q) const {
+  uint32_t total = count();
+  if (total == 0) {
+    return 0;
+  }
+  uint32_t rank = (uint32_t)(q * total + 0.5f);
+  if (rank < 1) {
+    rank = 1;
+  }
+  uint32_t cumulative = 0;
+  for (uint8_t i = 0; i < AVISHA_OTA_HISTOGRAM_BUCKETS; i++) {
+    cumulative += buckets[i];
+    if (cumulative >= rank) {
+      return bounds[i] < largest ? bounds[i] : largest;
+    }
+  }
+  return largest;
+}
+
+void AViShaOTAHistogram::write(Print& out, const char* name, const char* help) const {
+  AViShaOTAMetrics::writeHeader(out, name, "histogram", help);
+
+  // Buckets are stored per range and exported cumulative
+  char label[32];
+  uint32_t cumulative = 0;
+  for (uint8_t i = 0; i <= AVISHA_OTA_HISTOGRAM_BUCKETS; i++) {
+    cumulative += buckets[i];
+    if (i < AVISHA_OTA_HISTOGRAM_BUCKETS) {
+      snprintf(label, sizeof(label), "_bucket{le=\"%g\"}", bounds[i] / 1e6);
+    } else {
+      snprintf(label, sizeof(label), "_bucket{le=\"+Inf\"}");
+    }
+    out.print(name);
+    AViShaOTAMetrics::writeValue(out, label, cumulative);
+  }
+
+  snprintf(label, sizeof(label), "%.6f", sum / 1e6);
+  out.print(name);
+  out.print("_sum ");
+  out.print(label);
+  out.print('\n');
+  out.print(name);
+  AViShaOTAMetrics::writeValue(out, "_count", cumulative);
+}
+
+// Constructor
+AViShaOTAMetrics::AViShaOTAMetrics()
+  : flashWrite(FLASH_WRITE_BOUNDS), handleTime(HANDLE_BOUNDS), chunkTime(CHUNK_BOUNDS),
+    updateChunkTime(CHUNK_BOUNDS), updateStall(CHUNK_BOUNDS) {
+  this->receivedBytes = 0;
+  this->updatesSucceeded = 0;
+  this->updatesFailed = 0;
+  this->wifiReconnects = 0;
+  this->arduinoOtaProgress = 0;
+  this->wifiLost = false;
+}
+
+// Written piecewise: Print::printf() allocates for long lines and
+// println() ends lines with \r\n, which the text format does not allow
+void AViShaOTAMetrics::writeHeader(Print& out, const char* name, const char* type, const char* help) {
+  out.print("# HELP ");
+  out.print(name);
+  out.print(' ');
+  out.print(help);
+  out.print('\n');
+  out.print("# TYPE ");
+  out.print(name);
+  out.print(' ');
+  out.print(type);
+  out.print('\n');
+}
+
+void AViShaOTAMetrics::writeValue(Print& out, const char* name, uint64_t value, const char* labels) {
+  char digits[24];
+  snprintf(digits, sizeof(digits), "%llu", (unsigned long long)value);
+  out.print(name);
+  if (labels) {
+    out.print(labels);
+  }
+  out.print(' ');
+  out.print(digits);
+  out.print('\n');
+}
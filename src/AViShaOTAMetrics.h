@@ -0,0 +1,50 @@
+#ifndef AVISHA_OTA_METRICS_H
+#define AVISHA_OTA_METRICS_H
+
+#include <Arduino.h>
+
+#define AVISHA_OTA_HISTOGRAM_BUCKETS 10
+
+// Fixed-bucket histogram of microsecond samples, exported in seconds.
+// observe() is a few compares and adds, cheap enough for every chunk.
+class AViShaOTAHistogram {
+public:
+    explicit AViShaOTAHistogram(const uint32_t* bounds); // AVISHA_OTA_HISTOGRAM_BUCKETS ascending upper bounds
+
+    void observe(uint32_t micros);
+    void write(Print& out, const char* name, const char* help) const;
+    void reset();
+    
+    uint32_t count() const;
+    uint32_t peak() const;
+    uint32_t quantile(float q) const; // Upper bound of the bucket holding it, peak() past the last
+
+private:
+    const uint32_t* bounds;
+    volatile uint32_t buckets[AVISHA_OTA_HISTOGRAM_BUCKETS + 1]; // Last one is +Inf
+    volatile uint64_t sum;
+    volatile uint32_t largest;
+};
+
+// Counters kept by AViShaOTA and served at /metrics
+struct AViShaOTAMetrics {
+    AViShaOTAMetrics();
+
+    uint64_t receivedBytes;
+    uint32_t updatesSucceeded;
+    uint32_t updatesFailed;
+    uint32_t wifiReconnects;
+    uint32_t arduinoOtaProgress;    // Last ArduinoOTA progress, to count its bytes
+    bool wifiLost;
+    AViShaOTAHistogram flashWrite;  // Update.write() / partition write latency
+    AViShaOTAHistogram handleTime;  // handle() duration
+    AViShaOTAHistogram chunkTime;   // Receive-side cost of each upload chunk
+    AViShaOTAHistogram updateChunkTime; // The same, reset when an update starts
+    AViShaOTAHistogram updateStall;     // Waits for a free write buffer, reset when an update starts
+
+    // Prometheus text exposition helpers
+    static void writeHeader(Print& out, const char* name, const char* type, const char* help);
+    static void writeValue(Print& out, const char* name, uint64_t value, const char* labels = nullptr);
+};
+
+#endif // AVISHA_OTA_METRICS_H
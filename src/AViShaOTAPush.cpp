@@ -0,0 +1,214 @@
+// AViShaOTAPush.cpp - Native TCP push receiver, see extras/push_upload.py
+//
+// One update per connection, integers little-endian:
+//   host -> device   PushHeader
+//   device -> host   "AVP2" and a 32 character nonce, or a PushStatus
+//                    refusing the header
+//   host -> device   HMAC-SHA256(password, nonce), 32 bytes, zero without
+//                    a password
+//   device -> host   PushStatus, PUSH_READY or the reason for refusing
+//   host -> device   header.size bytes of image, nothing acknowledged
+//   device -> host   PushStatus with the result and the bytes received
+// The handshake is read a piece per handle() call, so a slow or silent
+// client does not hold up the other servers, and the nonce belongs to the
+// connection instead of taking one of the /auth slots. The sender is paced
+// by TCP flow control alone, so the link stays full instead of idling for
+// a reply after every chunk as espota does.
+#include "AViShaOTA.h"
+#include <Update.h>
+#include <esp_system.h>
+
+#define PUSH_HELLO "AVP2"
+#define PUSH_MAGIC "AVPU"
+#define PUSH_VERSION 2
+#define PUSH_MAC_SIZE 32
+
+// Header flags
+#define PUSH_FLAG_DELTA 0x01    // Image is a patch against the running app
+#define PUSH_FLAG_RAW 0x02      // Skip codec detection
+
+struct PushHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t flags;
+  uint16_t reserved;
+  uint32_t size;          // Bytes that follow the header
+  uint8_t md5[16];        // Resulting image, all zero = not checked
+  uint8_t sha256[32];     // Resulting image, all zero = not checked
+};
+
+struct PushStatus {
+  uint8_t code;
+  uint8_t reserved[3];
+  uint32_t value;         // Receive buffer size for PUSH_READY, else bytes received
+};
+
+enum PushCode {
+  PUSH_READY,
+  PUSH_OK,
+  PUSH_AUTH_FAILED,
+  PUSH_BUSY,
+  PUSH_BAD_HEADER,
+  PUSH_TOO_LARGE,
+  PUSH_BEGIN_FAILED,
+  PUSH_RECEIVE_FAILED,
+  PUSH_END_FAILED
+};
+
+// Lower-case hex, empty when every byte is zero
+static String pushHex(const uint8_t* data, size_t len) {
+  bool set = false;
+  char hex[65];
+  for (size_t i = 0; i < len; i++) {
+    set |= data[i] != 0;
+    snprintf(hex + i * 2, 3, "%02x", data[i]);
+  }
+  return set ? String(hex) : String();
+}
+
+void AViShaOTA::setupPushServer() {
+  if (!pushServer) {
+    pushServer = new WiFiServer(pushPort);
+  }
+  pushServer->begin();
+  pushServer->setNoDelay(true);
+  logInfo("Push server on port %u", pushPort);
+}
+
+void AViShaOTA::sendPushStatus(WiFiClient& client, uint8_t code, uint32_t value) {
+  PushStatus status;
+  memset(&status, 0, sizeof(status));
+  status.code = code;
+  status.value = value;
+  client.write((const uint8_t*)&status, sizeof(status));
+}
+
+// Sends the last status of the connection and closes it
+void AViShaOTA::closePush(uint8_t code, uint32_t value) {
+  sendPushStatus(pushClient, code, value);
+  pushClient.stop();
+}
+
+void AViShaOTA::handlePush() {
+  static_assert(sizeof(PushHeader) + PUSH_MAC_SIZE <= sizeof(pushBuffer), "pushBuffer too small");
+
+  if (!pushClient.connected()) {
+    pushClient = pushServer->available();
+    if (!pushClient) {
+      return;
+    }
+    pushClient.setNoDelay(true);
+    pushGot = 0;
+    pushStarted = millis();
+  }
+  if (millis() - pushStarted >= AVISHA_OTA_PUSH_TIMEOUT) {
+    logWarning("Push: handshake from %s timed out", pushClient.remoteIP().toString().c_str());
+    pushClient.stop();
+    return;
+  }
+
+  // The header first, then the MAC once the nonce is out
+  size_t want = pushGot < sizeof(PushHeader) ? sizeof(PushHeader) : sizeof(PushHeader) + PUSH_MAC_SIZE;
+  int available = pushClient.available();
+  if (available <= 0) {
+    return;
+  }
+  int n = pushClient.read(pushBuffer + pushGot, min((size_t)available, want - pushGot));
+  if (n > 0) {
+    pushGot += n;
+  }
+  if (pushGot < want) {
+    return;
+  }
+
+  PushHeader header;
+  memcpy(&header, pushBuffer, sizeof(header));
+  if (want == sizeof(PushHeader)) {
+    if (memcmp(header.magic, PUSH_MAGIC, 4) != 0 || header.version != PUSH_VERSION || header.size == 0) {
+      logWarning("Push: bad header from %s", pushClient.remoteIP().toString().c_str());
+      closePush(PUSH_BAD_HEADER, 0);
+      return;
+    }
+    if (!imageFits(header.size, 0, false)) {
+      logError("Push: %u bytes do not fit in %u", header.size, ESP.getFreeSketchSpace());
+      closePush(PUSH_TOO_LARGE, 0);
+      return;
+    }
+    // Only a well-formed header is worth a nonce
+    for (uint8_t i = 0; i < 4; i++) {
+      snprintf(pushNonce + i * 8, 9, "%08x", esp_random());
+    }
+    pushClient.write((const uint8_t*)PUSH_HELLO, 4);
+    pushClient.write((const uint8_t*)pushNonce, 32);
+    return;
+  }
+
+  if (otaPassword.length() > 0) {
+    char expected[65];
+    authDigest(pushNonce, expected);
+    String mac = pushHex(pushBuffer + sizeof(PushHeader), PUSH_MAC_SIZE);
+    if (mac.length() != 64 || !constantTimeEquals(mac.c_str(), expected, 64)) {
+      authFailures++;
+      logError("OTA: Authentication failed - access denied");
+      closePush(PUSH_AUTH_FAILED, 0);
+      return;
+    }
+  }
+  if (!claimUpdate(AViShaOTAEvent::SOURCE_PUSH)) {
+    closePush(PUSH_BUSY, 0);
+    return;
+  }
+
+  ImageOptions options;
+  options.delta = header.flags & PUSH_FLAG_DELTA;
+  options.encoding = (header.flags & PUSH_FLAG_RAW) ? "raw" : "";
+  options.md5 = pushHex(header.md5, sizeof(header.md5));
+  options.sha256 = pushHex(header.sha256, sizeof(header.sha256));
+  options.size = header.size;
+
+  // A full upload overwrites the partition a resumable session was filling
+  loadResume();
+  clearResume();
+
+  logInfo("Push update: %u bytes from %s", header.size, pushClient.remoteIP().toString().c_str());
+  emit(AViShaOTAEvent::UPDATE_START, AViShaOTAEvent::SOURCE_PUSH);
+
+  size_t bufferSize = receiveBufferSize ? receiveBufferSize : AVISHA_OTA_RECEIVE_BUFFER;
+  uint8_t* buffer = (uint8_t*)malloc(bufferSize);
+  if (!buffer || !beginImage(options)) {
+    free(buffer);
+    logError("Update.begin() failed: %s", Update.errorString());
+    releaseUpdate(AViShaOTAEvent::SOURCE_PUSH);
+    closePush(PUSH_BEGIN_FAILED, 0);
+    emitError(AViShaOTAEvent::SOURCE_PUSH, OTA_BEGIN_ERROR);
+    return;
+  }
+  sendPushStatus(pushClient, PUSH_READY, bufferSize);
+
+  // The image itself is received in one go, like a web upload
+  bool ok = receiveRaw(pushClient, header.size, buffer, bufferSize, AViShaOTAEvent::SOURCE_PUSH);
+  free(buffer);
+
+  if (!ok) {
+    logError("Push update incomplete after %u bytes", updateStats.receivedBytes);
+    abortImage();
+    releaseUpdate(AViShaOTAEvent::SOURCE_PUSH);
+    closePush(PUSH_RECEIVE_FAILED, updateStats.receivedBytes);
+    emitError(AViShaOTAEvent::SOURCE_PUSH, OTA_RECEIVE_ERROR);
+    return;
+  }
+  if (!endImage()) {
+    logError("Update.end() failed: %s", Update.errorString());
+    releaseUpdate(AViShaOTAEvent::SOURCE_PUSH);
+    closePush(PUSH_END_FAILED, header.size);
+    emitError(AViShaOTAEvent::SOURCE_PUSH, OTA_END_ERROR);
+    return;
+  }
+
+  logInfo("Push update successful! Restarting...");
+  logUpdateStats();
+  closePush(PUSH_OK, header.size);
+  emit(AViShaOTAEvent::UPDATE_END, AViShaOTAEvent::SOURCE_PUSH);
+  delay(1000);
+  ESP.restart();
+}
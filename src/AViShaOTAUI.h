@@ -0,0 +1,702 @@
+// Generated by extras/build_ui.py from extras/ui/upload.html - do not edit
+#ifndef AVISHA_OTA_UI_H
+#define AVISHA_OTA_UI_H
+
+#include <Arduino.h>
+
+#define AVISHA_OTA_UI_HASH "3700b02f"
+#define AVISHA_OTA_UI_SIZE 7978
+#define AVISHA_OTA_UI_GZ_SIZE 2966
+
+static const uint8_t AVISHA_OTA_UI_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x59, 0xed, 0x73, 0xda, 0x46,
+  0x1a, 0xff, 0xee, 0xbf, 0x62, 0xa3, 0x36, 0xad, 0x68, 0x40, 0x08, 0x61, 0x30, 0xb6, 0x81, 0x99,
+  0x24, 0xb5, 0x27, 0x99, 0x69, 0x9a, 0x4c, 0xed, 0xdc, 0xf5, 0xc6, 0xe3, 0x9b, 0x2e, 0xd2, 0x82,
+  0x14, 0x0b, 0x49, 0x27, 0xad, 0x8c, 0xb9, 0xd4, 0xf7, 0xb7, 0xdf, 0xef, 0xd9, 0x5d, 0x09, 0x81,
+  0x21, 0xe9, 0x7d, 0xc8, 0x87, 0x2b, 0x4d, 0xa4, 0x5d, 0x3d, 0xef, 0x6f, 0xfb, 0x3c, 0x9b, 0xf1,
+  0xb3, 0x9f, 0xdf, 0xbf, 0xbe, 0xfe, 0xc7, 0x87, 0x0b, 0x16, 0xca, 0x65, 0x3c, 0x3d, 0x1a, 0xd3,
+  0x83, 0xc5, 0x3c, 0x59, 0x4c, 0xac, 0x28, 0xb0, 0x68, 0x43, 0xf0, 0x00, 0x8f, 0xa5, 0x90, 0x9c,
+  0xf9, 0x21, 0xcf, 0x0b, 0x21, 0x27, 0xd6, 0xc7, 0xeb, 0xcb, 0xce, 0xc8, 0x62, 0xdd, 0xea, 0x43,
+  0xc2, 0x97, 0x62, 0x62, 0xdd, 0x47, 0x62, 0x95, 0xa5, 0xb9, 0xb4, 0x98, 0x9f, 0x26, 0x52, 0x24,
+  0x00, 0x5c, 0x45, 0x81, 0x0c, 0x27, 0x81, 0xb8, 0x8f, 0x7c, 0xd1, 0x51, 0x8b, 0x36, 0x8b, 0x92,
+  0x48, 0x46, 0x3c, 0xee, 0x14, 0x3e, 0x8f, 0xc5, 0xa4, 0xe7, 0xb8, 0x9a, 0x90, 0x8c, 0x64, 0x2c,
+  0xa6, 0x2f, 0xff, 0x16, 0x5d, 0x85, 0x9c, 0xbd, 0xbf, 0x7e, 0xc9, 0x3e, 0x66, 0x01, 0x97, 0x62,
+  0xdc, 0xd5, 0x1f, 0x8e, 0xc6, 0x85, 0x5c, 0xd3, 0x73, 0x96, 0x06, 0x6b, 0xf6, 0xf9, 0x68, 0x0e,
+  0x16, 0x9d, 0x39, 0x5f, 0x46, 0xf1, 0xfa, 0x8c, 0x75, 0x78, 0x96, 0xc5, 0xa2, 0x53, 0xac, 0x0b,
+  0x29, 0x96, 0x6d, 0xf6, 0x2a, 0x8e, 0x92, 0xbb, 0x77, 0xdc, 0xbf, 0x52, 0xeb, 0x4b, 0x40, 0xb6,
+  0x99, 0x75, 0x25, 0x16, 0xa9, 0x60, 0x1f, 0xdf, 0x5a, 0x6d, 0xf6, 0x5b, 0x3a, 0x4b, 0x65, 0xda,
+  0x66, 0xef, 0x1f, 0xd6, 0x0b, 0x91, 0xb4, 0x8f, 0x3e, 0xce, 0xca, 0x44, 0x96, 0x6d, 0xf6, 0x9a,
+  0x27, 0x92, 0xe7, 0x22, 0x8e, 0x01, 0xfe, 0x3e, 0x13, 0x09, 0xbb, 0xe2, 0x49, 0x01, 0x78, 0xeb,
+  0x8d, 0x88, 0xef, 0x85, 0x8c, 0x7c, 0xce, 0x7e, 0x15, 0xa5, 0xc0, 0x4e, 0x81, 0x0f, 0x9d, 0x42,
+  0xe4, 0xd1, 0xfc, 0xfc, 0x68, 0xc9, 0xf3, 0x45, 0x94, 0x9c, 0x31, 0xf7, 0xfc, 0x28, 0xe3, 0x41,
+  0x10, 0x25, 0x0b, 0xf5, 0x3e, 0xe3, 0xfe, 0xdd, 0x22, 0x4f, 0xcb, 0x24, 0x38, 0x63, 0xdf, 0xcd,
+  0x3d, 0xfc, 0x4e, 0xce, 0x8f, 0x1e, 0x8f, 0x1c, 0xb2, 0x0d, 0x8f, 0x12, 0x91, 0x43, 0x89, 0x25,
+  0x7f, 0xd0, 0x56, 0x39, 0x63, 0xc7, 0xae, 0x9b, 0x3d, 0x6c, 0x88, 0x8d, 0xb0, 0x62, 0xbc, 0x94,
+  0xe9, 0x2e, 0xa1, 0x39, 0x38, 0xce, 0xd2, 0x3c, 0x10, 0x79, 0x27, 0xe7, 0x41, 0x54, 0x16, 0x67,
+  0xcc, 0x53, 0x98, 0xb3, 0xf4, 0xa1, 0x53, 0x84, 0x3c, 0x48, 0x57, 0x60, 0xcf, 0x46, 0x40, 0xa7,
+  0x7d, 0x96, 0x2f, 0x66, 0xdc, 0x76, 0xdb, 0xcc, 0xfc, 0xef, 0xb8, 0xa3, 0x56, 0x43, 0xce, 0xbe,
+  0x42, 0x95, 0xe2, 0x41, 0x76, 0x78, 0x1c, 0x2d, 0xc0, 0xd8, 0x87, 0xdf, 0x44, 0x4e, 0x92, 0x86,
+  0xbd, 0xca, 0xcc, 0x45, 0xf4, 0x6f, 0x01, 0x36, 0xc7, 0x1b, 0x01, 0x3b, 0x30, 0xa0, 0x4c, 0x97,
+  0x67, 0xac, 0xa7, 0x08, 0xf8, 0x69, 0x9c, 0xe6, 0x90, 0xae, 0xd7, 0xeb, 0x11, 0x66, 0x06, 0xc4,
+  0x6a, 0x6b, 0x30, 0x18, 0x9c, 0x37, 0xa9, 0xf4, 0xf6, 0x51, 0xd1, 0x1a, 0xc0, 0x38, 0x65, 0x16,
+  0xa7, 0x3c, 0xe8, 0xc0, 0x09, 0x1c, 0x34, 0xb4, 0x9e, 0xf8, 0x0c, 0x3d, 0x02, 0x5e, 0x84, 0x22,
+  0x60, 0xdf, 0x05, 0x3d, 0xfc, 0x86, 0x4f, 0x6c, 0xd0, 0xf3, 0x88, 0xc2, 0x96, 0x5e, 0x46, 0xb6,
+  0x8d, 0xf9, 0x3a, 0x95, 0x4c, 0x73, 0x4e, 0x3f, 0xe8, 0x9d, 0xc3, 0x8d, 0x08, 0xc6, 0x14, 0x7a,
+  0x6f, 0xc0, 0x60, 0xa4, 0x7e, 0xc1, 0x04, 0x2f, 0xc4, 0xae, 0x48, 0x67, 0x61, 0x7a, 0xaf, 0xfc,
+  0xb6, 0xed, 0x12, 0x17, 0xbf, 0x01, 0xc1, 0x46, 0x49, 0x56, 0xca, 0x1b, 0xb9, 0xce, 0x90, 0x0c,
+  0x19, 0x2f, 0x8a, 0x15, 0x64, 0xb4, 0x6e, 0x29, 0xe2, 0x37, 0xfb, 0xf3, 0x28, 0x16, 0xd6, 0xad,
+  0xf2, 0xbd, 0x32, 0x81, 0x4c, 0x33, 0x48, 0x3f, 0xd8, 0x92, 0xde, 0x08, 0x6e, 0xb4, 0xef, 0x41,
+  0x95, 0x22, 0x8d, 0xa3, 0xc3, 0xca, 0x8f, 0x08, 0xfc, 0x89, 0x8d, 0x4d, 0x60, 0x8d, 0xdc, 0xe7,
+  0xe7, 0xcd, 0x40, 0xf3, 0x06, 0xc6, 0xd8, 0x7b, 0xa5, 0xf2, 0xcb, 0xbc, 0x20, 0x1b, 0x65, 0x69,
+  0xa4, 0xe3, 0xa0, 0x16, 0x6a, 0xa4, 0xb1, 0x66, 0x25, 0x5c, 0x96, 0xec, 0xc8, 0xef, 0x1d, 0xb2,
+  0xb4, 0xeb, 0x9e, 0x70, 0x8a, 0x58, 0xb3, 0x5e, 0x85, 0x91, 0x14, 0x1b, 0xcd, 0x92, 0x34, 0x11,
+  0x4d, 0xb5, 0xc9, 0xcf, 0x3a, 0xca, 0x9a, 0xca, 0x0c, 0x37, 0xc6, 0xd8, 0x71, 0xf7, 0x13, 0x61,
+  0xbf, 0xee, 0xd0, 0x25, 0x44, 0x36, 0x86, 0xe8, 0x55, 0x86, 0xd0, 0x2a, 0x69, 0xe7, 0x9e, 0x25,
+  0xa9, 0xb4, 0xcf, 0x82, 0xa8, 0xe0, 0xb3, 0x58, 0x04, 0xad, 0x2d, 0x5f, 0x37, 0xb4, 0x1a, 0x88,
+  0xe0, 0xb4, 0x81, 0x5a, 0xc1, 0xef, 0x07, 0x1f, 0x89, 0x91, 0x38, 0xed, 0x6f, 0xc4, 0x05, 0x0b,
+  0x64, 0x5b, 0x9c, 0xae, 0x44, 0xa0, 0x22, 0x2c, 0xcb, 0xd3, 0x45, 0x2e, 0x8a, 0x02, 0xd8, 0x95,
+  0x68, 0x2e, 0x39, 0x6d, 0x0f, 0x29, 0x31, 0xc0, 0x8f, 0x1f, 0x30, 0xc7, 0x96, 0x47, 0x54, 0x44,
+  0x85, 0x22, 0x5a, 0x84, 0xb2, 0xfa, 0x4e, 0xfa, 0xcd, 0x63, 0xaa, 0x0f, 0x61, 0x14, 0x04, 0x22,
+  0x39, 0x3f, 0x82, 0xdc, 0x59, 0xcc, 0xd7, 0x95, 0x27, 0x1a, 0xb2, 0x74, 0x66, 0x9c, 0x02, 0xbd,
+  0x26, 0xa0, 0x04, 0x32, 0xd2, 0x1d, 0x90, 0xad, 0x7f, 0xec, 0x9f, 0x0c, 0x4e, 0xb7, 0x9d, 0xa0,
+  0x30, 0xb6, 0x13, 0xea, 0xbb, 0x42, 0x72, 0x59, 0x16, 0xbb, 0x11, 0x34, 0xd8, 0x1b, 0xc3, 0x35,
+  0xed, 0x7e, 0x5f, 0x89, 0xa7, 0x71, 0x3b, 0x45, 0xe9, 0xfb, 0xda, 0x60, 0x15, 0x80, 0x37, 0xe2,
+  0x27, 0xc7, 0x83, 0x26, 0x8c, 0xc8, 0xf3, 0x34, 0x6f, 0x40, 0xcc, 0xe7, 0xfd, 0x59, 0xdf, 0x55,
+  0x10, 0x14, 0xed, 0x9d, 0x28, 0x99, 0xa7, 0xbb, 0x69, 0xe8, 0xee, 0x0a, 0xe1, 0x35, 0x85, 0x18,
+  0x0e, 0x87, 0x84, 0x3e, 0xee, 0x9a, 0x93, 0x68, 0xdc, 0x35, 0x87, 0x23, 0x1d, 0x49, 0x78, 0x04,
+  0xd1, 0x3d, 0xf3, 0x63, 0xe4, 0xfd, 0xc4, 0xaa, 0x8b, 0xbc, 0x3a, 0x42, 0x7b, 0xd3, 0x8b, 0xab,
+  0x0f, 0x7d, 0x6f, 0xeb, 0x54, 0xc3, 0xe6, 0xd1, 0x38, 0x9b, 0x5e, 0x89, 0x58, 0xf8, 0x92, 0x71,
+  0xe6, 0xcc, 0xa2, 0x84, 0x91, 0x60, 0x4c, 0xa6, 0xac, 0x54, 0x40, 0x6c, 0x9d, 0x96, 0x39, 0xd3,
+  0x87, 0xe7, 0x8f, 0x05, 0x3e, 0xe6, 0xcb, 0x15, 0xca, 0x90, 0x33, 0xee, 0x66, 0xdb, 0xdc, 0x1a,
+  0x25, 0x8a, 0xf8, 0xcd, 0xd3, 0x7c, 0xc9, 0xa2, 0xa0, 0xda, 0xbf, 0xc4, 0xd2, 0x62, 0x22, 0xf1,
+  0x75, 0xaa, 0x2f, 0xcb, 0x58, 0x46, 0x19, 0xcf, 0x65, 0x97, 0xe0, 0x3a, 0x60, 0xa4, 0x90, 0x54,
+  0x35, 0x60, 0x3b, 0xb5, 0x4b, 0x51, 0xa9, 0x56, 0x6f, 0x09, 0xc2, 0x62, 0x08, 0x18, 0x5f, 0x84,
+  0x69, 0x8c, 0xf8, 0x9b, 0x58, 0x17, 0x94, 0x77, 0x4a, 0xaf, 0x0f, 0x35, 0x0e, 0x1d, 0xe6, 0xb3,
+  0x5c, 0x3d, 0x9a, 0x44, 0x55, 0x89, 0x31, 0x9d, 0x82, 0xd6, 0x4f, 0x93, 0xa7, 0x7d, 0x43, 0x9a,
+  0xc3, 0xab, 0x19, 0xba, 0x06, 0xb2, 0x85, 0xc5, 0x72, 0xf1, 0xaf, 0x32, 0xca, 0x91, 0x54, 0xdd,
+  0x6d, 0x6d, 0x6b, 0xef, 0x35, 0xf1, 0xb1, 0x9a, 0x8e, 0xbb, 0x80, 0xda, 0x30, 0x37, 0x95, 0x4a,
+  0x73, 0x2f, 0xca, 0xd9, 0x32, 0x92, 0x56, 0xc3, 0x2c, 0xaf, 0x64, 0x62, 0x4d, 0x3f, 0xaa, 0x57,
+  0xc6, 0x51, 0x24, 0x2a, 0xc7, 0x68, 0x34, 0xf2, 0x2e, 0xd9, 0x87, 0x9e, 0x9a, 0x6a, 0x43, 0x82,
+  0x2a, 0x49, 0x8c, 0x7d, 0xcc, 0xea, 0x75, 0xd3, 0xe7, 0x7b, 0xa0, 0x29, 0xa5, 0xb6, 0x31, 0x5e,
+  0x61, 0xa3, 0x96, 0xba, 0xc1, 0x86, 0x60, 0x74, 0x14, 0x3f, 0xf9, 0x5c, 0xf8, 0x79, 0x94, 0xc9,
+  0x29, 0x62, 0x32, 0x29, 0x24, 0xdb, 0x38, 0x98, 0x4d, 0x58, 0x90, 0xfa, 0xe5, 0x12, 0xa7, 0xb7,
+  0xb3, 0x10, 0xf2, 0x22, 0x16, 0xf4, 0xfa, 0x6a, 0xfd, 0x36, 0xb0, 0x9b, 0x61, 0xd0, 0x3a, 0x37,
+  0x98, 0xb5, 0xd5, 0xbf, 0x84, 0xb8, 0x71, 0x4d, 0x8d, 0xb7, 0x15, 0x0c, 0x5f, 0xc2, 0xdd, 0x8e,
+  0x9a, 0x0d, 0xfe, 0xae, 0xb1, 0xbe, 0x48, 0xe3, 0x89, 0x65, 0x9f, 0xd0, 0x81, 0x09, 0xff, 0x0a,
+  0x05, 0xb2, 0x74, 0x8d, 0x6b, 0x0a, 0xd0, 0x17, 0xd0, 0x8c, 0xf1, 0x6b, 0x8c, 0x3a, 0x62, 0xbe,
+  0x6e, 0x66, 0x0a, 0xab, 0x1d, 0x2b, 0xa3, 0xce, 0x7c, 0xd5, 0xc8, 0x88, 0xdf, 0x1a, 0x0b, 0xa9,
+  0x9a, 0x06, 0xca, 0x32, 0x89, 0x58, 0xb1, 0x6b, 0x34, 0x67, 0x17, 0x7a, 0xc7, 0xae, 0x41, 0xf2,
+  0x54, 0xd2, 0x77, 0xfb, 0xa1, 0xcd, 0x92, 0x16, 0x9b, 0x4c, 0xf1, 0xc6, 0xa6, 0xd3, 0x29, 0x2d,
+  0xfe, 0xa4, 0xf7, 0xf1, 0x98, 0xd9, 0x28, 0x38, 0x1d, 0x6c, 0x00, 0x67, 0x5e, 0x22, 0xf9, 0x51,
+  0x8f, 0x19, 0xfa, 0x43, 0x6f, 0x30, 0xb4, 0x67, 0x6b, 0x29, 0x8a, 0x96, 0xaa, 0x8d, 0x44, 0x2c,
+  0x04, 0xa5, 0x9b, 0xdb, 0x8a, 0xf4, 0x9d, 0x59, 0x21, 0xfa, 0x99, 0x1d, 0x0b, 0xc9, 0x48, 0x69,
+  0xef, 0x9c, 0xdd, 0x39, 0xb1, 0x48, 0x16, 0xa8, 0xe6, 0x63, 0x36, 0x3c, 0x3e, 0x67, 0xc9, 0x8b,
+  0x17, 0x44, 0x81, 0x00, 0xb2, 0x3c, 0x5a, 0x0a, 0x00, 0xc9, 0xbc, 0x14, 0x0d, 0xbc, 0x40, 0xe3,
+  0x05, 0xec, 0x27, 0xfc, 0x19, 0x43, 0x19, 0xbc, 0x6b, 0xa4, 0x68, 0xce, 0xec, 0x84, 0x3d, 0x27,
+  0x88, 0xc9, 0x84, 0xb9, 0xb4, 0x55, 0xd1, 0x98, 0xf3, 0x98, 0x8e, 0x89, 0x19, 0x4a, 0xd9, 0x1d,
+  0x15, 0xdb, 0x47, 0x05, 0xac, 0xbe, 0x56, 0x98, 0xe1, 0x46, 0x90, 0x11, 0xed, 0x85, 0x4e, 0x56,
+  0x16, 0xa1, 0xfd, 0x8e, 0x4b, 0xbc, 0xa5, 0x2b, 0x3b, 0x69, 0xb3, 0x1e, 0xeb, 0x32, 0xaf, 0x05,
+  0xc6, 0xc7, 0xde, 0xe9, 0xf1, 0xe9, 0xf0, 0xc4, 0x3b, 0x1d, 0xc2, 0x2e, 0x6e, 0x8b, 0x28, 0xde,
+  0xed, 0x07, 0xef, 0x1f, 0x00, 0x7f, 0x34, 0x66, 0xa1, 0x58, 0x2e, 0x8c, 0x4b, 0x5e, 0xe6, 0x39,
+  0x5f, 0xdb, 0xb6, 0xb6, 0x63, 0x25, 0xcd, 0x0b, 0x76, 0x02, 0x96, 0xf0, 0xc1, 0xb0, 0x45, 0xe6,
+  0x3f, 0x6e, 0xd1, 0x31, 0x13, 0xdb, 0x44, 0xa5, 0x36, 0x49, 0x04, 0x02, 0xee, 0x39, 0x1e, 0x63,
+  0xd6, 0xc4, 0xc5, 0x8e, 0x36, 0x8c, 0x62, 0x72, 0x13, 0x11, 0x15, 0xef, 0x96, 0xfd, 0x39, 0xd1,
+  0x50, 0x37, 0xd1, 0xad, 0x72, 0xa8, 0x77, 0x0c, 0x87, 0xda, 0x11, 0x0c, 0x77, 0x4c, 0xc2, 0x8e,
+  0x94, 0x7c, 0x1a, 0x65, 0x4b, 0x92, 0x1a, 0xdb, 0x7d, 0x18, 0xb9, 0x0d, 0xcc, 0x2d, 0xa0, 0x06,
+  0x11, 0x4d, 0x42, 0xfd, 0x5d, 0x7d, 0xed, 0xb0, 0xde, 0x2d, 0x9b, 0x6c, 0x09, 0x49, 0xc0, 0x55,
+  0x8c, 0xac, 0x76, 0x63, 0xe4, 0x93, 0x56, 0xec, 0x13, 0x14, 0x6b, 0xd2, 0xa1, 0x9d, 0x17, 0x13,
+  0xb4, 0x70, 0x55, 0xa8, 0xdc, 0xf0, 0x36, 0x9b, 0xb5, 0x99, 0xdf, 0x66, 0x41, 0x9b, 0x89, 0x36,
+  0x9b, 0xb7, 0xd9, 0xa2, 0xcd, 0xc2, 0x90, 0x98, 0x85, 0xfb, 0x0d, 0x45, 0xc1, 0x16, 0x6d, 0xe2,
+  0x86, 0xb6, 0x34, 0xbd, 0x15, 0xd9, 0x65, 0xa2, 0xf9, 0xdd, 0x80, 0x0f, 0x8b, 0x20, 0xd1, 0x23,
+  0x13, 0x08, 0xa0, 0x3a, 0xb4, 0x0b, 0x17, 0x10, 0x94, 0x2c, 0x36, 0xa0, 0x49, 0xab, 0x01, 0xda,
+  0xf1, 0x93, 0x16, 0xfb, 0xe7, 0x93, 0xcd, 0xde, 0x88, 0x76, 0x37, 0x3b, 0x2a, 0x9d, 0xfa, 0x9b,
+  0x9a, 0xd1, 0xdb, 0x26, 0xe4, 0x11, 0xca, 0x2e, 0x21, 0xb5, 0x79, 0xda, 0xa0, 0xe3, 0x69, 0x32,
+  0x3d, 0x0a, 0x02, 0x23, 0x6e, 0xc5, 0x61, 0x78, 0x0b, 0x89, 0x21, 0xde, 0x0b, 0xa6, 0x37, 0x4e,
+  0xd4, 0xba, 0x47, 0xf9, 0xab, 0x9a, 0x14, 0xcd, 0x56, 0x12, 0x5b, 0x3b, 0xa4, 0xe8, 0xb2, 0x15,
+  0x23, 0xd8, 0x6c, 0x58, 0x73, 0xc5, 0xa2, 0xd7, 0x6b, 0xae, 0xbc, 0x41, 0xab, 0x45, 0xa0, 0xb6,
+  0x60, 0x3f, 0xb0, 0xb9, 0x12, 0xe4, 0x3f, 0xf4, 0xba, 0x50, 0xdb, 0x77, 0x24, 0x81, 0xe2, 0x77,
+  0x6b, 0xd8, 0x18, 0x26, 0x1e, 0x31, 0xd1, 0xf4, 0xe1, 0x1f, 0xaf, 0xa6, 0x88, 0x45, 0xaf, 0xdf,
+  0x5c, 0x79, 0x9e, 0xa1, 0xcf, 0x41, 0x74, 0xa6, 0xe8, 0xd3, 0x9b, 0xaf, 0xde, 0x66, 0xea, 0xad,
+  0x65, 0x48, 0x87, 0x54, 0x55, 0x16, 0xe7, 0x47, 0x0b, 0x4a, 0x6a, 0x78, 0x16, 0x0f, 0xe4, 0x35,
+  0xa5, 0xb8, 0x1d, 0x80, 0x84, 0xac, 0x34, 0xa5, 0x2a, 0xe1, 0x43, 0x12, 0x8a, 0x36, 0xe4, 0x3d,
+  0x1e, 0x68, 0x6f, 0x39, 0x81, 0x41, 0x77, 0xc0, 0x79, 0xb5, 0x45, 0x0e, 0xc6, 0x8e, 0x83, 0xb0,
+  0xb9, 0xe0, 0x7e, 0x68, 0xdb, 0xf7, 0x98, 0xb5, 0x54, 0x39, 0x0c, 0x8d, 0xb1, 0x43, 0xad, 0xf2,
+  0x7d, 0xab, 0xce, 0x67, 0xad, 0x72, 0x10, 0x2d, 0x44, 0x21, 0x4d, 0x3a, 0x7f, 0xc4, 0xf4, 0x30,
+  0xd2, 0x39, 0xdd, 0xf7, 0x00, 0x14, 0xee, 0x21, 0xf8, 0x79, 0x6f, 0xac, 0x23, 0x34, 0x3f, 0xe9,
+  0xd0, 0xd4, 0x04, 0xe1, 0x49, 0x14, 0x11, 0x30, 0xfc, 0x44, 0xdc, 0xef, 0x95, 0xf3, 0x75, 0xf2,
+  0x7d, 0xaa, 0x13, 0xf6, 0x11, 0x7f, 0xe7, 0x42, 0x96, 0x79, 0x62, 0xa4, 0xa0, 0xcd, 0xba, 0x42,
+  0x87, 0x4b, 0xee, 0x5f, 0xe9, 0x2a, 0x7d, 0x27, 0xd6, 0x6d, 0xb6, 0xc4, 0xe1, 0xc5, 0x17, 0x75,
+  0xed, 0xc3, 0x5e, 0x9d, 0xe5, 0xc8, 0x0c, 0xda, 0xc6, 0x16, 0x78, 0x15, 0x35, 0x4e, 0x43, 0xcb,
+  0x28, 0x49, 0xea, 0x63, 0xa4, 0xa1, 0xe4, 0x90, 0x24, 0x34, 0x84, 0x0d, 0xb5, 0x3a, 0xce, 0xd3,
+  0x52, 0x1e, 0x44, 0x51, 0xc6, 0xf9, 0x5a, 0x8a, 0x12, 0x4b, 0x63, 0x7c, 0x08, 0x43, 0x6f, 0x7f,
+  0x92, 0xe9, 0x11, 0x20, 0xee, 0x43, 0x1f, 0xfd, 0xb3, 0x62, 0x70, 0x08, 0x60, 0xe0, 0xeb, 0xc1,
+  0x14, 0x34, 0x9c, 0x42, 0x48, 0xdb, 0x08, 0xd9, 0x26, 0x55, 0x0d, 0xaa, 0xda, 0x37, 0xda, 0x2a,
+  0xc0, 0x96, 0xf9, 0x6a, 0x6c, 0x6a, 0x3e, 0x29, 0xd8, 0x86, 0x29, 0x64, 0xfa, 0x46, 0x3c, 0x10,
+  0x4f, 0x73, 0xf6, 0xc1, 0xa5, 0x4a, 0x33, 0x67, 0x9e, 0xa7, 0x4b, 0xbd, 0xd9, 0xc6, 0x47, 0xf5,
+  0x61, 0xe6, 0xc8, 0xf4, 0x4a, 0xe6, 0x98, 0x49, 0x6d, 0x54, 0x1a, 0x07, 0xf3, 0xe9, 0x95, 0x44,
+  0xbf, 0x6c, 0x7b, 0x6d, 0x66, 0xb9, 0x56, 0xab, 0xe5, 0x7c, 0xc2, 0xbc, 0x69, 0x5b, 0x74, 0x60,
+  0xd7, 0x1d, 0x92, 0x83, 0x21, 0xf6, 0xe2, 0x1e, 0x87, 0xfa, 0x2f, 0x51, 0x21, 0x05, 0xc4, 0xb2,
+  0x2d, 0x3f, 0xe4, 0xc9, 0x82, 0x2e, 0x8b, 0x2a, 0xe7, 0xda, 0x9b, 0x23, 0x57, 0x35, 0xfa, 0x38,
+  0x31, 0xc3, 0xa8, 0x50, 0xd3, 0x48, 0x71, 0xe3, 0xa2, 0x78, 0x91, 0x87, 0x69, 0xb5, 0x81, 0xa3,
+  0x31, 0xe4, 0xdd, 0x2b, 0x92, 0x9b, 0xf6, 0x1d, 0x5a, 0xe2, 0xac, 0xb2, 0x7b, 0x2e, 0x82, 0xea,
+  0x27, 0x46, 0x0f, 0x88, 0x23, 0xd3, 0xcb, 0xe8, 0x41, 0x04, 0xb6, 0x57, 0x0b, 0x34, 0x4f, 0x1d,
+  0xba, 0xd3, 0x79, 0xad, 0xaf, 0xe1, 0x80, 0xfe, 0xc7, 0x25, 0xf6, 0xcf, 0xd8, 0xf7, 0x9f, 0x15,
+  0x19, 0x6a, 0xc2, 0x1f, 0x99, 0xfd, 0xfd, 0x67, 0x4d, 0xfe, 0x91, 0xbd, 0x7b, 0xd5, 0xfa, 0xa3,
+  0x51, 0x3b, 0x0f, 0x10, 0xb1, 0xac, 0x2a, 0x7e, 0x37, 0x1d, 0xe5, 0x1e, 0xbd, 0x4d, 0xab, 0xdd,
+  0x66, 0xbc, 0x58, 0x27, 0x7e, 0xad, 0x3d, 0xb3, 0x95, 0x5e, 0x02, 0x23, 0xa6, 0x20, 0x84, 0x9f,
+  0xc5, 0x9c, 0x63, 0x14, 0xb1, 0xb7, 0x9a, 0x25, 0x2a, 0x16, 0xb5, 0x49, 0x37, 0x86, 0xd9, 0xee,
+  0x3d, 0x01, 0xb4, 0xd5, 0x5d, 0x3a, 0xf7, 0x3c, 0x2e, 0x85, 0x03, 0x8f, 0x2d, 0x89, 0x1a, 0x59,
+  0xf1, 0x99, 0x22, 0x86, 0xc0, 0x7a, 0x56, 0x2b, 0xec, 0x88, 0x24, 0x28, 0xfe, 0x1e, 0xc9, 0xd0,
+  0xd6, 0xf3, 0x45, 0x8b, 0xa4, 0xe1, 0xb1, 0x80, 0x63, 0xad, 0x0f, 0x31, 0x4d, 0xa7, 0xac, 0xa8,
+  0x86, 0x31, 0x10, 0x8c, 0x82, 0xcd, 0x48, 0xe6, 0x58, 0x75, 0x7c, 0x91, 0x05, 0x28, 0xfa, 0x79,
+  0x29, 0x43, 0x63, 0x12, 0xd5, 0xa0, 0x18, 0x79, 0x88, 0xa6, 0xcc, 0xd7, 0xb5, 0xff, 0xd0, 0x7b,
+  0x66, 0x78, 0x21, 0xbd, 0xf8, 0x8a, 0x47, 0x50, 0x52, 0x48, 0xd4, 0x15, 0xab, 0x4b, 0xf8, 0x30,
+  0xd1, 0x67, 0xe6, 0xa3, 0xce, 0xc0, 0x33, 0x56, 0x92, 0x76, 0x0a, 0x99, 0xe6, 0x18, 0x8a, 0x1e,
+  0x6b, 0x8b, 0x60, 0x2a, 0xf7, 0x37, 0xa8, 0x15, 0x2d, 0xe5, 0x15, 0x52, 0xd4, 0xc8, 0xa0, 0xa1,
+  0x5e, 0x30, 0xeb, 0xcc, 0xa2, 0x82, 0x49, 0x81, 0x6e, 0x37, 0xca, 0x88, 0xe9, 0x26, 0x1d, 0xfd,
+  0xdc, 0x48, 0xda, 0x66, 0x3b, 0x5f, 0x14, 0x9d, 0x16, 0xf5, 0x8b, 0x8f, 0x90, 0x0a, 0x62, 0xc2,
+  0x63, 0x79, 0x4e, 0x1a, 0xe9, 0x76, 0xd8, 0x51, 0xe9, 0xf6, 0xe6, 0xfa, 0xdd, 0x2f, 0x14, 0x50,
+  0xe3, 0xac, 0x9a, 0x6f, 0x9a, 0xf3, 0xb6, 0x35, 0x7d, 0x9d, 0x96, 0x71, 0x40, 0x57, 0x1c, 0x90,
+  0x17, 0xaa, 0x21, 0xc4, 0x85, 0x19, 0x61, 0xd5, 0xdc, 0xfa, 0x47, 0xd3, 0x90, 0x55, 0x72, 0xd2,
+  0xa0, 0xf5, 0x33, 0xe6, 0x50, 0x53, 0x77, 0x2e, 0xcd, 0xd2, 0xd6, 0xe5, 0x46, 0xbd, 0x3b, 0x3c,
+  0xcb, 0xe0, 0x40, 0xbb, 0x1a, 0x1d, 0xdb, 0xca, 0x31, 0xb5, 0xa5, 0x1e, 0xc2, 0xaa, 0x68, 0xfd,
+  0xfe, 0xee, 0x97, 0x37, 0x52, 0x66, 0xbf, 0x61, 0x78, 0x44, 0x6d, 0xb5, 0xeb, 0x60, 0x45, 0x5f,
+  0xee, 0xd4, 0xd7, 0x34, 0x55, 0xaf, 0xba, 0xf9, 0xb4, 0x13, 0xe9, 0x7a, 0x2e, 0x44, 0x05, 0x70,
+  0x1c, 0x07, 0x2e, 0x7e, 0x32, 0x88, 0x38, 0xea, 0x0a, 0xc0, 0x31, 0xf7, 0x27, 0x84, 0x31, 0x8b,
+  0x53, 0xff, 0x0e, 0xa0, 0x7b, 0x6c, 0x45, 0x41, 0x02, 0x01, 0xcd, 0x4d, 0xe2, 0x9e, 0x8c, 0xa9,
+  0xe7, 0xc9, 0xf6, 0x6e, 0xb6, 0x50, 0x6c, 0x55, 0x35, 0xfa, 0x75, 0xba, 0x44, 0xb0, 0x93, 0x02,
+  0x9b, 0xfa, 0x90, 0x89, 0xdc, 0xd7, 0x22, 0xab, 0x7e, 0x56, 0x5d, 0xc8, 0xd8, 0x84, 0x01, 0x46,
+  0x34, 0x39, 0x33, 0x44, 0x4b, 0x2a, 0x79, 0xdc, 0x52, 0xd5, 0x82, 0x4e, 0xc0, 0xc6, 0x44, 0x64,
+  0x94, 0xd0, 0x77, 0x34, 0x93, 0x9a, 0x16, 0x22, 0xe9, 0xf9, 0x7e, 0x45, 0xe0, 0xf4, 0x69, 0x6d,
+  0x19, 0xaa, 0x26, 0x06, 0xe5, 0xf1, 0xb9, 0x71, 0xad, 0xae, 0x0e, 0xa4, 0xeb, 0x53, 0x25, 0x09,
+  0x6d, 0x4b, 0x41, 0xd2, 0x62, 0xaf, 0x6f, 0xcc, 0x0c, 0xf0, 0x15, 0xe7, 0x34, 0x86, 0x76, 0x93,
+  0x84, 0xc4, 0xb7, 0x9a, 0xed, 0x30, 0x57, 0x78, 0xae, 0x99, 0x2c, 0x0e, 0x29, 0x6c, 0xd1, 0xad,
+  0xd6, 0x41, 0x4d, 0x77, 0xc2, 0xdb, 0x5c, 0x39, 0xd1, 0x95, 0x81, 0xba, 0x9b, 0x31, 0xeb, 0x79,
+  0x19, 0x3f, 0x63, 0xbf, 0x21, 0xd2, 0x70, 0x40, 0xc0, 0x28, 0x55, 0xa8, 0x3b, 0x55, 0xb0, 0xe3,
+  0xb4, 0xba, 0xc6, 0xec, 0x82, 0xe3, 0xc8, 0xb6, 0x4d, 0x23, 0xf1, 0xbf, 0xb1, 0xdb, 0xd0, 0x06,
+  0x51, 0xf6, 0x01, 0xa7, 0x21, 0x5b, 0x61, 0xae, 0x40, 0x76, 0xa9, 0x60, 0x3a, 0xc4, 0x06, 0xd1,
+  0xc8, 0xc9, 0xcc, 0x8e, 0x86, 0xb3, 0x91, 0xee, 0x03, 0x57, 0x05, 0xc0, 0x63, 0x9b, 0x2c, 0xa3,
+  0xde, 0x74, 0xbd, 0xdf, 0x63, 0xba, 0x63, 0xb7, 0xd7, 0x34, 0xdd, 0x17, 0xc2, 0x9e, 0x2e, 0x0e,
+  0xff, 0xaa, 0x09, 0x4d, 0x85, 0x78, 0x8b, 0x72, 0x93, 0xe7, 0x54, 0x68, 0xab, 0x5a, 0xf4, 0x8c,
+  0x99, 0x02, 0x8c, 0x52, 0xe8, 0xdf, 0x29, 0xc7, 0x52, 0x11, 0xe5, 0x0b, 0x30, 0xad, 0x34, 0xdc,
+  0xae, 0xf8, 0x73, 0x4c, 0xd3, 0x85, 0xfd, 0x65, 0x1d, 0xa8, 0x75, 0xfd, 0x56, 0x3a, 0x5c, 0x9a,
+  0xbb, 0x38, 0x16, 0x15, 0x2c, 0xe6, 0xf9, 0x02, 0x3d, 0x93, 0xc4, 0x71, 0xaf, 0xaa, 0x9d, 0xb9,
+  0xbc, 0xa3, 0x2b, 0x36, 0x75, 0x0b, 0x5a, 0x69, 0x50, 0x1f, 0xaf, 0xdf, 0x46, 0x24, 0x13, 0x97,
+  0x73, 0x8e, 0xba, 0x18, 0x50, 0x72, 0x92, 0x3d, 0xaa, 0x33, 0x83, 0x2e, 0x11, 0x1e, 0xff, 0x42,
+  0x92, 0x6a, 0x5a, 0xdf, 0x2c, 0x4b, 0xbf, 0x8d, 0xe6, 0xbf, 0x0a, 0x89, 0xc8, 0xb8, 0x63, 0xfa,
+  0xc6, 0x37, 0xf5, 0xfd, 0x32, 0xa7, 0x6b, 0xc3, 0x55, 0x48, 0x3d, 0x40, 0x59, 0x57, 0xf2, 0x4a,
+  0xfd, 0x83, 0xca, 0x4b, 0x9d, 0x41, 0xff, 0x6f, 0xea, 0x1b, 0x4e, 0x46, 0x7a, 0xcc, 0x1a, 0x99,
+  0x4e, 0xa6, 0x27, 0x29, 0x54, 0x69, 0x5e, 0x41, 0x4e, 0x58, 0xdf, 0xa5, 0xff, 0xf4, 0x6e, 0x8a,
+  0xf3, 0x15, 0x9d, 0xd0, 0xfb, 0xab, 0x6b, 0xfa, 0x17, 0xcf, 0xae, 0x39, 0x67, 0x0d, 0x0a, 0xea,
+  0x8b, 0x39, 0x51, 0xdf, 0x08, 0x4e, 0x37, 0x51, 0xd6, 0xef, 0x1d, 0xad, 0x56, 0xe7, 0x0a, 0x3d,
+  0xa4, 0x39, 0x8e, 0x55, 0x7f, 0x6a, 0x3a, 0x30, 0x6a, 0x4e, 0xc8, 0x78, 0x87, 0xb0, 0xdf, 0x5f,
+  0xbf, 0xec, 0xbc, 0xd4, 0x4d, 0x90, 0x02, 0xa5, 0xb8, 0xd4, 0xb0, 0x38, 0xc1, 0xaa, 0x53, 0xbf,
+  0xa5, 0x85, 0x5e, 0x45, 0x49, 0x90, 0xae, 0x9e, 0x7a, 0xec, 0x47, 0x52, 0xfc, 0xc7, 0x9d, 0x06,
+  0xbb, 0xd9, 0x8e, 0xe9, 0x62, 0xd1, 0xb8, 0xb1, 0x56, 0x15, 0xe1, 0x40, 0x25, 0x51, 0xac, 0xc6,
+  0xdd, 0xea, 0x86, 0x75, 0xdc, 0x35, 0xd7, 0xfa, 0x5d, 0xf5, 0x4f, 0xe3, 0xff, 0x05, 0x8b, 0x33,
+  0x2f, 0xc9, 0x2a, 0x1f, 0x00, 0x00,
+};
+
+static const uint8_t AVISHA_OTA_UI[] PROGMEM = {
+  0x3c, 0x21, 0x44, 0x4f, 0x43, 0x54, 0x59, 0x50, 0x45, 0x20, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x0a,
+  0x3c, 0x68, 0x74, 0x6d, 0x6c, 0x20, 0x6c, 0x61, 0x6e, 0x67, 0x3d, 0x22, 0x69, 0x64, 0x22, 0x3e,
+  0x0a, 0x3c, 0x68, 0x65, 0x61, 0x64, 0x3e, 0x0a, 0x3c, 0x6d, 0x65, 0x74, 0x61, 0x20, 0x63, 0x68,
+  0x61, 0x72, 0x73, 0x65, 0x74, 0x3d, 0x22, 0x55, 0x54, 0x46, 0x2d, 0x38, 0x22, 0x20, 0x2f, 0x3e,
+  0x0a, 0x3c, 0x6d, 0x65, 0x74, 0x61, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x76, 0x69, 0x65,
+  0x77, 0x70, 0x6f, 0x72, 0x74, 0x22, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x3d, 0x22,
+  0x77, 0x69, 0x64, 0x74, 0x68, 0x3d, 0x64, 0x65, 0x76, 0x69, 0x63, 0x65, 0x2d, 0x77, 0x69, 0x64,
+  0x74, 0x68, 0x2c, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x61, 0x6c, 0x2d, 0x73, 0x63, 0x61, 0x6c,
+  0x65, 0x3d, 0x31, 0x2e, 0x30, 0x22, 0x20, 0x2f, 0x3e, 0x0a, 0x3c, 0x74, 0x69, 0x74, 0x6c, 0x65,
+  0x3e, 0x41, 0x56, 0x69, 0x53, 0x68, 0x61, 0x20, 0x4f, 0x54, 0x41, 0x20, 0x55, 0x70, 0x64, 0x61,
+  0x74, 0x65, 0x3c, 0x2f, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 0x0a, 0x3c, 0x73, 0x74, 0x79, 0x6c,
+  0x65, 0x3e, 0x0a, 0x62, 0x6f, 0x64, 0x79, 0x20, 0x7b, 0x0a, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x66,
+  0x61, 0x6d, 0x69, 0x6c, 0x79, 0x3a, 0x20, 0x2d, 0x61, 0x70, 0x70, 0x6c, 0x65, 0x2d, 0x73, 0x79,
+  0x73, 0x74, 0x65, 0x6d, 0x2c, 0x20, 0x42, 0x6c, 0x69, 0x6e, 0x6b, 0x4d, 0x61, 0x63, 0x53, 0x79,
+  0x73, 0x74, 0x65, 0x6d, 0x46, 0x6f, 0x6e, 0x74, 0x2c, 0x20, 0x22, 0x53, 0x65, 0x67, 0x6f, 0x65,
+  0x20, 0x55, 0x49, 0x22, 0x2c, 0x20, 0x52, 0x6f, 0x62, 0x6f, 0x74, 0x6f, 0x2c, 0x20, 0x4f, 0x78,
+  0x79, 0x67, 0x65, 0x6e, 0x2c, 0x0a, 0x55, 0x62, 0x75, 0x6e, 0x74, 0x75, 0x2c, 0x20, 0x43, 0x61,
+  0x6e, 0x74, 0x61, 0x72, 0x65, 0x6c, 0x6c, 0x2c, 0x20, 0x22, 0x4f, 0x70, 0x65, 0x6e, 0x20, 0x53,
+  0x61, 0x6e, 0x73, 0x22, 0x2c, 0x20, 0x22, 0x48, 0x65, 0x6c, 0x76, 0x65, 0x74, 0x69, 0x63, 0x61,
+  0x20, 0x4e, 0x65, 0x75, 0x65, 0x22, 0x2c, 0x20, 0x73, 0x61, 0x6e, 0x73, 0x2d, 0x73, 0x65, 0x72,
+  0x69, 0x66, 0x3b, 0x0a, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3a, 0x20, 0x30, 0x3b, 0x0a, 0x70,
+  0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x30, 0x3b, 0x0a, 0x62, 0x61, 0x63, 0x6b, 0x67,
+  0x72, 0x6f, 0x75, 0x6e, 0x64, 0x3a, 0x20, 0x23, 0x66, 0x32, 0x66, 0x32, 0x66, 0x37, 0x3b, 0x0a,
+  0x7d, 0x0a, 0x2e, 0x63, 0x6f, 0x6e, 0x74, 0x61, 0x69, 0x6e, 0x65, 0x72, 0x20, 0x7b, 0x0a, 0x6d,
+  0x61, 0x78, 0x2d, 0x77, 0x69, 0x64, 0x74, 0x68, 0x3a, 0x20, 0x34, 0x30, 0x30, 0x70, 0x78, 0x3b,
+  0x0a, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3a, 0x20, 0x38, 0x30, 0x70, 0x78, 0x20, 0x61, 0x75,
+  0x74, 0x6f, 0x3b, 0x0a, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x3a, 0x20,
+  0x23, 0x66, 0x66, 0x66, 0x3b, 0x0a, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d, 0x72, 0x61, 0x64,
+  0x69, 0x75, 0x73, 0x3a, 0x20, 0x32, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x62, 0x6f, 0x78, 0x2d, 0x73,
+  0x68, 0x61, 0x64, 0x6f, 0x77, 0x3a, 0x20, 0x30, 0x20, 0x38, 0x70, 0x78, 0x20, 0x32, 0x30, 0x70,
+  0x78, 0x20, 0x72, 0x67, 0x62, 0x61, 0x28, 0x30, 0x2c, 0x20, 0x30, 0x2c, 0x20, 0x30, 0x2c, 0x20,
+  0x30, 0x2e, 0x30, 0x38, 0x29, 0x3b, 0x0a, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20,
+  0x33, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x74, 0x65, 0x78, 0x74, 0x2d, 0x61, 0x6c, 0x69, 0x67, 0x6e,
+  0x3a, 0x20, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x3b, 0x0a, 0x7d, 0x0a, 0x68, 0x31, 0x20, 0x7b,
+  0x0a, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69, 0x7a, 0x65, 0x3a, 0x20, 0x32, 0x34, 0x70, 0x78,
+  0x3b, 0x0a, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x2d, 0x62, 0x6f, 0x74, 0x74, 0x6f, 0x6d, 0x3a,
+  0x20, 0x31, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x31,
+  0x31, 0x31, 0x3b, 0x0a, 0x7d, 0x0a, 0x70, 0x20, 0x7b, 0x0a, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a,
+  0x20, 0x23, 0x35, 0x35, 0x35, 0x3b, 0x0a, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69, 0x7a, 0x65,
+  0x3a, 0x20, 0x31, 0x34, 0x70, 0x78, 0x3b, 0x0a, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x2d, 0x62,
+  0x6f, 0x74, 0x74, 0x6f, 0x6d, 0x3a, 0x20, 0x32, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x7d, 0x0a, 0x2e,
+  0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x2d, 0x61, 0x72, 0x65, 0x61, 0x20, 0x7b, 0x0a, 0x62, 0x6f,
+  0x72, 0x64, 0x65, 0x72, 0x3a, 0x20, 0x32, 0x70, 0x78, 0x20, 0x64, 0x61, 0x73, 0x68, 0x65, 0x64,
+  0x20, 0x23, 0x64, 0x31, 0x64, 0x31, 0x64, 0x36, 0x3b, 0x0a, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72,
+  0x2d, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x3a, 0x20, 0x31, 0x32, 0x70, 0x78, 0x3b, 0x0a, 0x70,
+  0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x33, 0x30, 0x70, 0x78, 0x20, 0x31, 0x30, 0x70,
+  0x78, 0x3b, 0x0a, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x2d, 0x63, 0x6f,
+  0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x66, 0x61, 0x66, 0x61, 0x66, 0x61, 0x3b, 0x0a, 0x74, 0x72,
+  0x61, 0x6e, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3a, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72,
+  0x6f, 0x75, 0x6e, 0x64, 0x20, 0x30, 0x2e, 0x33, 0x73, 0x20, 0x65, 0x61, 0x73, 0x65, 0x3b, 0x0a,
+  0x7d, 0x0a, 0x2e, 0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x2d, 0x61, 0x72, 0x65, 0x61, 0x3a, 0x68,
+  0x6f, 0x76, 0x65, 0x72, 0x20, 0x7b, 0x0a, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e,
+  0x64, 0x3a, 0x20, 0x23, 0x66, 0x30, 0x66, 0x30, 0x66, 0x35, 0x3b, 0x0a, 0x7d, 0x0a, 0x69, 0x6e,
+  0x70, 0x75, 0x74, 0x5b, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f,
+  0x72, 0x64, 0x22, 0x5d, 0x2c, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x5b, 0x74, 0x79, 0x70, 0x65,
+  0x3d, 0x22, 0x66, 0x69, 0x6c, 0x65, 0x22, 0x5d, 0x20, 0x7b, 0x0a, 0x6d, 0x61, 0x72, 0x67, 0x69,
+  0x6e, 0x2d, 0x74, 0x6f, 0x70, 0x3a, 0x20, 0x31, 0x35, 0x70, 0x78, 0x3b, 0x0a, 0x70, 0x61, 0x64,
+  0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x31, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x62, 0x6f, 0x72, 0x64,
+  0x65, 0x72, 0x3a, 0x20, 0x31, 0x70, 0x78, 0x20, 0x73, 0x6f, 0x6c, 0x69, 0x64, 0x20, 0x23, 0x64,
+  0x31, 0x64, 0x31, 0x64, 0x36, 0x3b, 0x0a, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d, 0x72, 0x61,
+  0x64, 0x69, 0x75, 0x73, 0x3a, 0x20, 0x38, 0x70, 0x78, 0x3b, 0x0a, 0x66, 0x6f, 0x6e, 0x74, 0x2d,
+  0x73, 0x69, 0x7a, 0x65, 0x3a, 0x20, 0x31, 0x34, 0x70, 0x78, 0x3b, 0x0a, 0x77, 0x69, 0x64, 0x74,
+  0x68, 0x3a, 0x20, 0x38, 0x30, 0x25, 0x3b, 0x0a, 0x6d, 0x61, 0x78, 0x2d, 0x77, 0x69, 0x64, 0x74,
+  0x68, 0x3a, 0x20, 0x32, 0x35, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x7d, 0x0a, 0x69, 0x6e, 0x70, 0x75,
+  0x74, 0x5b, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x66, 0x69, 0x6c, 0x65, 0x22, 0x5d, 0x20, 0x7b,
+  0x0a, 0x63, 0x75, 0x72, 0x73, 0x6f, 0x72, 0x3a, 0x20, 0x70, 0x6f, 0x69, 0x6e, 0x74, 0x65, 0x72,
+  0x3b, 0x0a, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x38, 0x70, 0x78, 0x3b, 0x0a,
+  0x7d, 0x0a, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x20, 0x7b, 0x0a, 0x6d, 0x61, 0x72, 0x67, 0x69,
+  0x6e, 0x2d, 0x74, 0x6f, 0x70, 0x3a, 0x20, 0x32, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x62, 0x61, 0x63,
+  0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x2d, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23,
+  0x30, 0x30, 0x37, 0x61, 0x66, 0x66, 0x3b, 0x0a, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x77,
+  0x68, 0x69, 0x74, 0x65, 0x3b, 0x0a, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x3a, 0x20, 0x6e, 0x6f,
+  0x6e, 0x65, 0x3b, 0x0a, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x31, 0x32, 0x70,
+  0x78, 0x20, 0x32, 0x34, 0x70, 0x78, 0x3b, 0x0a, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69, 0x7a,
+  0x65, 0x3a, 0x20, 0x31, 0x36, 0x70, 0x78, 0x3b, 0x0a, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d,
+  0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x3a, 0x20, 0x31, 0x32, 0x70, 0x78, 0x3b, 0x0a, 0x63, 0x75,
+  0x72, 0x73, 0x6f, 0x72, 0x3a, 0x20, 0x70, 0x6f, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x3b, 0x0a, 0x74,
+  0x72, 0x61, 0x6e, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3a, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67,
+  0x72, 0x6f, 0x75, 0x6e, 0x64, 0x20, 0x30, 0x2e, 0x33, 0x73, 0x20, 0x65, 0x61, 0x73, 0x65, 0x3b,
+  0x0a, 0x6d, 0x69, 0x6e, 0x2d, 0x77, 0x69, 0x64, 0x74, 0x68, 0x3a, 0x20, 0x31, 0x35, 0x30, 0x70,
+  0x78, 0x3b, 0x0a, 0x7d, 0x0a, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x3a, 0x68, 0x6f, 0x76, 0x65,
+  0x72, 0x3a, 0x6e, 0x6f, 0x74, 0x28, 0x3a, 0x64, 0x69, 0x73, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x29,
+  0x20, 0x7b, 0x0a, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x2d, 0x63, 0x6f,
+  0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x30, 0x30, 0x35, 0x65, 0x64, 0x39, 0x3b, 0x0a, 0x7d, 0x0a,
+  0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x3a, 0x64, 0x69, 0x73, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x20,
+  0x7b, 0x0a, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x2d, 0x63, 0x6f, 0x6c,
+  0x6f, 0x72, 0x3a, 0x20, 0x23, 0x38, 0x65, 0x38, 0x65, 0x39, 0x33, 0x3b, 0x0a, 0x63, 0x75, 0x72,
+  0x73, 0x6f, 0x72, 0x3a, 0x20, 0x6e, 0x6f, 0x74, 0x2d, 0x61, 0x6c, 0x6c, 0x6f, 0x77, 0x65, 0x64,
+  0x3b, 0x0a, 0x7d, 0x0a, 0x2e, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x20, 0x7b, 0x0a,
+  0x77, 0x69, 0x64, 0x74, 0x68, 0x3a, 0x20, 0x31, 0x30, 0x30, 0x25, 0x3b, 0x0a, 0x62, 0x61, 0x63,
+  0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x2d, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23,
+  0x65, 0x35, 0x65, 0x35, 0x65, 0x61, 0x3b, 0x0a, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d, 0x72,
+  0x61, 0x64, 0x69, 0x75, 0x73, 0x3a, 0x20, 0x31, 0x32, 0x70, 0x78, 0x3b, 0x0a, 0x6d, 0x61, 0x72,
+  0x67, 0x69, 0x6e, 0x2d, 0x74, 0x6f, 0x70, 0x3a, 0x20, 0x32, 0x35, 0x70, 0x78, 0x3b, 0x0a, 0x68,
+  0x65, 0x69, 0x67, 0x68, 0x74, 0x3a, 0x20, 0x31, 0x32, 0x70, 0x78, 0x3b, 0x0a, 0x6f, 0x76, 0x65,
+  0x72, 0x66, 0x6c, 0x6f, 0x77, 0x3a, 0x20, 0x68, 0x69, 0x64, 0x64, 0x65, 0x6e, 0x3b, 0x0a, 0x64,
+  0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x3a, 0x20, 0x6e, 0x6f, 0x6e, 0x65, 0x3b, 0x0a, 0x7d, 0x0a,
+  0x2e, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x2d, 0x62, 0x61, 0x72, 0x20, 0x7b, 0x0a,
+  0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 0x3a, 0x20, 0x31, 0x30, 0x30, 0x25, 0x3b, 0x0a, 0x77, 0x69,
+  0x64, 0x74, 0x68, 0x3a, 0x20, 0x30, 0x25, 0x3b, 0x0a, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f,
+  0x75, 0x6e, 0x64, 0x2d, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x33, 0x34, 0x63, 0x37,
+  0x35, 0x39, 0x3b, 0x0a, 0x74, 0x72, 0x61, 0x6e, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3a, 0x20,
+  0x77, 0x69, 0x64, 0x74, 0x68, 0x20, 0x30, 0x2e, 0x33, 0x73, 0x20, 0x65, 0x61, 0x73, 0x65, 0x3b,
+  0x0a, 0x7d, 0x0a, 0x23, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x20, 0x7b, 0x0a, 0x6d, 0x61, 0x72,
+  0x67, 0x69, 0x6e, 0x2d, 0x74, 0x6f, 0x70, 0x3a, 0x20, 0x32, 0x35, 0x70, 0x78, 0x3b, 0x0a, 0x66,
+  0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69, 0x7a, 0x65, 0x3a, 0x20, 0x31, 0x34, 0x70, 0x78, 0x3b, 0x0a,
+  0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x33, 0x33, 0x33, 0x3b, 0x0a, 0x7d, 0x0a, 0x2e,
+  0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2d, 0x73, 0x75, 0x63, 0x63, 0x65, 0x73, 0x73, 0x20, 0x7b,
+  0x0a, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x32, 0x38, 0x61, 0x37, 0x34, 0x35, 0x3b,
+  0x0a, 0x7d, 0x0a, 0x2e, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2d, 0x65, 0x72, 0x72, 0x6f, 0x72,
+  0x20, 0x7b, 0x0a, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x66, 0x66, 0x33, 0x62, 0x33,
+  0x30, 0x3b, 0x0a, 0x7d, 0x0a, 0x2e, 0x66, 0x69, 0x6c, 0x65, 0x2d, 0x69, 0x6e, 0x66, 0x6f, 0x20,
+  0x7b, 0x0a, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x2d, 0x74, 0x6f, 0x70, 0x3a, 0x20, 0x31, 0x30,
+  0x70, 0x78, 0x3b, 0x0a, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69, 0x7a, 0x65, 0x3a, 0x20, 0x31,
+  0x32, 0x70, 0x78, 0x3b, 0x0a, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x36, 0x36, 0x36,
+  0x3b, 0x0a, 0x7d, 0x0a, 0x3c, 0x2f, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x3e, 0x0a, 0x3c, 0x2f, 0x68,
+  0x65, 0x61, 0x64, 0x3e, 0x0a, 0x3c, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0x0a, 0x3c, 0x64, 0x69, 0x76,
+  0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x63, 0x6f, 0x6e, 0x74, 0x61, 0x69, 0x6e, 0x65,
+  0x72, 0x22, 0x3e, 0x0a, 0x3c, 0x68, 0x31, 0x3e, 0x45, 0x53, 0x50, 0x33, 0x32, 0x20, 0x4f, 0x54,
+  0x41, 0x20, 0x55, 0x70, 0x64, 0x61, 0x74, 0x65, 0x3c, 0x2f, 0x68, 0x31, 0x3e, 0x0a, 0x3c, 0x70,
+  0x3e, 0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x20, 0x61, 0x20, 0x2e, 0x62, 0x69, 0x6e, 0x20, 0x66,
+  0x69, 0x6c, 0x65, 0x20, 0x74, 0x6f, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x20, 0x79, 0x6f,
+  0x75, 0x72, 0x20, 0x64, 0x65, 0x76, 0x69, 0x63, 0x65, 0x27, 0x73, 0x20, 0x66, 0x69, 0x72, 0x6d,
+  0x77, 0x61, 0x72, 0x65, 0x2e, 0x3c, 0x2f, 0x70, 0x3e, 0x0a, 0x3c, 0x64, 0x69, 0x76, 0x20, 0x63,
+  0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x2d, 0x61, 0x72, 0x65,
+  0x61, 0x22, 0x3e, 0x0a, 0x3c, 0x66, 0x6f, 0x72, 0x6d, 0x20, 0x69, 0x64, 0x3d, 0x22, 0x75, 0x70,
+  0x6c, 0x6f, 0x61, 0x64, 0x46, 0x6f, 0x72, 0x6d, 0x22, 0x20, 0x65, 0x6e, 0x63, 0x74, 0x79, 0x70,
+  0x65, 0x3d, 0x22, 0x6d, 0x75, 0x6c, 0x74, 0x69, 0x70, 0x61, 0x72, 0x74, 0x2f, 0x66, 0x6f, 0x72,
+  0x6d, 0x2d, 0x64, 0x61, 0x74, 0x61, 0x22, 0x3e, 0x0a, 0x3c, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20,
+  0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x22, 0x20,
+  0x69, 0x64, 0x3d, 0x22, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x49, 0x6e, 0x70, 0x75,
+  0x74, 0x22, 0x20, 0x70, 0x6c, 0x61, 0x63, 0x65, 0x68, 0x6f, 0x6c, 0x64, 0x65, 0x72, 0x3d, 0x22,
+  0x45, 0x6e, 0x74, 0x65, 0x72, 0x20, 0x4f, 0x54, 0x41, 0x20, 0x50, 0x61, 0x73, 0x73, 0x77, 0x6f,
+  0x72, 0x64, 0x22, 0x20, 0x2f, 0x3e, 0x0a, 0x3c, 0x62, 0x72, 0x20, 0x2f, 0x3e, 0x0a, 0x3c, 0x69,
+  0x6e, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x66, 0x69, 0x6c, 0x65, 0x22,
+  0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x22, 0x20, 0x69,
+  0x64, 0x3d, 0x22, 0x66, 0x69, 0x6c, 0x65, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x22, 0x20, 0x61, 0x63,
+  0x63, 0x65, 0x70, 0x74, 0x3d, 0x22, 0x2e, 0x62, 0x69, 0x6e, 0x22, 0x20, 0x72, 0x65, 0x71, 0x75,
+  0x69, 0x72, 0x65, 0x64, 0x20, 0x2f, 0x3e, 0x0a, 0x3c, 0x64, 0x69, 0x76, 0x20, 0x63, 0x6c, 0x61,
+  0x73, 0x73, 0x3d, 0x22, 0x66, 0x69, 0x6c, 0x65, 0x2d, 0x69, 0x6e, 0x66, 0x6f, 0x22, 0x20, 0x69,
+  0x64, 0x3d, 0x22, 0x66, 0x69, 0x6c, 0x65, 0x49, 0x6e, 0x66, 0x6f, 0x22, 0x3e, 0x3c, 0x2f, 0x64,
+  0x69, 0x76, 0x3e, 0x0a, 0x3c, 0x62, 0x72, 0x20, 0x2f, 0x3e, 0x0a, 0x3c, 0x62, 0x75, 0x74, 0x74,
+  0x6f, 0x6e, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x73, 0x75, 0x62, 0x6d, 0x69, 0x74, 0x22,
+  0x20, 0x69, 0x64, 0x3d, 0x22, 0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x42, 0x74, 0x6e, 0x22, 0x3e,
+  0x55, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x55, 0x70, 0x64, 0x61, 0x74,
+  0x65, 0x3c, 0x2f, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x3e, 0x0a, 0x3c, 0x2f, 0x66, 0x6f, 0x72,
+  0x6d, 0x3e, 0x0a, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x0a, 0x3c, 0x64, 0x69, 0x76, 0x20, 0x63,
+  0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x22, 0x20,
+  0x69, 0x64, 0x3d, 0x22, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x43, 0x6f, 0x6e, 0x74,
+  0x61, 0x69, 0x6e, 0x65, 0x72, 0x22, 0x3e, 0x0a, 0x3c, 0x64, 0x69, 0x76, 0x20, 0x63, 0x6c, 0x61,
+  0x73, 0x73, 0x3d, 0x22, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x2d, 0x62, 0x61, 0x72,
+  0x22, 0x20, 0x69, 0x64, 0x3d, 0x22, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x42, 0x61,
+  0x72, 0x22, 0x3e, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x0a, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e,
+  0x0a, 0x3c, 0x64, 0x69, 0x76, 0x20, 0x69, 0x64, 0x3d, 0x22, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73,
+  0x22, 0x3e, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x0a, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x0a,
+  0x3c, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x3e, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75,
+  0x70, 0x6c, 0x6f, 0x61, 0x64, 0x46, 0x6f, 0x72, 0x6d, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x63, 0x75,
+  0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42,
+  0x79, 0x49, 0x64, 0x28, 0x22, 0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x46, 0x6f, 0x72, 0x6d, 0x22,
+  0x29, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x49, 0x6e, 0x70,
+  0x75, 0x74, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65,
+  0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x22, 0x66, 0x69,
+  0x6c, 0x65, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x22, 0x29, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74,
+  0x20, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x3d,
+  0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65,
+  0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x22, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f,
+  0x72, 0x64, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x22, 0x29, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74,
+  0x20, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x43, 0x6f, 0x6e, 0x74, 0x61, 0x69, 0x6e,
+  0x65, 0x72, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65,
+  0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x22, 0x70, 0x72,
+  0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x43, 0x6f, 0x6e, 0x74, 0x61, 0x69, 0x6e, 0x65, 0x72, 0x22,
+  0x29, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73,
+  0x73, 0x42, 0x61, 0x72, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e,
+  0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x22,
+  0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x42, 0x61, 0x72, 0x22, 0x29, 0x3b, 0x0a, 0x63,
+  0x6f, 0x6e, 0x73, 0x74, 0x20, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x20, 0x3d, 0x20, 0x64, 0x6f,
+  0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e,
+  0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x22, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x22, 0x29, 0x3b,
+  0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x42, 0x74, 0x6e,
+  0x20, 0x3d, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45,
+  0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x22, 0x75, 0x70, 0x6c, 0x6f,
+  0x61, 0x64, 0x42, 0x74, 0x6e, 0x22, 0x29, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66,
+  0x69, 0x6c, 0x65, 0x49, 0x6e, 0x66, 0x6f, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65,
+  0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49,
+  0x64, 0x28, 0x22, 0x66, 0x69, 0x6c, 0x65, 0x49, 0x6e, 0x66, 0x6f, 0x22, 0x29, 0x3b, 0x0a, 0x63,
+  0x6f, 0x6e, 0x73, 0x74, 0x20, 0x65, 0x6e, 0x63, 0x6f, 0x64, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x6e,
+  0x65, 0x77, 0x20, 0x54, 0x65, 0x78, 0x74, 0x45, 0x6e, 0x63, 0x6f, 0x64, 0x65, 0x72, 0x28, 0x29,
+  0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x72, 0x6f, 0x74, 0x72, 0x20, 0x3d, 0x20, 0x28,
+  0x78, 0x2c, 0x20, 0x6e, 0x29, 0x20, 0x3d, 0x3e, 0x20, 0x28, 0x78, 0x20, 0x3e, 0x3e, 0x3e, 0x20,
+  0x6e, 0x29, 0x20, 0x7c, 0x20, 0x28, 0x78, 0x20, 0x3c, 0x3c, 0x20, 0x28, 0x33, 0x32, 0x20, 0x2d,
+  0x20, 0x6e, 0x29, 0x29, 0x3b, 0x0a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x73,
+  0x68, 0x61, 0x32, 0x35, 0x36, 0x28, 0x62, 0x79, 0x74, 0x65, 0x73, 0x29, 0x20, 0x7b, 0x0a, 0x63,
+  0x6f, 0x6e, 0x73, 0x74, 0x20, 0x68, 0x20, 0x3d, 0x20, 0x5b, 0x5d, 0x3b, 0x0a, 0x63, 0x6f, 0x6e,
+  0x73, 0x74, 0x20, 0x6b, 0x20, 0x3d, 0x20, 0x5b, 0x5d, 0x3b, 0x0a, 0x66, 0x6f, 0x72, 0x20, 0x28,
+  0x6c, 0x65, 0x74, 0x20, 0x6e, 0x20, 0x3d, 0x20, 0x32, 0x3b, 0x20, 0x6b, 0x2e, 0x6c, 0x65, 0x6e,
+  0x67, 0x74, 0x68, 0x20, 0x3c, 0x20, 0x36, 0x34, 0x3b, 0x20, 0x6e, 0x2b, 0x2b, 0x29, 0x20, 0x7b,
+  0x0a, 0x6c, 0x65, 0x74, 0x20, 0x70, 0x72, 0x69, 0x6d, 0x65, 0x20, 0x3d, 0x20, 0x74, 0x72, 0x75,
+  0x65, 0x3b, 0x0a, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x6c, 0x65, 0x74, 0x20, 0x64, 0x20, 0x3d, 0x20,
+  0x32, 0x3b, 0x20, 0x64, 0x20, 0x2a, 0x20, 0x64, 0x20, 0x3c, 0x3d, 0x20, 0x6e, 0x3b, 0x20, 0x64,
+  0x2b, 0x2b, 0x29, 0x20, 0x7b, 0x0a, 0x69, 0x66, 0x20, 0x28, 0x6e, 0x20, 0x25, 0x20, 0x64, 0x20,
+  0x3d, 0x3d, 0x3d, 0x20, 0x30, 0x29, 0x20, 0x7b, 0x0a, 0x70, 0x72, 0x69, 0x6d, 0x65, 0x20, 0x3d,
+  0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3b, 0x0a, 0x62, 0x72, 0x65, 0x61, 0x6b, 0x3b, 0x0a, 0x7d,
+  0x0a, 0x7d, 0x0a, 0x69, 0x66, 0x20, 0x28, 0x70, 0x72, 0x69, 0x6d, 0x65, 0x29, 0x20, 0x7b, 0x0a,
+  0x69, 0x66, 0x20, 0x28, 0x68, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20, 0x3c, 0x20, 0x38,
+  0x29, 0x20, 0x7b, 0x0a, 0x68, 0x2e, 0x70, 0x75, 0x73, 0x68, 0x28, 0x4d, 0x61, 0x74, 0x68, 0x2e,
+  0x70, 0x6f, 0x77, 0x28, 0x6e, 0x2c, 0x20, 0x31, 0x20, 0x2f, 0x20, 0x32, 0x29, 0x20, 0x2a, 0x20,
+  0x34, 0x32, 0x39, 0x34, 0x39, 0x36, 0x37, 0x32, 0x39, 0x36, 0x20, 0x7c, 0x20, 0x30, 0x29, 0x3b,
+  0x0a, 0x7d, 0x0a, 0x6b, 0x2e, 0x70, 0x75, 0x73, 0x68, 0x28, 0x4d, 0x61, 0x74, 0x68, 0x2e, 0x70,
+  0x6f, 0x77, 0x28, 0x6e, 0x2c, 0x20, 0x31, 0x20, 0x2f, 0x20, 0x33, 0x29, 0x20, 0x2a, 0x20, 0x34,
+  0x32, 0x39, 0x34, 0x39, 0x36, 0x37, 0x32, 0x39, 0x36, 0x20, 0x7c, 0x20, 0x30, 0x29, 0x3b, 0x0a,
+  0x7d, 0x0a, 0x7d, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x77, 0x6f, 0x72, 0x64, 0x73, 0x20,
+  0x3d, 0x20, 0x6e, 0x65, 0x77, 0x20, 0x41, 0x72, 0x72, 0x61, 0x79, 0x28, 0x28, 0x28, 0x62, 0x79,
+  0x74, 0x65, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20, 0x2b, 0x20, 0x37, 0x32, 0x29,
+  0x20, 0x3e, 0x3e, 0x20, 0x36, 0x29, 0x20, 0x3c, 0x3c, 0x20, 0x34, 0x29, 0x2e, 0x66, 0x69, 0x6c,
+  0x6c, 0x28, 0x30, 0x29, 0x3b, 0x0a, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x6c, 0x65, 0x74, 0x20, 0x69,
+  0x20, 0x3d, 0x20, 0x30, 0x3b, 0x20, 0x69, 0x20, 0x3c, 0x20, 0x62, 0x79, 0x74, 0x65, 0x73, 0x2e,
+  0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3b, 0x20, 0x69, 0x2b, 0x2b, 0x29, 0x20, 0x7b, 0x0a, 0x77,
+  0x6f, 0x72, 0x64, 0x73, 0x5b, 0x69, 0x20, 0x3e, 0x3e, 0x20, 0x32, 0x5d, 0x20, 0x7c, 0x3d, 0x20,
+  0x62, 0x79, 0x74, 0x65, 0x73, 0x5b, 0x69, 0x5d, 0x20, 0x3c, 0x3c, 0x20, 0x28, 0x32, 0x34, 0x20,
+  0x2d, 0x20, 0x28, 0x69, 0x20, 0x25, 0x20, 0x34, 0x29, 0x20, 0x2a, 0x20, 0x38, 0x29, 0x3b, 0x0a,
+  0x7d, 0x0a, 0x77, 0x6f, 0x72, 0x64, 0x73, 0x5b, 0x62, 0x79, 0x74, 0x65, 0x73, 0x2e, 0x6c, 0x65,
+  0x6e, 0x67, 0x74, 0x68, 0x20, 0x3e, 0x3e, 0x20, 0x32, 0x5d, 0x20, 0x7c, 0x3d, 0x20, 0x30, 0x78,
+  0x38, 0x30, 0x20, 0x3c, 0x3c, 0x20, 0x28, 0x32, 0x34, 0x20, 0x2d, 0x20, 0x28, 0x62, 0x79, 0x74,
+  0x65, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20, 0x25, 0x20, 0x34, 0x29, 0x20, 0x2a,
+  0x20, 0x38, 0x29, 0x3b, 0x0a, 0x77, 0x6f, 0x72, 0x64, 0x73, 0x5b, 0x77, 0x6f, 0x72, 0x64, 0x73,
+  0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20, 0x2d, 0x20, 0x31, 0x5d, 0x20, 0x3d, 0x20, 0x62,
+  0x79, 0x74, 0x65, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20, 0x2a, 0x20, 0x38, 0x3b,
+  0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x77, 0x20, 0x3d, 0x20, 0x5b, 0x5d, 0x3b, 0x0a, 0x66,
+  0x6f, 0x72, 0x20, 0x28, 0x6c, 0x65, 0x74, 0x20, 0x6a, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x20, 0x6a,
+  0x20, 0x3c, 0x20, 0x77, 0x6f, 0x72, 0x64, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3b,
+  0x20, 0x6a, 0x20, 0x2b, 0x3d, 0x20, 0x31, 0x36, 0x29, 0x20, 0x7b, 0x0a, 0x6c, 0x65, 0x74, 0x20,
+  0x5b, 0x61, 0x2c, 0x20, 0x62, 0x2c, 0x20, 0x63, 0x2c, 0x20, 0x64, 0x2c, 0x20, 0x65, 0x2c, 0x20,
+  0x66, 0x2c, 0x20, 0x67, 0x2c, 0x20, 0x68, 0x68, 0x5d, 0x20, 0x3d, 0x20, 0x68, 0x3b, 0x0a, 0x66,
+  0x6f, 0x72, 0x20, 0x28, 0x6c, 0x65, 0x74, 0x20, 0x69, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x20, 0x69,
+  0x20, 0x3c, 0x20, 0x36, 0x34, 0x3b, 0x20, 0x69, 0x2b, 0x2b, 0x29, 0x20, 0x7b, 0x0a, 0x69, 0x66,
+  0x20, 0x28, 0x69, 0x20, 0x3c, 0x20, 0x31, 0x36, 0x29, 0x20, 0x7b, 0x0a, 0x77, 0x5b, 0x69, 0x5d,
+  0x20, 0x3d, 0x20, 0x77, 0x6f, 0x72, 0x64, 0x73, 0x5b, 0x6a, 0x20, 0x2b, 0x20, 0x69, 0x5d, 0x3b,
+  0x0a, 0x7d, 0x20, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x7b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20,
+  0x73, 0x30, 0x20, 0x3d, 0x20, 0x72, 0x6f, 0x74, 0x72, 0x28, 0x77, 0x5b, 0x69, 0x20, 0x2d, 0x20,
+  0x31, 0x35, 0x5d, 0x2c, 0x20, 0x37, 0x29, 0x20, 0x5e, 0x20, 0x72, 0x6f, 0x74, 0x72, 0x28, 0x77,
+  0x5b, 0x69, 0x20, 0x2d, 0x20, 0x31, 0x35, 0x5d, 0x2c, 0x20, 0x31, 0x38, 0x29, 0x20, 0x5e, 0x20,
+  0x28, 0x77, 0x5b, 0x69, 0x20, 0x2d, 0x20, 0x31, 0x35, 0x5d, 0x20, 0x3e, 0x3e, 0x3e, 0x20, 0x33,
+  0x29, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x73, 0x31, 0x20, 0x3d, 0x20, 0x72, 0x6f,
+  0x74, 0x72, 0x28, 0x77, 0x5b, 0x69, 0x20, 0x2d, 0x20, 0x32, 0x5d, 0x2c, 0x20, 0x31, 0x37, 0x29,
+  0x20, 0x5e, 0x20, 0x72, 0x6f, 0x74, 0x72, 0x28, 0x77, 0x5b, 0x69, 0x20, 0x2d, 0x20, 0x32, 0x5d,
+  0x2c, 0x20, 0x31, 0x39, 0x29, 0x20, 0x5e, 0x20, 0x28, 0x77, 0x5b, 0x69, 0x20, 0x2d, 0x20, 0x32,
+  0x5d, 0x20, 0x3e, 0x3e, 0x3e, 0x20, 0x31, 0x30, 0x29, 0x3b, 0x0a, 0x77, 0x5b, 0x69, 0x5d, 0x20,
+  0x3d, 0x20, 0x28, 0x77, 0x5b, 0x69, 0x20, 0x2d, 0x20, 0x31, 0x36, 0x5d, 0x20, 0x2b, 0x20, 0x73,
+  0x30, 0x20, 0x2b, 0x20, 0x77, 0x5b, 0x69, 0x20, 0x2d, 0x20, 0x37, 0x5d, 0x20, 0x2b, 0x20, 0x73,
+  0x31, 0x29, 0x20, 0x7c, 0x20, 0x30, 0x3b, 0x0a, 0x7d, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20,
+  0x74, 0x31, 0x20, 0x3d, 0x20, 0x28, 0x68, 0x68, 0x20, 0x2b, 0x20, 0x28, 0x72, 0x6f, 0x74, 0x72,
+  0x28, 0x65, 0x2c, 0x20, 0x36, 0x29, 0x20, 0x5e, 0x20, 0x72, 0x6f, 0x74, 0x72, 0x28, 0x65, 0x2c,
+  0x20, 0x31, 0x31, 0x29, 0x20, 0x5e, 0x20, 0x72, 0x6f, 0x74, 0x72, 0x28, 0x65, 0x2c, 0x20, 0x32,
+  0x35, 0x29, 0x29, 0x20, 0x2b, 0x20, 0x28, 0x28, 0x65, 0x20, 0x26, 0x20, 0x66, 0x29, 0x20, 0x5e,
+  0x20, 0x28, 0x7e, 0x65, 0x20, 0x26, 0x20, 0x67, 0x29, 0x29, 0x20, 0x2b, 0x20, 0x6b, 0x5b, 0x69,
+  0x5d, 0x20, 0x2b, 0x20, 0x77, 0x5b, 0x69, 0x5d, 0x29, 0x20, 0x7c, 0x20, 0x30, 0x3b, 0x0a, 0x63,
+  0x6f, 0x6e, 0x73, 0x74, 0x20, 0x74, 0x32, 0x20, 0x3d, 0x20, 0x28, 0x28, 0x72, 0x6f, 0x74, 0x72,
+  0x28, 0x61, 0x2c, 0x20, 0x32, 0x29, 0x20, 0x5e, 0x20, 0x72, 0x6f, 0x74, 0x72, 0x28, 0x61, 0x2c,
+  0x20, 0x31, 0x33, 0x29, 0x20, 0x5e, 0x20, 0x72, 0x6f, 0x74, 0x72, 0x28, 0x61, 0x2c, 0x20, 0x32,
+  0x32, 0x29, 0x29, 0x20, 0x2b, 0x20, 0x28, 0x28, 0x61, 0x20, 0x26, 0x20, 0x62, 0x29, 0x20, 0x5e,
+  0x20, 0x28, 0x61, 0x20, 0x26, 0x20, 0x63, 0x29, 0x20, 0x5e, 0x20, 0x28, 0x62, 0x20, 0x26, 0x20,
+  0x63, 0x29, 0x29, 0x29, 0x20, 0x7c, 0x20, 0x30, 0x3b, 0x0a, 0x68, 0x68, 0x20, 0x3d, 0x20, 0x67,
+  0x3b, 0x0a, 0x67, 0x20, 0x3d, 0x20, 0x66, 0x3b, 0x0a, 0x66, 0x20, 0x3d, 0x20, 0x65, 0x3b, 0x0a,
+  0x65, 0x20, 0x3d, 0x20, 0x28, 0x64, 0x20, 0x2b, 0x20, 0x74, 0x31, 0x29, 0x20, 0x7c, 0x20, 0x30,
+  0x3b, 0x0a, 0x64, 0x20, 0x3d, 0x20, 0x63, 0x3b, 0x0a, 0x63, 0x20, 0x3d, 0x20, 0x62, 0x3b, 0x0a,
+  0x62, 0x20, 0x3d, 0x20, 0x61, 0x3b, 0x0a, 0x61, 0x20, 0x3d, 0x20, 0x28, 0x74, 0x31, 0x20, 0x2b,
+  0x20, 0x74, 0x32, 0x29, 0x20, 0x7c, 0x20, 0x30, 0x3b, 0x0a, 0x7d, 0x0a, 0x5b, 0x61, 0x2c, 0x20,
+  0x62, 0x2c, 0x20, 0x63, 0x2c, 0x20, 0x64, 0x2c, 0x20, 0x65, 0x2c, 0x20, 0x66, 0x2c, 0x20, 0x67,
+  0x2c, 0x20, 0x68, 0x68, 0x5d, 0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x28, 0x76,
+  0x2c, 0x20, 0x69, 0x29, 0x20, 0x3d, 0x3e, 0x20, 0x68, 0x5b, 0x69, 0x5d, 0x20, 0x3d, 0x20, 0x28,
+  0x68, 0x5b, 0x69, 0x5d, 0x20, 0x2b, 0x20, 0x76, 0x29, 0x20, 0x7c, 0x20, 0x30, 0x29, 0x3b, 0x0a,
+  0x7d, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x64, 0x69, 0x67, 0x65, 0x73, 0x74, 0x20, 0x3d,
+  0x20, 0x6e, 0x65, 0x77, 0x20, 0x55, 0x69, 0x6e, 0x74, 0x38, 0x41, 0x72, 0x72, 0x61, 0x79, 0x28,
+  0x33, 0x32, 0x29, 0x3b, 0x0a, 0x68, 0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x28,
+  0x76, 0x2c, 0x20, 0x69, 0x29, 0x20, 0x3d, 0x3e, 0x20, 0x7b, 0x0a, 0x66, 0x6f, 0x72, 0x20, 0x28,
+  0x6c, 0x65, 0x74, 0x20, 0x6a, 0x20, 0x3d, 0x20, 0x30, 0x3b, 0x20, 0x6a, 0x20, 0x3c, 0x20, 0x34,
+  0x3b, 0x20, 0x6a, 0x2b, 0x2b, 0x29, 0x20, 0x7b, 0x0a, 0x64, 0x69, 0x67, 0x65, 0x73, 0x74, 0x5b,
+  0x69, 0x20, 0x2a, 0x20, 0x34, 0x20, 0x2b, 0x20, 0x6a, 0x5d, 0x20, 0x3d, 0x20, 0x76, 0x20, 0x3e,
+  0x3e, 0x3e, 0x20, 0x28, 0x32, 0x34, 0x20, 0x2d, 0x20, 0x6a, 0x20, 0x2a, 0x20, 0x38, 0x29, 0x3b,
+  0x0a, 0x7d, 0x0a, 0x7d, 0x29, 0x3b, 0x0a, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x64, 0x69,
+  0x67, 0x65, 0x73, 0x74, 0x3b, 0x0a, 0x7d, 0x0a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e,
+  0x20, 0x68, 0x6d, 0x61, 0x63, 0x53, 0x68, 0x61, 0x32, 0x35, 0x36, 0x28, 0x6b, 0x65, 0x79, 0x2c,
+  0x20, 0x6d, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x69, 0x66, 0x20, 0x28,
+  0x6b, 0x65, 0x79, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20, 0x3e, 0x20, 0x36, 0x34, 0x29,
+  0x20, 0x7b, 0x0a, 0x6b, 0x65, 0x79, 0x20, 0x3d, 0x20, 0x73, 0x68, 0x61, 0x32, 0x35, 0x36, 0x28,
+  0x6b, 0x65, 0x79, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x69, 0x6e,
+  0x6e, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x6e, 0x65, 0x77, 0x20, 0x55, 0x69, 0x6e, 0x74, 0x38, 0x41,
+  0x72, 0x72, 0x61, 0x79, 0x28, 0x36, 0x34, 0x20, 0x2b, 0x20, 0x6d, 0x65, 0x73, 0x73, 0x61, 0x67,
+  0x65, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x29, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74,
+  0x20, 0x6f, 0x75, 0x74, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x6e, 0x65, 0x77, 0x20, 0x55, 0x69, 0x6e,
+  0x74, 0x38, 0x41, 0x72, 0x72, 0x61, 0x79, 0x28, 0x36, 0x34, 0x20, 0x2b, 0x20, 0x33, 0x32, 0x29,
+  0x3b, 0x0a, 0x66, 0x6f, 0x72, 0x20, 0x28, 0x6c, 0x65, 0x74, 0x20, 0x69, 0x20, 0x3d, 0x20, 0x30,
+  0x3b, 0x20, 0x69, 0x20, 0x3c, 0x20, 0x36, 0x34, 0x3b, 0x20, 0x69, 0x2b, 0x2b, 0x29, 0x20, 0x7b,
+  0x0a, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x5b, 0x69, 0x5d, 0x20, 0x3d, 0x20, 0x28, 0x6b, 0x65, 0x79,
+  0x5b, 0x69, 0x5d, 0x20, 0x7c, 0x7c, 0x20, 0x30, 0x29, 0x20, 0x5e, 0x20, 0x30, 0x78, 0x33, 0x36,
+  0x3b, 0x0a, 0x6f, 0x75, 0x74, 0x65, 0x72, 0x5b, 0x69, 0x5d, 0x20, 0x3d, 0x20, 0x28, 0x6b, 0x65,
+  0x79, 0x5b, 0x69, 0x5d, 0x20, 0x7c, 0x7c, 0x20, 0x30, 0x29, 0x20, 0x5e, 0x20, 0x30, 0x78, 0x35,
+  0x63, 0x3b, 0x0a, 0x7d, 0x0a, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x2e, 0x73, 0x65, 0x74, 0x28, 0x6d,
+  0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x2c, 0x20, 0x36, 0x34, 0x29, 0x3b, 0x0a, 0x6f, 0x75, 0x74,
+  0x65, 0x72, 0x2e, 0x73, 0x65, 0x74, 0x28, 0x73, 0x68, 0x61, 0x32, 0x35, 0x36, 0x28, 0x69, 0x6e,
+  0x6e, 0x65, 0x72, 0x29, 0x2c, 0x20, 0x36, 0x34, 0x29, 0x3b, 0x0a, 0x72, 0x65, 0x74, 0x75, 0x72,
+  0x6e, 0x20, 0x73, 0x68, 0x61, 0x32, 0x35, 0x36, 0x28, 0x6f, 0x75, 0x74, 0x65, 0x72, 0x29, 0x3b,
+  0x0a, 0x7d, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x74, 0x6f, 0x48, 0x65, 0x78, 0x20, 0x3d,
+  0x20, 0x28, 0x62, 0x79, 0x74, 0x65, 0x73, 0x29, 0x20, 0x3d, 0x3e, 0x20, 0x41, 0x72, 0x72, 0x61,
+  0x79, 0x2e, 0x66, 0x72, 0x6f, 0x6d, 0x28, 0x62, 0x79, 0x74, 0x65, 0x73, 0x2c, 0x20, 0x28, 0x62,
+  0x29, 0x20, 0x3d, 0x3e, 0x20, 0x62, 0x2e, 0x74, 0x6f, 0x53, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x28,
+  0x31, 0x36, 0x29, 0x2e, 0x70, 0x61, 0x64, 0x53, 0x74, 0x61, 0x72, 0x74, 0x28, 0x32, 0x2c, 0x20,
+  0x22, 0x30, 0x22, 0x29, 0x29, 0x2e, 0x6a, 0x6f, 0x69, 0x6e, 0x28, 0x22, 0x22, 0x29, 0x3b, 0x0a,
+  0x66, 0x69, 0x6c, 0x65, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65,
+  0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x22, 0x63, 0x68, 0x61, 0x6e,
+  0x67, 0x65, 0x22, 0x2c, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x29, 0x20,
+  0x7b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x20, 0x3d, 0x20, 0x74,
+  0x68, 0x69, 0x73, 0x2e, 0x66, 0x69, 0x6c, 0x65, 0x73, 0x5b, 0x30, 0x5d, 0x3b, 0x0a, 0x69, 0x66,
+  0x20, 0x28, 0x66, 0x69, 0x6c, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20,
+  0x73, 0x69, 0x7a, 0x65, 0x4d, 0x42, 0x20, 0x3d, 0x20, 0x28, 0x66, 0x69, 0x6c, 0x65, 0x2e, 0x73,
+  0x69, 0x7a, 0x65, 0x20, 0x2f, 0x20, 0x28, 0x31, 0x30, 0x32, 0x34, 0x20, 0x2a, 0x20, 0x31, 0x30,
+  0x32, 0x34, 0x29, 0x29, 0x2e, 0x74, 0x6f, 0x46, 0x69, 0x78, 0x65, 0x64, 0x28, 0x32, 0x29, 0x3b,
+  0x0a, 0x66, 0x69, 0x6c, 0x65, 0x49, 0x6e, 0x66, 0x6f, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x43, 0x6f,
+  0x6e, 0x74, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x60, 0x46, 0x69, 0x6c, 0x65, 0x3a, 0x20, 0x24,
+  0x7b, 0x66, 0x69, 0x6c, 0x65, 0x2e, 0x6e, 0x61, 0x6d, 0x65, 0x7d, 0x20, 0x28, 0x24, 0x7b, 0x73,
+  0x69, 0x7a, 0x65, 0x4d, 0x42, 0x7d, 0x20, 0x4d, 0x42, 0x29, 0x60, 0x3b, 0x0a, 0x7d, 0x20, 0x65,
+  0x6c, 0x73, 0x65, 0x20, 0x7b, 0x0a, 0x66, 0x69, 0x6c, 0x65, 0x49, 0x6e, 0x66, 0x6f, 0x2e, 0x74,
+  0x65, 0x78, 0x74, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x22, 0x22, 0x3b,
+  0x0a, 0x7d, 0x0a, 0x7d, 0x29, 0x3b, 0x0a, 0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x46, 0x6f, 0x72,
+  0x6d, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e,
+  0x65, 0x72, 0x28, 0x22, 0x73, 0x75, 0x62, 0x6d, 0x69, 0x74, 0x22, 0x2c, 0x20, 0x61, 0x73, 0x79,
+  0x6e, 0x63, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x28, 0x65, 0x29, 0x20,
+  0x7b, 0x0a, 0x65, 0x2e, 0x70, 0x72, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x44, 0x65, 0x66, 0x61, 0x75,
+  0x6c, 0x74, 0x28, 0x29, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x69, 0x6c, 0x65,
+  0x20, 0x3d, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x2e, 0x66, 0x69, 0x6c,
+  0x65, 0x73, 0x5b, 0x30, 0x5d, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x70, 0x61, 0x73,
+  0x73, 0x77, 0x6f, 0x72, 0x64, 0x20, 0x3d, 0x20, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64,
+  0x49, 0x6e, 0x70, 0x75, 0x74, 0x2e, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x74, 0x72, 0x69, 0x6d,
+  0x28, 0x29, 0x3b, 0x0a, 0x69, 0x66, 0x20, 0x28, 0x21, 0x66, 0x69, 0x6c, 0x65, 0x20, 0x7c, 0x7c,
+  0x20, 0x21, 0x66, 0x69, 0x6c, 0x65, 0x2e, 0x6e, 0x61, 0x6d, 0x65, 0x2e, 0x65, 0x6e, 0x64, 0x73,
+  0x57, 0x69, 0x74, 0x68, 0x28, 0x22, 0x2e, 0x62, 0x69, 0x6e, 0x22, 0x29, 0x29, 0x20, 0x7b, 0x0a,
+  0x61, 0x6c, 0x65, 0x72, 0x74, 0x28, 0x22, 0x50, 0x6c, 0x65, 0x61, 0x73, 0x65, 0x20, 0x73, 0x65,
+  0x6c, 0x65, 0x63, 0x74, 0x20, 0x61, 0x20, 0x76, 0x61, 0x6c, 0x69, 0x64, 0x20, 0x2e, 0x62, 0x69,
+  0x6e, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x2e, 0x22, 0x29, 0x3b, 0x0a, 0x72, 0x65, 0x74, 0x75, 0x72,
+  0x6e, 0x3b, 0x0a, 0x7d, 0x0a, 0x6c, 0x65, 0x74, 0x20, 0x61, 0x75, 0x74, 0x68, 0x20, 0x3d, 0x20,
+  0x22, 0x22, 0x3b, 0x0a, 0x69, 0x66, 0x20, 0x28, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64,
+  0x29, 0x20, 0x7b, 0x0a, 0x74, 0x72, 0x79, 0x20, 0x7b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20,
+  0x72, 0x65, 0x73, 0x70, 0x6f, 0x6e, 0x73, 0x65, 0x20, 0x3d, 0x20, 0x61, 0x77, 0x61, 0x69, 0x74,
+  0x20, 0x66, 0x65, 0x74, 0x63, 0x68, 0x28, 0x22, 0x2f, 0x61, 0x75, 0x74, 0x68, 0x22, 0x2c, 0x20,
+  0x7b, 0x20, 0x63, 0x61, 0x63, 0x68, 0x65, 0x3a, 0x20, 0x22, 0x6e, 0x6f, 0x2d, 0x73, 0x74, 0x6f,
+  0x72, 0x65, 0x22, 0x20, 0x7d, 0x29, 0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6e, 0x6f,
+  0x6e, 0x63, 0x65, 0x20, 0x3d, 0x20, 0x61, 0x77, 0x61, 0x69, 0x74, 0x20, 0x72, 0x65, 0x73, 0x70,
+  0x6f, 0x6e, 0x73, 0x65, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x28, 0x29, 0x3b, 0x0a, 0x61, 0x75, 0x74,
+  0x68, 0x20, 0x3d, 0x20, 0x6e, 0x6f, 0x6e, 0x63, 0x65, 0x20, 0x2b, 0x20, 0x22, 0x3a, 0x22, 0x20,
+  0x2b, 0x20, 0x74, 0x6f, 0x48, 0x65, 0x78, 0x28, 0x68, 0x6d, 0x61, 0x63, 0x53, 0x68, 0x61, 0x32,
+  0x35, 0x36, 0x28, 0x65, 0x6e, 0x63, 0x6f, 0x64, 0x65, 0x72, 0x2e, 0x65, 0x6e, 0x63, 0x6f, 0x64,
+  0x65, 0x28, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x29, 0x2c, 0x20, 0x65, 0x6e, 0x63,
+  0x6f, 0x64, 0x65, 0x72, 0x2e, 0x65, 0x6e, 0x63, 0x6f, 0x64, 0x65, 0x28, 0x6e, 0x6f, 0x6e, 0x63,
+  0x65, 0x29, 0x29, 0x29, 0x3b, 0x0a, 0x7d, 0x20, 0x63, 0x61, 0x74, 0x63, 0x68, 0x20, 0x28, 0x65,
+  0x72, 0x72, 0x29, 0x20, 0x7b, 0x0a, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2e, 0x69, 0x6e, 0x6e,
+  0x65, 0x72, 0x48, 0x54, 0x4d, 0x4c, 0x20, 0x3d, 0x20, 0x60, 0x3c, 0x70, 0x20, 0x63, 0x6c, 0x61,
+  0x73, 0x73, 0x3d, 0x22, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2d, 0x65, 0x72, 0x72, 0x6f, 0x72,
+  0x22, 0x3e, 0x43, 0x6f, 0x75, 0x6c, 0x64, 0x20, 0x6e, 0x6f, 0x74, 0x20, 0x72, 0x65, 0x61, 0x63,
+  0x68, 0x20, 0x74, 0x68, 0x65, 0x20, 0x64, 0x65, 0x76, 0x69, 0x63, 0x65, 0x2e, 0x3c, 0x2f, 0x70,
+  0x3e, 0x60, 0x3b, 0x0a, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x7d, 0x0a, 0x7d, 0x0a,
+  0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x6f, 0x72, 0x6d, 0x44, 0x61, 0x74, 0x61, 0x20, 0x3d,
+  0x20, 0x6e, 0x65, 0x77, 0x20, 0x46, 0x6f, 0x72, 0x6d, 0x44, 0x61, 0x74, 0x61, 0x28, 0x29, 0x3b,
+  0x0a, 0x66, 0x6f, 0x72, 0x6d, 0x44, 0x61, 0x74, 0x61, 0x2e, 0x61, 0x70, 0x70, 0x65, 0x6e, 0x64,
+  0x28, 0x22, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x22, 0x2c, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x29,
+  0x3b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x78, 0x68, 0x72, 0x20, 0x3d, 0x20, 0x6e, 0x65,
+  0x77, 0x20, 0x58, 0x4d, 0x4c, 0x48, 0x74, 0x74, 0x70, 0x52, 0x65, 0x71, 0x75, 0x65, 0x73, 0x74,
+  0x28, 0x29, 0x3b, 0x0a, 0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x42, 0x74, 0x6e, 0x2e, 0x64, 0x69,
+  0x73, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x20, 0x3d, 0x20, 0x74, 0x72, 0x75, 0x65, 0x3b, 0x0a, 0x75,
+  0x70, 0x6c, 0x6f, 0x61, 0x64, 0x42, 0x74, 0x6e, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x43, 0x6f, 0x6e,
+  0x74, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x22, 0x55, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x69, 0x6e,
+  0x67, 0x2e, 0x2e, 0x2e, 0x22, 0x3b, 0x0a, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x43,
+  0x6f, 0x6e, 0x74, 0x61, 0x69, 0x6e, 0x65, 0x72, 0x2e, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x2e, 0x64,
+  0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x20, 0x3d, 0x20, 0x22, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x22,
+  0x3b, 0x0a, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54,
+  0x4d, 0x4c, 0x20, 0x3d, 0x20, 0x22, 0x22, 0x3b, 0x0a, 0x78, 0x68, 0x72, 0x2e, 0x75, 0x70, 0x6c,
+  0x6f, 0x61, 0x64, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74,
+  0x65, 0x6e, 0x65, 0x72, 0x28, 0x22, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x22, 0x2c,
+  0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x28, 0x65, 0x29, 0x20, 0x7b, 0x0a,
+  0x69, 0x66, 0x20, 0x28, 0x65, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x43, 0x6f, 0x6d, 0x70,
+  0x75, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20,
+  0x70, 0x65, 0x72, 0x63, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x4d, 0x61, 0x74, 0x68, 0x2e, 0x72,
+  0x6f, 0x75, 0x6e, 0x64, 0x28, 0x28, 0x65, 0x2e, 0x6c, 0x6f, 0x61, 0x64, 0x65, 0x64, 0x20, 0x2f,
+  0x20, 0x65, 0x2e, 0x74, 0x6f, 0x74, 0x61, 0x6c, 0x29, 0x20, 0x2a, 0x20, 0x31, 0x30, 0x30, 0x29,
+  0x3b, 0x0a, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x42, 0x61, 0x72, 0x2e, 0x73, 0x74,
+  0x79, 0x6c, 0x65, 0x2e, 0x77, 0x69, 0x64, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x70, 0x65, 0x72, 0x63,
+  0x65, 0x6e, 0x74, 0x20, 0x2b, 0x20, 0x22, 0x25, 0x22, 0x3b, 0x0a, 0x73, 0x74, 0x61, 0x74, 0x75,
+  0x73, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54, 0x4d, 0x4c, 0x20, 0x3d, 0x20, 0x60, 0x3c,
+  0x70, 0x3e, 0x55, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x24, 0x7b, 0x70,
+  0x65, 0x72, 0x63, 0x65, 0x6e, 0x74, 0x7d, 0x25, 0x3c, 0x2f, 0x70, 0x3e, 0x60, 0x3b, 0x0a, 0x7d,
+  0x0a, 0x7d, 0x29, 0x3b, 0x0a, 0x78, 0x68, 0x72, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e,
+  0x74, 0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x22, 0x6c, 0x6f, 0x61, 0x64, 0x22,
+  0x2c, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x28, 0x29, 0x20, 0x7b, 0x0a,
+  0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x42, 0x74, 0x6e, 0x2e, 0x64, 0x69, 0x73, 0x61, 0x62, 0x6c,
+  0x65, 0x64, 0x20, 0x3d, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3b, 0x0a, 0x75, 0x70, 0x6c, 0x6f,
+  0x61, 0x64, 0x42, 0x74, 0x6e, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e,
+  0x74, 0x20, 0x3d, 0x20, 0x22, 0x55, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x20, 0x61, 0x6e, 0x64, 0x20,
+  0x55, 0x70, 0x64, 0x61, 0x74, 0x65, 0x22, 0x3b, 0x0a, 0x69, 0x66, 0x20, 0x28, 0x78, 0x68, 0x72,
+  0x2e, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 0x32, 0x30, 0x30, 0x29,
+  0x20, 0x7b, 0x0a, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x42, 0x61, 0x72, 0x2e, 0x73,
+  0x74, 0x79, 0x6c, 0x65, 0x2e, 0x77, 0x69, 0x64, 0x74, 0x68, 0x20, 0x3d, 0x20, 0x22, 0x31, 0x30,
+  0x30, 0x25, 0x22, 0x3b, 0x0a, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2e, 0x69, 0x6e, 0x6e, 0x65,
+  0x72, 0x48, 0x54, 0x4d, 0x4c, 0x20, 0x3d, 0x20, 0x60, 0x3c, 0x70, 0x20, 0x63, 0x6c, 0x61, 0x73,
+  0x73, 0x3d, 0x22, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2d, 0x73, 0x75, 0x63, 0x63, 0x65, 0x73,
+  0x73, 0x22, 0x3e, 0x55, 0x70, 0x64, 0x61, 0x74, 0x65, 0x20, 0x73, 0x75, 0x63, 0x63, 0x65, 0x73,
+  0x73, 0x66, 0x75, 0x6c, 0x21, 0x20, 0x52, 0x65, 0x73, 0x74, 0x61, 0x72, 0x74, 0x69, 0x6e, 0x67,
+  0x20, 0x64, 0x65, 0x76, 0x69, 0x63, 0x65, 0x2e, 0x2e, 0x2e, 0x3c, 0x2f, 0x70, 0x3e, 0x60, 0x3b,
+  0x0a, 0x73, 0x65, 0x74, 0x54, 0x69, 0x6d, 0x65, 0x6f, 0x75, 0x74, 0x28, 0x28, 0x29, 0x20, 0x3d,
+  0x3e, 0x20, 0x7b, 0x0a, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72,
+  0x48, 0x54, 0x4d, 0x4c, 0x20, 0x3d, 0x20, 0x60, 0x3c, 0x70, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73,
+  0x3d, 0x22, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2d, 0x73, 0x75, 0x63, 0x63, 0x65, 0x73, 0x73,
+  0x22, 0x3e, 0x52, 0x65, 0x73, 0x74, 0x61, 0x72, 0x74, 0x69, 0x6e, 0x67, 0x2e, 0x2e, 0x2e, 0x20,
+  0x50, 0x61, 0x67, 0x65, 0x20, 0x77, 0x69, 0x6c, 0x6c, 0x20, 0x72, 0x65, 0x6c, 0x6f, 0x61, 0x64,
+  0x2e, 0x3c, 0x2f, 0x70, 0x3e, 0x60, 0x3b, 0x0a, 0x73, 0x65, 0x74, 0x54, 0x69, 0x6d, 0x65, 0x6f,
+  0x75, 0x74, 0x28, 0x28, 0x29, 0x20, 0x3d, 0x3e, 0x20, 0x6c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f,
+  0x6e, 0x2e, 0x72, 0x65, 0x6c, 0x6f, 0x61, 0x64, 0x28, 0x29, 0x2c, 0x20, 0x35, 0x30, 0x30, 0x30,
+  0x29, 0x3b, 0x0a, 0x7d, 0x2c, 0x20, 0x32, 0x30, 0x30, 0x30, 0x29, 0x3b, 0x0a, 0x7d, 0x20, 0x65,
+  0x6c, 0x73, 0x65, 0x20, 0x69, 0x66, 0x20, 0x28, 0x78, 0x68, 0x72, 0x2e, 0x73, 0x74, 0x61, 0x74,
+  0x75, 0x73, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 0x34, 0x30, 0x31, 0x29, 0x20, 0x7b, 0x0a, 0x70, 0x72,
+  0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x43, 0x6f, 0x6e, 0x74, 0x61, 0x69, 0x6e, 0x65, 0x72, 0x2e,
+  0x73, 0x74, 0x79, 0x6c, 0x65, 0x2e, 0x64, 0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x20, 0x3d, 0x20,
+  0x22, 0x6e, 0x6f, 0x6e, 0x65, 0x22, 0x3b, 0x0a, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2e, 0x69,
+  0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54, 0x4d, 0x4c, 0x20, 0x3d, 0x20, 0x60, 0x3c, 0x70, 0x20, 0x63,
+  0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2d, 0x65, 0x72, 0x72,
+  0x6f, 0x72, 0x22, 0x3e, 0x49, 0x6e, 0x63, 0x6f, 0x72, 0x72, 0x65, 0x63, 0x74, 0x20, 0x70, 0x61,
+  0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x21, 0x20, 0x50, 0x6c, 0x65, 0x61, 0x73, 0x65, 0x20, 0x63,
+  0x68, 0x65, 0x63, 0x6b, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x74, 0x72, 0x79, 0x20, 0x61, 0x67, 0x61,
+  0x69, 0x6e, 0x2e, 0x3c, 0x2f, 0x70, 0x3e, 0x60, 0x3b, 0x0a, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f,
+  0x72, 0x64, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x2e, 0x66, 0x6f, 0x63, 0x75, 0x73, 0x28, 0x29, 0x3b,
+  0x0a, 0x7d, 0x20, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66, 0x20, 0x28, 0x78, 0x68, 0x72, 0x2e,
+  0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 0x34, 0x31, 0x33, 0x29, 0x20,
+  0x7b, 0x0a, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x43, 0x6f, 0x6e, 0x74, 0x61, 0x69,
+  0x6e, 0x65, 0x72, 0x2e, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x2e, 0x64, 0x69, 0x73, 0x70, 0x6c, 0x61,
+  0x79, 0x20, 0x3d, 0x20, 0x22, 0x6e, 0x6f, 0x6e, 0x65, 0x22, 0x3b, 0x0a, 0x73, 0x74, 0x61, 0x74,
+  0x75, 0x73, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54, 0x4d, 0x4c, 0x20, 0x3d, 0x20, 0x60,
+  0x3c, 0x70, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73,
+  0x2d, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x22, 0x3e, 0x46, 0x69, 0x72, 0x6d, 0x77, 0x61, 0x72, 0x65,
+  0x20, 0x69, 0x73, 0x20, 0x6c, 0x61, 0x72, 0x67, 0x65, 0x72, 0x20, 0x74, 0x68, 0x61, 0x6e, 0x20,
+  0x74, 0x68, 0x65, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x20, 0x70, 0x61, 0x72, 0x74, 0x69,
+  0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x3c, 0x2f, 0x70, 0x3e, 0x60, 0x3b, 0x0a, 0x7d, 0x20, 0x65, 0x6c,
+  0x73, 0x65, 0x20, 0x7b, 0x0a, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x43, 0x6f, 0x6e,
+  0x74, 0x61, 0x69, 0x6e, 0x65, 0x72, 0x2e, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x2e, 0x64, 0x69, 0x73,
+  0x70, 0x6c, 0x61, 0x79, 0x20, 0x3d, 0x20, 0x22, 0x6e, 0x6f, 0x6e, 0x65, 0x22, 0x3b, 0x0a, 0x73,
+  0x74, 0x61, 0x74, 0x75, 0x73, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54, 0x4d, 0x4c, 0x20,
+  0x3d, 0x20, 0x60, 0x3c, 0x70, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x73, 0x74, 0x61,
+  0x74, 0x75, 0x73, 0x2d, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x22, 0x3e, 0x55, 0x70, 0x64, 0x61, 0x74,
+  0x65, 0x20, 0x66, 0x61, 0x69, 0x6c, 0x65, 0x64, 0x3a, 0x20, 0x24, 0x7b, 0x78, 0x68, 0x72, 0x2e,
+  0x72, 0x65, 0x73, 0x70, 0x6f, 0x6e, 0x73, 0x65, 0x54, 0x65, 0x78, 0x74, 0x7d, 0x3c, 0x2f, 0x70,
+  0x3e, 0x60, 0x3b, 0x0a, 0x7d, 0x0a, 0x7d, 0x29, 0x3b, 0x0a, 0x78, 0x68, 0x72, 0x2e, 0x61, 0x64,
+  0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x22,
+  0x65, 0x72, 0x72, 0x6f, 0x72, 0x22, 0x2c, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e,
+  0x20, 0x28, 0x29, 0x20, 0x7b, 0x0a, 0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x42, 0x74, 0x6e, 0x2e,
+  0x64, 0x69, 0x73, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x20, 0x3d, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65,
+  0x3b, 0x0a, 0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x42, 0x74, 0x6e, 0x2e, 0x74, 0x65, 0x78, 0x74,
+  0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x22, 0x55, 0x70, 0x6c, 0x6f, 0x61,
+  0x64, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x55, 0x70, 0x64, 0x61, 0x74, 0x65, 0x22, 0x3b, 0x0a, 0x70,
+  0x72, 0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x43, 0x6f, 0x6e, 0x74, 0x61, 0x69, 0x6e, 0x65, 0x72,
+  0x2e, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x2e, 0x64, 0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x20, 0x3d,
+  0x20, 0x22, 0x6e, 0x6f, 0x6e, 0x65, 0x22, 0x3b, 0x0a, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2e,
+  0x69, 0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54, 0x4d, 0x4c, 0x20, 0x3d, 0x20, 0x60, 0x3c, 0x70, 0x20,
+  0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2d, 0x65, 0x72,
+  0x72, 0x6f, 0x72, 0x22, 0x3e, 0x4e, 0x65, 0x74, 0x77, 0x6f, 0x72, 0x6b, 0x20, 0x65, 0x72, 0x72,
+  0x6f, 0x72, 0x20, 0x6f, 0x63, 0x63, 0x75, 0x72, 0x72, 0x65, 0x64, 0x20, 0x77, 0x68, 0x69, 0x6c,
+  0x65, 0x20, 0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x69, 0x6e, 0x67, 0x2e, 0x3c, 0x2f, 0x70, 0x3e,
+  0x60, 0x3b, 0x0a, 0x7d, 0x29, 0x3b, 0x0a, 0x78, 0x68, 0x72, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76,
+  0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x22, 0x74, 0x69, 0x6d,
+  0x65, 0x6f, 0x75, 0x74, 0x22, 0x2c, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20,
+  0x28, 0x29, 0x20, 0x7b, 0x0a, 0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x42, 0x74, 0x6e, 0x2e, 0x64,
+  0x69, 0x73, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x20, 0x3d, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3b,
+  0x0a, 0x75, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x42, 0x74, 0x6e, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x43,
+  0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x22, 0x55, 0x70, 0x6c, 0x6f, 0x61, 0x64,
+  0x20, 0x61, 0x6e, 0x64, 0x20, 0x55, 0x70, 0x64, 0x61, 0x74, 0x65, 0x22, 0x3b, 0x0a, 0x70, 0x72,
+  0x6f, 0x67, 0x72, 0x65, 0x73, 0x73, 0x43, 0x6f, 0x6e, 0x74, 0x61, 0x69, 0x6e, 0x65, 0x72, 0x2e,
+  0x73, 0x74, 0x79, 0x6c, 0x65, 0x2e, 0x64, 0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x20, 0x3d, 0x20,
+  0x22, 0x6e, 0x6f, 0x6e, 0x65, 0x22, 0x3b, 0x0a, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2e, 0x69,
+  0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54, 0x4d, 0x4c, 0x20, 0x3d, 0x20, 0x60, 0x3c, 0x70, 0x20, 0x63,
+  0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2d, 0x65, 0x72, 0x72,
+  0x6f, 0x72, 0x22, 0x3e, 0x55, 0x70, 0x6c, 0x6f, 0x61, 0x64, 0x20, 0x74, 0x69, 0x6d, 0x65, 0x6f,
+  0x75, 0x74, 0x20, 0x2d, 0x20, 0x70, 0x6c, 0x65, 0x61, 0x73, 0x65, 0x20, 0x74, 0x72, 0x79, 0x20,
+  0x61, 0x67, 0x61, 0x69, 0x6e, 0x2e, 0x3c, 0x2f, 0x70, 0x3e, 0x60, 0x3b, 0x0a, 0x7d, 0x29, 0x3b,
+  0x0a, 0x78, 0x68, 0x72, 0x2e, 0x74, 0x69, 0x6d, 0x65, 0x6f, 0x75, 0x74, 0x20, 0x3d, 0x20, 0x33,
+  0x30, 0x30, 0x30, 0x30, 0x30, 0x3b, 0x0a, 0x78, 0x68, 0x72, 0x2e, 0x6f, 0x70, 0x65, 0x6e, 0x28,
+  0x22, 0x50, 0x4f, 0x53, 0x54, 0x22, 0x2c, 0x20, 0x22, 0x2f, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65,
+  0x22, 0x29, 0x3b, 0x0a, 0x78, 0x68, 0x72, 0x2e, 0x73, 0x65, 0x74, 0x52, 0x65, 0x71, 0x75, 0x65,
+  0x73, 0x74, 0x48, 0x65, 0x61, 0x64, 0x65, 0x72, 0x28, 0x22, 0x58, 0x2d, 0x55, 0x70, 0x64, 0x61,
+  0x74, 0x65, 0x2d, 0x53, 0x69, 0x7a, 0x65, 0x22, 0x2c, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x2e, 0x73,
+  0x69, 0x7a, 0x65, 0x29, 0x3b, 0x0a, 0x69, 0x66, 0x20, 0x28, 0x61, 0x75, 0x74, 0x68, 0x29, 0x20,
+  0x7b, 0x0a, 0x78, 0x68, 0x72, 0x2e, 0x73, 0x65, 0x74, 0x52, 0x65, 0x71, 0x75, 0x65, 0x73, 0x74,
+  0x48, 0x65, 0x61, 0x64, 0x65, 0x72, 0x28, 0x22, 0x58, 0x2d, 0x4f, 0x54, 0x41, 0x2d, 0x41, 0x75,
+  0x74, 0x68, 0x22, 0x2c, 0x20, 0x61, 0x75, 0x74, 0x68, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x78, 0x68,
+  0x72, 0x2e, 0x73, 0x65, 0x6e, 0x64, 0x28, 0x66, 0x6f, 0x72, 0x6d, 0x44, 0x61, 0x74, 0x61, 0x29,
+  0x3b, 0x0a, 0x7d, 0x29, 0x3b, 0x0a, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x2e, 0x61, 0x64, 0x64,
+  0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x27, 0x6c,
+  0x6f, 0x61, 0x64, 0x27, 0x2c, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x29,
+  0x20, 0x7b, 0x0a, 0x69, 0x66, 0x20, 0x28, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x49,
+  0x6e, 0x70, 0x75, 0x74, 0x2e, 0x70, 0x6c, 0x61, 0x63, 0x65, 0x68, 0x6f, 0x6c, 0x64, 0x65, 0x72,
+  0x29, 0x20, 0x7b, 0x0a, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x49, 0x6e, 0x70, 0x75,
+  0x74, 0x2e, 0x66, 0x6f, 0x63, 0x75, 0x73, 0x28, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x7d, 0x29, 0x3b,
+  0x0a, 0x3c, 0x2f, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x3e, 0x0a, 0x3c, 0x2f, 0x62, 0x6f, 0x64,
+  0x79, 0x3e, 0x0a, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x00,
+};
+
+#endif // AVISHA_OTA_UI_H
@@ -0,0 +1,347 @@
+// AViShaOTAWriter.cpp - Double-buffered flash writer task
+#include "AViShaOTAWriter.h"
+#include <Update.h>
+#include <esp_image_format.h>
+
+#define WRITER_STOP 0xFF
+#define WRITER_ERASE 0xFE  // Wakes the task to start erasing
+#define WRITER_MD5_STEP 4096  // MD5Builder::add() takes a 16-bit length on older cores
+
+// Constructor
+AViShaOTAWriter::AViShaOTAWriter() {
+  this->count = 0;
+  this->size = 0;
+  this->current = -1;
+  this->freeQueue = nullptr;
+  this->fullQueue = nullptr;
+  this->doneSemaphore = nullptr;
+  this->task = nullptr;
+  this->partition = nullptr;
+  this->offset = 0;
+  this->erased = 0;
+  this->eraseEnd = 0;
+  this->hashing = false;
+  this->latency = nullptr;
+  this->stall = nullptr;
+  this->failed = false;
+  this->busyMicros = 0;
+  this->stallMicros = 0;
+  for (uint8_t i = 0; i < AVISHA_OTA_MAX_WRITE_BUFFERS; i++) {
+    blocks[i].data = nullptr;
+    blocks[i].len = 0;
+  }
+}
+
+// Destructor
+AViShaOTAWriter::~AViShaOTAWriter() {
+  if (task) {
+    abort();
+  }
+  release();
+}
+
+bool AViShaOTAWriter::begin(uint8_t count, size_t size) {
+  if (task) {
+    abort();
+  }
+  release();
+
+  if (count == 0 || count > AVISHA_OTA_MAX_WRITE_BUFFERS || size == 0) {
+    return false;
+  }
+  this->count = count;
+  this->size = size;
+  this->current = -1;
+  this->partition = nullptr;
+  this->eraseEnd = 0;
+  this->hashing = false;
+  this->failed = false;
+  this->busyMicros = 0;
+  this->stallMicros = 0;
+
+  // Room for every buffer plus the erase and stop messages
+  freeQueue = xQueueCreate(count, sizeof(uint8_t));
+  fullQueue = xQueueCreate(count + 2, sizeof(uint8_t));
+  doneSemaphore = xSemaphoreCreateBinary();
+  if (!freeQueue || !fullQueue || !doneSemaphore) {
+    release();
+    return false;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    blocks[i].data = (uint8_t*)malloc(size);
+    blocks[i].len = 0;
+    if (!blocks[i].data) {
+      release();
+      return false;
+    }
+    xQueueSend(freeQueue, &i, 0);
+  }
+
+  if (xTaskCreate(taskEntry, "ota_writer", AVISHA_OTA_WRITER_STACK, this,
+                  AVISHA_OTA_WRITER_PRIORITY, &task) != pdPASS) {
+    task = nullptr;
+    release();
+    return false;
+  }
+  return true;
+}
+
+bool AViShaOTAWriter::setPartition(const esp_partition_t* partition, size_t imageSize, bool md5) {
+  if (!task || !partition || imageSize > partition->size) {
+    return false;
+  }
+  this->partition = partition;
+  this->offset = 0;
+  this->erased = 0;
+  this->eraseEnd = (imageSize + AVISHA_OTA_WRITER_SECTOR - 1) & ~(size_t)(AVISHA_OTA_WRITER_SECTOR - 1);
+  this->hashing = md5;
+  if (md5) {
+    this->md5.begin();
+  }
+
+  // Start erasing now rather than when the first buffer arrives
+  uint8_t index = WRITER_ERASE;
+  xQueueSend(fullQueue, &index, portMAX_DELAY);
+  return true;
+}
+
+void AViShaOTAWriter::setLatencyHistogram(AViShaOTAHistogram* histogram) {
+  this->latency = histogram;
+}
+
+void AViShaOTAWriter::setStallHistogram(AViShaOTAHistogram* histogram) {
+  this->stall = histogram;
+}
+
+bool AViShaOTAWriter::write(const uint8_t* data, size_t len) {
+  while (len > 0) {
+    if (failed) {
+      return false;
+    }
+    if (current < 0 && !acquire()) {
+      return false;
+    }
+
+    Block& block = blocks[current];
+    size_t n = min(len, size - block.len);
+    memcpy(block.data + block.len, data, n);
+    block.len += n;
+    data += n;
+    len -= n;
+
+    if (block.len == size) {
+      submit();
+    }
+  }
+  return !failed;
+}
+
+uint8_t* AViShaOTAWriter::reserve(size_t& len) {
+  if (failed || (current < 0 && !acquire())) {
+    len = 0;
+    return nullptr;
+  }
+  Block& block = blocks[current];
+  len = size - block.len;
+  return block.data + block.len;
+}
+
+bool AViShaOTAWriter::commit(size_t len) {
+  if (failed || current < 0) {
+    return false;
+  }
+  Block& block = blocks[current];
+  block.len += len;
+  if (block.len == size) {
+    submit();
+  }
+  return true;
+}
+
+bool AViShaOTAWriter::finish() {
+  if (!task) {
+    return false;
+  }
+  if (current >= 0) {
+    submit();
+  }
+  bool ok = stop() && !failed;
+  release();
+  return ok;
+}
+
+void AViShaOTAWriter::abort() {
+  // Queued buffers are drained without being written
+  failed = true;
+  if (task) {
+    stop();
+  }
+  release();
+}
+
+bool AViShaOTAWriter::isActive() const {
+  return task != nullptr;
+}
+
+bool AViShaOTAWriter::hasFailed() const {
+  return failed;
+}
+
+String AViShaOTAWriter::getMD5() {
+  if (!hashing) {
+    return String();
+  }
+  md5.calculate();
+  return md5.toString();
+}
+
+unsigned long AViShaOTAWriter::getBusyMs() const {
+  return busyMicros / 1000;
+}
+
+unsigned long AViShaOTAWriter::getStallMs() const {
+  return stallMicros / 1000;
+}
+
+void AViShaOTAWriter::taskEntry(void* arg) {
+  static_cast<AViShaOTAWriter*>(arg)->run();
+  vTaskDelete(nullptr);
+}
+
+void AViShaOTAWriter::run() {
+  uint8_t index;
+
+  for (;;) {
+    // Erase the next sector or block ahead of the data while no buffer is waiting
+    TickType_t wait = !failed && erased < eraseEnd ? 0 : portMAX_DELAY;
+    if (xQueueReceive(fullQueue, &index, wait) != pdTRUE) {
+      unsigned long eraseStart = micros();
+      if (!eraseTo(erased + AVISHA_OTA_WRITER_SECTOR)) {
+        failed = true;
+      }
+      busyMicros += micros() - eraseStart;
+      continue;
+    }
+    if (index == WRITER_STOP) {
+      break;
+    }
+    if (index == WRITER_ERASE) {
+      continue;
+    }
+
+    Block& block = blocks[index];
+    if (!failed && block.len > 0) {
+      unsigned long writeStart = micros();
+      if (!writeBlock(block)) {
+        failed = true;
+      }
+      unsigned long elapsed = micros() - writeStart;
+      busyMicros += elapsed;
+      if (latency) {
+        latency->observe(elapsed);
+      }
+    }
+    block.len = 0;
+    xQueueSend(freeQueue, &index, portMAX_DELAY);
+  }
+
+  xSemaphoreGive(doneSemaphore);
+}
+
+bool AViShaOTAWriter::writeBlock(const Block& block) {
+  if (!partition) {
+    return Update.write(block.data, block.len) == block.len;
+  }
+
+  // Update.write() rejects anything else before writing it
+  if (offset == 0 && block.data[0] != ESP_IMAGE_HEADER_MAGIC) {
+    return false;
+  }
+  // Only what the background erase has not reached yet
+  if (!eraseTo(offset + block.len) ||
+      esp_partition_write(partition, offset, block.data, block.len) != ESP_OK) {
+    return false;
+  }
+  if (hashing) {
+    for (size_t done = 0; done < block.len; done += WRITER_MD5_STEP) {
+      md5.add(block.data + done, min(block.len - done, (size_t)WRITER_MD5_STEP));
+    }
+  }
+  offset += block.len;
+  return true;
+}
+
+// Erase up to end, a 64 KB block at a time where the flash address is
+// aligned and the image covers it, which the chip erases several times
+// faster than its sixteen sectors
+bool AViShaOTAWriter::eraseTo(size_t end) {
+  while (erased < end) {
+    size_t step = AVISHA_OTA_WRITER_SECTOR;
+    if ((partition->address + erased) % AVISHA_OTA_WRITER_BLOCK == 0 &&
+        erased + AVISHA_OTA_WRITER_BLOCK <= eraseEnd) {
+      step = AVISHA_OTA_WRITER_BLOCK;
+    }
+    if (esp_partition_erase_range(partition, erased, step) != ESP_OK) {
+      return false;
+    }
+    erased += step;
+  }
+  return true;
+}
+
+// Take a free buffer, waiting for the writer task if all are queued
+bool AViShaOTAWriter::acquire() {
+  uint8_t index;
+  unsigned long waitStart = micros();
+
+  if (xQueueReceive(freeQueue, &index, portMAX_DELAY) != pdTRUE) {
+    return false;
+  }
+  uint32_t waited = micros() - waitStart;
+  stallMicros += waited;
+  if (stall) {
+    stall->observe(waited);
+  }
+  current = index;
+  return true;
+}
+
+void AViShaOTAWriter::submit() {
+  uint8_t index = (uint8_t)current;
+  current = -1;
+  xQueueSend(fullQueue, &index, portMAX_DELAY);
+}
+
+bool AViShaOTAWriter::stop() {
+  uint8_t index = WRITER_STOP;
+  if (xQueueSend(fullQueue, &index, portMAX_DELAY) != pdTRUE) {
+    return false;
+  }
+  xSemaphoreTake(doneSemaphore, portMAX_DELAY);
+  task = nullptr;
+  return true;
+}
+
+void AViShaOTAWriter::release() {
+  for (uint8_t i = 0; i < AVISHA_OTA_MAX_WRITE_BUFFERS; i++) {
+    if (blocks[i].data) {
+      free(blocks[i].data);
+      blocks[i].data = nullptr;
+    }
+    blocks[i].len = 0;
+  }
+  if (freeQueue) {
+    vQueueDelete(freeQueue);
+    freeQueue = nullptr;
+  }
+  if (fullQueue) {
+    vQueueDelete(fullQueue);
+    fullQueue = nullptr;
+  }
+  if (doneSemaphore) {
+    vSemaphoreDelete(doneSemaphore);
+    doneSemaphore = nullptr;
+  }
+  current = -1;
+}
@@ -0,0 +1,89 @@
+#ifndef AVISHA_OTA_WRITER_H
+#define AVISHA_OTA_WRITER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <esp_partition.h>
+#include <MD5Builder.h>
+#include "AViShaOTAMetrics.h"
+
+#define AVISHA_OTA_MAX_WRITE_BUFFERS 4
+#define AVISHA_OTA_WRITER_STACK 4096
+#define AVISHA_OTA_WRITER_PRIORITY 2
+#define AVISHA_OTA_WRITER_SECTOR 4096
+#define AVISHA_OTA_WRITER_BLOCK 65536    // Erased in one go where aligned, as Update does
+
+// Collects decoded image data into sector-sized buffers and hands full
+// buffers to a dedicated task that writes them to flash, so the network side
+// keeps receiving while flash erases and programs. When every buffer is
+// queued, write() blocks until the task returns one.
+//
+// Given the partition and the image size, the task writes the partition
+// itself and erases it ahead of the data, 64 KB blocks where aligned and
+// sectors elsewhere, whenever no buffer is waiting. Update.write() would
+// erase each block only once the data reaches it.
+class AViShaOTAWriter {
+public:
+    AViShaOTAWriter();
+    ~AViShaOTAWriter();
+
+    bool begin(uint8_t count, size_t size);
+    // Before the first write(); the caller finishes the image, see getMD5()
+    bool setPartition(const esp_partition_t* partition, size_t imageSize, bool md5);
+    void setLatencyHistogram(AViShaOTAHistogram* histogram); // Observes each flash write
+    void setStallHistogram(AViShaOTAHistogram* histogram);   // Observes each wait for a free buffer
+    bool write(const uint8_t* data, size_t len);
+    uint8_t* reserve(size_t& len);  // Free space in the current buffer, to be filled in place
+    bool commit(size_t len);        // Hand on len bytes written to reserve()
+    bool finish();  // Flush the partial buffer and wait for the task
+    void abort();
+
+    bool isActive() const;
+    bool hasFailed() const;
+    String getMD5();                   // Of the data written to the partition
+    unsigned long getBusyMs() const;   // Time spent writing and erasing flash
+    unsigned long getStallMs() const;  // Time the receiver waited for a buffer
+
+private:
+    struct Block {
+        uint8_t* data;
+        size_t len;
+    };
+
+    Block blocks[AVISHA_OTA_MAX_WRITE_BUFFERS];
+    uint8_t count;
+    size_t size;
+    int current;
+
+    QueueHandle_t freeQueue;
+    QueueHandle_t fullQueue;
+    SemaphoreHandle_t doneSemaphore;
+    TaskHandle_t task;
+
+    const esp_partition_t* partition;  // nullptr writes through Update
+    size_t offset;
+    size_t erased;
+    size_t eraseEnd;
+    bool hashing;
+    MD5Builder md5;
+
+    AViShaOTAHistogram* latency;
+    AViShaOTAHistogram* stall;
+    volatile bool failed;
+    volatile unsigned long busyMicros;
+    unsigned long stallMicros;
+
+    static void taskEntry(void* arg);
+    void run();
+    bool writeBlock(const Block& block);
+    bool eraseTo(size_t end);
+    bool acquire();
+    void submit();
+    bool stop();
+    void release();
+};
+
+#endif // AVISHA_OTA_WRITER_H